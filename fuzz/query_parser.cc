@@ -0,0 +1,44 @@
+#include "server/api/query_parser.hpp"
+
+#include "util.hpp"
+
+#include <cstdlib>
+#include <iterator>
+#include <string>
+
+using osrm::server::api::QueryParser;
+
+// Runs the parser primitives over the input and checks that they never move the position
+// backwards or past the end and that failing integer parsers leave the position untouched.
+extern "C" int LLVMFuzzerTestOneInput(const unsigned char *data, unsigned long size)
+{
+    std::string in(reinterpret_cast<const char *>(data), size);
+
+    QueryParser parser(begin(in), end(in));
+    while (!parser.AtEnd())
+    {
+        const auto position = parser.Position();
+
+        double real;
+        unsigned integer;
+        short signed_integer;
+        unsigned char hex;
+        bool boolean;
+        if (!parser.Double(real) && !parser.JsonDouble(real))
+        {
+            parser.Reset(position);
+            const bool matched = parser.Unsigned(integer) || parser.Signed(signed_integer) ||
+                                 parser.Hex(hex) || parser.Bool(boolean);
+            if (!matched && parser.Position() != position)
+                std::abort();
+            if (!matched)
+                parser.Reset(position + 1);
+        }
+        escape(&real);
+
+        if (parser.Position() <= position || parser.Position() > parser.End())
+            std::abort();
+    }
+
+    return 0;
+}
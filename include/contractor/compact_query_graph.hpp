@@ -0,0 +1,218 @@
+#ifndef OSRM_CONTRACTOR_COMPACT_QUERY_GRAPH_HPP
+#define OSRM_CONTRACTOR_COMPACT_QUERY_GRAPH_HPP
+
+#include "contractor/query_edge.hpp"
+#include "util/integer_range.hpp"
+#include "util/shared_memory_vector_wrapper.hpp"
+#include "util/static_graph.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace osrm
+{
+namespace contractor
+{
+
+// The part of QueryEdge::EdgeData a search needs to relax an edge
+struct QueryEdgeSearchData
+{
+    std::int32_t weight : 30;
+    std::uint32_t forward : 1;
+    std::uint32_t backward : 1;
+};
+
+/**
+ * Query graph with the edge data split by access pattern: the target, weight and direction
+ * flags are touched by every relaxation and packed into 8 bytes per edge. The shortcut flag and
+ * the ID (middle node of a shortcut or ID of the original edge) are only needed to unpack paths
+ * and live in a separate array, so searches only stream 2/3 of the edge data of StaticGraph.
+ *
+ * The interface mirrors util::StaticGraph, except that GetEdgeData returns the assembled data by
+ * value and GetEdgeSearchData only returns the hot part.
+ */
+template <bool UseSharedMemory = false> class CompactQueryGraph
+{
+  public:
+    using NodeIterator = NodeID;
+    using EdgeIterator = NodeID;
+    using EdgeData = QueryEdge::EdgeData;
+    using EdgeRange = util::range<EdgeIterator>;
+
+    using NodeArrayEntry = typename util::StaticGraph<EdgeData>::NodeArrayEntry;
+
+    struct EdgeArrayEntry
+    {
+        NodeID target;
+        QueryEdgeSearchData data;
+    };
+
+    struct EdgeIDEntry
+    {
+        NodeID id : 31;
+        std::uint32_t shortcut : 1;
+    };
+
+    // Splits an edge of the .hsgr file into its hot and cold part
+    static void Split(const typename util::StaticGraph<EdgeData>::EdgeArrayEntry &edge,
+                      EdgeArrayEntry &edge_entry,
+                      EdgeIDEntry &id_entry)
+    {
+        edge_entry.target = edge.target;
+        edge_entry.data.weight = edge.data.weight;
+        edge_entry.data.forward = edge.data.forward;
+        edge_entry.data.backward = edge.data.backward;
+        id_entry.id = edge.data.id;
+        id_entry.shortcut = edge.data.shortcut;
+    }
+
+    template <typename ContainerT> CompactQueryGraph(const int nodes, const ContainerT &graph)
+    {
+        BOOST_ASSERT(std::is_sorted(graph.begin(), graph.end()));
+
+        number_of_nodes = nodes;
+        number_of_edges = static_cast<EdgeIterator>(graph.size());
+        node_array.resize(number_of_nodes + 1);
+        edge_array.resize(number_of_edges);
+        id_array.resize(number_of_edges);
+
+        EdgeIterator edge = 0;
+        for (const auto node : util::irange(0u, number_of_nodes + 1))
+        {
+            node_array[node].first_edge = edge;
+            while (edge < number_of_edges && graph[edge].source == node)
+            {
+                edge_array[edge].target = graph[edge].target;
+                edge_array[edge].data.weight = graph[edge].data.weight;
+                edge_array[edge].data.forward = graph[edge].data.forward;
+                edge_array[edge].data.backward = graph[edge].data.backward;
+                id_array[edge].id = graph[edge].data.id;
+                id_array[edge].shortcut = graph[edge].data.shortcut;
+                ++edge;
+            }
+        }
+    }
+
+    CompactQueryGraph(typename util::ShM<NodeArrayEntry, UseSharedMemory>::vector &nodes,
+                      typename util::ShM<EdgeArrayEntry, UseSharedMemory>::vector &edges,
+                      typename util::ShM<EdgeIDEntry, UseSharedMemory>::vector &ids)
+    {
+        BOOST_ASSERT(edges.size() == ids.size());
+        number_of_nodes = static_cast<decltype(number_of_nodes)>(nodes.size() - 1);
+        number_of_edges = static_cast<decltype(number_of_edges)>(edges.size());
+
+        using std::swap;
+        swap(node_array, nodes);
+        swap(edge_array, edges);
+        swap(id_array, ids);
+    }
+
+    unsigned GetNumberOfNodes() const { return number_of_nodes; }
+
+    unsigned GetNumberOfEdges() const { return number_of_edges; }
+
+    unsigned GetOutDegree(const NodeIterator n) const { return EndEdges(n) - BeginEdges(n); }
+
+    NodeIterator GetTarget(const EdgeIterator e) const { return edge_array[e].target; }
+
+    const QueryEdgeSearchData &GetEdgeSearchData(const EdgeIterator e) const
+    {
+        return edge_array[e].data;
+    }
+
+    EdgeData GetEdgeData(const EdgeIterator e) const
+    {
+        EdgeData data;
+        data.id = id_array[e].id;
+        data.shortcut = id_array[e].shortcut;
+        data.weight = edge_array[e].data.weight;
+        data.forward = edge_array[e].data.forward;
+        data.backward = edge_array[e].data.backward;
+        return data;
+    }
+
+    EdgeIterator BeginEdges(const NodeIterator n) const { return node_array[n].first_edge; }
+
+    EdgeIterator EndEdges(const NodeIterator n) const { return node_array[n + 1].first_edge; }
+
+    EdgeRange GetAdjacentEdgeRange(const NodeIterator node) const
+    {
+        return util::irange(BeginEdges(node), EndEdges(node));
+    }
+
+    // searches for a specific edge
+    EdgeIterator FindEdge(const NodeIterator from, const NodeIterator to) const
+    {
+        for (const auto i : GetAdjacentEdgeRange(from))
+        {
+            if (to == edge_array[i].target)
+            {
+                return i;
+            }
+        }
+        return SPECIAL_EDGEID;
+    }
+
+    // Finds the edge with the smallest weight going from `from` to `to` that satisfies `filter`
+    template <typename FilterFunction>
+    EdgeIterator
+    FindSmallestEdge(const NodeIterator from, const NodeIterator to, FilterFunction &&filter) const
+    {
+        EdgeIterator smallest_edge = SPECIAL_EDGEID;
+        EdgeWeight smallest_weight = INVALID_EDGE_WEIGHT;
+        for (const auto edge : GetAdjacentEdgeRange(from))
+        {
+            const auto &data = edge_array[edge].data;
+            if (edge_array[edge].target == to && data.weight < smallest_weight &&
+                std::forward<FilterFunction>(filter)(GetEdgeData(edge)))
+            {
+                smallest_edge = edge;
+                smallest_weight = data.weight;
+            }
+        }
+        return smallest_edge;
+    }
+
+    EdgeIterator FindEdgeInEitherDirection(const NodeIterator from, const NodeIterator to) const
+    {
+        const EdgeIterator edge = FindEdge(from, to);
+        return (SPECIAL_EDGEID != edge ? edge : FindEdge(to, from));
+    }
+
+    EdgeIterator
+    FindEdgeIndicateIfReverse(const NodeIterator from, const NodeIterator to, bool &result) const
+    {
+        EdgeIterator current_iterator = FindEdge(from, to);
+        if (SPECIAL_EDGEID == current_iterator)
+        {
+            current_iterator = FindEdge(to, from);
+            if (SPECIAL_EDGEID != current_iterator)
+            {
+                result = true;
+            }
+        }
+        return current_iterator;
+    }
+
+  private:
+    NodeIterator number_of_nodes;
+    EdgeIterator number_of_edges;
+
+    typename util::ShM<NodeArrayEntry, UseSharedMemory>::vector node_array;
+    typename util::ShM<EdgeArrayEntry, UseSharedMemory>::vector edge_array;
+    typename util::ShM<EdgeIDEntry, UseSharedMemory>::vector id_array;
+};
+
+static_assert(sizeof(QueryEdgeSearchData) == 4, "search data should be packed into 4 bytes");
+static_assert(sizeof(CompactQueryGraph<>::EdgeArrayEntry) == 8,
+              "hot edge data should be packed into 8 bytes");
+static_assert(sizeof(CompactQueryGraph<>::EdgeIDEntry) == 4,
+              "edge ids should be packed into 4 bytes");
+}
+}
+
+#endif
@@ -0,0 +1,283 @@
+#ifndef OSRM_CONTRACTOR_CONTRACTION_GRAPH_HPP
+#define OSRM_CONTRACTOR_CONTRACTION_GRAPH_HPP
+
+#include "util/integer_range.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace contractor
+{
+
+/**
+ * Adjacency store used by the GraphContractor.
+ *
+ * In contrast to util::DynamicGraph all edges are kept in a single packed array. Every node owns
+ * a contiguous slice of that array with an explicit capacity. If a node runs out of capacity its
+ * edges are moved to the end of the array, leaving a hole behind. Holes are tracked and the array
+ * is compacted in place once they make up a large fraction of the storage, which keeps the peak
+ * memory usage close to the number of live edges.
+ *
+ * DeleteEdgesTo may be called concurrently for distinct source nodes, all other modifying
+ * operations must be called from a single thread.
+ */
+template <typename EdgeDataT> class ContractionGraph
+{
+  public:
+    using EdgeData = EdgeDataT;
+    using NodeIterator = std::uint32_t;
+    using EdgeIterator = std::uint32_t;
+    using EdgeRange = util::range<EdgeIterator>;
+
+    class InputEdge
+    {
+      public:
+        NodeIterator source;
+        NodeIterator target;
+        EdgeDataT data;
+
+        InputEdge()
+            : source(std::numeric_limits<NodeIterator>::max()),
+              target(std::numeric_limits<NodeIterator>::max())
+        {
+        }
+
+        template <typename... Ts>
+        InputEdge(NodeIterator source, NodeIterator target, Ts &&... data)
+            : source(source), target(target), data(std::forward<Ts>(data)...)
+        {
+        }
+
+        bool operator<(const InputEdge &rhs) const
+        {
+            return std::tie(source, target) < std::tie(rhs.source, rhs.target);
+        }
+    };
+
+    // Input edges need to be sorted by source
+    template <class ContainerT>
+    ContractionGraph(const NodeIterator nodes, const ContainerT &graph)
+        : number_of_edges(0), number_of_unused_edge_slots(0)
+    {
+        BOOST_ASSERT(std::is_sorted(const_cast<ContainerT &>(graph).begin(),
+                                    const_cast<ContainerT &>(graph).end()));
+
+        node_array.resize(nodes);
+        edge_array.reserve(graph.size());
+
+        std::size_t edge = 0;
+        for (const auto node : util::irange(0u, nodes))
+        {
+            node_array[node].first_edge = static_cast<EdgeIterator>(edge_array.size());
+            while (edge < graph.size() && graph[edge].source == node)
+            {
+                BOOST_ASSERT(graph[edge].target < nodes);
+                edge_array.push_back(Edge{graph[edge].target, graph[edge].data});
+                ++edge;
+            }
+            node_array[node].edges = edge_array.size() - node_array[node].first_edge;
+            node_array[node].capacity = node_array[node].edges;
+        }
+        BOOST_ASSERT(edge == graph.size());
+        number_of_edges = static_cast<EdgeIterator>(edge_array.size());
+    }
+
+    ContractionGraph(const ContractionGraph &) = delete;
+    ContractionGraph &operator=(const ContractionGraph &) = delete;
+
+    unsigned GetNumberOfNodes() const { return node_array.size(); }
+
+    unsigned GetNumberOfEdges() const { return number_of_edges; }
+
+    unsigned GetOutDegree(const NodeIterator n) const { return node_array[n].edges; }
+
+    NodeIterator GetTarget(const EdgeIterator e) const { return edge_array[e].target; }
+
+    EdgeDataT &GetEdgeData(const EdgeIterator e) { return edge_array[e].data; }
+
+    const EdgeDataT &GetEdgeData(const EdgeIterator e) const { return edge_array[e].data; }
+
+    EdgeIterator BeginEdges(const NodeIterator n) const { return node_array[n].first_edge; }
+
+    EdgeIterator EndEdges(const NodeIterator n) const
+    {
+        return node_array[n].first_edge + node_array[n].edges;
+    }
+
+    EdgeRange GetAdjacentEdgeRange(const NodeIterator node) const
+    {
+        return util::irange(BeginEdges(node), EndEdges(node));
+    }
+
+    // adds an edge and returns it. Invalidates edge iterators for the source node
+    EdgeIterator InsertEdge(const NodeIterator from, const NodeIterator to, const EdgeDataT &data)
+    {
+        Node &node = node_array[from];
+        if (node.edges == node.capacity)
+        {
+            const bool is_last_slice = node.first_edge + node.capacity == edge_array.size();
+            const unsigned new_capacity = node.edges + node.edges / 4 + 2;
+            if (is_last_slice)
+            {
+                // the slice can grow in place
+                Resize(edge_array.size() + (new_capacity - node.capacity));
+            }
+            else
+            {
+                const EdgeIterator new_first_edge = static_cast<EdgeIterator>(edge_array.size());
+                Resize(edge_array.size() + new_capacity);
+                std::copy(edge_array.begin() + node.first_edge,
+                          edge_array.begin() + node.first_edge + node.edges,
+                          edge_array.begin() + new_first_edge);
+                number_of_unused_edge_slots += node.capacity;
+                node.first_edge = new_first_edge;
+            }
+            node.capacity = new_capacity;
+        }
+
+        BOOST_ASSERT(node.edges < node.capacity);
+        Edge &edge = edge_array[node.first_edge + node.edges];
+        edge.target = to;
+        edge.data = data;
+        ++number_of_edges;
+        ++node.edges;
+        return EdgeIterator(node.first_edge + node.edges - 1);
+    }
+
+    // removes all edges (source,target)
+    std::int32_t DeleteEdgesTo(const NodeIterator source, const NodeIterator target)
+    {
+        Node &node = node_array[source];
+        std::int32_t deleted = 0;
+        for (EdgeIterator i = BeginEdges(source), iend = EndEdges(source); i < iend - deleted; ++i)
+        {
+            while (i < iend - deleted && edge_array[i].target == target)
+            {
+                deleted++;
+                edge_array[i] = edge_array[iend - deleted];
+            }
+        }
+
+        number_of_edges -= deleted;
+        node.edges -= deleted;
+
+        return deleted;
+    }
+
+    // searches for a specific edge
+    EdgeIterator FindEdge(const NodeIterator from, const NodeIterator to) const
+    {
+        for (const auto i : GetAdjacentEdgeRange(from))
+        {
+            if (to == edge_array[i].target)
+            {
+                return i;
+            }
+        }
+        return SPECIAL_EDGEID;
+    }
+
+    // Returns true if holes left behind by moved slices make up at least `factor` of the storage
+    bool NeedsCompaction(const double factor = 0.5) const
+    {
+        return number_of_unused_edge_slots > factor * edge_array.size();
+    }
+
+    // Moves all slices to the front of the edge array, removing all unused capacity.
+    // Invalidates all edge iterators.
+    void Compact()
+    {
+        std::vector<NodeIterator> nodes_by_first_edge(node_array.size());
+        std::iota(nodes_by_first_edge.begin(), nodes_by_first_edge.end(), NodeIterator{0});
+        std::sort(nodes_by_first_edge.begin(),
+                  nodes_by_first_edge.end(),
+                  [this](const NodeIterator lhs, const NodeIterator rhs) {
+                      return node_array[lhs].first_edge < node_array[rhs].first_edge;
+                  });
+
+        // slices are processed front to back, so the destination never overlaps unprocessed data
+        EdgeIterator position = 0;
+        for (const auto node_id : nodes_by_first_edge)
+        {
+            Node &node = node_array[node_id];
+            if (node.edges == 0)
+            {
+                // the first edge of a node without edges can point anywhere, e.g. into the slice
+                // of a node that grew in place behind it
+                node.first_edge = position;
+                node.capacity = 0;
+                continue;
+            }
+            BOOST_ASSERT(position <= node.first_edge);
+            std::copy(edge_array.begin() + node.first_edge,
+                      edge_array.begin() + node.first_edge + node.edges,
+                      edge_array.begin() + position);
+            node.first_edge = position;
+            node.capacity = node.edges;
+            position += node.edges;
+        }
+        BOOST_ASSERT(position == number_of_edges);
+
+        nodes_by_first_edge.clear();
+        nodes_by_first_edge.shrink_to_fit();
+
+        edge_array.resize(position);
+        edge_array.shrink_to_fit();
+        number_of_unused_edge_slots = 0;
+    }
+
+    // Number of bytes allocated for the node and edge storage
+    std::size_t GetMemoryUsage() const
+    {
+        return node_array.capacity() * sizeof(Node) + edge_array.capacity() * sizeof(Edge);
+    }
+
+  private:
+    void Resize(const std::size_t new_size)
+    {
+        // avoid the doubling growth strategy of std::vector, which wastes a lot of memory
+        // for graphs of this size
+        if (new_size > edge_array.capacity())
+        {
+            edge_array.reserve(new_size * 1.1);
+        }
+        edge_array.resize(new_size);
+    }
+
+    struct Node
+    {
+        // index of the first edge
+        EdgeIterator first_edge;
+        // number of edges
+        std::uint32_t edges;
+        // number of edge slots reserved for this node
+        std::uint32_t capacity;
+    };
+
+    struct Edge
+    {
+        NodeIterator target;
+        EdgeDataT data;
+    };
+
+    std::atomic_uint number_of_edges;
+    std::size_t number_of_unused_edge_slots;
+
+    std::vector<Node> node_array;
+    std::vector<Edge> edge_array;
+};
+}
+}
+
+#endif
@@ -66,6 +66,8 @@ class Contractor
                        std::vector<bool> &is_core_node,
                        std::vector<float> &inout_node_levels) const;
     void WriteCoreNodeMarker(std::vector<bool> &&is_core_node) const;
+    void WriteCoreLandmarks(const util::DeallocatingVector<QueryEdge> &contracted_edge_list,
+                            const std::vector<bool> &is_core_node) const;
     void WriteNodeLevels(std::vector<float> &&node_levels) const;
     void ReadNodeLevels(std::vector<float> &contraction_order) const;
     std::size_t
@@ -91,7 +93,8 @@ class Contractor
                           const std::string &datasource_names_filename,
                           const std::string &datasource_indexes_filename,
                           const std::string &rtree_leaf_filename,
-                          const double log_edge_updates_factor);
+                          const double log_edge_updates_factor,
+                          const bool cache_lookup_files);
 };
 }
 }
@@ -39,13 +39,19 @@ namespace contractor
 
 struct ContractorConfig
 {
-    ContractorConfig() : requested_num_threads(0) {}
+    ContractorConfig()
+        : requested_num_threads(0), number_of_core_landmarks(16), checkpoint_interval(0),
+          resume_from_checkpoint(false), cache_lookup_files(false)
+    {
+    }
 
     // Infer the output names from the path of the .osrm file
     void UseDefaultOutputNames()
     {
         level_output_path = osrm_input_path.string() + ".level";
         core_output_path = osrm_input_path.string() + ".core";
+        core_landmarks_output_path = osrm_input_path.string() + ".core.landmarks";
+        checkpoint_path = osrm_input_path.string() + ".contract.checkpoint";
         graph_output_path = osrm_input_path.string() + ".hsgr";
         edge_based_graph_path = osrm_input_path.string() + ".ebg";
         edge_segment_lookup_path = osrm_input_path.string() + ".edge_segment_lookup";
@@ -62,6 +68,7 @@ struct ContractorConfig
 
     std::string level_output_path;
     std::string core_output_path;
+    std::string core_landmarks_output_path;
     std::string graph_output_path;
     std::string edge_based_graph_path;
 
@@ -81,8 +88,20 @@ struct ContractorConfig
     //(e.g. 0.8 contracts 80 percent of the hierarchy, leaving a core of 20%)
     double core_factor;
 
+    // Number of landmarks selected on the core for goal-directed (ALT) core queries.
+    // Only used if core_factor < 1.0, 0 disables the landmark computation.
+    unsigned number_of_core_landmarks;
+
+    // Seconds between two checkpoints of the contraction state, 0 disables checkpoints.
+    // With resume_from_checkpoint set the contraction continues from the last checkpoint.
+    std::string checkpoint_path;
+    double checkpoint_interval;
+    bool resume_from_checkpoint;
+
     std::vector<std::string> segment_speed_lookup_paths;
     std::vector<std::string> turn_penalty_lookup_paths;
+    // Keep a binary copy (<file>.bin) of parsed speed and penalty files for repeated runs
+    bool cache_lookup_files;
     std::string datasource_indexes_path;
     std::string datasource_names_path;
 };
@@ -0,0 +1,270 @@
+#ifndef OSRM_CONTRACTOR_CORE_LANDMARKS_HPP
+#define OSRM_CONTRACTOR_CORE_LANDMARKS_HPP
+
+#include "contractor/query_edge.hpp"
+#include "util/deallocating_vector.hpp"
+#include "util/integer_range.hpp"
+#include "util/log.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
+#include <cstdint>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace contractor
+{
+
+/**
+ * Landmark distances for the core of a partially contracted hierarchy.
+ *
+ * The landmarks are picked on the core graph by farthest selection. For every core node we store
+ * the distances from and to every landmark, which the query side uses to compute A* potentials
+ * for the core search (ALT). Core nodes are addressed by their rank among all core nodes:
+ *
+ *   rank(node) = bucket_ranks[node / 32] + number of core nodes in [node - node % 32, node)
+ *
+ * bucket_ranks has one trailing entry holding the total number of core nodes.
+ * distances holds 2 * number_of_landmarks weights per core node: first the distances from all
+ * landmarks to the node, then the distances from the node to all landmarks. Unreachable
+ * pairs are marked with INVALID_EDGE_WEIGHT.
+ */
+struct CoreLandmarks
+{
+    static constexpr std::uint32_t BUCKET_SIZE = 32;
+
+    std::uint32_t number_of_landmarks = 0;
+    std::vector<std::uint32_t> bucket_ranks;
+    std::vector<EdgeWeight> distances;
+};
+
+namespace detail
+{
+// Adjacency array of the core graph, indexed by core rank
+struct CoreAdjacency
+{
+    struct Arc
+    {
+        std::uint32_t target;
+        EdgeWeight weight;
+    };
+
+    std::vector<std::uint32_t> offsets;
+    std::vector<Arc> arcs;
+
+    template <typename ArcListT> CoreAdjacency(const std::uint32_t num_nodes, ArcListT &arc_list)
+    {
+        std::sort(arc_list.begin(), arc_list.end());
+        offsets.resize(num_nodes + 1, 0);
+        arcs.reserve(arc_list.size());
+        for (const auto &arc : arc_list)
+        {
+            ++offsets[std::get<0>(arc) + 1];
+            arcs.push_back(Arc{std::get<1>(arc), std::get<2>(arc)});
+        }
+        std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+    }
+
+    // Plain Dijkstra from a set of sources, fills the distances of all core nodes
+    void Search(const std::vector<std::uint32_t> &sources, std::vector<EdgeWeight> &distances) const
+    {
+        using QueueEntry = std::pair<EdgeWeight, std::uint32_t>;
+        std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+
+        distances.assign(offsets.size() - 1, INVALID_EDGE_WEIGHT);
+        for (const auto source : sources)
+        {
+            distances[source] = 0;
+            queue.emplace(0, source);
+        }
+
+        while (!queue.empty())
+        {
+            const auto weight = queue.top().first;
+            const auto node = queue.top().second;
+            queue.pop();
+            if (weight > distances[node])
+            {
+                // outdated queue entry
+                continue;
+            }
+
+            for (auto arc = offsets[node]; arc < offsets[node + 1]; ++arc)
+            {
+                const auto to_weight = weight + arcs[arc].weight;
+                if (to_weight < distances[arcs[arc].target])
+                {
+                    distances[arcs[arc].target] = to_weight;
+                    queue.emplace(to_weight, arcs[arc].target);
+                }
+            }
+        }
+    }
+};
+}
+
+/**
+ * Selects `number_of_landmarks` landmarks on the core graph and computes the distances between
+ * them and all core nodes. `contracted_edge_list` is the exported edge list of the contractor,
+ * only edges between two core nodes are considered.
+ */
+inline CoreLandmarks ComputeCoreLandmarks(const util::DeallocatingVector<QueryEdge> &contracted_edge_list,
+                                          const std::vector<bool> &is_core_node,
+                                          const unsigned number_of_landmarks)
+{
+    CoreLandmarks landmarks;
+
+    const auto number_of_buckets =
+        (is_core_node.size() + CoreLandmarks::BUCKET_SIZE - 1) / CoreLandmarks::BUCKET_SIZE;
+    landmarks.bucket_ranks.reserve(number_of_buckets + 1);
+
+    std::vector<std::uint32_t> core_rank(is_core_node.size(), SPECIAL_NODEID);
+    std::uint32_t number_of_core_nodes = 0;
+    for (const auto node : util::irange<std::size_t>(0UL, is_core_node.size()))
+    {
+        if (node % CoreLandmarks::BUCKET_SIZE == 0)
+        {
+            landmarks.bucket_ranks.push_back(number_of_core_nodes);
+        }
+        if (is_core_node[node])
+        {
+            core_rank[node] = number_of_core_nodes++;
+        }
+    }
+    landmarks.bucket_ranks.push_back(number_of_core_nodes);
+
+    if (number_of_core_nodes == 0 || number_of_landmarks == 0)
+    {
+        landmarks.bucket_ranks.clear();
+        return landmarks;
+    }
+
+    // (source rank, target rank, weight)
+    using CoreArc = std::tuple<std::uint32_t, std::uint32_t, EdgeWeight>;
+    std::vector<CoreArc> forward_arcs;
+    std::vector<CoreArc> backward_arcs;
+    for (const auto &edge : contracted_edge_list)
+    {
+        if (edge.source >= core_rank.size() || edge.target >= core_rank.size() ||
+            core_rank[edge.source] == SPECIAL_NODEID || core_rank[edge.target] == SPECIAL_NODEID)
+        {
+            continue;
+        }
+
+        const auto source = core_rank[edge.source];
+        const auto target = core_rank[edge.target];
+        if (edge.data.forward)
+        {
+            forward_arcs.emplace_back(source, target, edge.data.weight);
+            backward_arcs.emplace_back(target, source, edge.data.weight);
+        }
+        if (edge.data.backward)
+        {
+            forward_arcs.emplace_back(target, source, edge.data.weight);
+            backward_arcs.emplace_back(source, target, edge.data.weight);
+        }
+    }
+    core_rank.clear();
+    core_rank.shrink_to_fit();
+
+    const detail::CoreAdjacency forward_graph(number_of_core_nodes, forward_arcs);
+    const detail::CoreAdjacency backward_graph(number_of_core_nodes, backward_arcs);
+    forward_arcs.clear();
+    forward_arcs.shrink_to_fit();
+
+    // Farthest selection on the undirected core graph: every new landmark is the node farthest
+    // away from all previous landmarks. Nodes in other components are preferred, so every
+    // component receives at least one landmark if possible.
+    const auto num_landmarks = std::min<std::uint32_t>(number_of_landmarks, number_of_core_nodes);
+    std::vector<std::uint32_t> landmark_ranks;
+    {
+        std::vector<CoreArc> undirected_arcs;
+        undirected_arcs.reserve(2 * backward_arcs.size());
+        for (const auto &arc : backward_arcs)
+        {
+            undirected_arcs.push_back(arc);
+            undirected_arcs.emplace_back(std::get<1>(arc), std::get<0>(arc), std::get<2>(arc));
+        }
+        backward_arcs.clear();
+        backward_arcs.shrink_to_fit();
+        const detail::CoreAdjacency undirected_graph(number_of_core_nodes, undirected_arcs);
+        undirected_arcs.clear();
+        undirected_arcs.shrink_to_fit();
+
+        std::vector<EdgeWeight> distances;
+        std::vector<std::uint32_t> sources = {0};
+        const auto pick_farthest = [&distances]() {
+            std::uint32_t farthest = 0;
+            for (const auto rank : util::irange<std::uint32_t>(0, distances.size()))
+            {
+                // unreachable nodes have the largest possible distance
+                if (distances[rank] > distances[farthest])
+                {
+                    farthest = rank;
+                }
+            }
+            return farthest;
+        };
+
+        undirected_graph.Search(sources, distances);
+        landmark_ranks.push_back(pick_farthest());
+        while (landmark_ranks.size() < num_landmarks)
+        {
+            undirected_graph.Search(landmark_ranks, distances);
+            const auto farthest = pick_farthest();
+            if (distances[farthest] == 0)
+            {
+                // every core node is a landmark already
+                break;
+            }
+            landmark_ranks.push_back(farthest);
+        }
+    }
+
+    landmarks.number_of_landmarks = landmark_ranks.size();
+    const auto stride = 2 * landmarks.number_of_landmarks;
+    landmarks.distances.resize(static_cast<std::size_t>(number_of_core_nodes) * stride);
+
+    tbb::parallel_for(
+        tbb::blocked_range<std::uint32_t>(0, landmarks.number_of_landmarks, 1),
+        [&](const tbb::blocked_range<std::uint32_t> &range) {
+            std::vector<EdgeWeight> distances;
+            for (auto landmark = range.begin(); landmark != range.end(); ++landmark)
+            {
+                const std::vector<std::uint32_t> sources = {landmark_ranks[landmark]};
+
+                forward_graph.Search(sources, distances);
+                for (const auto rank : util::irange<std::uint32_t>(0, number_of_core_nodes))
+                {
+                    landmarks.distances[std::size_t{rank} * stride + landmark] = distances[rank];
+                }
+
+                backward_graph.Search(sources, distances);
+                for (const auto rank : util::irange<std::uint32_t>(0, number_of_core_nodes))
+                {
+                    landmarks.distances[std::size_t{rank} * stride +
+                                        landmarks.number_of_landmarks + landmark] = distances[rank];
+                }
+            }
+        });
+
+    util::Log() << "Computed " << landmarks.number_of_landmarks << " landmarks for "
+                << number_of_core_nodes << " core nodes";
+
+    return landmarks;
+}
+}
+}
+
+#endif
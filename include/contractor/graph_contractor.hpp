@@ -1,12 +1,16 @@
 #ifndef GRAPH_CONTRACTOR_HPP
 #define GRAPH_CONTRACTOR_HPP
 
+#include "contractor/contraction_graph.hpp"
 #include "contractor/query_edge.hpp"
+#include "storage/io.hpp"
 #include "util/binary_heap.hpp"
 #include "util/deallocating_vector.hpp"
-#include "util/dynamic_graph.hpp"
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
 #include "util/integer_range.hpp"
 #include "util/log.hpp"
+#include "util/meminfo.hpp"
 #include "util/percent.hpp"
 #include "util/timing_util.hpp"
 #include "util/typedefs.hpp"
@@ -14,16 +18,22 @@
 #include "util/xor_fast_hash_storage.hpp"
 
 #include <boost/assert.hpp>
+#include <boost/crc.hpp>
+#include <boost/filesystem/operations.hpp>
 
 #include <stxxl/vector>
 
 #include <tbb/enumerable_thread_specific.h>
 #include <tbb/parallel_for.h>
+#include <tbb/parallel_reduce.h>
 #include <tbb/parallel_sort.h>
 
 #include <algorithm>
+#include <chrono>
+#include <cstdint>
 #include <limits>
 #include <memory>
+#include <string>
 #include <vector>
 
 namespace osrm
@@ -70,7 +80,7 @@ class GraphContractor
         bool target = false;
     };
 
-    using ContractorGraph = util::DynamicGraph<ContractorEdgeData>;
+    using ContractorGraph = ContractionGraph<ContractorEdgeData>;
     //    using ContractorHeap = util::BinaryHeap<NodeID, NodeID, int, ContractorHeapData,
     //    ArrayStorage<NodeID, NodeID>
     //    >;
@@ -81,11 +91,38 @@ class GraphContractor
                                             util::XORFastHashStorage<NodeID, NodeID>>;
     using ContractorEdge = ContractorGraph::InputEdge;
 
+    // Bounds for a single witness search. Searches stop after settling max_settled_nodes nodes
+    // and do not relax edges of nodes that are max_hops edges away from the source.
+    struct WitnessSearchLimits
+    {
+        short max_hops;
+        int max_settled_nodes_simulation;
+        int max_settled_nodes_contraction;
+    };
+
+    struct WitnessSearchStats
+    {
+        std::uint64_t witness_searches = 0;
+        std::uint64_t limit_reached_searches = 0;
+        std::uint64_t settled_nodes = 0;
+        std::uint64_t shortcuts_added = 0;
+
+        WitnessSearchStats &operator+=(const WitnessSearchStats &other)
+        {
+            witness_searches += other.witness_searches;
+            limit_reached_searches += other.limit_reached_searches;
+            settled_nodes += other.settled_nodes;
+            shortcuts_added += other.shortcuts_added;
+            return *this;
+        }
+    };
+
     struct ContractorThreadData
     {
         ContractorHeap heap;
         std::vector<ContractorEdge> inserted_edges;
         std::vector<NodeID> neighbours;
+        WitnessSearchStats stats;
         explicit ContractorThreadData(NodeID nodes) : heap(nodes) {}
     };
 
@@ -247,6 +284,8 @@ class GraphContractor
         util::Log() << "merged " << edges.size() - edge << " edges out of " << edges.size();
         edges.resize(edge);
         contractor_graph = std::make_shared<ContractorGraph>(nodes, edges);
+        number_of_input_edges = contractor_graph->GetNumberOfEdges();
+        input_checksum = ComputeInputChecksum(edges);
         edges.clear();
         edges.shrink_to_fit();
 
@@ -254,6 +293,21 @@ class GraphContractor
         util::Log() << "contractor finished initalization";
     }
 
+    // Makes Run write its state to `path` at the end of a round whenever `interval` seconds have
+    // passed since the last checkpoint. If `resume` is set, Run continues from an existing
+    // checkpoint at `path` instead of starting from scratch.
+    void SetCheckpointing(std::string path, const double interval, const bool resume)
+    {
+        checkpoint_path = std::move(path);
+        checkpoint_interval = interval;
+        resume_from_checkpoint = resume;
+    }
+
+    // Makes Run write a checkpoint to the path set by SetCheckpointing and return as soon as
+    // `level` levels are contracted. A later run resumes the contraction from the checkpoint,
+    // GetEdges must not be called after a stopped run.
+    void StopAfterLevel(const unsigned level) { stop_after_level = level; }
+
     void Run(double core_factor = 1.0)
     {
         // for the preperation we can use a big grain size, which is much faster (probably cache)
@@ -276,25 +330,51 @@ class GraphContractor
         std::vector<float> node_priorities;
         is_core_node.resize(number_of_nodes, false);
 
-        std::vector<RemainingNodeData> remaining_nodes(number_of_nodes);
-        // initialize priorities in parallel
-        tbb::parallel_for(tbb::blocked_range<NodeID>(0, number_of_nodes, InitGrainSize),
-                          [this, &remaining_nodes](const tbb::blocked_range<NodeID> &range) {
-                              for (auto x = range.begin(), end = range.end(); x != end; ++x)
-                              {
-                                  remaining_nodes[x].id = x;
-                              }
-                          });
-
+        std::vector<RemainingNodeData> remaining_nodes;
+        unsigned current_level = 0;
+        bool flushed_contractor = false;
         bool use_cached_node_priorities = !node_levels.empty();
-        if (use_cached_node_priorities)
+
+        witness_search_stats = WitnessSearchStats{};
+
+        const bool resumed = resume_from_checkpoint &&
+                             ReadCheckpoint(core_factor,
+                                            number_of_contracted_nodes,
+                                            current_level,
+                                            flushed_contractor,
+                                            use_cached_node_priorities,
+                                            remaining_nodes,
+                                            node_priorities,
+                                            node_depth);
+        if (resumed)
+        {
+            thread_data_list.number_of_nodes = contractor_graph->GetNumberOfNodes();
+            util::Log() << "resuming contraction at level " << current_level << " with "
+                        << number_of_contracted_nodes << " contracted nodes";
+        }
+        else
+        {
+            remaining_nodes.resize(number_of_nodes);
+            // initialize priorities in parallel
+            tbb::parallel_for(tbb::blocked_range<NodeID>(0, number_of_nodes, InitGrainSize),
+                              [this, &remaining_nodes](const tbb::blocked_range<NodeID> &range) {
+                                  for (auto x = range.begin(), end = range.end(); x != end; ++x)
+                                  {
+                                      remaining_nodes[x].id = x;
+                                  }
+                              });
+        }
+
+        witness_search_limits = GetWitnessSearchLimits(GetAverageDegree(remaining_nodes));
+
+        if (!resumed && use_cached_node_priorities)
         {
             util::UnbufferedLog log;
             log << "using cached node priorities ...";
             node_priorities.swap(node_levels);
             log << "ok";
         }
-        else
+        else if (!resumed)
         {
             node_depth.resize(number_of_nodes, 0);
             node_priorities.resize(number_of_nodes);
@@ -314,15 +394,14 @@ class GraphContractor
                 });
             log << "ok";
         }
-        BOOST_ASSERT(node_priorities.size() == number_of_nodes);
+        BOOST_ASSERT(node_priorities.size() == contractor_graph->GetNumberOfNodes());
 
         util::Log() << "preprocessing " << number_of_nodes << " nodes ...";
 
         util::UnbufferedLog log;
         util::Percent p(log, number_of_nodes);
 
-        unsigned current_level = 0;
-        bool flushed_contractor = false;
+        auto last_checkpoint = std::chrono::steady_clock::now();
         while (number_of_nodes > 2 &&
                number_of_contracted_nodes < static_cast<NodeID>(number_of_nodes * core_factor))
         {
@@ -336,6 +415,7 @@ class GraphContractor
                 log << " [flush " << number_of_contracted_nodes << " nodes] ";
 
                 // Delete old heap data to free memory that we need for the coming operations
+                AccumulateWitnessSearchStats(thread_data_list);
                 thread_data_list.data.clear();
 
                 // Create new priority array
@@ -384,7 +464,7 @@ class GraphContractor
                         else
                         {
                             // node is not yet contracted.
-                            // add (renumbered) outgoing edges to new util::DynamicGraph.
+                            // add (renumbered) outgoing edges to new ContractionGraph.
                             ContractorEdge new_edge = {new_node_id_from_orig_id_map[source],
                                                        new_node_id_from_orig_id_map[target],
                                                        data};
@@ -423,11 +503,16 @@ class GraphContractor
                 new_edge_set.clear();
                 flushed_contractor = true;
 
+                LogMemoryUsage(log);
+
                 // INFO: MAKE SURE THIS IS THE LAST OPERATION OF THE FLUSH!
                 // reinitialize heaps and ThreadData objects with appropriate size
                 thread_data_list.number_of_nodes = contractor_graph->GetNumberOfNodes();
             }
 
+            // the remaining graph gets denser with every round, relax the witness search bounds
+            witness_search_limits = GetWitnessSearchLimits(GetAverageDegree(remaining_nodes));
+
             tbb::parallel_for(
                 tbb::blocked_range<NodeID>(0, remaining_nodes.size(), IndependentGrainSize),
                 [this, &node_priorities, &remaining_nodes, &thread_data_list](
@@ -543,6 +628,12 @@ class GraphContractor
                 data->inserted_edges.clear();
             }
 
+            // inserting edges leaves holes in the edge array when adjacency slices are moved
+            if (contractor_graph->NeedsCompaction())
+            {
+                contractor_graph->Compact();
+            }
+
             if (!use_cached_node_priorities)
             {
                 tbb::parallel_for(
@@ -568,6 +659,30 @@ class GraphContractor
 
             p.PrintStatus(number_of_contracted_nodes);
             ++current_level;
+
+            const bool stop = current_level >= stop_after_level;
+            const std::chrono::duration<double> since_checkpoint =
+                std::chrono::steady_clock::now() - last_checkpoint;
+            if (stop ||
+                (checkpoint_interval > 0 && since_checkpoint.count() >= checkpoint_interval))
+            {
+                AccumulateWitnessSearchStats(thread_data_list);
+                WriteCheckpoint(core_factor,
+                                number_of_contracted_nodes,
+                                current_level,
+                                flushed_contractor,
+                                use_cached_node_priorities,
+                                remaining_nodes,
+                                node_priorities,
+                                node_depth);
+                log << " [checkpoint] ";
+                last_checkpoint = std::chrono::steady_clock::now();
+            }
+            if (stop)
+            {
+                log << " [stopped at level " << current_level << "] ";
+                return;
+            }
         }
 
         if (remaining_nodes.size() > 2)
@@ -606,8 +721,20 @@ class GraphContractor
 
         util::Log() << "[core] " << remaining_nodes.size() << " nodes "
                     << contractor_graph->GetNumberOfEdges() << " edges.";
+        {
+            util::Log memory_log;
+            memory_log << "[memory]";
+            LogMemoryUsage(memory_log);
+        }
 
+        AccumulateWitnessSearchStats(thread_data_list);
         thread_data_list.data.clear();
+
+        util::Log() << "[witness] " << witness_search_stats.witness_searches << " searches, "
+                    << witness_search_stats.limit_reached_searches << " hit the search limits, "
+                    << witness_search_stats.settled_nodes << " nodes settled";
+        util::Log() << "[witness] " << witness_search_stats.shortcuts_added
+                    << " shortcuts added";
     }
 
     inline void GetCoreMarker(std::vector<bool> &out_is_core_node)
@@ -678,6 +805,234 @@ class GraphContractor
     }
 
   private:
+    // Layout of a checkpoint (after the fingerprint):
+    //   header: number of input nodes and edges, checksum of the input, core factor, round
+    //           counters and flags
+    //   node state: remaining nodes, priorities, depths, levels, weights and the id mapping
+    //   edges: the remaining graph and the edges of nodes that were flushed out of it
+    void WriteCheckpoint(const double core_factor,
+                         const NodeID number_of_contracted_nodes,
+                         const unsigned current_level,
+                         const bool flushed_contractor,
+                         const bool use_cached_node_priorities,
+                         std::vector<RemainingNodeData> &remaining_nodes,
+                         std::vector<float> &node_priorities,
+                         std::vector<NodeDepth> &node_depth)
+    {
+        // write to a temporary file first, a crash while writing must not destroy the last
+        // complete checkpoint
+        const std::string temporary_path = checkpoint_path + ".tmp";
+        {
+            storage::io::FileWriter writer(temporary_path,
+                                           storage::io::FileWriter::GenerateFingerprint);
+            writer.WriteOne(static_cast<std::uint32_t>(is_core_node.size()));
+            writer.WriteOne(number_of_input_edges);
+            writer.WriteOne(input_checksum);
+            writer.WriteOne(core_factor);
+            writer.WriteOne(static_cast<std::uint32_t>(number_of_contracted_nodes));
+            writer.WriteOne(static_cast<std::uint32_t>(current_level));
+            writer.WriteOne(static_cast<std::uint8_t>(flushed_contractor));
+            writer.WriteOne(static_cast<std::uint8_t>(use_cached_node_priorities));
+            writer.WriteOne(witness_search_stats);
+
+            writer.SerializeVector(remaining_nodes);
+            writer.SerializeVector(node_priorities);
+            writer.SerializeVector(node_depth);
+            writer.SerializeVector(node_levels);
+            writer.SerializeVector(node_weights);
+            writer.SerializeVector(orig_node_id_from_new_node_id_map);
+
+            const constexpr std::size_t BUFFER_SIZE = 1024 * 1024;
+
+            std::vector<ContractorEdge> edge_buffer;
+            edge_buffer.reserve(BUFFER_SIZE);
+            writer.WriteOne(static_cast<std::uint32_t>(contractor_graph->GetNumberOfNodes()));
+            writer.WriteElementCount64(contractor_graph->GetNumberOfEdges());
+            for (const auto node : util::irange(0u, contractor_graph->GetNumberOfNodes()))
+            {
+                for (const auto edge : contractor_graph->GetAdjacentEdgeRange(node))
+                {
+                    edge_buffer.emplace_back(node,
+                                             contractor_graph->GetTarget(edge),
+                                             contractor_graph->GetEdgeData(edge));
+                }
+                if (edge_buffer.size() >= BUFFER_SIZE)
+                {
+                    writer.WriteFrom(edge_buffer.data(), edge_buffer.size());
+                    edge_buffer.clear();
+                }
+            }
+            writer.WriteFrom(edge_buffer.data(), edge_buffer.size());
+
+            std::vector<QueryEdge> external_edge_buffer;
+            external_edge_buffer.reserve(BUFFER_SIZE);
+            writer.WriteElementCount64(external_edge_list.size());
+            for (const auto &edge : external_edge_list)
+            {
+                external_edge_buffer.push_back(edge);
+                if (external_edge_buffer.size() >= BUFFER_SIZE)
+                {
+                    writer.WriteFrom(external_edge_buffer.data(), external_edge_buffer.size());
+                    external_edge_buffer.clear();
+                }
+            }
+            writer.WriteFrom(external_edge_buffer.data(), external_edge_buffer.size());
+        }
+        boost::filesystem::rename(temporary_path, checkpoint_path);
+    }
+
+    // Restores the state written by WriteCheckpoint. Returns false if there is no checkpoint.
+    bool ReadCheckpoint(const double core_factor,
+                        NodeID &number_of_contracted_nodes,
+                        unsigned &current_level,
+                        bool &flushed_contractor,
+                        bool &use_cached_node_priorities,
+                        std::vector<RemainingNodeData> &remaining_nodes,
+                        std::vector<float> &node_priorities,
+                        std::vector<NodeDepth> &node_depth)
+    {
+        if (!boost::filesystem::exists(checkpoint_path))
+        {
+            util::Log(logWARNING) << "No checkpoint found at " << checkpoint_path
+                                  << ", starting from scratch";
+            return false;
+        }
+
+        storage::io::FileReader reader(checkpoint_path,
+                                       storage::io::FileReader::VerifyFingerprint);
+
+        const auto checkpoint_number_of_nodes = reader.ReadOne<std::uint32_t>();
+        const auto checkpoint_number_of_edges = reader.ReadOne<std::uint64_t>();
+        const auto checkpoint_checksum = reader.ReadOne<std::uint32_t>();
+        const auto checkpoint_core_factor = reader.ReadOne<double>();
+        if (checkpoint_number_of_nodes != contractor_graph->GetNumberOfNodes() ||
+            checkpoint_number_of_edges != number_of_input_edges ||
+            checkpoint_checksum != input_checksum || checkpoint_core_factor != core_factor)
+        {
+            throw util::exception("Checkpoint " + checkpoint_path +
+                                  " was written for a different graph or core factor" +
+                                  SOURCE_REF);
+        }
+
+        number_of_contracted_nodes = reader.ReadOne<std::uint32_t>();
+        current_level = reader.ReadOne<std::uint32_t>();
+        flushed_contractor = reader.ReadOne<std::uint8_t>() != 0;
+        use_cached_node_priorities = reader.ReadOne<std::uint8_t>() != 0;
+        witness_search_stats = reader.ReadOne<WitnessSearchStats>();
+
+        reader.DeserializeVector(remaining_nodes);
+        reader.DeserializeVector(node_priorities);
+        reader.DeserializeVector(node_depth);
+        reader.DeserializeVector(node_levels);
+        reader.DeserializeVector(node_weights);
+        reader.DeserializeVector(orig_node_id_from_new_node_id_map);
+
+        const auto number_of_graph_nodes = reader.ReadOne<std::uint32_t>();
+        std::vector<ContractorEdge> edges;
+        reader.DeserializeVector(edges);
+        // edges were written grouped by source only
+        tbb::parallel_sort(edges.begin(), edges.end());
+        contractor_graph.reset();
+        contractor_graph = std::make_shared<ContractorGraph>(number_of_graph_nodes, edges);
+        edges.clear();
+        edges.shrink_to_fit();
+
+        const auto number_of_external_edges = reader.ReadElementCount64();
+        external_edge_list.clear();
+        const constexpr std::size_t BUFFER_SIZE = 1024 * 1024;
+        std::vector<QueryEdge> external_edge_buffer;
+        for (std::uint64_t offset = 0; offset < number_of_external_edges; offset += BUFFER_SIZE)
+        {
+            external_edge_buffer.resize(
+                std::min<std::uint64_t>(BUFFER_SIZE, number_of_external_edges - offset));
+            reader.ReadInto(external_edge_buffer);
+            for (const auto &edge : external_edge_buffer)
+            {
+                external_edge_list.push_back(edge);
+            }
+        }
+
+        return true;
+    }
+
+    // Checksum of the merged input edges and the node weights. Updated edge weights (traffic
+    // updates) don't change the number of edges but must invalidate a checkpoint as well.
+    std::uint32_t ComputeInputChecksum(const std::vector<ContractorEdge> &input_edges) const
+    {
+        boost::crc_32_type checksum;
+        const auto process = [&checksum](const std::uint32_t value) {
+            checksum.process_bytes(&value, sizeof(value));
+        };
+        for (const auto &edge : input_edges)
+        {
+            process(edge.source);
+            process(edge.target);
+            process(edge.data.weight);
+            process(edge.data.id);
+            process(edge.data.forward | edge.data.backward << 1);
+        }
+        for (const auto weight : node_weights)
+        {
+            process(weight);
+        }
+        return checksum.checksum();
+    }
+
+    // Adaptive witness search limits depending on the average degree of the remaining graph.
+    // In the sparse graph of the first rounds almost all witnesses consist of a few edges, so
+    // small limits suffice and keep the searches cheap. As the graph densifies, witnesses get
+    // longer and we allow deeper searches to avoid adding superfluous shortcuts.
+    static WitnessSearchLimits GetWitnessSearchLimits(const double average_degree)
+    {
+        if (average_degree < 3.3)
+        {
+            return WitnessSearchLimits{3, 500, 1000};
+        }
+        if (average_degree < 10.)
+        {
+            return WitnessSearchLimits{5, 1000, 2000};
+        }
+        return WitnessSearchLimits{std::numeric_limits<short>::max(), 1000, 2000};
+    }
+
+    double GetAverageDegree(const std::vector<RemainingNodeData> &remaining_nodes) const
+    {
+        if (remaining_nodes.empty())
+        {
+            return 0.;
+        }
+
+        const std::uint64_t number_of_edges = tbb::parallel_reduce(
+            tbb::blocked_range<std::size_t>(0, remaining_nodes.size()),
+            std::uint64_t{0},
+            [this, &remaining_nodes](const tbb::blocked_range<std::size_t> &range,
+                                     std::uint64_t sum) {
+                for (auto x = range.begin(), end = range.end(); x != end; ++x)
+                {
+                    sum += contractor_graph->GetOutDegree(remaining_nodes[x].id);
+                }
+                return sum;
+            },
+            [](const std::uint64_t lhs, const std::uint64_t rhs) { return lhs + rhs; });
+
+        return static_cast<double>(number_of_edges) / remaining_nodes.size();
+    }
+
+    void LogMemoryUsage(util::Log &log) const
+    {
+        log << " [graph " << (contractor_graph->GetMemoryUsage() >> 20) << " MB, peak RAM "
+            << (util::GetPeakRAMUsage() >> 20) << " MB] ";
+    }
+
+    void AccumulateWitnessSearchStats(ThreadDataContainer &thread_data_list)
+    {
+        for (auto &data : thread_data_list.data)
+        {
+            witness_search_stats += data->stats;
+            data->stats = WitnessSearchStats{};
+        }
+    }
+
     inline void RelaxNode(const NodeID node,
                           const NodeID forbidden_node,
                           const int weight,
@@ -712,14 +1067,18 @@ class GraphContractor
         }
     }
 
+    // One witness search from a single source covering all targets at once. The search is
+    // aborted once all targets are settled, max_weight is exceeded or the limits are reached.
     inline void Dijkstra(const int max_weight,
                          const unsigned number_of_targets,
                          const int max_nodes,
+                         const short max_hops,
                          ContractorThreadData &data,
                          const NodeID middle_node)
     {
 
         ContractorHeap &heap = data.heap;
+        ++data.stats.witness_searches;
 
         int nodes = 0;
         unsigned number_of_targets_found = 0;
@@ -729,11 +1088,12 @@ class GraphContractor
             const auto weight = heap.GetKey(node);
             if (++nodes > max_nodes)
             {
-                return;
+                ++data.stats.limit_reached_searches;
+                break;
             }
             if (weight > max_weight)
             {
-                return;
+                break;
             }
 
             // Destination settled?
@@ -742,12 +1102,19 @@ class GraphContractor
                 ++number_of_targets_found;
                 if (number_of_targets_found >= number_of_targets)
                 {
-                    return;
+                    break;
                 }
             }
 
+            // no witness may use more than max_hops edges, don't expand the search any further
+            if (heap.GetData(node).hop >= max_hops)
+            {
+                continue;
+            }
+
             RelaxNode(node, middle_node, weight, heap);
         }
+        data.stats.settled_nodes += std::min(nodes, max_nodes);
     }
 
     inline float EvaluateNodePriority(ContractorThreadData *const data,
@@ -880,13 +1247,21 @@ class GraphContractor
 
             if (RUNSIMULATION)
             {
-                const int constexpr SIMULATION_SEARCH_SPACE_SIZE = 1000;
-                Dijkstra(max_weight, number_of_targets, SIMULATION_SEARCH_SPACE_SIZE, *data, node);
+                Dijkstra(max_weight,
+                         number_of_targets,
+                         witness_search_limits.max_settled_nodes_simulation,
+                         witness_search_limits.max_hops,
+                         *data,
+                         node);
             }
             else
             {
-                const int constexpr FULL_SEARCH_SPACE_SIZE = 2000;
-                Dijkstra(max_weight, number_of_targets, FULL_SEARCH_SPACE_SIZE, *data, node);
+                Dijkstra(max_weight,
+                         number_of_targets,
+                         witness_search_limits.max_settled_nodes_contraction,
+                         witness_search_limits.max_hops,
+                         *data,
+                         node);
             }
             for (auto out_edge : contractor_graph->GetAdjacentEdgeRange(node))
             {
@@ -936,6 +1311,7 @@ class GraphContractor
 
         if (!RUNSIMULATION)
         {
+            const std::size_t first_inserted_edge = inserted_edges_size;
             std::size_t iend = inserted_edges.size();
             for (std::size_t i = inserted_edges_size; i < iend; ++i)
             {
@@ -969,6 +1345,7 @@ class GraphContractor
                 }
             }
             inserted_edges.resize(inserted_edges_size);
+            data->stats.shortcuts_added += inserted_edges_size - first_inserted_edge;
         }
         return true;
     }
@@ -1119,6 +1496,17 @@ class GraphContractor
     std::vector<EdgeWeight> node_weights;
     std::vector<bool> is_core_node;
     util::XORFastHash<> fast_hash;
+
+    WitnessSearchLimits witness_search_limits;
+    WitnessSearchStats witness_search_stats;
+
+    // number of edges and checksum of the input graph, identify the graph a checkpoint belongs to
+    std::uint64_t number_of_input_edges = 0;
+    std::uint32_t input_checksum = 0;
+    std::string checkpoint_path;
+    double checkpoint_interval = 0;
+    bool resume_from_checkpoint = false;
+    unsigned stop_after_level = std::numeric_limits<unsigned>::max();
 };
 }
 }
@@ -52,7 +52,7 @@ namespace api
  *  - hints: hint for the service to derive the position(s) in the road network more efficiently,
  *           optional per coordinate
  *  - radiuses: limits the search for segments in the road network to given radius(es) in meter,
- *              optional per coordinate
+ *              non-negative, optional per coordinate
  *  - bearings: limits the search for segments in the road network to given bearing(s) in degree
  *              towards true north in clockwise direction, optional per coordinate
  *
@@ -69,6 +69,14 @@ struct BaseParameters
     // Adds hints to response which can be included in subsequent requests, see `hints` above.
     bool generate_hints = true;
 
+    enum class OutputFormatType
+    {
+        JSON,
+        CBOR
+    };
+    // Encoding of the response rendered by osrm-routed, libosrm always returns a json::Object
+    OutputFormatType format = OutputFormatType::JSON;
+
     BaseParameters(const std::vector<util::Coordinate> coordinates_ = {},
                    const std::vector<boost::optional<Hint>> hints_ = {},
                    std::vector<boost::optional<double>> radiuses_ = {},
@@ -85,6 +93,12 @@ struct BaseParameters
         return (hints.empty() || hints.size() == coordinates.size()) &&
                (bearings.empty() || bearings.size() == coordinates.size()) &&
                (radiuses.empty() || radiuses.size() == coordinates.size()) &&
+               std::all_of(radiuses.begin(),
+                           radiuses.end(),
+                           [](const boost::optional<double> radius) {
+                               // also rejects NaN
+                               return !radius || *radius >= 0;
+                           }) &&
                std::all_of(bearings.begin(),
                            bearings.end(),
                            [](const boost::optional<Bearing> bearing_and_range) {
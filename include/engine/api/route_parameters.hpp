@@ -45,6 +45,8 @@ namespace api
  * Holds member attributes:
  *  - steps: return route step for each route leg
  *  - alternatives: tries to find alternative routes
+ *  - number_of_alternatives: the maximal number of alternative routes, one if only alternatives
+ *                            is set
  *  - geometries: route geometry encoded in Polyline, Polyline6 or GeoJSON
  *  - overview: adds overview geometry either Full, Simplified (according to highest zoom level) or
  *              False (not at all)
@@ -101,6 +103,7 @@ struct RouteParameters : public BaseParameters
 
     bool steps = false;
     bool alternatives = false;
+    unsigned number_of_alternatives = 0;
     bool annotations = false;
     GeometriesType geometries = GeometriesType::Polyline;
     OverviewType overview = OverviewType::Simplified;
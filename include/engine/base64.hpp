@@ -1,6 +1,10 @@
 #ifndef OSRM_BASE64_HPP
 #define OSRM_BASE64_HPP
 
+#include "util/exception.hpp"
+
+#include <algorithm>
+#include <array>
 #include <iterator>
 #include <string>
 #include <type_traits>
@@ -8,10 +12,10 @@
 
 #include <climits>
 #include <cstddef>
+#include <cstdint>
 
 #include <boost/algorithm/string/trim.hpp>
 #include <boost/archive/iterators/base64_from_binary.hpp>
-#include <boost/archive/iterators/binary_from_base64.hpp>
 #include <boost/archive/iterators/transform_width.hpp>
 #include <boost/range/algorithm/copy.hpp>
 
@@ -33,11 +37,27 @@ using Base64FromBinary = boost::archive::iterators::base64_from_binary<
                                                8             // from sequence of 8 bit
                                                >>;
 
-using BinaryFromBase64 = boost::archive::iterators::transform_width<
-    boost::archive::iterators::binary_from_base64<std::string::const_iterator>,
-    8, // get a view of 8 bit
-    6  // from a sequence of 6 bit
-    >;
+const constexpr unsigned char INVALID_BASE64_CHAR = 0xff;
+
+// Maps the characters of the standard and of the URL safe alphabet to their 6 bit values and
+// the padding '=' to zero bits, all other characters are invalid.
+inline const std::array<unsigned char, 256> &base64DecodingTable()
+{
+    static const auto table = [] {
+        std::array<unsigned char, 256> table;
+        table.fill(INVALID_BASE64_CHAR);
+        const char alphabet[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+        for (unsigned char value = 0; value < 64; ++value)
+        {
+            table[static_cast<unsigned char>(alphabet[value])] = value;
+        }
+        table['-'] = table['+'];
+        table['_'] = table['/'];
+        table['='] = 0;
+        return table;
+    }();
+    return table;
+}
 } // ns detail
 namespace engine
 {
@@ -96,19 +116,70 @@ template <typename T> std::string encodeBase64Bytewise(const T &x)
 
 // Decoding Implementation
 
-// Decodes into a chunk of memory that is at least as large as the input.
+// Decodes into a chunk of memory that is at least as large as the input. Accepts the standard
+// and the URL safe alphabet, throws on any other character. Every block of four characters is
+// decoded with four table lookups into three bytes, there is no per bit work.
 template <typename OutputIter> void decodeBase64(const std::string &encoded, OutputIter out)
 {
-    auto unpadded = encoded;
+    const auto &table = detail::base64DecodingTable();
+    const auto size = encoded.size();
+    // a single character in the last block does not make up a byte
+    if (size % 4 == 1)
+    {
+        throw util::exception("Invalid base64 length");
+    }
+    const auto num_padded = static_cast<std::size_t>(std::count(begin(encoded), end(encoded), '='));
+    // every character holds 6 bit, incomplete bytes at the end and padding are dropped
+    const auto decoded_size = std::max<std::size_t>(size * 6 / 8, num_padded) - num_padded;
 
-    const auto num_padded = std::count(begin(encoded), end(encoded), '=');
-    std::replace(begin(unpadded), end(unpadded), '=', 'A'); // A_64 == \0
+    const auto lookup = [&](const std::size_t index) -> std::uint32_t {
+        return table[static_cast<unsigned char>(encoded[index])];
+    };
 
-    std::string decoded{detail::BinaryFromBase64{begin(unpadded)},
-                        detail::BinaryFromBase64{begin(unpadded) + unpadded.length()}};
+    std::size_t written = 0;
+    std::size_t index = 0;
+    for (; index + 4 <= size; index += 4)
+    {
+        const auto a = lookup(index), b = lookup(index + 1), c = lookup(index + 2),
+                   d = lookup(index + 3);
+        // valid values fit into 6 bit
+        if (((a | b | c | d) & 0xc0) != 0)
+        {
+            throw util::exception("Invalid base64 character");
+        }
+        const std::uint32_t block = a << 18 | b << 12 | c << 6 | d;
+        for (const auto shift : {16, 8, 0})
+        {
+            if (written < decoded_size)
+            {
+                *out++ = static_cast<unsigned char>(block >> shift);
+                ++written;
+            }
+        }
+    }
 
-    decoded.erase(end(decoded) - num_padded, end(decoded));
-    std::copy(begin(decoded), end(decoded), out);
+    // the remaining characters do not fill a block
+    std::uint32_t bits = 0;
+    std::size_t number_of_bits = 0;
+    for (; index < size; ++index)
+    {
+        const auto value = lookup(index);
+        if (value == detail::INVALID_BASE64_CHAR)
+        {
+            throw util::exception("Invalid base64 character");
+        }
+        bits = bits << 6 | value;
+        number_of_bits += 6;
+        if (number_of_bits >= 8)
+        {
+            number_of_bits -= 8;
+            if (written < decoded_size)
+            {
+                *out++ = static_cast<unsigned char>(bits >> number_of_bits);
+                ++written;
+            }
+        }
+    }
 }
 
 // Convenience specialization, filling string instead of byte-dumping into it.
@@ -128,7 +199,8 @@ template <typename T> T decodeBase64Bytewise(const std::string &encoded)
     static_assert(std::is_trivially_copyable<T>::value, "requires a trivially copyable type");
 #endif
 
-    T x;
+    // padding characters leave the trailing bytes untouched
+    T x{};
 
     decodeBase64(encoded, reinterpret_cast<unsigned char *>(&x));
 
@@ -0,0 +1,65 @@
+#ifndef OSRM_ENGINE_CACHE_STATISTICS_HPP
+#define OSRM_ENGINE_CACHE_STATISTICS_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace osrm
+{
+namespace engine
+{
+
+/**
+ * Counts over all datasets of the process how many lookups the query caches answered. The
+ * caches count every lookup, so the counters can be read while the caches are in use.
+ */
+class CacheStatistics
+{
+  public:
+    static CacheStatistics &GetInstance();
+
+    CacheStatistics(const CacheStatistics &) = delete;
+    CacheStatistics &operator=(const CacheStatistics &) = delete;
+
+    void CountShortcutUnpacking(const std::uint64_t hits, const std::uint64_t misses)
+    {
+        shortcut_unpacking_hits.fetch_add(hits, std::memory_order_relaxed);
+        shortcut_unpacking_misses.fetch_add(misses, std::memory_order_relaxed);
+    }
+
+    void CountSnapping(const std::uint64_t hits, const std::uint64_t misses)
+    {
+        snapping_hits.fetch_add(hits, std::memory_order_relaxed);
+        snapping_misses.fetch_add(misses, std::memory_order_relaxed);
+    }
+
+    std::uint64_t GetNumberOfShortcutUnpackingHits() const
+    {
+        return shortcut_unpacking_hits.load(std::memory_order_relaxed);
+    }
+    std::uint64_t GetNumberOfShortcutUnpackingMisses() const
+    {
+        return shortcut_unpacking_misses.load(std::memory_order_relaxed);
+    }
+
+    std::uint64_t GetNumberOfSnappingHits() const
+    {
+        return snapping_hits.load(std::memory_order_relaxed);
+    }
+    std::uint64_t GetNumberOfSnappingMisses() const
+    {
+        return snapping_misses.load(std::memory_order_relaxed);
+    }
+
+  private:
+    CacheStatistics() = default;
+
+    std::atomic<std::uint64_t> shortcut_unpacking_hits{0};
+    std::atomic<std::uint64_t> shortcut_unpacking_misses{0};
+    std::atomic<std::uint64_t> snapping_hits{0};
+    std::atomic<std::uint64_t> snapping_misses{0};
+};
+}
+}
+
+#endif
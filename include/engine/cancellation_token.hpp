@@ -0,0 +1,178 @@
+/*
+
+Copyright (c) 2016, Project OSRM contributors
+All rights reserved.
+
+Redistribution and use in source and binary forms, with or without modification,
+are permitted provided that the following conditions are met:
+
+Redistributions of source code must retain the above copyright notice, this list
+of conditions and the following disclaimer.
+Redistributions in binary form must reproduce the above copyright notice, this
+list of conditions and the following disclaimer in the documentation and/or
+other materials provided with the distribution.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+(INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON
+ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+(INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+*/
+
+#ifndef OSRM_ENGINE_CANCELLATION_TOKEN_HPP
+#define OSRM_ENGINE_CANCELLATION_TOKEN_HPP
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <utility>
+
+namespace osrm
+{
+namespace engine
+{
+
+/**
+ * Thrown by the searches of a query whose CancellationToken was cancelled or whose deadline
+ * passed. The Engine catches it and returns Status::Timeout.
+ */
+class RequestCancelled final : public std::exception
+{
+  public:
+    enum class Reason
+    {
+        DeadlineExceeded,
+        Cancelled
+    };
+
+    explicit RequestCancelled(const Reason reason) : reason(reason) {}
+
+    Reason GetReason() const { return reason; }
+
+    const char *what() const noexcept override
+    {
+        return reason == Reason::DeadlineExceeded ? "Request exceeded its deadline"
+                                                  : "Request was cancelled";
+    }
+
+  private:
+    Reason reason;
+};
+
+/**
+ * Lets the caller of a query give up on it, e.g. because the client closed the connection or is
+ * not going to wait any longer. A query is aborted once its deadline passed, Cancel was called or
+ * the optional check function returns true.
+ *
+ * Searches look at the token every CHECK_INTERVAL heap pops, so a query is given up a fraction of
+ * a millisecond after it was cancelled instead of running to completion.
+ */
+class CancellationToken
+{
+  public:
+    using Clock = std::chrono::steady_clock;
+
+    // Number of heap pops between two looks at the token
+    static constexpr std::uint32_t CHECK_INTERVAL = 1024;
+
+    // Never cancelled unless Cancel is called
+    CancellationToken() = default;
+
+    explicit CancellationToken(const Clock::time_point deadline,
+                               std::function<bool()> is_cancelled = {})
+        : deadline(deadline), is_cancelled(std::move(is_cancelled))
+    {
+    }
+
+    CancellationToken(const CancellationToken &) = delete;
+    CancellationToken &operator=(const CancellationToken &) = delete;
+
+    // Can be called from any thread
+    void Cancel() { cancelled.store(true, std::memory_order_relaxed); }
+
+    void ThrowIfCancelled() const
+    {
+        if (cancelled.load(std::memory_order_relaxed))
+        {
+            throw RequestCancelled(RequestCancelled::Reason::Cancelled);
+        }
+        if (Clock::now() >= deadline)
+        {
+            throw RequestCancelled(RequestCancelled::Reason::DeadlineExceeded);
+        }
+        if (is_cancelled && is_cancelled())
+        {
+            cancelled.store(true, std::memory_order_relaxed);
+            throw RequestCancelled(RequestCancelled::Reason::Cancelled);
+        }
+    }
+
+  private:
+    const Clock::time_point deadline = Clock::time_point::max();
+    const std::function<bool()> is_cancelled;
+    mutable std::atomic<bool> cancelled{false};
+};
+
+// Per thread state of CancellationScope and CancellationCheck
+struct CancellationState
+{
+    const CancellationToken *token = nullptr;
+    std::uint32_t pops = 0;
+};
+
+/**
+ * Makes `token` the cancellation token of all searches run by the calling thread while in scope.
+ * The Engine opens a scope for every query, so the routing algorithms don't need to pass the
+ * token around.
+ */
+class CancellationScope
+{
+  public:
+    explicit CancellationScope(const CancellationToken &token);
+    ~CancellationScope();
+
+    CancellationScope(const CancellationScope &) = delete;
+    CancellationScope &operator=(const CancellationScope &) = delete;
+
+    // Throws RequestCancelled if the query of the calling thread was cancelled
+    static void Check();
+
+    static CancellationState &GetState();
+
+  private:
+    const CancellationToken *previous_token;
+};
+
+/**
+ * Counts the heap pops of a search and looks at the cancellation token of the calling thread
+ * every CancellationToken::CHECK_INTERVAL pops. The count is kept per thread, so queries that run
+ * many short searches are checked as well.
+ */
+class CancellationCheck
+{
+  public:
+    CancellationCheck() : state(CancellationScope::GetState()) {}
+
+    void operator()() const
+    {
+        if (state.token && ++state.pops % CancellationToken::CHECK_INTERVAL == 0)
+        {
+            state.token->ThrowIfCancelled();
+        }
+    }
+
+  private:
+    CancellationState &state;
+};
+}
+}
+
+#endif
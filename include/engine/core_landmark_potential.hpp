@@ -0,0 +1,131 @@
+#ifndef OSRM_ENGINE_CORE_LANDMARK_POTENTIAL_HPP
+#define OSRM_ENGINE_CORE_LANDMARK_POTENTIAL_HPP
+
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <limits>
+#include <tuple>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+
+/**
+ * A* potential for the core search, derived from the landmark distances (ALT).
+ *
+ * For the forward search the potential is a lower bound on the weight of the remaining path
+ * from a node to any of the reverse entry points into the core (including their offsets), for
+ * the reverse search a lower bound on the weight from any of the forward entry points to a node.
+ * Both follow from the triangle inequality with respect to every landmark L:
+ *
+ *   forward: d(v,t) >= d(L,t) - d(L,v)  and  d(v,t) >= d(v,L) - d(t,L)
+ *   reverse: d(s,v) >= d(s,L) - d(v,L)  and  d(s,v) >= d(L,v) - d(L,s)
+ *
+ * Taking the minimum over all entry points upfront makes every term a constant minus a landmark
+ * distance of v, so the potential is consistent and cheap to evaluate.
+ */
+template <class DataFacadeT> class CoreLandmarkPotential
+{
+  public:
+    // (node, weight, parent) as collected by the search on the contracted part of the graph
+    using CoreEntryPoint = std::tuple<NodeID, EdgeWeight, NodeID>;
+
+    // `entry_points` are the entry points of the opposite search direction
+    CoreLandmarkPotential(const DataFacadeT &facade_,
+                          const std::vector<CoreEntryPoint> &entry_points,
+                          const bool forward_direction)
+        : facade(facade_), number_of_landmarks(facade_.GetNumberOfCoreLandmarks()),
+          // near distances are d(L,v) for the forward and d(v,L) for the reverse search
+          near_offset(forward_direction ? 0 : number_of_landmarks),
+          far_offset(forward_direction ? number_of_landmarks : 0), min_entry_weight(0)
+    {
+        if (number_of_landmarks == 0 || entry_points.empty())
+        {
+            return;
+        }
+
+        min_entry_weight = std::numeric_limits<EdgeWeight>::max();
+        for (const auto &entry_point : entry_points)
+        {
+            min_entry_weight = std::min(min_entry_weight, std::get<1>(entry_point));
+        }
+
+        near_bounds.resize(number_of_landmarks, INVALID_EDGE_WEIGHT);
+        far_bounds.resize(number_of_landmarks, -INVALID_EDGE_WEIGHT);
+        for (const auto &entry_point : entry_points)
+        {
+            const auto *distances = facade.GetCoreLandmarkDistances(std::get<0>(entry_point));
+            const auto entry_weight = std::get<1>(entry_point);
+            for (unsigned landmark = 0; landmark < number_of_landmarks; ++landmark)
+            {
+                const auto near = distances[near_offset + landmark];
+                if (near != INVALID_EDGE_WEIGHT)
+                {
+                    near_bounds[landmark] = std::min(near_bounds[landmark], near + entry_weight);
+                }
+
+                // the bound only holds if all entry points are connected to the landmark
+                const auto far = distances[far_offset + landmark];
+                if (far == INVALID_EDGE_WEIGHT || far_bounds[landmark] == INVALID_EDGE_WEIGHT)
+                {
+                    far_bounds[landmark] = INVALID_EDGE_WEIGHT;
+                }
+                else
+                {
+                    far_bounds[landmark] = std::max(far_bounds[landmark], far - entry_weight);
+                }
+            }
+        }
+    }
+
+    // Lower bound on the remaining weight from/to `node`. Returns INVALID_EDGE_WEIGHT if the node
+    // is provably not connected to any of the entry points. Only valid for core nodes.
+    EdgeWeight operator()(const NodeID node) const
+    {
+        if (near_bounds.empty())
+        {
+            return min_entry_weight;
+        }
+
+        const auto *distances = facade.GetCoreLandmarkDistances(node);
+        EdgeWeight potential = min_entry_weight;
+        for (unsigned landmark = 0; landmark < number_of_landmarks; ++landmark)
+        {
+            const auto near = distances[near_offset + landmark];
+            if (near != INVALID_EDGE_WEIGHT && near_bounds[landmark] != INVALID_EDGE_WEIGHT)
+            {
+                potential = std::max(potential, near_bounds[landmark] - near);
+            }
+
+            if (far_bounds[landmark] != INVALID_EDGE_WEIGHT)
+            {
+                const auto far = distances[far_offset + landmark];
+                if (far == INVALID_EDGE_WEIGHT)
+                {
+                    return INVALID_EDGE_WEIGHT;
+                }
+                potential = std::max(potential, far - far_bounds[landmark]);
+            }
+        }
+        BOOST_ASSERT(potential != INVALID_EDGE_WEIGHT);
+        return potential;
+    }
+
+  private:
+    const DataFacadeT &facade;
+    const unsigned number_of_landmarks;
+    const unsigned near_offset;
+    const unsigned far_offset;
+    EdgeWeight min_entry_weight;
+    std::vector<EdgeWeight> near_bounds;
+    std::vector<EdgeWeight> far_bounds;
+};
+}
+}
+
+#endif
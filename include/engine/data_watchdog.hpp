@@ -2,17 +2,16 @@
 #define OSRM_ENGINE_DATA_WATCHDOG_HPP
 
 #include "engine/datafacade/shared_memory_datafacade.hpp"
+#include "engine/engine_config.hpp"
 
-#include "storage/shared_barriers.hpp"
 #include "storage/shared_datatype.hpp"
 #include "storage/shared_memory.hpp"
 
-#include <boost/interprocess/sync/named_upgradable_mutex.hpp>
-#include <boost/thread/lock_types.hpp>
-#include <boost/thread/locks.hpp>
-#include <boost/thread/shared_mutex.hpp>
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
 
 #include <memory>
+#include <mutex>
 
 namespace osrm
 {
@@ -23,17 +22,22 @@ namespace engine
 // the data and layout regions that should be used. This region is updated
 // once a new dataset arrives.
 //
-// TODO: This also needs a shared memory reader lock with other clients and
-// possibly osrm-datastore since updating the CURRENT_REGIONS data is not atomic.
-// Currently we enfore this by waiting that all queries have finished before
-// osrm-datastore writes to this section.
+// Queries do not take any cross-process locks: every query pins the facade that was current
+// when it started through a shared_ptr (read-copy-update). osrm-datastore publishes a new
+// dataset with a single atomic store and removes the regions of the previous one right away.
+// Processes that still have them attached keep them alive, the memory is released once the
+// last query on the old dataset finished and its facade detached the regions.
+//
+// A single thread loads a new dataset, including the rtree warmup. Meanwhile the other queries
+// keep using the previous dataset instead of waiting for it, only the very first dataset has to
+// be waited for.
 class DataWatchdog
 {
   public:
-    DataWatchdog()
-        : shared_barriers{std::make_shared<storage::SharedBarriers>()},
-          shared_regions(storage::makeSharedMemory(storage::CURRENT_REGIONS)),
-          current_timestamp{storage::LAYOUT_NONE, storage::DATA_NONE, 0}
+    // the facade of every dataset is configured with `config_`, see
+    // ContiguousInternalMemoryDataFacadeBase::Configure
+    explicit DataWatchdog(const EngineConfig &config_)
+        : shared_regions(storage::makeSharedMemory(storage::CURRENT_REGIONS)), config(config_)
     {
     }
 
@@ -43,84 +47,95 @@ class DataWatchdog
         return storage::SharedMemory::RegionExists(storage::CURRENT_REGIONS);
     }
 
-    using RegionsLock =
-        boost::interprocess::sharable_lock<boost::interprocess::named_sharable_mutex>;
-    using LockAndFacade = std::pair<RegionsLock, std::shared_ptr<datafacade::BaseDataFacade>>;
-
-    // This will either update the contens of facade or just leave it as is
-    // if the update was already done by another thread
-    LockAndFacade GetDataFacade()
+    // Returns the facade of the newest dataset. Holding on to the returned pointer keeps the
+    // dataset alive, even if a newer one is published in the meantime.
+    std::shared_ptr<datafacade::BaseDataFacade> GetDataFacade()
     {
-        const boost::interprocess::sharable_lock<boost::interprocess::named_upgradable_mutex> lock(
-            shared_barriers->current_regions_mutex);
+        const auto current_regions =
+            static_cast<const storage::SharedCurrentRegions *>(shared_regions->Ptr());
 
-        const auto shared_timestamp =
-            static_cast<const storage::SharedDataTimestamp *>(shared_regions->Ptr());
+        // common case: no data update, this only needs an atomic load of the facade
+        auto current_facade = std::atomic_load(&facade);
+        if (current_facade &&
+            current_regions->Load().timestamp == current_facade->GetSharedTimestamp())
+        {
+            return current_facade;
+        }
 
-        const auto get_locked_facade = [this, shared_timestamp]() {
-            if (current_timestamp.data == storage::DATA_1)
-            {
-                BOOST_ASSERT(current_timestamp.layout == storage::LAYOUT_1);
-                return std::make_pair(RegionsLock(shared_barriers->regions_1_mutex), facade);
-            }
-            else
+        // if we reach this code there is a data update to be made. multiple
+        // requests can reach this, but only ever one goes through at a time.
+        std::unique_lock<std::mutex> update_lock(update_mutex, std::try_to_lock);
+        if (!update_lock.owns_lock())
+        {
+            // another thread is loading the new dataset, don't stall while it warms up
+            if (current_facade)
             {
-                BOOST_ASSERT(current_timestamp.layout == storage::LAYOUT_2);
-                BOOST_ASSERT(current_timestamp.data == storage::DATA_2);
-                return std::make_pair(RegionsLock(shared_barriers->regions_2_mutex), facade);
+                return current_facade;
             }
-        };
+            update_lock.lock();
+        }
 
-        // this blocks handle the common case when there is no data update -> we will only need a
-        // shared lock
+        auto current_timestamp = current_regions->Load();
+        current_facade = std::atomic_load(&facade);
+        // we might get overtaken by another thread that already loaded the new dataset
+        while (!current_facade ||
+               current_timestamp.timestamp != current_facade->GetSharedTimestamp())
         {
-            boost::shared_lock<boost::shared_mutex> facade_lock(facade_mutex);
+            auto layout_memory = TryAttach(current_timestamp.layout);
+            auto large_memory = TryAttach(current_timestamp.data);
+
+            // The regions might have been replaced while we attached them. Once attached they
+            // can't go away anymore, so they are only valid if the dataset is still current.
+            const auto attached_timestamp = current_timestamp;
+            current_timestamp = current_regions->Load();
+            if (attached_timestamp.timestamp != current_timestamp.timestamp)
+            {
+                continue;
+            }
 
-            if (shared_timestamp->timestamp == current_timestamp.timestamp)
+            if (!layout_memory || !large_memory)
             {
-                BOOST_ASSERT(shared_timestamp->layout == current_timestamp.layout);
-                BOOST_ASSERT(shared_timestamp->data == current_timestamp.data);
-                return get_locked_facade();
+                throw util::exception("Shared memory regions of the current dataset are missing" +
+                                      SOURCE_REF);
             }
+
+            current_facade = std::make_shared<datafacade::SharedMemoryDataFacade>(
+                std::move(layout_memory), std::move(large_memory), current_timestamp.timestamp);
+            // the new facade is only published once it is configured and warmed up
+            current_facade->Configure(config);
+            std::atomic_store(&facade, current_facade);
         }
 
-        // if we reach this code there is a data update to be made. multiple
-        // requests can reach this, but only ever one goes through at a time.
-        boost::upgrade_lock<boost::shared_mutex> facade_lock(facade_mutex);
+        return current_facade;
+    }
 
-        // we might get overtaken before we actually do the writing
-        // in that case we don't modify anthing
-        if (shared_timestamp->timestamp == current_timestamp.timestamp)
+  private:
+    static std::unique_ptr<storage::SharedMemory> TryAttach(const storage::SharedDataType region)
+    {
+        if (!storage::SharedMemory::RegionExists(region))
         {
-            BOOST_ASSERT(shared_timestamp->layout == current_timestamp.layout);
-            BOOST_ASSERT(shared_timestamp->data == current_timestamp.data);
-
-            return get_locked_facade();
+            return nullptr;
         }
 
-        // this thread has won and can update the data
-        boost::upgrade_to_unique_lock<boost::upgrade_mutex> unique_facade_lock(facade_lock);
-
-        current_timestamp = *shared_timestamp;
-        facade = std::make_shared<datafacade::SharedMemoryDataFacade>(shared_barriers,
-                                                                      current_timestamp.layout,
-                                                                      current_timestamp.data,
-                                                                      current_timestamp.timestamp);
-
-        return get_locked_facade();
+        try
+        {
+            return storage::makeSharedMemory(region);
+        }
+        catch (const util::exception &)
+        {
+            // removed after we checked for it
+            return nullptr;
+        }
     }
 
-  private:
-    // mutexes should be mutable even on const objects: This enables
-    // marking functions as logical const and thread-safe.
-    std::shared_ptr<storage::SharedBarriers> shared_barriers;
-
     // shared memory table containing pointers to all shared regions
     std::unique_ptr<storage::SharedMemory> shared_regions;
 
-    mutable boost::shared_mutex facade_mutex;
+    const EngineConfig config;
+
+    // only serializes loading a new dataset within this process
+    std::mutex update_mutex;
     std::shared_ptr<datafacade::SharedMemoryDataFacade> facade;
-    storage::SharedDataTimestamp current_timestamp;
 };
 }
 }
@@ -3,6 +3,8 @@
 
 #include "engine/datafacade/datafacade_base.hpp"
 
+#include "contractor/compact_query_graph.hpp"
+#include "contractor/core_landmarks.hpp"
 #include "extractor/compressed_edge_container.hpp"
 #include "extractor/guidance/turn_instruction.hpp"
 #include "extractor/guidance/turn_lane_types.hpp"
@@ -12,11 +14,14 @@
 #include "util/guidance/entry_class.hpp"
 #include "util/guidance/turn_lanes.hpp"
 
+#include "engine/engine_config.hpp"
 #include "engine/geospatial_query.hpp"
+#include "util/bit_packed_vector.hpp"
 #include "util/exception.hpp"
 #include "util/exception_utils.hpp"
 #include "util/guidance/turn_bearing.hpp"
 #include "util/log.hpp"
+#include "util/packed_coordinate_vector.hpp"
 #include "util/packed_vector.hpp"
 #include "util/range_table.hpp"
 #include "util/rectangle.hpp"
@@ -56,14 +61,13 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
 {
   private:
     using super = BaseDataFacade;
-    using QueryGraph = util::StaticGraph<EdgeData, true>;
+    using QueryGraph = contractor::CompactQueryGraph<true>;
     using GraphNode = QueryGraph::NodeArrayEntry;
     using GraphEdge = QueryGraph::EdgeArrayEntry;
+    using GraphEdgeID = QueryGraph::EdgeIDEntry;
     using IndexBlock = util::RangeTable<16, true>::BlockT;
-    using InputEdge = QueryGraph::InputEdge;
     using RTreeLeaf = super::RTreeLeaf;
-    using SharedRTree =
-        util::StaticRTree<RTreeLeaf, util::ShM<util::Coordinate, true>::vector, true>;
+    using SharedRTree = util::StaticRTree<RTreeLeaf, util::CoordinateList<true>, true>;
     using SharedGeospatialQuery = GeospatialQuery<SharedRTree, BaseDataFacade>;
     using RTreeNode = SharedRTree::TreeNode;
 
@@ -72,7 +76,7 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     std::string m_timestamp;
     extractor::ProfileProperties *m_profile_properties;
 
-    util::ShM<util::Coordinate, true>::vector m_coordinate_list;
+    util::CoordinateList<true> m_coordinate_list;
     util::PackedVector<OSMNodeID, true> m_osmnodeid_list;
     util::ShM<GeometryID, true>::vector m_via_geometry_list;
     util::ShM<unsigned, true>::vector m_name_ID_list;
@@ -84,10 +88,13 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     util::ShM<char, true>::vector m_names_char_list;
     util::ShM<unsigned, true>::vector m_name_begin_indices;
     util::ShM<unsigned, true>::vector m_geometry_indices;
-    util::ShM<NodeID, true>::vector m_geometry_node_list;
+    util::BitPackedVector<NodeID, true> m_geometry_node_list;
     util::ShM<EdgeWeight, true>::vector m_geometry_fwd_weight_list;
     util::ShM<EdgeWeight, true>::vector m_geometry_rev_weight_list;
     util::ShM<bool, true>::vector m_is_core_node;
+    util::ShM<std::uint32_t, true>::vector m_core_landmark_ranks;
+    util::ShM<EdgeWeight, true>::vector m_core_landmark_distances;
+    unsigned m_number_of_core_landmarks;
     util::ShM<uint8_t, true>::vector m_datasource_list;
     util::ShM<std::uint32_t, true>::vector m_lane_description_offsets;
     util::ShM<extractor::guidance::TurnLaneType::Mask, true>::vector m_lane_description_masks;
@@ -99,6 +106,7 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
 
     std::unique_ptr<SharedRTree> m_static_rtree;
     std::unique_ptr<SharedGeospatialQuery> m_geospatial_query;
+    std::unique_ptr<ShortcutUnpackingCache> m_shortcut_unpacking_cache;
     boost::filesystem::path file_index_path;
 
     std::shared_ptr<util::RangeTable<16, true>> m_name_table;
@@ -175,13 +183,27 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
             graph_nodes_ptr, data_layout.num_entries[storage::DataLayout::GRAPH_NODE_LIST]);
         util::ShM<GraphEdge, true>::vector edge_list(
             graph_edges_ptr, data_layout.num_entries[storage::DataLayout::GRAPH_EDGE_LIST]);
-        m_query_graph.reset(new QueryGraph(node_list, edge_list));
+
+        auto graph_edge_ids_ptr = data_layout.GetBlockPtr<GraphEdgeID>(
+            memory_block, storage::DataLayout::GRAPH_EDGE_ID_LIST);
+        util::ShM<GraphEdgeID, true>::vector edge_id_list(
+            graph_edge_ids_ptr, data_layout.num_entries[storage::DataLayout::GRAPH_EDGE_ID_LIST]);
+        m_query_graph.reset(new QueryGraph(node_list, edge_list, edge_id_list));
     }
 
     void InitializeNodeAndEdgeInformationPointers(storage::DataLayout &data_layout,
                                                   char *memory_block)
     {
-        const auto coordinate_list_ptr = data_layout.GetBlockPtr<util::Coordinate>(
+        if (data_layout.packed_coordinates != util::PACKED_COORDINATE_LIST)
+        {
+            throw util::exception(
+                std::string("The coordinates of the dataset are ") +
+                (data_layout.packed_coordinates ? "packed" : "not packed") +
+                ", osrm-datastore and osrm-routed have to be built with the same "
+                "ENABLE_PACKED_COORDINATES setting" +
+                SOURCE_REF);
+        }
+        const auto coordinate_list_ptr = data_layout.GetBlockPtr<util::CoordinateListEntry>(
             memory_block, storage::DataLayout::COORDINATE_LIST);
         m_coordinate_list.reset(coordinate_list_ptr,
                                 data_layout.num_entries[storage::DataLayout::COORDINATE_LIST]);
@@ -196,8 +218,7 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         m_osmnodeid_list.reset(osmnodeid_list_ptr,
                                data_layout.num_entries[storage::DataLayout::OSM_NODE_ID_LIST]);
         // We (ab)use the number of coordinates here because we know we have the same amount of ids
-        m_osmnodeid_list.set_number_of_entries(
-            data_layout.num_entries[storage::DataLayout::COORDINATE_LIST]);
+        m_osmnodeid_list.set_number_of_entries(m_coordinate_list.size());
 
         const auto travel_mode_list_ptr = data_layout.GetBlockPtr<extractor::TravelMode>(
             memory_block, storage::DataLayout::TRAVEL_MODE);
@@ -305,6 +326,52 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         util::ShM<bool, true>::vector is_core_node(
             core_marker_ptr, data_layout.num_entries[storage::DataLayout::CORE_MARKER]);
         m_is_core_node = std::move(is_core_node);
+
+        auto ranks_ptr = data_layout.GetBlockPtr<std::uint32_t>(
+            memory_block, storage::DataLayout::CORE_LANDMARK_RANKS);
+        util::ShM<std::uint32_t, true>::vector ranks(
+            ranks_ptr, data_layout.num_entries[storage::DataLayout::CORE_LANDMARK_RANKS]);
+        m_core_landmark_ranks = std::move(ranks);
+
+        auto distances_ptr = data_layout.GetBlockPtr<EdgeWeight>(
+            memory_block, storage::DataLayout::CORE_LANDMARK_DISTANCES);
+        util::ShM<EdgeWeight, true>::vector distances(
+            distances_ptr, data_layout.num_entries[storage::DataLayout::CORE_LANDMARK_DISTANCES]);
+        m_core_landmark_distances = std::move(distances);
+
+        // the last rank entry holds the number of core nodes
+        m_number_of_core_landmarks = 0;
+        if (!m_is_core_node.empty() && !m_core_landmark_ranks.empty())
+        {
+            using contractor::CoreLandmarks;
+            const auto number_of_buckets =
+                (m_is_core_node.size() + CoreLandmarks::BUCKET_SIZE - 1) /
+                CoreLandmarks::BUCKET_SIZE;
+            const auto number_of_core_nodes =
+                m_core_landmark_ranks[m_core_landmark_ranks.size() - 1];
+            // landmarks of another graph, e.g. a .core.landmarks file that was left behind by an
+            // earlier run of osrm-contract, would give wrong and possibly inadmissible potentials
+            const auto last_node = m_is_core_node.size() - 1;
+            const bool landmarks_match_core =
+                m_core_landmark_ranks.size() == number_of_buckets + 1 &&
+                m_core_landmark_ranks[number_of_buckets - 1] +
+                        m_is_core_node.rank_in_bucket(last_node) +
+                        (m_is_core_node[last_node] ? 1 : 0) ==
+                    number_of_core_nodes &&
+                (number_of_core_nodes == 0 ||
+                 m_core_landmark_distances.size() % (2 * number_of_core_nodes) == 0);
+            if (!landmarks_match_core)
+            {
+                throw util::exception("The core landmarks don't match the core of the graph, "
+                                      "re-run osrm-contract with --core-landmarks" +
+                                      SOURCE_REF);
+            }
+            if (number_of_core_nodes > 0)
+            {
+                m_number_of_core_landmarks =
+                    m_core_landmark_distances.size() / (2 * number_of_core_nodes);
+            }
+        }
     }
 
     void InitializeGeometryPointers(storage::DataLayout &data_layout, char *memory_block)
@@ -315,12 +382,13 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
             geometries_index_ptr, data_layout.num_entries[storage::DataLayout::GEOMETRIES_INDEX]);
         m_geometry_indices = std::move(geometry_begin_indices);
 
-        auto geometries_node_list_ptr = data_layout.GetBlockPtr<NodeID>(
+        // geometries store node IDs with just enough bits for the number of nodes
+        auto geometries_node_list_ptr = data_layout.GetBlockPtr<std::uint64_t>(
             memory_block, storage::DataLayout::GEOMETRIES_NODE_LIST);
-        util::ShM<NodeID, true>::vector geometry_node_list(
+        m_geometry_node_list.reset(
             geometries_node_list_ptr,
-            data_layout.num_entries[storage::DataLayout::GEOMETRIES_NODE_LIST]);
-        m_geometry_node_list = std::move(geometry_node_list);
+            data_layout.num_entries[storage::DataLayout::GEOMETRIES_FWD_WEIGHT_LIST],
+            data_layout.geometry_node_bits);
 
         auto geometries_fwd_weight_list_ptr = data_layout.GetBlockPtr<EdgeWeight>(
             memory_block, storage::DataLayout::GEOMETRIES_FWD_WEIGHT_LIST);
@@ -398,6 +466,18 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
     }
 
   public:
+    ~ContiguousInternalMemoryDataFacadeBase() override
+    {
+        if (m_static_rtree && m_static_rtree->GetNumberOfLeafAccesses() > 0)
+        {
+            util::Log() << "rtree: " << m_static_rtree->GetNumberOfLeafAccesses()
+                        << " leaf accesses, " << m_static_rtree->GetNumberOfLeafPageFaults()
+                        << " page faults, " << m_static_rtree->GetNumberOfResidentLeafPages()
+                        << " of " << m_static_rtree->GetNumberOfLeafPages()
+                        << " leaf pages in RAM";
+        }
+    }
+
     void InitializeInternalPointers(storage::DataLayout &data_layout, char *memory_block)
     {
         InitializeGraphPointer(data_layout, memory_block);
@@ -414,6 +494,51 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         InitializeIntersectionClassPointers(data_layout, memory_block);
     }
 
+    // Sets up the caches and rtree options of `config` for this dataset
+    void Configure(const EngineConfig &config)
+    {
+        SetShortcutUnpackingCacheSize(config.shortcut_cache_size);
+        SetSnappingCacheSize(config.snapping_cache_size);
+        if (config.warmup_rtree)
+        {
+            WarmUpRTree();
+        }
+        if (config.rtree_statistics)
+        {
+            EnableRTreeStatistics();
+        }
+    }
+
+    // Caches up to `capacity` original edges of shortcuts, 0 disables the cache
+    void SetShortcutUnpackingCacheSize(const std::size_t capacity)
+    {
+        m_shortcut_unpacking_cache.reset(capacity > 0 ? new ShortcutUnpackingCache(capacity)
+                                                      : nullptr);
+    }
+
+    // Caches the phantom nodes of up to `capacity` snapped coordinates, 0 disables the cache
+    void SetSnappingCacheSize(const std::size_t capacity)
+    {
+        BOOST_ASSERT(m_geospatial_query.get());
+        m_geospatial_query->SetSnappingCacheSize(capacity);
+    }
+
+    // Reads the rtree leaves into RAM, so the first queries don't wait for page faults
+    void WarmUpRTree()
+    {
+        BOOST_ASSERT(m_static_rtree.get());
+        m_static_rtree->WarmUpLeaves();
+        util::Log() << "rtree: " << m_static_rtree->GetNumberOfResidentLeafPages() << " of "
+                    << m_static_rtree->GetNumberOfLeafPages() << " leaf pages in RAM";
+    }
+
+    // Counts the rtree leaf accesses and page faults of all queries, logged on destruction
+    void EnableRTreeStatistics()
+    {
+        BOOST_ASSERT(m_static_rtree.get());
+        m_static_rtree->EnableLeafStatistics();
+    }
+
     // search graph access
     unsigned GetNumberOfNodes() const override final { return m_query_graph->GetNumberOfNodes(); }
 
@@ -426,11 +551,16 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
 
     NodeID GetTarget(const EdgeID e) const override final { return m_query_graph->GetTarget(e); }
 
-    EdgeData &GetEdgeData(const EdgeID e) const override final
+    EdgeData GetEdgeData(const EdgeID e) const override final
     {
         return m_query_graph->GetEdgeData(e);
     }
 
+    const EdgeSearchData &GetEdgeSearchData(const EdgeID e) const override final
+    {
+        return m_query_graph->GetEdgeSearchData(e);
+    }
+
     EdgeID BeginEdges(const NodeID n) const override final { return m_query_graph->BeginEdges(n); }
 
     EdgeID EndEdges(const NodeID n) const override final { return m_query_graph->EndEdges(n); }
@@ -464,6 +594,11 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         return m_query_graph->FindSmallestEdge(from, to, filter);
     }
 
+    ShortcutUnpackingCache *GetShortcutUnpackingCache() const override final
+    {
+        return m_shortcut_unpacking_cache.get();
+    }
+
     // node and edge information access
     util::Coordinate GetCoordinateOfNode(const NodeID id) const override final
     {
@@ -491,11 +626,11 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
 
         std::vector<NodeID> result_nodes;
 
-        result_nodes.resize(end - begin);
-
-        std::copy(m_geometry_node_list.begin() + begin,
-                  m_geometry_node_list.begin() + end,
-                  result_nodes.begin());
+        result_nodes.reserve(end - begin);
+        for (auto index = begin; index < end; ++index)
+        {
+            result_nodes.push_back(m_geometry_node_list[index]);
+        }
 
         return result_nodes;
     }
@@ -514,11 +649,11 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
 
         std::vector<NodeID> result_nodes;
 
-        result_nodes.resize(end - begin);
-
-        std::copy(m_geometry_node_list.rbegin() + (m_geometry_node_list.size() - end),
-                  m_geometry_node_list.rbegin() + (m_geometry_node_list.size() - begin),
-                  result_nodes.begin());
+        result_nodes.reserve(end - begin);
+        for (auto index = end; index > begin; --index)
+        {
+            result_nodes.push_back(m_geometry_node_list[index - 1]);
+        }
 
         return result_nodes;
     }
@@ -587,6 +722,67 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
         return m_travel_mode_list.at(id);
     }
 
+    void GetOriginalEdgeSequence(const std::vector<EdgeID> &edge_ids,
+                                 OriginalEdgeSequence &sequence) const override final
+    {
+        sequence = OriginalEdgeSequence{};
+        sequence.name_ids.reserve(edge_ids.size());
+        sequence.turn_instructions.reserve(edge_ids.size());
+        sequence.travel_modes.reserve(edge_ids.size());
+        sequence.entry_class_ids.reserve(edge_ids.size());
+        sequence.pre_turn_bearings.reserve(edge_ids.size());
+        sequence.post_turn_bearings.reserve(edge_ids.size());
+        sequence.lane_data.reserve(edge_ids.size());
+        sequence.segment_offsets.reserve(edge_ids.size() + 1);
+        sequence.segment_offsets.push_back(0);
+
+        const auto add_segment = [this, &sequence](const unsigned index, const EdgeWeight weight) {
+            sequence.segment_nodes.push_back(m_geometry_node_list[index]);
+            sequence.segment_weights.push_back(weight);
+            sequence.segment_datasources.push_back(
+                m_datasource_list.empty() ? 0 : m_datasource_list[index]);
+        };
+
+        for (const auto id : edge_ids)
+        {
+            sequence.name_ids.push_back(m_name_ID_list[id]);
+            sequence.turn_instructions.push_back(m_turn_instruction_list[id]);
+            sequence.travel_modes.push_back(m_travel_mode_list[id]);
+            sequence.entry_class_ids.push_back(m_entry_class_id_list[id]);
+            sequence.pre_turn_bearings.push_back(m_pre_turn_bearing[id]);
+            sequence.post_turn_bearings.push_back(m_post_turn_bearing[id]);
+            const auto lane_data_id = m_lane_data_id[id];
+            sequence.lane_data.push_back(
+                lane_data_id == INVALID_LANE_DATAID
+                    ? util::guidance::LaneTupleIdPair{{0, INVALID_LANEID},
+                                                      INVALID_LANE_DESCRIPTIONID}
+                    : m_lane_tupel_id_pairs[lane_data_id]);
+
+            // same layout as in GetUncompressed{Forward,Reverse}{Geometry,Weights,Datasources}:
+            // in both directions the segment ending at the node with index i has its weight and
+            // datasource at index i
+            const GeometryID geometry = m_via_geometry_list[id];
+            const unsigned begin = m_geometry_indices[geometry.id];
+            const unsigned end = m_geometry_indices[geometry.id + 1];
+            BOOST_ASSERT(begin < end);
+            if (geometry.forward)
+            {
+                for (auto index = begin + 1; index < end; ++index)
+                {
+                    add_segment(index, m_geometry_fwd_weight_list[index]);
+                }
+            }
+            else
+            {
+                for (auto index = end - 1; index > begin; --index)
+                {
+                    add_segment(index - 1, m_geometry_rev_weight_list[index - 1]);
+                }
+            }
+            sequence.segment_offsets.push_back(sequence.segment_nodes.size());
+        }
+    }
+
     std::vector<RTreeLeaf> GetEdgesInBox(const util::Coordinate south_west,
                                          const util::Coordinate north_east) const override final
     {
@@ -702,6 +898,18 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
             input_coordinate, bearing, bearing_range);
     }
 
+    std::vector<std::pair<PhantomNode, PhantomNode>>
+    NearestPhantomNodesWithAlternativeFromBigComponent(
+        const std::vector<util::Coordinate> &input_coordinates,
+        const std::vector<boost::optional<double>> &max_distances,
+        const std::vector<boost::optional<Bearing>> &bearings) const override final
+    {
+        BOOST_ASSERT(m_geospatial_query.get());
+
+        return m_geospatial_query->NearestPhantomNodesWithAlternativeFromBigComponent(
+            input_coordinates, max_distances, bearings);
+    }
+
     unsigned GetCheckSum() const override final { return m_check_sum; }
 
     unsigned GetNameIndexFromEdgeID(const unsigned id) const override final
@@ -768,6 +976,26 @@ class ContiguousInternalMemoryDataFacadeBase : public BaseDataFacade
 
     virtual std::size_t GetCoreSize() const override final { return m_is_core_node.size(); }
 
+    unsigned GetNumberOfCoreLandmarks() const override final
+    {
+        return m_number_of_core_landmarks;
+    }
+
+    const EdgeWeight *GetCoreLandmarkDistances(const NodeID id) const override final
+    {
+        BOOST_ASSERT(m_number_of_core_landmarks > 0);
+        BOOST_ASSERT(m_is_core_node.at(id));
+        // rank_in_bucket counts the core nodes in the 32 bit word of `id`
+        static_assert(contractor::CoreLandmarks::BUCKET_SIZE == 32,
+                      "landmark buckets have to match the words of the core node bit vector");
+        const std::size_t rank =
+            m_core_landmark_ranks[id / contractor::CoreLandmarks::BUCKET_SIZE] +
+            m_is_core_node.rank_in_bucket(id);
+        BOOST_ASSERT((rank + 1) * 2 * m_number_of_core_landmarks <=
+                     m_core_landmark_distances.size());
+        return &m_core_landmark_distances[rank * 2 * m_number_of_core_landmarks];
+    }
+
     // Returns the data source ids that were used to supply the edge
     // weights.
     virtual std::vector<uint8_t>
@@ -3,13 +3,16 @@
 
 // Exposes all data access interfaces to the algorithms via base class ptr
 
+#include "contractor/compact_query_graph.hpp"
 #include "contractor/query_edge.hpp"
 #include "extractor/edge_based_node.hpp"
 #include "extractor/external_memory_node.hpp"
 #include "extractor/guidance/turn_instruction.hpp"
 #include "extractor/guidance/turn_lane_types.hpp"
 #include "extractor/original_edge_data.hpp"
+#include "engine/bearing.hpp"
 #include "engine/phantom_node.hpp"
+#include "engine/shortcut_unpacking_cache.hpp"
 #include "util/exception.hpp"
 #include "util/guidance/bearing_class.hpp"
 #include "util/guidance/entry_class.hpp"
@@ -21,6 +24,8 @@
 
 #include "osrm/coordinate.hpp"
 
+#include <boost/optional.hpp>
+
 #include <cstddef>
 
 #include <string>
@@ -36,10 +41,33 @@ namespace datafacade
 
 using EdgeRange = util::range<EdgeID>;
 
+// Data of a sequence of original edges in struct-of-arrays layout, filled by a single call of
+// BaseDataFacade::GetOriginalEdgeSequence. The segments of the geometry of edge i, in the
+// direction the edge is traversed, are the entries [segment_offsets[i], segment_offsets[i + 1])
+// of the segment arrays.
+struct OriginalEdgeSequence
+{
+    std::vector<unsigned> name_ids;
+    std::vector<extractor::guidance::TurnInstruction> turn_instructions;
+    std::vector<extractor::TravelMode> travel_modes;
+    std::vector<EntryClassID> entry_class_ids;
+    std::vector<util::guidance::TurnBearing> pre_turn_bearings;
+    std::vector<util::guidance::TurnBearing> post_turn_bearings;
+    // invalid lane data for edges without lanes
+    std::vector<util::guidance::LaneTupleIdPair> lane_data;
+
+    std::vector<std::size_t> segment_offsets;
+    // the node at the end of every segment
+    std::vector<NodeID> segment_nodes;
+    std::vector<EdgeWeight> segment_weights;
+    std::vector<DatasourceID> segment_datasources;
+};
+
 class BaseDataFacade
 {
   public:
     using EdgeData = contractor::QueryEdge::EdgeData;
+    using EdgeSearchData = contractor::QueryEdgeSearchData;
     using RTreeLeaf = extractor::EdgeBasedNode;
     BaseDataFacade() {}
     virtual ~BaseDataFacade() {}
@@ -53,7 +81,11 @@ class BaseDataFacade
 
     virtual NodeID GetTarget(const EdgeID e) const = 0;
 
-    virtual const EdgeData &GetEdgeData(const EdgeID e) const = 0;
+    virtual EdgeData GetEdgeData(const EdgeID e) const = 0;
+
+    // Weight and directions of an edge, all a search needs to relax it. Cheaper than GetEdgeData,
+    // which also reads the IDs that are only needed for unpacking.
+    virtual const EdgeSearchData &GetEdgeSearchData(const EdgeID e) const = 0;
 
     virtual EdgeID BeginEdges(const NodeID n) const = 0;
 
@@ -73,6 +105,9 @@ class BaseDataFacade
                                     const NodeID to,
                                     const std::function<bool(EdgeData)> filter) const = 0;
 
+    // Cache of unpacked shortcuts of this dataset, nullptr if disabled
+    virtual ShortcutUnpackingCache *GetShortcutUnpackingCache() const = 0;
+
     // node and edge information access
     virtual util::Coordinate GetCoordinateOfNode(const unsigned id) const = 0;
     virtual OSMNodeID GetOSMNodeIDOfNode(const unsigned id) const = 0;
@@ -102,6 +137,11 @@ class BaseDataFacade
 
     virtual extractor::TravelMode GetTravelModeForEdgeID(const unsigned id) const = 0;
 
+    // Gathers all data of the original edges `edge_ids` needed to build a route, replaces the
+    // per-edge calls of the getters above when unpacking paths
+    virtual void GetOriginalEdgeSequence(const std::vector<EdgeID> &edge_ids,
+                                         OriginalEdgeSequence &sequence) const = 0;
+
     virtual std::vector<RTreeLeaf> GetEdgesInBox(const util::Coordinate south_west,
                                                  const util::Coordinate north_east) const = 0;
 
@@ -147,6 +187,12 @@ class BaseDataFacade
     NearestPhantomNodeWithAlternativeFromBigComponent(const util::Coordinate input_coordinate,
                                                       const int bearing,
                                                       const int bearing_range) const = 0;
+    // Snaps all coordinates at once, radiuses and bearings are optional per coordinate
+    virtual std::vector<std::pair<PhantomNode, PhantomNode>>
+    NearestPhantomNodesWithAlternativeFromBigComponent(
+        const std::vector<util::Coordinate> &input_coordinates,
+        const std::vector<boost::optional<double>> &max_distances,
+        const std::vector<boost::optional<Bearing>> &bearings) const = 0;
 
     virtual bool hasLaneData(const EdgeID id) const = 0;
     virtual util::guidance::LaneTupleIdPair GetLaneData(const EdgeID id) const = 0;
@@ -169,6 +215,14 @@ class BaseDataFacade
 
     virtual std::size_t GetCoreSize() const = 0;
 
+    // Number of landmarks available for goal-directed search on the core, 0 if there are none
+    virtual unsigned GetNumberOfCoreLandmarks() const = 0;
+
+    // Distances of a core node to the landmarks: GetNumberOfCoreLandmarks() distances from the
+    // landmarks to the node followed by the same number of distances from the node to the
+    // landmarks. Unreachable pairs are INVALID_EDGE_WEIGHT.
+    virtual const EdgeWeight *GetCoreLandmarkDistances(const NodeID id) const = 0;
+
     virtual std::string GetTimestamp() const = 0;
 
     virtual bool GetContinueStraightDefault() const = 0;
@@ -0,0 +1,90 @@
+#ifndef MMAP_MEMORY_DATAFACADE_HPP
+#define MMAP_MEMORY_DATAFACADE_HPP
+
+// implements all data storage when a dataset file is mapped into memory
+
+#include "storage/shared_datatype.hpp"
+#include "engine/datafacade/contiguous_internalmem_datafacade_base.hpp"
+
+#include "util/exception.hpp"
+#include "util/exception_utils.hpp"
+#include "util/fingerprint.hpp"
+
+#include <boost/filesystem/operations.hpp>
+#include <boost/filesystem/path.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+
+namespace osrm
+{
+namespace engine
+{
+namespace datafacade
+{
+
+/**
+ * This datafacade maps a dataset file written by osrm-datastore --dataset into memory and uses
+ * the data in place. Nothing is copied on startup, pages are loaded on first access and are
+ * shared through the page cache by all processes that map the same file.
+ * The file is mapped read-only like the shared memory regions of osrm-datastore, the facade
+ * never writes to its data.
+ */
+class MMapMemoryDataFacade final : public ContiguousInternalMemoryDataFacadeBase
+{
+
+  private:
+    boost::interprocess::file_mapping dataset_mapping;
+    boost::interprocess::mapped_region dataset_region;
+    storage::DataLayout dataset_layout;
+
+  public:
+    explicit MMapMemoryDataFacade(const boost::filesystem::path &dataset_path)
+    {
+        if (!boost::filesystem::is_regular_file(dataset_path))
+        {
+            throw util::exception("Dataset file " + dataset_path.string() +
+                                  " not found, have you forgotten to run "
+                                  "osrm-datastore --dataset?" +
+                                  SOURCE_REF);
+        }
+
+        dataset_mapping = boost::interprocess::file_mapping(dataset_path.string().c_str(),
+                                                            boost::interprocess::read_only);
+        dataset_region =
+            boost::interprocess::mapped_region(dataset_mapping, boost::interprocess::read_only);
+
+        if (dataset_region.get_size() < sizeof(storage::DatasetHeader))
+        {
+            throw util::exception("Dataset file " + dataset_path.string() + " is truncated" +
+                                  SOURCE_REF);
+        }
+
+        char *memory_ptr = static_cast<char *>(dataset_region.get_address());
+        const auto &header = *reinterpret_cast<const storage::DatasetHeader *>(memory_ptr);
+
+        const auto valid = util::FingerPrint::GetValid();
+        if (!valid.IsMagicNumberOK(header.fingerprint) ||
+            !valid.TestContractor(header.fingerprint) ||
+            !valid.TestGraphUtil(header.fingerprint) || !valid.TestRTree(header.fingerprint) ||
+            !valid.TestQueryObjects(header.fingerprint))
+        {
+            throw util::exception("Fingerprint mismatch in " + dataset_path.string() +
+                                  SOURCE_REF);
+        }
+
+        if (dataset_region.get_size() < header.data_offset + header.data_size)
+        {
+            throw util::exception("Dataset file " + dataset_path.string() + " is truncated" +
+                                  SOURCE_REF);
+        }
+
+        // Adjust all the private m_* members to point into the mapped file
+        dataset_layout = header.layout;
+        InitializeInternalPointers(dataset_layout, memory_ptr + header.data_offset);
+    }
+};
+}
+}
+}
+
+#endif // MMAP_MEMORY_DATAFACADE_HPP
@@ -4,11 +4,15 @@
 #include "extractor/guidance/turn_instruction.hpp"
 #include "extractor/travel_mode.hpp"
 #include "engine/phantom_node.hpp"
+#include "engine/shortcut_unpacking_cache.hpp"
 #include "osrm/coordinate.hpp"
 #include "util/guidance/turn_lanes.hpp"
 #include "util/typedefs.hpp"
 
+#include <iterator>
+#include <limits>
 #include <stack>
+#include <utility>
 #include <vector>
 
 namespace osrm
@@ -31,6 +35,9 @@ namespace engine
  * the original route
  * from beginning to end.
  *
+ * If the facade has a shortcut unpacking cache, the original edges of every shortcut of the
+ * packed path are looked up there first and long expansions are added to it.
+ *
  * @param packed_path_begin iterator pointing to the start of the NodeID list
  * @param packed_path_end iterator pointing to the end of the NodeID list
  * @param callback void(const std::pair<NodeID, NodeID>, const EdgeData &) called for each
@@ -49,28 +56,14 @@ inline void UnpackCHPath(const DataFacadeT &facade,
 
     using EdgeData = typename DataFacadeT::EdgeData;
 
-    std::stack<std::pair<NodeID, NodeID>> recursion_stack;
-
-    // We have to push the path in reverse order onto the stack because it's LIFO.
-    for (auto current = std::prev(packed_path_end); current != packed_path_begin;
-         current = std::prev(current))
-    {
-        recursion_stack.emplace(*std::prev(current), *current);
-    }
-
-    std::pair<NodeID, NodeID> edge;
-    while (!recursion_stack.empty())
-    {
-        edge = recursion_stack.top();
-        recursion_stack.pop();
-
+    const auto find_edge_data = [&facade](const std::pair<NodeID, NodeID> &edge) {
         // Look for an edge on the forward CH graph (.forward)
         EdgeID smaller_edge_id = facade.FindSmallestEdge(
             edge.first, edge.second, [](const EdgeData &data) { return data.forward; });
 
         // If we didn't find one there, the we might be looking at a part of the path that
-        // was found using the backward search.  Here, we flip the node order (.second, .first)
-        // and only consider edges with the `.backward` flag.
+        // was found using the backward search.  Here, we flip the node order (.second,
+        // .first) and only consider edges with the `.backward` flag.
         if (SPECIAL_EDGEID == smaller_edge_id)
         {
             smaller_edge_id = facade.FindSmallestEdge(
@@ -81,23 +74,79 @@ inline void UnpackCHPath(const DataFacadeT &facade,
         // called this function with bad values.
         BOOST_ASSERT_MSG(smaller_edge_id != SPECIAL_EDGEID, "Invalid smaller edge ID");
 
-        const auto &data = facade.GetEdgeData(smaller_edge_id);
+        const auto data = facade.GetEdgeData(smaller_edge_id);
         BOOST_ASSERT_MSG(data.weight != std::numeric_limits<EdgeWeight>::max(),
                          "edge weight invalid");
+        return data;
+    };
+
+    auto *cache = facade.GetShortcutUnpackingCache();
+    ShortcutUnpackingCache::OriginalEdges original_edges;
+
+    std::stack<std::pair<NodeID, NodeID>> recursion_stack;
+
+    // Every edge of the packed path is unpacked on its own, so its expansion can be cached.
+    for (auto current = packed_path_begin; std::next(current) != packed_path_end; ++current)
+    {
+        const std::pair<NodeID, NodeID> packed_edge{*current, *std::next(current)};
+        const auto packed_data = find_edge_data(packed_edge);
+
+        // original edges are never cached, don't bother the cache with them
+        if (!packed_data.shortcut)
+        {
+            auto edge = packed_edge;
+            std::forward<Callback>(callback)(edge, packed_data);
+            continue;
+        }
+
+        if (cache != nullptr)
+        {
+            if (const auto cached_edges = cache->Get(packed_edge.first, packed_edge.second))
+            {
+                for (const auto &original_edge : *cached_edges)
+                {
+                    auto edge = original_edge.nodes;
+                    std::forward<Callback>(callback)(edge, original_edge.data);
+                }
+                continue;
+            }
+            original_edges.clear();
+        }
+
+        // Note the order here - we're adding these to a stack, so we
+        // want the first->middle to get visited before middle->second
+        recursion_stack.emplace(packed_data.id, packed_edge.second);
+        recursion_stack.emplace(packed_edge.first, packed_data.id);
+
+        std::pair<NodeID, NodeID> edge;
+        while (!recursion_stack.empty())
+        {
+            edge = recursion_stack.top();
+            recursion_stack.pop();
+
+            const auto data = find_edge_data(edge);
 
-        // If the edge is a shortcut, we need to add the two halfs to the stack.
-        if (data.shortcut)
-        { // unpack
-            const NodeID middle_node_id = data.id;
-            // Note the order here - we're adding these to a stack, so we
-            // want the first->middle to get visited before middle->second
-            recursion_stack.emplace(middle_node_id, edge.second);
-            recursion_stack.emplace(edge.first, middle_node_id);
+            // If the edge is a shortcut, we need to add the two halfs to the stack.
+            if (data.shortcut)
+            { // unpack
+                const NodeID middle_node_id = data.id;
+                recursion_stack.emplace(middle_node_id, edge.second);
+                recursion_stack.emplace(edge.first, middle_node_id);
+            }
+            else
+            {
+                // We found an original edge, call our callback.
+                std::forward<Callback>(callback)(edge, data);
+                if (cache != nullptr)
+                {
+                    original_edges.push_back({edge, data});
+                }
+            }
         }
-        else
+
+        if (cache != nullptr)
         {
-            // We found an original edge, call our callback.
-            std::forward<Callback>(callback)(edge, data);
+            cache->Insert(packed_edge.first, packed_edge.second, std::move(original_edges));
         }
     }
 }
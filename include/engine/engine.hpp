@@ -1,13 +1,13 @@
 #ifndef ENGINE_HPP
 #define ENGINE_HPP
 
-#include "storage/shared_barriers.hpp"
 #include "engine/api/match_parameters.hpp"
 #include "engine/api/nearest_parameters.hpp"
 #include "engine/api/route_parameters.hpp"
 #include "engine/api/table_parameters.hpp"
 #include "engine/api/tile_parameters.hpp"
 #include "engine/api/trip_parameters.hpp"
+#include "engine/cancellation_token.hpp"
 #include "engine/data_watchdog.hpp"
 #include "engine/datafacade/datafacade_base.hpp"
 #include "engine/engine_config.hpp"
@@ -42,15 +42,27 @@ class Engine final
     Engine(const Engine &) = delete;
     Engine &operator=(const Engine &) = delete;
 
-    Status Route(const api::RouteParameters &parameters, util::json::Object &result) const;
-    Status Table(const api::TableParameters &parameters, util::json::Object &result) const;
-    Status Nearest(const api::NearestParameters &parameters, util::json::Object &result) const;
-    Status Trip(const api::TripParameters &parameters, util::json::Object &result) const;
-    Status Match(const api::MatchParameters &parameters, util::json::Object &result) const;
-    Status Tile(const api::TileParameters &parameters, std::string &result) const;
+    // The query is given up with Status::Timeout once the token is cancelled
+    Status Route(const api::RouteParameters &parameters,
+                 util::json::Object &result,
+                 const CancellationToken &token) const;
+    Status Table(const api::TableParameters &parameters,
+                 util::json::Object &result,
+                 const CancellationToken &token) const;
+    Status Nearest(const api::NearestParameters &parameters,
+                   util::json::Object &result,
+                   const CancellationToken &token) const;
+    Status Trip(const api::TripParameters &parameters,
+                util::json::Object &result,
+                const CancellationToken &token) const;
+    Status Match(const api::MatchParameters &parameters,
+                 util::json::Object &result,
+                 const CancellationToken &token) const;
+    Status Tile(const api::TileParameters &parameters,
+                std::string &result,
+                const CancellationToken &token) const;
 
   private:
-    std::unique_ptr<storage::SharedBarriers> lock;
     std::unique_ptr<DataWatchdog> watchdog;
 
     const plugins::ViaRoutePlugin route_plugin;
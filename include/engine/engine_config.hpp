@@ -32,6 +32,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <boost/filesystem/path.hpp>
 
+#include <cstddef>
 #include <string>
 
 namespace osrm
@@ -53,7 +54,21 @@ namespace engine
  *  - Match
  *  - Nearest
  *
- * In addition, shared memory can be used for datasets loaded with osrm-datastore.
+ * The Route service returns at most max_alternatives alternative routes (-1 for unlimited).
+ *
+ * In addition, shared memory can be used for datasets loaded with osrm-datastore, or a dataset
+ * file written by osrm-datastore --dataset can be mapped into memory (use_mmap).
+ *
+ * The original edges of long shortcuts are cached per dataset to speed up unpacking routes on
+ * busy corridors. shortcut_cache_size is the maximal number of cached original edges, each takes
+ * 16 bytes, 0 disables the cache.
+ *
+ * The phantom nodes of up to snapping_cache_size coordinates are cached per dataset, so
+ * coordinates that are requested repeatedly skip the rtree search, 0 disables the cache.
+ *
+ * With warmup_rtree the rtree leaves are read into RAM when a dataset is loaded instead of on
+ * demand by the first queries. With rtree_statistics the rtree leaf accesses and page faults of
+ * all queries are counted and logged when a dataset is unloaded.
  *
  * \see OSRM, StorageConfig
  */
@@ -67,7 +82,13 @@ struct EngineConfig final
     int max_locations_distance_table = -1;
     int max_locations_map_matching = -1;
     int max_results_nearest = -1;
+    int max_alternatives = 3;
     bool use_shared_memory = true;
+    bool use_mmap = false;
+    std::size_t shortcut_cache_size = 0;
+    std::size_t snapping_cache_size = 0;
+    bool warmup_rtree = false;
+    bool rtree_statistics = false;
 };
 }
 }
@@ -1,7 +1,9 @@
 #ifndef GEOSPATIAL_QUERY_HPP
 #define GEOSPATIAL_QUERY_HPP
 
+#include "engine/bearing.hpp"
 #include "engine/phantom_node.hpp"
+#include "engine/snapping_cache.hpp"
 #include "util/bearing.hpp"
 #include "util/coordinate_calculation.hpp"
 #include "util/rectangle.hpp"
@@ -10,9 +12,12 @@
 
 #include "osrm/coordinate.hpp"
 
+#include <boost/optional.hpp>
+
 #include <algorithm>
 #include <cmath>
 #include <memory>
+#include <utility>
 #include <vector>
 
 namespace osrm
@@ -27,6 +32,7 @@ inline std::pair<bool, bool> boolPairAnd(const std::pair<bool, bool> &A,
 }
 
 // Implements complex queries on top of an RTree and builds PhantomNodes from it.
+// The results of the nearest queries can be cached per coordinate, see SnappingCache.
 //
 // Only holds a weak reference on the RTree and coordinates!
 template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
@@ -41,6 +47,14 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
     {
     }
 
+    // Caches the results of up to `capacity` nearest queries, 0 disables the cache
+    void SetSnappingCacheSize(const std::size_t capacity)
+    {
+        snapping_cache.reset(capacity > 0 ? new SnappingCache(capacity) : nullptr);
+    }
+
+    const SnappingCache *GetSnappingCache() const { return snapping_cache.get(); }
+
     std::vector<EdgeData> Search(const util::RectangleInt2D &bbox)
     {
         return rtree.SearchInBox(bbox);
@@ -52,6 +66,14 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
     NearestPhantomNodesInRange(const util::Coordinate input_coordinate,
                                const double max_distance) const
     {
+        SnappingCache::Key key{input_coordinate, SnappingCache::QueryType::NearestInRange};
+        key.max_distance = max_distance;
+        std::vector<PhantomNodeWithDistance> phantom_nodes;
+        if (LookUp(key, phantom_nodes))
+        {
+            return phantom_nodes;
+        }
+
         auto results =
             rtree.Nearest(input_coordinate,
                           [this](const CandidateSegment &segment) { return HasValidEdge(segment); },
@@ -60,7 +82,7 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                               return CheckSegmentDistance(input_coordinate, segment, max_distance);
                           });
 
-        return MakePhantomNodes(input_coordinate, results);
+        return Store(key, MakePhantomNodes(input_coordinate, results));
     }
 
     // Returns nearest PhantomNodes in the given bearing range within max_distance.
@@ -71,6 +93,15 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                                const int bearing,
                                const int bearing_range) const
     {
+        SnappingCache::Key key{input_coordinate, SnappingCache::QueryType::NearestInRange};
+        key.max_distance = max_distance;
+        key.bearing = std::make_pair(bearing, bearing_range);
+        std::vector<PhantomNodeWithDistance> phantom_nodes;
+        if (LookUp(key, phantom_nodes))
+        {
+            return phantom_nodes;
+        }
+
         auto results = rtree.Nearest(
             input_coordinate,
             [this, bearing, bearing_range, max_distance](const CandidateSegment &segment) {
@@ -82,7 +113,7 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                 return CheckSegmentDistance(input_coordinate, segment, max_distance);
             });
 
-        return MakePhantomNodes(input_coordinate, results);
+        return Store(key, MakePhantomNodes(input_coordinate, results));
     }
 
     // Returns max_results nearest PhantomNodes in the given bearing range.
@@ -93,6 +124,15 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                         const int bearing,
                         const int bearing_range) const
     {
+        SnappingCache::Key key{input_coordinate, SnappingCache::QueryType::Nearest};
+        key.max_results = max_results;
+        key.bearing = std::make_pair(bearing, bearing_range);
+        std::vector<PhantomNodeWithDistance> phantom_nodes;
+        if (LookUp(key, phantom_nodes))
+        {
+            return phantom_nodes;
+        }
+
         auto results = rtree.Nearest(
             input_coordinate,
             [this, bearing, bearing_range](const CandidateSegment &segment) {
@@ -103,7 +143,7 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                 return num_results >= max_results;
             });
 
-        return MakePhantomNodes(input_coordinate, results);
+        return Store(key, MakePhantomNodes(input_coordinate, results));
     }
 
     // Returns max_results nearest PhantomNodes in the given bearing range within the maximum
@@ -116,6 +156,16 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                         const int bearing,
                         const int bearing_range) const
     {
+        SnappingCache::Key key{input_coordinate, SnappingCache::QueryType::Nearest};
+        key.max_results = max_results;
+        key.max_distance = max_distance;
+        key.bearing = std::make_pair(bearing, bearing_range);
+        std::vector<PhantomNodeWithDistance> phantom_nodes;
+        if (LookUp(key, phantom_nodes))
+        {
+            return phantom_nodes;
+        }
+
         auto results = rtree.Nearest(
             input_coordinate,
             [this, bearing, bearing_range](const CandidateSegment &segment) {
@@ -128,7 +178,7 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                        CheckSegmentDistance(input_coordinate, segment, max_distance);
             });
 
-        return MakePhantomNodes(input_coordinate, results);
+        return Store(key, MakePhantomNodes(input_coordinate, results));
     }
 
     // Returns max_results nearest PhantomNodes.
@@ -136,6 +186,14 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
     std::vector<PhantomNodeWithDistance>
     NearestPhantomNodes(const util::Coordinate input_coordinate, const unsigned max_results) const
     {
+        SnappingCache::Key key{input_coordinate, SnappingCache::QueryType::Nearest};
+        key.max_results = max_results;
+        std::vector<PhantomNodeWithDistance> phantom_nodes;
+        if (LookUp(key, phantom_nodes))
+        {
+            return phantom_nodes;
+        }
+
         auto results =
             rtree.Nearest(input_coordinate,
                           [this](const CandidateSegment &segment) { return HasValidEdge(segment); },
@@ -143,7 +201,7 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                               return num_results >= max_results;
                           });
 
-        return MakePhantomNodes(input_coordinate, results);
+        return Store(key, MakePhantomNodes(input_coordinate, results));
     }
 
     // Returns max_results nearest PhantomNodes in the given max distance.
@@ -153,6 +211,15 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                         const unsigned max_results,
                         const double max_distance) const
     {
+        SnappingCache::Key key{input_coordinate, SnappingCache::QueryType::Nearest};
+        key.max_results = max_results;
+        key.max_distance = max_distance;
+        std::vector<PhantomNodeWithDistance> phantom_nodes;
+        if (LookUp(key, phantom_nodes))
+        {
+            return phantom_nodes;
+        }
+
         auto results =
             rtree.Nearest(input_coordinate,
                           [this](const CandidateSegment &segment) { return HasValidEdge(segment); },
@@ -162,18 +229,117 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
                                      CheckSegmentDistance(input_coordinate, segment, max_distance);
                           });
 
-        return MakePhantomNodes(input_coordinate, results);
+        return Store(key, MakePhantomNodes(input_coordinate, results));
+    }
+
+    // Returns the nearest phantom node. If this phantom node is not from a big component
+    // a second phantom node is return that is the nearest coordinate in a big component.
+    std::pair<PhantomNode, PhantomNode>
+    NearestPhantomNodeWithAlternativeFromBigComponent(const util::Coordinate input_coordinate,
+                                                      const double max_distance) const
+    {
+        return NearestPhantomNodeWithAlternativeFromBigComponent(
+            rtree, input_coordinate, max_distance);
+    }
+
+    // Returns the nearest phantom node. If this phantom node is not from a big component
+    // a second phantom node is return that is the nearest coordinate in a big component.
+    std::pair<PhantomNode, PhantomNode>
+    NearestPhantomNodeWithAlternativeFromBigComponent(const util::Coordinate input_coordinate) const
+    {
+        return NearestPhantomNodeWithAlternativeFromBigComponent(rtree, input_coordinate);
+    }
+
+    // Returns the nearest phantom node. If this phantom node is not from a big component
+    // a second phantom node is return that is the nearest coordinate in a big component.
+    std::pair<PhantomNode, PhantomNode> NearestPhantomNodeWithAlternativeFromBigComponent(
+        const util::Coordinate input_coordinate, const int bearing, const int bearing_range) const
+    {
+        return NearestPhantomNodeWithAlternativeFromBigComponent(
+            rtree, input_coordinate, bearing, bearing_range);
     }
 
     // Returns the nearest phantom node. If this phantom node is not from a big component
     // a second phantom node is return that is the nearest coordinate in a big component.
     std::pair<PhantomNode, PhantomNode>
     NearestPhantomNodeWithAlternativeFromBigComponent(const util::Coordinate input_coordinate,
+                                                      const double max_distance,
+                                                      const int bearing,
+                                                      const int bearing_range) const
+    {
+        return NearestPhantomNodeWithAlternativeFromBigComponent(
+            rtree, input_coordinate, max_distance, bearing, bearing_range);
+    }
+
+    // Runs NearestPhantomNodeWithAlternativeFromBigComponent for all coordinates with their
+    // radius and bearing, if given. Both may be empty or have to contain an optional value per
+    // coordinate. Nearby coordinates are snapped together and share the rtree leaves they visit.
+    std::vector<std::pair<PhantomNode, PhantomNode>>
+    NearestPhantomNodesWithAlternativeFromBigComponent(
+        const std::vector<util::Coordinate> &input_coordinates,
+        const std::vector<boost::optional<double>> &max_distances,
+        const std::vector<boost::optional<Bearing>> &bearings) const
+    {
+        BOOST_ASSERT(max_distances.empty() || max_distances.size() == input_coordinates.size());
+        BOOST_ASSERT(bearings.empty() || bearings.size() == input_coordinates.size());
+
+        std::vector<std::pair<PhantomNode, PhantomNode>> phantom_node_pairs(
+            input_coordinates.size());
+        const auto snap = [&](const std::size_t index, typename RTreeT::NearestBatch &batch) {
+            const auto &coordinate = input_coordinates[index];
+            const bool has_distance = !max_distances.empty() && max_distances[index];
+            const bool has_bearing = !bearings.empty() && bearings[index];
+            auto &phantom_node_pair = phantom_node_pairs[index];
+            if (has_bearing && has_distance)
+            {
+                phantom_node_pair =
+                    NearestPhantomNodeWithAlternativeFromBigComponent(batch,
+                                                                      coordinate,
+                                                                      *max_distances[index],
+                                                                      bearings[index]->bearing,
+                                                                      bearings[index]->range);
+            }
+            else if (has_bearing)
+            {
+                phantom_node_pair = NearestPhantomNodeWithAlternativeFromBigComponent(
+                    batch, coordinate, bearings[index]->bearing, bearings[index]->range);
+            }
+            else if (has_distance)
+            {
+                phantom_node_pair = NearestPhantomNodeWithAlternativeFromBigComponent(
+                    batch, coordinate, *max_distances[index]);
+            }
+            else
+            {
+                phantom_node_pair =
+                    NearestPhantomNodeWithAlternativeFromBigComponent(batch, coordinate);
+            }
+        };
+        rtree.Nearest(input_coordinates, snap);
+
+        return phantom_node_pairs;
+    }
+
+  private:
+    // Implementations of NearestPhantomNodeWithAlternativeFromBigComponent, `search` is the
+    // rtree or a NearestBatch of it
+    template <typename SearchT>
+    std::pair<PhantomNode, PhantomNode>
+    NearestPhantomNodeWithAlternativeFromBigComponent(SearchT &search,
+                                                      const util::Coordinate input_coordinate,
                                                       const double max_distance) const
     {
+        SnappingCache::Key key{input_coordinate, SnappingCache::QueryType::NearestWithAlternative};
+        key.max_distance = max_distance;
+        std::pair<PhantomNode, PhantomNode> phantom_nodes;
+        if (LookUp(key, phantom_nodes))
+        {
+            return phantom_nodes;
+        }
+
         bool has_small_component = false;
         bool has_big_component = false;
-        auto results = rtree.Nearest(
+        auto results = search.Nearest(
             input_coordinate,
             [this, &has_big_component, &has_small_component](const CandidateSegment &segment) {
                 auto use_segment = (!has_small_component ||
@@ -197,22 +363,31 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
 
         if (results.size() == 0)
         {
-            return std::make_pair(PhantomNode{}, PhantomNode{});
+            return Store(key, std::make_pair(PhantomNode{}, PhantomNode{}));
         }
 
         BOOST_ASSERT(results.size() == 1 || results.size() == 2);
-        return std::make_pair(MakePhantomNode(input_coordinate, results.front()).phantom_node,
-                              MakePhantomNode(input_coordinate, results.back()).phantom_node);
+        return Store(key,
+                     std::make_pair(MakePhantomNode(input_coordinate, results.front()).phantom_node,
+                                    MakePhantomNode(input_coordinate, results.back())
+                                        .phantom_node));
     }
 
-    // Returns the nearest phantom node. If this phantom node is not from a big component
-    // a second phantom node is return that is the nearest coordinate in a big component.
+    template <typename SearchT>
     std::pair<PhantomNode, PhantomNode>
-    NearestPhantomNodeWithAlternativeFromBigComponent(const util::Coordinate input_coordinate) const
+    NearestPhantomNodeWithAlternativeFromBigComponent(SearchT &search,
+                                                      const util::Coordinate input_coordinate) const
     {
+        SnappingCache::Key key{input_coordinate, SnappingCache::QueryType::NearestWithAlternative};
+        std::pair<PhantomNode, PhantomNode> phantom_nodes;
+        if (LookUp(key, phantom_nodes))
+        {
+            return phantom_nodes;
+        }
+
         bool has_small_component = false;
         bool has_big_component = false;
-        auto results = rtree.Nearest(
+        auto results = search.Nearest(
             input_coordinate,
             [this, &has_big_component, &has_small_component](const CandidateSegment &segment) {
                 auto use_segment = (!has_small_component ||
@@ -238,22 +413,34 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
 
         if (results.size() == 0)
         {
-            return std::make_pair(PhantomNode{}, PhantomNode{});
+            return Store(key, std::make_pair(PhantomNode{}, PhantomNode{}));
         }
 
         BOOST_ASSERT(results.size() == 1 || results.size() == 2);
-        return std::make_pair(MakePhantomNode(input_coordinate, results.front()).phantom_node,
-                              MakePhantomNode(input_coordinate, results.back()).phantom_node);
+        return Store(key,
+                     std::make_pair(MakePhantomNode(input_coordinate, results.front()).phantom_node,
+                                    MakePhantomNode(input_coordinate, results.back())
+                                        .phantom_node));
     }
 
-    // Returns the nearest phantom node. If this phantom node is not from a big component
-    // a second phantom node is return that is the nearest coordinate in a big component.
-    std::pair<PhantomNode, PhantomNode> NearestPhantomNodeWithAlternativeFromBigComponent(
-        const util::Coordinate input_coordinate, const int bearing, const int bearing_range) const
+    template <typename SearchT>
+    std::pair<PhantomNode, PhantomNode>
+    NearestPhantomNodeWithAlternativeFromBigComponent(SearchT &search,
+                                                      const util::Coordinate input_coordinate,
+                                                      const int bearing,
+                                                      const int bearing_range) const
     {
+        SnappingCache::Key key{input_coordinate, SnappingCache::QueryType::NearestWithAlternative};
+        key.bearing = std::make_pair(bearing, bearing_range);
+        std::pair<PhantomNode, PhantomNode> phantom_nodes;
+        if (LookUp(key, phantom_nodes))
+        {
+            return phantom_nodes;
+        }
+
         bool has_small_component = false;
         bool has_big_component = false;
-        auto results = rtree.Nearest(
+        auto results = search.Nearest(
             input_coordinate,
             [this, bearing, bearing_range, &has_big_component, &has_small_component](
                 const CandidateSegment &segment) {
@@ -282,25 +469,36 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
 
         if (results.size() == 0)
         {
-            return std::make_pair(PhantomNode{}, PhantomNode{});
+            return Store(key, std::make_pair(PhantomNode{}, PhantomNode{}));
         }
 
         BOOST_ASSERT(results.size() > 0);
-        return std::make_pair(MakePhantomNode(input_coordinate, results.front()).phantom_node,
-                              MakePhantomNode(input_coordinate, results.back()).phantom_node);
+        return Store(key,
+                     std::make_pair(MakePhantomNode(input_coordinate, results.front()).phantom_node,
+                                    MakePhantomNode(input_coordinate, results.back())
+                                        .phantom_node));
     }
 
-    // Returns the nearest phantom node. If this phantom node is not from a big component
-    // a second phantom node is return that is the nearest coordinate in a big component.
+    template <typename SearchT>
     std::pair<PhantomNode, PhantomNode>
-    NearestPhantomNodeWithAlternativeFromBigComponent(const util::Coordinate input_coordinate,
+    NearestPhantomNodeWithAlternativeFromBigComponent(SearchT &search,
+                                                      const util::Coordinate input_coordinate,
                                                       const double max_distance,
                                                       const int bearing,
                                                       const int bearing_range) const
     {
+        SnappingCache::Key key{input_coordinate, SnappingCache::QueryType::NearestWithAlternative};
+        key.max_distance = max_distance;
+        key.bearing = std::make_pair(bearing, bearing_range);
+        std::pair<PhantomNode, PhantomNode> phantom_nodes;
+        if (LookUp(key, phantom_nodes))
+        {
+            return phantom_nodes;
+        }
+
         bool has_small_component = false;
         bool has_big_component = false;
-        auto results = rtree.Nearest(
+        auto results = search.Nearest(
             input_coordinate,
             [this, bearing, bearing_range, &has_big_component, &has_small_component](
                 const CandidateSegment &segment) {
@@ -331,15 +529,61 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
 
         if (results.size() == 0)
         {
-            return std::make_pair(PhantomNode{}, PhantomNode{});
+            return Store(key, std::make_pair(PhantomNode{}, PhantomNode{}));
         }
 
         BOOST_ASSERT(results.size() > 0);
-        return std::make_pair(MakePhantomNode(input_coordinate, results.front()).phantom_node,
-                              MakePhantomNode(input_coordinate, results.back()).phantom_node);
+        return Store(key,
+                     std::make_pair(MakePhantomNode(input_coordinate, results.front()).phantom_node,
+                                    MakePhantomNode(input_coordinate, results.back())
+                                        .phantom_node));
+    }
+
+    bool LookUp(const SnappingCache::Key &key,
+                std::vector<PhantomNodeWithDistance> &phantom_nodes) const
+    {
+        const auto cached = snapping_cache ? snapping_cache->Get(key) : nullptr;
+        if (!cached)
+        {
+            return false;
+        }
+        phantom_nodes = *cached;
+        return true;
+    }
+
+    bool LookUp(const SnappingCache::Key &key,
+                std::pair<PhantomNode, PhantomNode> &phantom_nodes) const
+    {
+        const auto cached = snapping_cache ? snapping_cache->Get(key) : nullptr;
+        if (!cached)
+        {
+            return false;
+        }
+        BOOST_ASSERT(cached->size() == 2);
+        phantom_nodes = std::make_pair(cached->front().phantom_node, cached->back().phantom_node);
+        return true;
+    }
+
+    std::vector<PhantomNodeWithDistance>
+    Store(const SnappingCache::Key &key, std::vector<PhantomNodeWithDistance> phantom_nodes) const
+    {
+        if (snapping_cache)
+        {
+            snapping_cache->Insert(key, phantom_nodes);
+        }
+        return phantom_nodes;
+    }
+
+    std::pair<PhantomNode, PhantomNode>
+    Store(const SnappingCache::Key &key, std::pair<PhantomNode, PhantomNode> phantom_nodes) const
+    {
+        if (snapping_cache)
+        {
+            snapping_cache->Insert(key, {{phantom_nodes.first, 0.}, {phantom_nodes.second, 0.}});
+        }
+        return phantom_nodes;
     }
 
-  private:
     std::vector<PhantomNodeWithDistance>
     MakePhantomNodes(const util::Coordinate input_coordinate,
                      const std::vector<EdgeData> &results) const
@@ -493,6 +737,7 @@ template <typename RTreeT, typename DataFacadeT> class GeospatialQuery
     const RTreeT &rtree;
     const CoordinateList &coordinates;
     DataFacadeT &datafacade;
+    std::unique_ptr<SnappingCache> snapping_cache;
 };
 }
 }
@@ -56,6 +56,12 @@ struct Hint
     bool IsValid(const util::Coordinate new_input_coordinates,
                  const datafacade::BaseDataFacade &facade) const;
 
+    // Same as above for the dataset with `checksum` and `number_of_nodes`, so many hints can be
+    // validated without calling into the facade for each of them
+    bool IsValid(const util::Coordinate new_input_coordinates,
+                 const std::uint32_t checksum,
+                 const unsigned number_of_nodes) const;
+
     std::string ToBase64() const;
     static Hint FromBase64(const std::string &base64Hint);
 
@@ -0,0 +1,55 @@
+#ifndef OSRM_ENGINE_HINT_STATISTICS_HPP
+#define OSRM_ENGINE_HINT_STATISTICS_HPP
+
+#include <atomic>
+#include <cstdint>
+
+namespace osrm
+{
+namespace engine
+{
+
+/**
+ * Counts over all queries of the process how many coordinates were snapped with the phantom
+ * node of their hint, how many came with a hint that was not valid for the loaded dataset, e.g.
+ * after a data update, and how many had no hint at all. The counters are updated once per
+ * query, not per coordinate.
+ */
+class HintStatistics
+{
+  public:
+    static HintStatistics &GetInstance();
+
+    HintStatistics(const HintStatistics &) = delete;
+    HintStatistics &operator=(const HintStatistics &) = delete;
+
+    void Count(const std::uint64_t valid_hints,
+               const std::uint64_t invalid_hints,
+               const std::uint64_t missing_hints)
+    {
+        valid.fetch_add(valid_hints, std::memory_order_relaxed);
+        invalid.fetch_add(invalid_hints, std::memory_order_relaxed);
+        missing.fetch_add(missing_hints, std::memory_order_relaxed);
+    }
+
+    std::uint64_t GetNumberOfValidHints() const { return valid.load(std::memory_order_relaxed); }
+    std::uint64_t GetNumberOfInvalidHints() const
+    {
+        return invalid.load(std::memory_order_relaxed);
+    }
+    std::uint64_t GetNumberOfMissingHints() const
+    {
+        return missing.load(std::memory_order_relaxed);
+    }
+
+  private:
+    HintStatistics() = default;
+
+    std::atomic<std::uint64_t> valid{0};
+    std::atomic<std::uint64_t> invalid{0};
+    std::atomic<std::uint64_t> missing{0};
+};
+}
+}
+
+#endif
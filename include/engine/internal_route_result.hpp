@@ -47,28 +47,26 @@ struct PathData
 struct InternalRouteResult
 {
     std::vector<std::vector<PathData>> unpacked_path_segments;
-    std::vector<PathData> unpacked_alternative;
+    // alternatives are only computed for routes with a single leg
+    std::vector<std::vector<PathData>> unpacked_alternatives;
     std::vector<PhantomNodes> segment_end_coordinates;
     std::vector<bool> source_traversed_in_reverse;
     std::vector<bool> target_traversed_in_reverse;
     std::vector<bool> alt_source_traversed_in_reverse;
     std::vector<bool> alt_target_traversed_in_reverse;
+    std::vector<int> alternative_path_lengths;
     int shortest_path_length;
-    int alternative_path_length;
 
     bool is_valid() const { return INVALID_EDGE_WEIGHT != shortest_path_length; }
 
-    bool has_alternative() const { return INVALID_EDGE_WEIGHT != alternative_path_length; }
+    bool has_alternative() const { return !alternative_path_lengths.empty(); }
 
     bool is_via_leg(const std::size_t leg) const
     {
         return (leg != unpacked_path_segments.size() - 1);
     }
 
-    InternalRouteResult()
-        : shortest_path_length(INVALID_EDGE_WEIGHT), alternative_path_length(INVALID_EDGE_WEIGHT)
-    {
-    }
+    InternalRouteResult() : shortest_path_length(INVALID_EDGE_WEIGHT) {}
 };
 }
 }
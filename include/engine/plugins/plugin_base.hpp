@@ -3,6 +3,7 @@
 
 #include "engine/api/base_parameters.hpp"
 #include "engine/datafacade/datafacade_base.hpp"
+#include "engine/hint_statistics.hpp"
 #include "engine/phantom_node.hpp"
 #include "engine/status.hpp"
 
@@ -12,8 +13,10 @@
 #include "util/json_container.hpp"
 
 #include <algorithm>
+#include <cstdint>
 #include <iterator>
 #include <string>
+#include <utility>
 #include <vector>
 
 namespace osrm
@@ -106,6 +109,39 @@ class BasePlugin
         return snapped_phantoms;
     }
 
+    // Marks the coordinates whose hint is valid for the loaded dataset, they take the phantom node
+    // of the hint and are never looked up in the rtree. The facade is asked once for all hints.
+    std::vector<bool> GetValidHints(const datafacade::BaseDataFacade &facade,
+                                    const api::BaseParameters &parameters) const
+    {
+        std::vector<bool> valid_hints(parameters.coordinates.size(), false);
+        std::uint64_t number_of_valid_hints = 0;
+        std::uint64_t number_of_invalid_hints = 0;
+
+        if (!parameters.hints.empty())
+        {
+            BOOST_ASSERT(parameters.hints.size() == parameters.coordinates.size());
+            const auto checksum = facade.GetCheckSum();
+            const auto number_of_nodes = facade.GetNumberOfNodes();
+            for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
+            {
+                if (!parameters.hints[i])
+                {
+                    continue;
+                }
+                valid_hints[i] = parameters.hints[i]->IsValid(
+                    parameters.coordinates[i], checksum, number_of_nodes);
+                ++(valid_hints[i] ? number_of_valid_hints : number_of_invalid_hints);
+            }
+        }
+
+        HintStatistics::GetInstance().Count(number_of_valid_hints,
+                                            number_of_invalid_hints,
+                                            parameters.coordinates.size() - number_of_valid_hints -
+                                                number_of_invalid_hints);
+        return valid_hints;
+    }
+
     // Falls back to default_radius for non-set radii
     std::vector<std::vector<PhantomNodeWithDistance>>
     GetPhantomNodesInRange(const datafacade::BaseDataFacade &facade,
@@ -116,13 +152,12 @@ class BasePlugin
             parameters.coordinates.size());
         BOOST_ASSERT(radiuses.size() == parameters.coordinates.size());
 
-        const bool use_hints = !parameters.hints.empty();
+        const auto valid_hints = GetValidHints(facade, parameters);
         const bool use_bearings = !parameters.bearings.empty();
 
         for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
         {
-            if (use_hints && parameters.hints[i] &&
-                parameters.hints[i]->IsValid(parameters.coordinates[i], facade))
+            if (valid_hints[i])
             {
                 phantom_nodes[i].push_back(PhantomNodeWithDistance{
                     parameters.hints[i]->phantom,
@@ -157,15 +192,14 @@ class BasePlugin
         std::vector<std::vector<PhantomNodeWithDistance>> phantom_nodes(
             parameters.coordinates.size());
 
-        const bool use_hints = !parameters.hints.empty();
         const bool use_bearings = !parameters.bearings.empty();
         const bool use_radiuses = !parameters.radiuses.empty();
 
         BOOST_ASSERT(parameters.IsValid());
+        const auto valid_hints = GetValidHints(facade, parameters);
         for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
         {
-            if (use_hints && parameters.hints[i] &&
-                parameters.hints[i]->IsValid(parameters.coordinates[i], facade))
+            if (valid_hints[i])
             {
                 phantom_nodes[i].push_back(PhantomNodeWithDistance{
                     parameters.hints[i]->phantom,
@@ -221,57 +255,49 @@ class BasePlugin
     {
         std::vector<PhantomNodePair> phantom_node_pairs(parameters.coordinates.size());
 
-        const bool use_hints = !parameters.hints.empty();
         const bool use_bearings = !parameters.bearings.empty();
         const bool use_radiuses = !parameters.radiuses.empty();
 
         BOOST_ASSERT(parameters.IsValid());
+        const auto valid_hints = GetValidHints(facade, parameters);
+
+        // coordinates without a valid hint are snapped together in one batch
+        std::vector<std::size_t> snapped_indices;
+        std::vector<util::Coordinate> coordinates;
+        std::vector<boost::optional<double>> radiuses;
+        std::vector<boost::optional<Bearing>> bearings;
         for (const auto i : util::irange<std::size_t>(0UL, parameters.coordinates.size()))
         {
-            if (use_hints && parameters.hints[i] &&
-                parameters.hints[i]->IsValid(parameters.coordinates[i], facade))
+            if (valid_hints[i])
             {
                 phantom_node_pairs[i].first = parameters.hints[i]->phantom;
                 // we don't set the second one - it will be marked as invalid
                 continue;
             }
 
-            if (use_bearings && parameters.bearings[i])
+            snapped_indices.push_back(i);
+            coordinates.push_back(parameters.coordinates[i]);
+            if (use_radiuses)
             {
-                if (use_radiuses && parameters.radiuses[i])
-                {
-                    phantom_node_pairs[i] =
-                        facade.NearestPhantomNodeWithAlternativeFromBigComponent(
-                            parameters.coordinates[i],
-                            *parameters.radiuses[i],
-                            parameters.bearings[i]->bearing,
-                            parameters.bearings[i]->range);
-                }
-                else
-                {
-                    phantom_node_pairs[i] =
-                        facade.NearestPhantomNodeWithAlternativeFromBigComponent(
-                            parameters.coordinates[i],
-                            parameters.bearings[i]->bearing,
-                            parameters.bearings[i]->range);
-                }
+                radiuses.push_back(parameters.radiuses[i]);
             }
-            else
+            if (use_bearings)
             {
-                if (use_radiuses && parameters.radiuses[i])
-                {
-                    phantom_node_pairs[i] =
-                        facade.NearestPhantomNodeWithAlternativeFromBigComponent(
-                            parameters.coordinates[i], *parameters.radiuses[i]);
-                }
-                else
-                {
-                    phantom_node_pairs[i] =
-                        facade.NearestPhantomNodeWithAlternativeFromBigComponent(
-                            parameters.coordinates[i]);
-                }
+                bearings.push_back(parameters.bearings[i]);
             }
+        }
 
+        auto snapped_phantom_node_pairs =
+            facade.NearestPhantomNodesWithAlternativeFromBigComponent(
+                coordinates, radiuses, bearings);
+        BOOST_ASSERT(snapped_phantom_node_pairs.size() == snapped_indices.size());
+        for (const auto i : util::irange<std::size_t>(0UL, snapped_indices.size()))
+        {
+            phantom_node_pairs[snapped_indices[i]] = std::move(snapped_phantom_node_pairs[i]);
+        }
+
+        for (const auto i : snapped_indices)
+        {
             // we didn't find a fitting node, return error
             if (!phantom_node_pairs[i].first.IsValid(facade.GetNumberOfNodes()))
             {
@@ -34,9 +34,10 @@ class ViaRoutePlugin final : public BasePlugin
     mutable routing_algorithms::DirectShortestPathRouting<datafacade::BaseDataFacade>
         direct_shortest_path;
     const int max_locations_viaroute;
+    const int max_alternatives;
 
   public:
-    explicit ViaRoutePlugin(int max_locations_viaroute);
+    explicit ViaRoutePlugin(int max_locations_viaroute, int max_alternatives);
 
     Status HandleRequest(const std::shared_ptr<datafacade::BaseDataFacade> facade,
                          const api::RouteParameters &route_parameters,
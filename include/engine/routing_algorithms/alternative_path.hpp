@@ -1,17 +1,23 @@
 #ifndef ALTERNATIVE_PATH_ROUTING_HPP
 #define ALTERNATIVE_PATH_ROUTING_HPP
 
+#include "engine/cancellation_token.hpp"
+#include "engine/edge_unpacker.hpp"
 #include "engine/routing_algorithms/routing_base.hpp"
 #include "engine/search_engine_data.hpp"
 #include "util/integer_range.hpp"
 
 #include <boost/assert.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <algorithm>
+#include <cstddef>
 #include <iterator>
 #include <unordered_map>
 #include <unordered_set>
-
+#include <utility>
 #include <vector>
 
 namespace osrm
@@ -24,6 +30,8 @@ namespace routing_algorithms
 const double VIAPATH_ALPHA = 0.10;
 const double VIAPATH_EPSILON = 0.15; // alternative at most 15% longer
 const double VIAPATH_GAMMA = 0.75;   // alternative shares at most 75% with the shortest.
+// number of via node candidates that are verified concurrently
+const std::size_t VIAPATH_T_TEST_BATCH_SIZE = 8;
 
 template <class DataFacadeT>
 class AlternativeRouting final
@@ -50,6 +58,18 @@ class AlternativeRouting final
             return (2 * length + sharing) < (2 * other.length + other.sharing);
         }
     };
+
+    // A via node candidate and the result of its T-test
+    struct ViaPath
+    {
+        explicit ViaPath(const NodeID node) : node(node) {}
+
+        NodeID node;
+        bool passes_t_test = false;
+        int length = INVALID_EDGE_WEIGHT;
+        std::vector<NodeID> packed_path;
+    };
+
     SearchEngineData &engine_working_data;
 
   public:
@@ -60,8 +80,11 @@ class AlternativeRouting final
 
     virtual ~AlternativeRouting() {}
 
+    // Computes the shortest path and up to `number_of_alternatives` alternatives, all via nodes
+    // are taken from the same forward and reverse search.
     void operator()(const DataFacadeT &facade,
                     const PhantomNodes &phantom_node_pair,
+                    const unsigned number_of_alternatives,
                     InternalRouteResult &raw_route_data)
     {
         std::vector<NodeID> alternative_path;
@@ -76,8 +99,6 @@ class AlternativeRouting final
 
         QueryHeap &forward_heap1 = *(engine_working_data.forward_heap_1);
         QueryHeap &reverse_heap1 = *(engine_working_data.reverse_heap_1);
-        QueryHeap &forward_heap2 = *(engine_working_data.forward_heap_2);
-        QueryHeap &reverse_heap2 = *(engine_working_data.reverse_heap_2);
 
         int upper_bound_to_shortest_path_weight = INVALID_EDGE_WEIGHT;
         NodeID middle_node = SPECIAL_NODEID;
@@ -124,8 +145,10 @@ class AlternativeRouting final
         }
 
         // search from s and t till new_min/(1+epsilon) > length_of_shortest_path
+        const CancellationCheck check_cancellation;
         while (0 < (forward_heap1.Size() + reverse_heap1.Size()))
         {
+            check_cancellation();
             if (0 < forward_heap1.Size())
             {
                 AlternativeRoutingStep<true>(facade,
@@ -301,30 +324,124 @@ class AlternativeRouting final
         }
         std::sort(ranked_candidates_list.begin(), ranked_candidates_list.end());
 
-        NodeID selected_via_node = SPECIAL_NODEID;
-        int length_of_via_path = INVALID_EDGE_WEIGHT;
-        NodeID s_v_middle = SPECIAL_NODEID, v_t_middle = SPECIAL_NODEID;
-        for (const RankedCandidateNode &candidate : ranked_candidates_list)
-        {
-            if (ViaNodeCandidatePassesTTest(facade,
-                                            forward_heap1,
-                                            reverse_heap1,
-                                            forward_heap2,
-                                            reverse_heap2,
-                                            candidate,
-                                            upper_bound_to_shortest_path_weight,
-                                            &length_of_via_path,
-                                            &s_v_middle,
-                                            &v_t_middle,
-                                            min_edge_offset))
+        // Select the best ranked candidates that pass the T-test. Different via nodes often lead
+        // to the same path, so candidates on a selected alternative are skipped and every new
+        // alternative may share at most VIAPATH_GAMMA with each of the selected ones.
+        const int maximum_allowed_sharing =
+            static_cast<int>(upper_bound_to_shortest_path_weight * VIAPATH_GAMMA);
+        std::vector<std::vector<NodeID>> packed_alternate_paths;
+        std::vector<int> alternate_path_lengths;
+        std::vector<std::unordered_map<NodeID, EdgeWeight>> alternate_path_edges;
+        const auto is_on_selected_path = [&alternate_path_edges](const NodeID node) {
+            return std::any_of(alternate_path_edges.begin(),
+                               alternate_path_edges.end(),
+                               [node](const std::unordered_map<NodeID, EdgeWeight> &edges) {
+                                   return edges.count(node) > 0;
+                               });
+        };
+
+        // The T-tests only read the heaps of the first search, so a batch of candidates is tested
+        // concurrently with thread local second and third heaps. The results are evaluated in
+        // rank order and no further batch is tested once enough alternatives are selected.
+        for (std::size_t batch_begin = 0; batch_begin < ranked_candidates_list.size() &&
+                                          packed_alternate_paths.size() < number_of_alternatives;
+             batch_begin += VIAPATH_T_TEST_BATCH_SIZE)
+        {
+            // the threads running the T-tests don't check the cancellation token themselves
+            CancellationScope::Check();
+
+            const auto batch_end = std::min(batch_begin + VIAPATH_T_TEST_BATCH_SIZE,
+                                            ranked_candidates_list.size());
+
+            std::vector<ViaPath> batch;
+            for (const auto index : util::irange(batch_begin, batch_end))
             {
-                // select first admissable
-                selected_via_node = candidate.node;
-                break;
+                if (!is_on_selected_path(ranked_candidates_list[index].node))
+                {
+                    batch.emplace_back(ranked_candidates_list[index].node);
+                }
+            }
+
+            tbb::parallel_for(
+                tbb::blocked_range<std::size_t>(0, batch.size(), 1),
+                [&](const tbb::blocked_range<std::size_t> &range) {
+                    engine_working_data.InitializeOrClearSecondThreadLocalStorage(
+                        facade.GetNumberOfNodes());
+                    QueryHeap &forward_heap2 = *engine_working_data.forward_heap_2;
+                    QueryHeap &reverse_heap2 = *engine_working_data.reverse_heap_2;
+
+                    for (const auto index : util::irange(range.begin(), range.end()))
+                    {
+                        auto &via_path = batch[index];
+                        NodeID s_v_middle = SPECIAL_NODEID, v_t_middle = SPECIAL_NODEID;
+                        via_path.passes_t_test =
+                            ViaNodeCandidatePassesTTest(facade,
+                                                        forward_heap1,
+                                                        reverse_heap1,
+                                                        forward_heap2,
+                                                        reverse_heap2,
+                                                        via_path.node,
+                                                        upper_bound_to_shortest_path_weight,
+                                                        &via_path.length,
+                                                        &s_v_middle,
+                                                        &v_t_middle,
+                                                        min_edge_offset);
+                        if (via_path.passes_t_test)
+                        {
+                            // the second heaps are reused by the next T-test
+                            RetrievePackedAlternatePath(forward_heap1,
+                                                        reverse_heap1,
+                                                        forward_heap2,
+                                                        reverse_heap2,
+                                                        s_v_middle,
+                                                        v_t_middle,
+                                                        via_path.packed_path);
+                        }
+                    }
+                },
+                tbb::simple_partitioner());
+
+            for (auto &via_path : batch)
+            {
+                if (packed_alternate_paths.size() >= number_of_alternatives)
+                {
+                    break;
+                }
+
+                // an alternative selected earlier in this batch can contain later candidates
+                if (!via_path.passes_t_test || is_on_selected_path(via_path.node))
+                {
+                    continue;
+                }
+
+                std::unordered_map<NodeID, EdgeWeight> path_edges;
+                UnpackCHPath(
+                    facade,
+                    via_path.packed_path.begin(),
+                    via_path.packed_path.end(),
+                    [&path_edges](std::pair<NodeID, NodeID> &edge, const EdgeData &data) {
+                        path_edges.emplace(edge.first, data.weight);
+                    });
+
+                const bool is_diverse = std::none_of(
+                    alternate_path_edges.begin(),
+                    alternate_path_edges.end(),
+                    [&](const std::unordered_map<NodeID, EdgeWeight> &selected_edges) {
+                        return ComputeSharing(path_edges, selected_edges) >
+                               maximum_allowed_sharing;
+                    });
+                if (!is_diverse)
+                {
+                    continue;
+                }
+
+                packed_alternate_paths.push_back(std::move(via_path.packed_path));
+                alternate_path_lengths.push_back(via_path.length);
+                alternate_path_edges.push_back(std::move(path_edges));
             }
         }
 
-        // Unpack shortest path and alternative, if they exist
+        // Unpack shortest path and alternatives, if they exist
         if (INVALID_EDGE_WEIGHT != upper_bound_to_shortest_path_weight)
         {
             BOOST_ASSERT(!packed_shortest_path.empty());
@@ -347,18 +464,10 @@ class AlternativeRouting final
             raw_route_data.shortest_path_length = upper_bound_to_shortest_path_weight;
         }
 
-        if (SPECIAL_NODEID != selected_via_node)
+        raw_route_data.unpacked_alternatives.resize(packed_alternate_paths.size());
+        for (const auto index : util::irange<std::size_t>(0, packed_alternate_paths.size()))
         {
-            std::vector<NodeID> packed_alternate_path;
-            // retrieve alternate path
-            RetrievePackedAlternatePath(forward_heap1,
-                                        reverse_heap1,
-                                        forward_heap2,
-                                        reverse_heap2,
-                                        s_v_middle,
-                                        v_t_middle,
-                                        packed_alternate_path);
-
+            const auto &packed_alternate_path = packed_alternate_paths[index];
             raw_route_data.alt_source_traversed_in_reverse.push_back(
                 (packed_alternate_path.front() !=
                  phantom_node_pair.source_phantom.forward_segment_id.id));
@@ -371,17 +480,27 @@ class AlternativeRouting final
                               packed_alternate_path.begin(),
                               packed_alternate_path.end(),
                               phantom_node_pair,
-                              raw_route_data.unpacked_alternative);
-
-            raw_route_data.alternative_path_length = length_of_via_path;
+                              raw_route_data.unpacked_alternatives[index]);
         }
-        else
+        raw_route_data.alternative_path_lengths = std::move(alternate_path_lengths);
+    }
+
+  private:
+    // weight of the original edges of `path_edges` that are also in `other_path_edges`
+    static int ComputeSharing(const std::unordered_map<NodeID, EdgeWeight> &path_edges,
+                              const std::unordered_map<NodeID, EdgeWeight> &other_path_edges)
+    {
+        int sharing = 0;
+        for (const auto &edge : path_edges)
         {
-            BOOST_ASSERT(raw_route_data.alternative_path_length == INVALID_EDGE_WEIGHT);
+            if (other_path_edges.count(edge.first) > 0)
+            {
+                sharing += edge.second;
+            }
         }
+        return sharing;
     }
 
-  private:
     // unpack alternate <s,..,v,..,t> by exploring search spaces from v
     void RetrievePackedAlternatePath(const QueryHeap &forward_heap1,
                                      const QueryHeap &reverse_heap1,
@@ -690,7 +809,7 @@ class AlternativeRouting final
 
         for (auto edge : facade.GetAdjacentEdgeRange(node))
         {
-            const EdgeData &data = facade.GetEdgeData(edge);
+            const auto &data = facade.GetEdgeSearchData(edge);
             const bool edge_is_forward_directed =
                 (is_forward_directed ? data.forward : data.backward);
             if (edge_is_forward_directed)
@@ -720,11 +839,11 @@ class AlternativeRouting final
 
     // conduct T-Test
     bool ViaNodeCandidatePassesTTest(const DataFacadeT &facade,
-                                     QueryHeap &existing_forward_heap,
-                                     QueryHeap &existing_reverse_heap,
+                                     const QueryHeap &existing_forward_heap,
+                                     const QueryHeap &existing_reverse_heap,
                                      QueryHeap &new_forward_heap,
                                      QueryHeap &new_reverse_heap,
-                                     const RankedCandidateNode &candidate,
+                                     const NodeID via_node,
                                      const int length_of_shortest_path,
                                      int *length_of_via_path,
                                      NodeID *s_v_middle,
@@ -739,7 +858,7 @@ class AlternativeRouting final
         *s_v_middle = SPECIAL_NODEID;
         int upper_bound_s_v_path_length = INVALID_EDGE_WEIGHT;
         // compute path <s,..,v> by reusing forward search from s
-        new_reverse_heap.Insert(candidate.node, 0, candidate.node);
+        new_reverse_heap.Insert(via_node, 0, via_node);
         const bool constexpr STALLING_ENABLED = true;
         const bool constexpr DO_NOT_FORCE_LOOPS = false;
         while (new_reverse_heap.Size() > 0)
@@ -764,7 +883,7 @@ class AlternativeRouting final
         // compute path <v,..,t> by reusing backward search from t
         *v_t_middle = SPECIAL_NODEID;
         int upper_bound_of_v_t_path_length = INVALID_EDGE_WEIGHT;
-        new_forward_heap.Insert(candidate.node, 0, candidate.node);
+        new_forward_heap.Insert(via_node, 0, via_node);
         while (new_forward_heap.Size() > 0)
         {
             super::RoutingStep(facade,
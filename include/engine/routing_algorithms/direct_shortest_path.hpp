@@ -127,7 +127,6 @@ class DirectShortestPathRouting final
         if (INVALID_EDGE_WEIGHT == weight)
         {
             raw_route_data.shortest_path_length = INVALID_EDGE_WEIGHT;
-            raw_route_data.alternative_path_length = INVALID_EDGE_WEIGHT;
             return;
         }
 
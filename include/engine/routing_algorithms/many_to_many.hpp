@@ -1,6 +1,7 @@
 #ifndef MANY_TO_MANY_ROUTING_HPP
 #define MANY_TO_MANY_ROUTING_HPP
 
+#include "engine/cancellation_token.hpp"
 #include "engine/routing_algorithms/routing_base.hpp"
 #include "engine/search_engine_data.hpp"
 #include "util/typedefs.hpp"
@@ -64,6 +65,7 @@ class ManyToManyRouting final
         QueryHeap &query_heap = *(engine_working_data.forward_heap_1);
 
         SearchSpaceWithBuckets search_space_with_buckets;
+        const CancellationCheck check_cancellation;
 
         unsigned column_idx = 0;
         const auto search_target_phantom = [&](const PhantomNode &phantom) {
@@ -86,6 +88,7 @@ class ManyToManyRouting final
             // explore search space
             while (!query_heap.Empty())
             {
+                check_cancellation();
                 BackwardRoutingStep(facade, column_idx, query_heap, search_space_with_buckets);
             }
             ++column_idx;
@@ -113,6 +116,7 @@ class ManyToManyRouting final
             // explore search space
             while (!query_heap.Empty())
             {
+                check_cancellation();
                 ForwardRoutingStep(facade,
                                    row_idx,
                                    number_of_targets,
@@ -231,7 +235,7 @@ class ManyToManyRouting final
     {
         for (auto edge : facade.GetAdjacentEdgeRange(node))
         {
-            const auto &data = facade.GetEdgeData(edge);
+            const auto &data = facade.GetEdgeSearchData(edge);
             const bool direction_flag = (forward_direction ? data.forward : data.backward);
             if (direction_flag)
             {
@@ -266,7 +270,7 @@ class ManyToManyRouting final
     {
         for (auto edge : facade.GetAdjacentEdgeRange(node))
         {
-            const auto &data = facade.GetEdgeData(edge);
+            const auto &data = facade.GetEdgeSearchData(edge);
             const bool reverse_flag = ((!forward_direction) ? data.forward : data.backward);
             if (reverse_flag)
             {
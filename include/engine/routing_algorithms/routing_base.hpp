@@ -2,11 +2,14 @@
 #define ROUTING_BASE_HPP
 
 #include "extractor/guidance/turn_instruction.hpp"
+#include "engine/cancellation_token.hpp"
+#include "engine/core_landmark_potential.hpp"
 #include "engine/edge_unpacker.hpp"
 #include "engine/internal_route_result.hpp"
 #include "engine/search_engine_data.hpp"
 #include "util/coordinate_calculation.hpp"
 #include "util/guidance/turn_bearing.hpp"
+#include "util/integer_range.hpp"
 #include "util/typedefs.hpp"
 
 #include <boost/assert.hpp>
@@ -66,7 +69,7 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
     */
     void RoutingStep(const DataFacadeT &facade,
                      SearchEngineData::QueryHeap &forward_heap,
-                     SearchEngineData::QueryHeap &reverse_heap,
+                     const SearchEngineData::QueryHeap &reverse_heap,
                      NodeID &middle_node_id,
                      std::int32_t &upper_bound,
                      std::int32_t min_edge_offset,
@@ -93,7 +96,7 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
                     // check whether there is a loop present at the node
                     for (const auto edge : facade.GetAdjacentEdgeRange(node))
                     {
-                        const EdgeData &data = facade.GetEdgeData(edge);
+                        const auto &data = facade.GetEdgeSearchData(edge);
                         bool forward_directionFlag =
                             (forward_direction ? data.forward : data.backward);
                         if (forward_directionFlag)
@@ -136,7 +139,7 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
         {
             for (const auto edge : facade.GetAdjacentEdgeRange(node))
             {
-                const EdgeData &data = facade.GetEdgeData(edge);
+                const auto &data = facade.GetEdgeSearchData(edge);
                 const bool reverse_flag = ((!forward_direction) ? data.forward : data.backward);
                 if (reverse_flag)
                 {
@@ -158,7 +161,7 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
 
         for (const auto edge : facade.GetAdjacentEdgeRange(node))
         {
-            const EdgeData &data = facade.GetEdgeData(edge);
+            const auto &data = facade.GetEdgeSearchData(edge);
             bool forward_directionFlag = (forward_direction ? data.forward : data.backward);
             if (forward_directionFlag)
             {
@@ -184,12 +187,105 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
         }
     }
 
+    /*
+    Routing step of the goal-directed core search. The heap keys are reduced weights
+    (weight + potential), so the smallest key of a direction is a lower bound on every path that
+    is yet to be found by it. Once it reaches the upper bound the direction is done, which is
+    enough to terminate the whole search.
+    */
+    void LandmarkRoutingStep(const DataFacadeT &facade,
+                             SearchEngineData::QueryHeap &forward_heap,
+                             SearchEngineData::QueryHeap &reverse_heap,
+                             const CoreLandmarkPotential<DataFacadeT> &forward_potential,
+                             const CoreLandmarkPotential<DataFacadeT> &reverse_potential,
+                             NodeID &middle_node_id,
+                             std::int32_t &upper_bound,
+                             const bool forward_direction,
+                             const bool force_loop_forward,
+                             const bool force_loop_reverse) const
+    {
+        const NodeID node = forward_heap.DeleteMin();
+        const std::int32_t key = forward_heap.GetKey(node);
+
+        if (key >= upper_bound)
+        {
+            forward_heap.DeleteAll();
+            return;
+        }
+
+        const std::int32_t weight = key - forward_potential(node);
+
+        if (reverse_heap.WasInserted(node))
+        {
+            const std::int32_t new_weight =
+                reverse_heap.GetKey(node) - reverse_potential(node) + weight;
+            if (new_weight < upper_bound)
+            {
+                // same loop handling as in RoutingStep
+                if ((force_loop_forward && forward_heap.GetData(node).parent == node) ||
+                    (force_loop_reverse && reverse_heap.GetData(node).parent == node) ||
+                    new_weight < 0)
+                {
+                    for (const auto edge : facade.GetAdjacentEdgeRange(node))
+                    {
+                        const auto &data = facade.GetEdgeSearchData(edge);
+                        const bool forward_directionFlag =
+                            (forward_direction ? data.forward : data.backward);
+                        if (forward_directionFlag && facade.GetTarget(edge) == node)
+                        {
+                            const std::int32_t loop_weight = new_weight + data.weight;
+                            if (loop_weight >= 0 && loop_weight < upper_bound)
+                            {
+                                middle_node_id = node;
+                                upper_bound = loop_weight;
+                            }
+                        }
+                    }
+                }
+                else
+                {
+                    middle_node_id = node;
+                    upper_bound = new_weight;
+                }
+            }
+        }
+
+        for (const auto edge : facade.GetAdjacentEdgeRange(node))
+        {
+            const auto &data = facade.GetEdgeSearchData(edge);
+            const bool forward_directionFlag = (forward_direction ? data.forward : data.backward);
+            if (forward_directionFlag)
+            {
+                const NodeID to = facade.GetTarget(edge);
+                BOOST_ASSERT_MSG(data.weight > 0, "edge_weight invalid");
+
+                const auto potential = forward_potential(to);
+                if (potential == INVALID_EDGE_WEIGHT)
+                {
+                    // can not be part of a path to the other side
+                    continue;
+                }
+                const int to_key = weight + data.weight + potential;
+
+                if (!forward_heap.WasInserted(to))
+                {
+                    forward_heap.Insert(to, to_key, node);
+                }
+                else if (to_key < forward_heap.GetKey(to))
+                {
+                    forward_heap.GetData(to).parent = node;
+                    forward_heap.DecreaseKey(to, to_key);
+                }
+            }
+        }
+    }
+
     inline EdgeWeight GetLoopWeight(const DataFacadeT &facade, NodeID node) const
     {
         EdgeWeight loop_weight = INVALID_EDGE_WEIGHT;
         for (auto edge : facade.GetAdjacentEdgeRange(node))
         {
-            const auto &data = facade.GetEdgeData(edge);
+            const auto &data = facade.GetEdgeSearchData(edge);
             if (data.forward)
             {
                 const NodeID to = facade.GetTarget(edge);
@@ -222,87 +318,76 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
             *std::prev(packed_path_end) == phantom_node_pair.target_phantom.forward_segment_id.id ||
             *std::prev(packed_path_end) == phantom_node_pair.target_phantom.reverse_segment_id.id);
 
-        UnpackCHPath(
-            facade,
-            packed_path_begin,
-            packed_path_end,
-            [this,
-             &facade,
-             &unpacked_path,
-             &phantom_node_pair,
-             &start_traversed_in_reverse,
-             &target_traversed_in_reverse](std::pair<NodeID, NodeID> & /* edge */,
-                                           const EdgeData &edge_data) {
-
-                BOOST_ASSERT_MSG(!edge_data.shortcut, "original edge flagged as shortcut");
-                const auto name_index = facade.GetNameIndexFromEdgeID(edge_data.id);
-                const auto turn_instruction = facade.GetTurnInstructionForEdgeID(edge_data.id);
-                const extractor::TravelMode travel_mode =
-                    (unpacked_path.empty() && start_traversed_in_reverse)
-                        ? phantom_node_pair.source_phantom.backward_travel_mode
-                        : facade.GetTravelModeForEdgeID(edge_data.id);
-
-                const auto geometry_index = facade.GetGeometryIndexForEdgeID(edge_data.id);
-                std::vector<NodeID> id_vector;
-                std::vector<EdgeWeight> weight_vector;
-                std::vector<DatasourceID> datasource_vector;
-                if (geometry_index.forward)
-                {
-                    id_vector = facade.GetUncompressedForwardGeometry(geometry_index.id);
-                    weight_vector = facade.GetUncompressedForwardWeights(geometry_index.id);
-                    datasource_vector = facade.GetUncompressedForwardDatasources(geometry_index.id);
-                }
-                else
-                {
-                    id_vector = facade.GetUncompressedReverseGeometry(geometry_index.id);
-                    weight_vector = facade.GetUncompressedReverseWeights(geometry_index.id);
-                    datasource_vector = facade.GetUncompressedReverseDatasources(geometry_index.id);
-                }
-                BOOST_ASSERT(id_vector.size() > 0);
-                BOOST_ASSERT(weight_vector.size() > 0);
-                BOOST_ASSERT(datasource_vector.size() > 0);
-
-                const auto total_weight =
-                    std::accumulate(weight_vector.begin(), weight_vector.end(), 0);
-
-                BOOST_ASSERT(weight_vector.size() == id_vector.size() - 1);
-                const bool is_first_segment = unpacked_path.empty();
-
-                const std::size_t start_index =
-                    (is_first_segment
-                         ? ((start_traversed_in_reverse)
-                                ? weight_vector.size() -
-                                      phantom_node_pair.source_phantom.fwd_segment_position - 1
-                                : phantom_node_pair.source_phantom.fwd_segment_position)
-                         : 0);
-                const std::size_t end_index = weight_vector.size();
-
-                BOOST_ASSERT(start_index >= 0);
-                BOOST_ASSERT(start_index < end_index);
-                for (std::size_t segment_idx = start_index; segment_idx < end_index; ++segment_idx)
-                {
-                    unpacked_path.push_back(
-                        PathData{id_vector[segment_idx + 1],
-                                 name_index,
-                                 weight_vector[segment_idx],
-                                 extractor::guidance::TurnInstruction::NO_TURN(),
-                                 {{0, INVALID_LANEID}, INVALID_LANE_DESCRIPTIONID},
-                                 travel_mode,
-                                 INVALID_ENTRY_CLASSID,
-                                 datasource_vector[segment_idx],
-                                 util::guidance::TurnBearing(0),
-                                 util::guidance::TurnBearing(0)});
-                }
-                BOOST_ASSERT(unpacked_path.size() > 0);
-                if (facade.hasLaneData(edge_data.id))
-                    unpacked_path.back().lane_data = facade.GetLaneData(edge_data.id);
-
-                unpacked_path.back().entry_classid = facade.GetEntryClassID(edge_data.id);
-                unpacked_path.back().turn_instruction = turn_instruction;
-                unpacked_path.back().duration_until_turn += (edge_data.weight - total_weight);
-                unpacked_path.back().pre_turn_bearing = facade.PreTurnBearing(edge_data.id);
-                unpacked_path.back().post_turn_bearing = facade.PostTurnBearing(edge_data.id);
-            });
+        // Collect the original edges first, so their data can be fetched with a single facade call
+        std::vector<EdgeID> original_edges;
+        std::vector<EdgeWeight> original_weights;
+        UnpackCHPath(facade,
+                     packed_path_begin,
+                     packed_path_end,
+                     [&original_edges, &original_weights](std::pair<NodeID, NodeID> & /* edge */,
+                                                          const EdgeData &edge_data) {
+                         BOOST_ASSERT_MSG(!edge_data.shortcut, "original edge flagged as shortcut");
+                         original_edges.push_back(edge_data.id);
+                         original_weights.push_back(edge_data.weight);
+                     });
+
+        datafacade::OriginalEdgeSequence sequence;
+        facade.GetOriginalEdgeSequence(original_edges, sequence);
+        BOOST_ASSERT(sequence.segment_offsets.size() == original_edges.size() + 1);
+        unpacked_path.reserve(unpacked_path.size() + sequence.segment_nodes.size());
+
+        for (const auto edge_index : util::irange<std::size_t>(0, original_edges.size()))
+        {
+            const extractor::TravelMode travel_mode =
+                (unpacked_path.empty() && start_traversed_in_reverse)
+                    ? phantom_node_pair.source_phantom.backward_travel_mode
+                    : sequence.travel_modes[edge_index];
+
+            const auto segments_begin = sequence.segment_offsets[edge_index];
+            const auto segments_end = sequence.segment_offsets[edge_index + 1];
+            BOOST_ASSERT(segments_begin < segments_end);
+
+            const auto total_weight =
+                std::accumulate(sequence.segment_weights.begin() + segments_begin,
+                                sequence.segment_weights.begin() + segments_end,
+                                0);
+
+            const bool is_first_segment = unpacked_path.empty();
+            const std::size_t number_of_segments = segments_end - segments_begin;
+
+            const std::size_t start_index =
+                (is_first_segment
+                     ? ((start_traversed_in_reverse)
+                            ? number_of_segments -
+                                  phantom_node_pair.source_phantom.fwd_segment_position - 1
+                            : phantom_node_pair.source_phantom.fwd_segment_position)
+                     : 0);
+
+            BOOST_ASSERT(start_index < number_of_segments);
+            for (std::size_t segment_idx = segments_begin + start_index;
+                 segment_idx < segments_end;
+                 ++segment_idx)
+            {
+                unpacked_path.push_back(PathData{sequence.segment_nodes[segment_idx],
+                                                 sequence.name_ids[edge_index],
+                                                 sequence.segment_weights[segment_idx],
+                                                 extractor::guidance::TurnInstruction::NO_TURN(),
+                                                 {{0, INVALID_LANEID}, INVALID_LANE_DESCRIPTIONID},
+                                                 travel_mode,
+                                                 INVALID_ENTRY_CLASSID,
+                                                 sequence.segment_datasources[segment_idx],
+                                                 util::guidance::TurnBearing(0),
+                                                 util::guidance::TurnBearing(0)});
+            }
+            BOOST_ASSERT(unpacked_path.size() > 0);
+            unpacked_path.back().lane_data = sequence.lane_data[edge_index];
+            unpacked_path.back().entry_classid = sequence.entry_class_ids[edge_index];
+            unpacked_path.back().turn_instruction = sequence.turn_instructions[edge_index];
+            unpacked_path.back().duration_until_turn +=
+                (original_weights[edge_index] - total_weight);
+            unpacked_path.back().pre_turn_bearing = sequence.pre_turn_bearings[edge_index];
+            unpacked_path.back().post_turn_bearing = sequence.post_turn_bearings[edge_index];
+        }
 
         std::size_t start_index = 0, end_index = 0;
         std::vector<unsigned> id_vector;
@@ -499,8 +584,10 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
 
         // run two-Target Dijkstra routing step.
         const constexpr bool STALLING_ENABLED = true;
+        const CancellationCheck check_cancellation;
         while (0 < (forward_heap.Size() + reverse_heap.Size()))
         {
+            check_cancellation();
             if (!forward_heap.Empty())
             {
                 RoutingStep(facade,
@@ -586,9 +673,11 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
         BOOST_ASSERT(reverse_heap.MinKey() >= 0);
 
         const constexpr bool STALLING_ENABLED = true;
+        const CancellationCheck check_cancellation;
         // run two-Target Dijkstra routing step.
         while (0 < (forward_heap.Size() + reverse_heap.Size()))
         {
+            check_cancellation();
             if (!forward_heap.Empty())
             {
                 if (facade.IsCoreNode(forward_heap.Min()))
@@ -645,56 +734,118 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
             core_heap.Insert(id, weight, parent);
         };
 
-        forward_core_heap.Clear();
-        for (const auto &p : forward_entry_points)
-        {
-            insertInCoreHeap(p, forward_core_heap);
-        }
+        // use landmarks to guide the core search if the dataset provides them
+        const bool use_landmarks = facade.GetNumberOfCoreLandmarks() > 0 &&
+                                   !forward_entry_points.empty() &&
+                                   !reverse_entry_points.empty();
+        const CoreLandmarkPotential<DataFacadeT> forward_potential(
+            facade, use_landmarks ? reverse_entry_points : std::vector<CoreEntryPoint>{}, true);
+        const CoreLandmarkPotential<DataFacadeT> reverse_potential(
+            facade, use_landmarks ? forward_entry_points : std::vector<CoreEntryPoint>{}, false);
 
+        forward_core_heap.Clear();
         reverse_core_heap.Clear();
-        for (const auto &p : reverse_entry_points)
+        if (use_landmarks)
         {
-            insertInCoreHeap(p, reverse_core_heap);
-        }
+            const auto insertWithPotential =
+                [](const CoreEntryPoint &p,
+                   const CoreLandmarkPotential<DataFacadeT> &potential,
+                   SearchEngineData::QueryHeap &core_heap) {
+                    const auto node_potential = potential(std::get<0>(p));
+                    if (node_potential != INVALID_EDGE_WEIGHT)
+                    {
+                        core_heap.Insert(
+                            std::get<0>(p), std::get<1>(p) + node_potential, std::get<2>(p));
+                    }
+                };
 
-        // get offset to account for offsets on phantom nodes on compressed edges
-        int min_core_edge_offset = 0;
-        if (forward_core_heap.Size() > 0)
-        {
-            min_core_edge_offset = std::min(min_core_edge_offset, forward_core_heap.MinKey());
+            for (const auto &p : forward_entry_points)
+            {
+                insertWithPotential(p, forward_potential, forward_core_heap);
+            }
+            for (const auto &p : reverse_entry_points)
+            {
+                insertWithPotential(p, reverse_potential, reverse_core_heap);
+            }
+
+            while (0 < forward_core_heap.Size() && 0 < reverse_core_heap.Size())
+            {
+                check_cancellation();
+                LandmarkRoutingStep(facade,
+                                    forward_core_heap,
+                                    reverse_core_heap,
+                                    forward_potential,
+                                    reverse_potential,
+                                    middle,
+                                    weight,
+                                    true,
+                                    force_loop_forward,
+                                    force_loop_reverse);
+
+                LandmarkRoutingStep(facade,
+                                    reverse_core_heap,
+                                    forward_core_heap,
+                                    reverse_potential,
+                                    forward_potential,
+                                    middle,
+                                    weight,
+                                    false,
+                                    force_loop_reverse,
+                                    force_loop_forward);
+            }
         }
-        if (reverse_core_heap.Size() > 0 && reverse_core_heap.MinKey() < 0)
+        else
         {
-            min_core_edge_offset = std::min(min_core_edge_offset, reverse_core_heap.MinKey());
-        }
-        BOOST_ASSERT(min_core_edge_offset <= 0);
+            for (const auto &p : forward_entry_points)
+            {
+                insertInCoreHeap(p, forward_core_heap);
+            }
 
-        // run two-target Dijkstra routing step on core with termination criterion
-        const constexpr bool STALLING_DISABLED = false;
-        while (0 < forward_core_heap.Size() && 0 < reverse_core_heap.Size() &&
-               weight > (forward_core_heap.MinKey() + reverse_core_heap.MinKey()))
-        {
-            RoutingStep(facade,
-                        forward_core_heap,
-                        reverse_core_heap,
-                        middle,
-                        weight,
-                        min_core_edge_offset,
-                        true,
-                        STALLING_DISABLED,
-                        force_loop_forward,
-                        force_loop_reverse);
+            for (const auto &p : reverse_entry_points)
+            {
+                insertInCoreHeap(p, reverse_core_heap);
+            }
+
+            // get offset to account for offsets on phantom nodes on compressed edges
+            int min_core_edge_offset = 0;
+            if (forward_core_heap.Size() > 0)
+            {
+                min_core_edge_offset = std::min(min_core_edge_offset, forward_core_heap.MinKey());
+            }
+            if (reverse_core_heap.Size() > 0 && reverse_core_heap.MinKey() < 0)
+            {
+                min_core_edge_offset = std::min(min_core_edge_offset, reverse_core_heap.MinKey());
+            }
+            BOOST_ASSERT(min_core_edge_offset <= 0);
+
+            // run two-target Dijkstra routing step on core with termination criterion
+            const constexpr bool STALLING_DISABLED = false;
+            while (0 < forward_core_heap.Size() && 0 < reverse_core_heap.Size() &&
+                   weight > (forward_core_heap.MinKey() + reverse_core_heap.MinKey()))
+            {
+                check_cancellation();
+                RoutingStep(facade,
+                            forward_core_heap,
+                            reverse_core_heap,
+                            middle,
+                            weight,
+                            min_core_edge_offset,
+                            true,
+                            STALLING_DISABLED,
+                            force_loop_forward,
+                            force_loop_reverse);
 
-            RoutingStep(facade,
-                        reverse_core_heap,
-                        forward_core_heap,
-                        middle,
-                        weight,
-                        min_core_edge_offset,
-                        false,
-                        STALLING_DISABLED,
-                        force_loop_reverse,
-                        force_loop_forward);
+                RoutingStep(facade,
+                            reverse_core_heap,
+                            forward_core_heap,
+                            middle,
+                            weight,
+                            min_core_edge_offset,
+                            false,
+                            STALLING_DISABLED,
+                            force_loop_reverse,
+                            force_loop_forward);
+            }
         }
 
         // No path found for both target nodes?
@@ -711,7 +862,13 @@ template <class DataFacadeT, class Derived> class BasicRoutingInterface
         // we need to unpack sub path from core heaps
         if (facade.IsCoreNode(middle))
         {
-            if (weight != forward_core_heap.GetKey(middle) + reverse_core_heap.GetKey(middle))
+            // with landmarks the core heaps store reduced weights
+            const auto core_weight =
+                use_landmarks
+                    ? forward_core_heap.GetKey(middle) - forward_potential(middle) +
+                          reverse_core_heap.GetKey(middle) - reverse_potential(middle)
+                    : forward_core_heap.GetKey(middle) + reverse_core_heap.GetKey(middle);
+            if (weight != core_weight)
             {
                 // self loop
                 BOOST_ASSERT(forward_core_heap.GetData(middle).parent == middle &&
@@ -0,0 +1,82 @@
+#ifndef OSRM_ENGINE_SHORTCUT_UNPACKING_CACHE_HPP
+#define OSRM_ENGINE_SHORTCUT_UNPACKING_CACHE_HPP
+
+#include "contractor/query_edge.hpp"
+#include "engine/cache_statistics.hpp"
+#include "util/sharded_lru_cache.hpp"
+#include "util/typedefs.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+
+/**
+ * Caches the original edges of shortcuts of the packed paths of queries, so shortcuts on busy
+ * corridors are unpacked once instead of a FindSmallestEdge lookup per level for every query.
+ * Only shortcuts that expand to at least MIN_ORIGINAL_EDGES edges are cached, short ones are
+ * cheaper to unpack than to look up. The size of the cache is bounded by the total number of
+ * cached original edges, so memory stays bounded no matter how long the cached shortcuts are.
+ *
+ * The cache belongs to the facade of a dataset and is safe to use from all query threads: it is
+ * a util::ShardedLRUCache and the entries are immutable once inserted.
+ */
+class ShortcutUnpackingCache
+{
+  public:
+    struct OriginalEdge
+    {
+        std::pair<NodeID, NodeID> nodes;
+        contractor::QueryEdge::EdgeData data;
+    };
+    using OriginalEdges = std::vector<OriginalEdge>;
+    using OriginalEdgesPtr = std::shared_ptr<const OriginalEdges>;
+
+    static const constexpr std::size_t MIN_ORIGINAL_EDGES = 32;
+
+    // `capacity` is the maximal number of cached original edges over all shortcuts, an edge
+    // takes sizeof(OriginalEdge) bytes
+    explicit ShortcutUnpackingCache(const std::size_t capacity) : cache(capacity) {}
+
+    // Returns the original edges of the shortcut from `from` to `to`, nullptr if not cached
+    OriginalEdgesPtr Get(const NodeID from, const NodeID to) const
+    {
+        OriginalEdgesPtr edges;
+        const auto found = cache.Get(MakeKey(from, to), edges);
+        CacheStatistics::GetInstance().CountShortcutUnpacking(found ? 1 : 0, found ? 0 : 1);
+        return edges;
+    }
+
+    void Insert(const NodeID from, const NodeID to, OriginalEdges edges)
+    {
+        if (edges.size() < MIN_ORIGINAL_EDGES)
+        {
+            return;
+        }
+
+        const auto cost = edges.size();
+        cache.Insert(
+            MakeKey(from, to), std::make_shared<const OriginalEdges>(std::move(edges)), cost);
+    }
+
+    std::uint64_t GetNumberOfHits() const { return cache.GetNumberOfHits(); }
+    std::uint64_t GetNumberOfMisses() const { return cache.GetNumberOfMisses(); }
+
+  private:
+    static std::uint64_t MakeKey(const NodeID from, const NodeID to)
+    {
+        return (static_cast<std::uint64_t>(from) << 32) | to;
+    }
+
+    util::ShardedLRUCache<std::uint64_t, OriginalEdgesPtr> cache;
+};
+}
+}
+
+#endif
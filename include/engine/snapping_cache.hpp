@@ -0,0 +1,126 @@
+#ifndef OSRM_ENGINE_SNAPPING_CACHE_HPP
+#define OSRM_ENGINE_SNAPPING_CACHE_HPP
+
+#include "engine/phantom_node.hpp"
+#include "engine/cache_statistics.hpp"
+#include "util/coordinate.hpp"
+#include "util/sharded_lru_cache.hpp"
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace osrm
+{
+namespace engine
+{
+
+/**
+ * Caches the phantom nodes that GeospatialQuery found for a coordinate and a set of snapping
+ * parameters, so coordinates that are queried over and over again (depots, customers) are
+ * snapped once instead of an rtree search and phantom node construction per request.
+ *
+ * Coordinates are keyed by their fixed point representation, i.e. quantized to 1e-6 degrees,
+ * which is the precision every coordinate is parsed into. Any coarser quantization would change
+ * the snapped locations. The cache belongs to the GeospatialQuery of a dataset and is dropped
+ * together with it when the dataset is swapped.
+ *
+ * The cache is a util::ShardedLRUCache and the entries are immutable once inserted, so it is safe
+ * to use from all query threads.
+ */
+class SnappingCache
+{
+  public:
+    enum class QueryType : std::uint8_t
+    {
+        NearestInRange,
+        Nearest,
+        NearestWithAlternative
+    };
+
+    // Parameters that are not used by a query have to be left unset, so a query without a radius
+    // or bearing never shares an entry with a query that has one
+    struct Key
+    {
+        util::Coordinate coordinate;
+        QueryType type;
+        unsigned max_results = 0;
+        boost::optional<double> max_distance = boost::none;
+        // bearing and bearing range
+        boost::optional<std::pair<int, int>> bearing = boost::none;
+
+        bool operator==(const Key &other) const
+        {
+            return coordinate == other.coordinate && type == other.type &&
+                   max_results == other.max_results && max_distance == other.max_distance &&
+                   bearing == other.bearing;
+        }
+    };
+
+    // The pair returned by NearestPhantomNodeWithAlternativeFromBigComponent is stored as the
+    // first and last element
+    using PhantomNodes = std::vector<PhantomNodeWithDistance>;
+    using PhantomNodesPtr = std::shared_ptr<const PhantomNodes>;
+
+    // `capacity` is the maximal number of cached queries
+    explicit SnappingCache(const std::size_t capacity) : cache(capacity) {}
+
+    // Returns the phantom nodes found for `key`, nullptr if not cached
+    PhantomNodesPtr Get(const Key &key) const
+    {
+        PhantomNodesPtr phantom_nodes;
+        const auto found = cache.Get(key, phantom_nodes);
+        CacheStatistics::GetInstance().CountSnapping(found ? 1 : 0, found ? 0 : 1);
+        return phantom_nodes;
+    }
+
+    void Insert(const Key &key, PhantomNodes phantom_nodes)
+    {
+        cache.Insert(key, std::make_shared<const PhantomNodes>(std::move(phantom_nodes)));
+    }
+
+    std::uint64_t GetNumberOfHits() const { return cache.GetNumberOfHits(); }
+    std::uint64_t GetNumberOfMisses() const { return cache.GetNumberOfMisses(); }
+
+  private:
+    static std::uint64_t Mix(const std::uint64_t value)
+    {
+        return (value ^ (value >> 29)) * 0x9E3779B97F4A7C15ull;
+    }
+
+    struct KeyHash
+    {
+        std::size_t operator()(const Key &key) const
+        {
+            // an unset radius is hashed like a radius of 0, they are told apart by operator==
+            const double max_distance = key.max_distance ? *key.max_distance : 0.;
+            std::uint64_t distance_bits;
+            std::memcpy(&distance_bits, &max_distance, sizeof(distance_bits));
+
+            const auto lon =
+                static_cast<std::uint32_t>(static_cast<std::int32_t>(key.coordinate.lon));
+            const auto lat =
+                static_cast<std::uint32_t>(static_cast<std::int32_t>(key.coordinate.lat));
+            std::uint64_t hash = Mix((static_cast<std::uint64_t>(lon) << 32) | lat);
+            hash = Mix(hash ^ static_cast<std::uint64_t>(key.type));
+            hash = Mix(hash ^ key.max_results);
+            hash = Mix(hash ^ distance_bits);
+            const auto bearing = key.bearing ? static_cast<std::uint32_t>(key.bearing->first) : 0;
+            const auto bearing_range =
+                key.bearing ? static_cast<std::uint32_t>(key.bearing->second) : 0;
+            return static_cast<std::size_t>(
+                Mix(hash ^ ((static_cast<std::uint64_t>(bearing) << 32) | bearing_range)));
+        }
+    };
+
+    util::ShardedLRUCache<Key, PhantomNodesPtr, KeyHash> cache;
+};
+}
+}
+
+#endif
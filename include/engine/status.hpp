@@ -34,13 +34,15 @@ namespace engine
 {
 
 /**
- * Status for indicating query success or failure.
- * \see OSRM
+ * Status for indicating query success or failure. Timeout is returned if the query was given up
+ * because its CancellationToken was cancelled or its deadline passed.
+ * \see OSRM, CancellationToken
  */
 enum class Status
 {
     Ok,
-    Error
+    Error,
+    Timeout
 };
 }
 }
@@ -0,0 +1,127 @@
+#ifndef OSRM_EXTRACTOR_EDGE_BASED_NODE_RENUMBERING_HPP
+#define OSRM_EXTRACTOR_EDGE_BASED_NODE_RENUMBERING_HPP
+
+#include "extractor/edge_based_edge.hpp"
+#include "extractor/edge_based_node.hpp"
+#include "extractor/query_node.hpp"
+
+#include "util/coordinate.hpp"
+#include "util/coordinate_calculation.hpp"
+#include "util/deallocating_vector.hpp"
+#include "util/hilbert_value.hpp"
+#include "util/integer_range.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/assert.hpp>
+
+#include <tbb/parallel_sort.h>
+
+#include <cstdint>
+#include <limits>
+#include <numeric>
+#include <vector>
+
+namespace osrm
+{
+namespace extractor
+{
+
+/**
+ * Computes a cache friendly numbering of the edge-based nodes: nodes are ordered along a Hilbert
+ * curve, so nodes that are close on the map end up close in all arrays indexed by node (the query
+ * graph, node weights, core markers and the search heaps). The position of a node is the
+ * centroid of the first segment that belongs to it.
+ *
+ * Returns the new ID for every old ID. Nodes without any segment are placed at the end and keep
+ * their relative order.
+ */
+inline std::vector<NodeID> ComputeHilbertNodeOrder(const std::vector<EdgeBasedNode> &segments,
+                                                   const std::vector<QueryNode> &coordinates,
+                                                   const std::size_t number_of_nodes)
+{
+    const constexpr auto NO_POSITION = std::numeric_limits<std::uint64_t>::max();
+    std::vector<std::uint64_t> node_positions(number_of_nodes, NO_POSITION);
+
+    const auto set_position = [&node_positions](const SegmentID segment_id,
+                                                const std::uint64_t position) {
+        if (segment_id.id == SPECIAL_SEGMENTID)
+        {
+            return;
+        }
+        BOOST_ASSERT(segment_id.id < node_positions.size());
+        if (node_positions[segment_id.id] == NO_POSITION)
+        {
+            node_positions[segment_id.id] = position;
+        }
+    };
+
+    for (const auto &segment : segments)
+    {
+        BOOST_ASSERT(segment.u < coordinates.size());
+        BOOST_ASSERT(segment.v < coordinates.size());
+        const auto centroid = util::coordinate_calculation::centroid(
+            util::Coordinate(coordinates[segment.u]), util::Coordinate(coordinates[segment.v]));
+        const auto position = util::GetHilbertCode(centroid);
+
+        set_position(segment.forward_segment_id, position);
+        set_position(segment.reverse_segment_id, position);
+    }
+
+    std::vector<NodeID> order(number_of_nodes);
+    std::iota(order.begin(), order.end(), 0);
+    tbb::parallel_sort(
+        order.begin(), order.end(), [&node_positions](const NodeID lhs, const NodeID rhs) {
+            return node_positions[lhs] < node_positions[rhs] ||
+                   (node_positions[lhs] == node_positions[rhs] && lhs < rhs);
+        });
+
+    std::vector<NodeID> old_to_new(number_of_nodes);
+    for (const auto rank : util::irange<NodeID>(0, number_of_nodes))
+    {
+        old_to_new[order[rank]] = rank;
+    }
+    return old_to_new;
+}
+
+/**
+ * Applies a node numbering computed by ComputeHilbertNodeOrder to all edge-based node IDs the
+ * extractor writes: the segments stored in the r-tree, the node weights and the edge list.
+ */
+inline void RenumberEdgeBasedNodes(const std::vector<NodeID> &old_to_new,
+                                   std::vector<EdgeBasedNode> &segments,
+                                   std::vector<EdgeWeight> &node_weights,
+                                   util::DeallocatingVector<EdgeBasedEdge> &edges)
+{
+    BOOST_ASSERT(old_to_new.size() == node_weights.size());
+
+    for (auto &segment : segments)
+    {
+        if (segment.forward_segment_id.id != SPECIAL_SEGMENTID)
+        {
+            segment.forward_segment_id.id = old_to_new[segment.forward_segment_id.id];
+        }
+        if (segment.reverse_segment_id.id != SPECIAL_SEGMENTID)
+        {
+            segment.reverse_segment_id.id = old_to_new[segment.reverse_segment_id.id];
+        }
+    }
+
+    std::vector<EdgeWeight> renumbered_weights(node_weights.size());
+    for (const auto node : util::irange<NodeID>(0, node_weights.size()))
+    {
+        renumbered_weights[old_to_new[node]] = node_weights[node];
+    }
+    node_weights.swap(renumbered_weights);
+
+    for (auto &edge : edges)
+    {
+        BOOST_ASSERT(edge.source < old_to_new.size());
+        BOOST_ASSERT(edge.target < old_to_new.size());
+        edge.source = old_to_new[edge.source];
+        edge.target = old_to_new[edge.target];
+    }
+}
+}
+}
+
+#endif
@@ -40,7 +40,7 @@ namespace extractor
 
 struct ExtractorConfig
 {
-    ExtractorConfig() noexcept : requested_num_threads(0) {}
+    ExtractorConfig() noexcept : requested_num_threads(0), renumber_nodes(false) {}
     void UseDefaultOutputNames()
     {
         std::string basepath = input_path.string();
@@ -100,6 +100,7 @@ struct ExtractorConfig
     unsigned small_component_size;
 
     bool generate_edge_lookup;
+    bool renumber_nodes;
     std::string edge_penalty_path;
     std::string edge_segment_lookup_path;
 };
@@ -28,6 +28,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #ifndef OSRM_HPP
 #define OSRM_HPP
 
+#include "osrm/cancellation_token.hpp"
 #include "osrm/osrm_fwd.hpp"
 #include "osrm/status.hpp"
 
@@ -85,6 +86,15 @@ class OSRM final
      */
     Status Route(const RouteParameters &parameters, json::Object &result) const;
 
+    /**
+     * As above, but gives up the query with Status::Timeout once the token is cancelled.
+     *
+     * \see CancellationToken
+     */
+    Status Route(const RouteParameters &parameters,
+                 json::Object &result,
+                 const CancellationToken &token) const;
+
     /**
      * Distance tables for coordinates.
      *
@@ -94,6 +104,15 @@ class OSRM final
      */
     Status Table(const TableParameters &parameters, json::Object &result) const;
 
+    /**
+     * As above, but gives up the query with Status::Timeout once the token is cancelled.
+     *
+     * \see CancellationToken
+     */
+    Status Table(const TableParameters &parameters,
+                 json::Object &result,
+                 const CancellationToken &token) const;
+
     /**
      * Nearest street segment for coordinate.
      *
@@ -103,6 +122,15 @@ class OSRM final
      */
     Status Nearest(const NearestParameters &parameters, json::Object &result) const;
 
+    /**
+     * As above, but gives up the query with Status::Timeout once the token is cancelled.
+     *
+     * \see CancellationToken
+     */
+    Status Nearest(const NearestParameters &parameters,
+                   json::Object &result,
+                   const CancellationToken &token) const;
+
     /**
      * Trip: shortest round trip between coordinates.
      *
@@ -112,6 +140,15 @@ class OSRM final
      */
     Status Trip(const TripParameters &parameters, json::Object &result) const;
 
+    /**
+     * As above, but gives up the query with Status::Timeout once the token is cancelled.
+     *
+     * \see CancellationToken
+     */
+    Status Trip(const TripParameters &parameters,
+                json::Object &result,
+                const CancellationToken &token) const;
+
     /**
      * Match: snaps noisy coordinate traces to the road network
      *
@@ -121,6 +158,15 @@ class OSRM final
      */
     Status Match(const MatchParameters &parameters, json::Object &result) const;
 
+    /**
+     * As above, but gives up the query with Status::Timeout once the token is cancelled.
+     *
+     * \see CancellationToken
+     */
+    Status Match(const MatchParameters &parameters,
+                 json::Object &result,
+                 const CancellationToken &token) const;
+
     /**
      * Tile: vector tiles with internal graph representation
      *
@@ -130,6 +176,15 @@ class OSRM final
      */
     Status Tile(const TileParameters &parameters, std::string &result) const;
 
+    /**
+     * As above, but gives up the query with Status::Timeout once the token is cancelled.
+     *
+     * \see CancellationToken
+     */
+    Status Tile(const TileParameters &parameters,
+                std::string &result,
+                const CancellationToken &token) const;
+
   private:
     std::unique_ptr<engine::Engine> engine_;
 };
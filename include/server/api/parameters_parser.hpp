@@ -6,6 +6,9 @@
 
 #include <boost/optional/optional.hpp>
 
+#include <cstddef>
+#include <cstdint>
+#include <string>
 #include <type_traits>
 
 namespace osrm
@@ -43,6 +46,27 @@ boost::optional<ParameterT> parseParameters(std::string options_string)
     return parseParameters<ParameterT>(first, last);
 }
 
+// Size of a coordinate in a request body: longitude and latitude as little-endian 32 bit
+// integers in fixed point (1e-6 degrees)
+const constexpr std::size_t BODY_COORDINATE_SIZE = 2 * sizeof(std::int32_t);
+
+// Parses only the format and the options of a request whose coordinates are sent in the body.
+// Implemented for the table, trip and match parameters.
+template <typename ParameterT,
+          typename std::enable_if<detail::is_parameter_t<ParameterT>::value, int>::type = 0>
+boost::optional<ParameterT> parseParameters(std::string::iterator &iter,
+                                            const std::string::iterator end,
+                                            const std::string &body);
+
+template <typename ParameterT,
+          typename std::enable_if<detail::is_parameter_t<ParameterT>::value, int>::type = 0>
+boost::optional<ParameterT> parseParameters(std::string options_string, const std::string &body)
+{
+    auto first = options_string.begin();
+    const auto last = options_string.end();
+    return parseParameters<ParameterT>(first, last, body);
+}
+
 } // ns api
 } // ns server
 } // ns osrm
@@ -0,0 +1,432 @@
+#ifndef SERVER_API_QUERY_PARSER_HPP
+#define SERVER_API_QUERY_PARSER_HPP
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <type_traits>
+#include <utility>
+
+namespace osrm
+{
+namespace server
+{
+namespace api
+{
+
+/**
+ * Single pass parser over a request buffer with the primitives of the service grammars.
+ *
+ * Every primitive either matches and advances the position or fails and leaves the position
+ * untouched. Expect() turns a failed match into an ExpectationFailure at the current position,
+ * which is how the parsers report the position of an invalid value. Nothing is copied, callers
+ * convert the matched values directly into the parameter structs.
+ */
+class QueryParser
+{
+  public:
+    using Iterator = std::string::iterator;
+
+    struct ExpectationFailure
+    {
+        Iterator position;
+    };
+
+    QueryParser(const Iterator begin, const Iterator end) : position(begin), end(end) {}
+
+    Iterator Position() const { return position; }
+    Iterator End() const { return end; }
+    void Reset(const Iterator position_) { position = position_; }
+    bool AtEnd() const { return position == end; }
+
+    void Expect(const bool matched) const
+    {
+        if (!matched)
+        {
+            throw ExpectationFailure{position};
+        }
+    }
+
+    bool Char(const char character)
+    {
+        if (position != end && *position == character)
+        {
+            ++position;
+            return true;
+        }
+        return false;
+    }
+
+    bool Literal(const char *literal)
+    {
+        auto iter = position;
+        for (; *literal != '\0'; ++literal, ++iter)
+        {
+            if (iter == end || *iter != *literal)
+            {
+                return false;
+            }
+        }
+        position = iter;
+        return true;
+    }
+
+    // Matches one or more characters accepted by `predicate`
+    template <typename Predicate> bool Many(Predicate &&predicate)
+    {
+        const auto begin = position;
+        while (position != end && predicate(*position))
+        {
+            ++position;
+        }
+        return position != begin;
+    }
+
+    // Matches exactly `count` characters accepted by `predicate`
+    template <typename Predicate> bool Repeat(const std::size_t count, Predicate &&predicate)
+    {
+        if (static_cast<std::size_t>(end - position) < count ||
+            !std::all_of(position, position + count, predicate))
+        {
+            return false;
+        }
+        position += count;
+        return true;
+    }
+
+    bool Bool(bool &value)
+    {
+        if (Literal("true"))
+        {
+            value = true;
+            return true;
+        }
+        if (Literal("false"))
+        {
+            value = false;
+            return true;
+        }
+        return false;
+    }
+
+    // Matches the longest of the `symbols`
+    template <typename T, std::size_t N>
+    bool Symbol(const std::pair<const char *, T> (&symbols)[N], T &value)
+    {
+        std::size_t longest_match = 0;
+        for (const auto &symbol : symbols)
+        {
+            const auto length = std::strlen(symbol.first);
+            if (length > longest_match && static_cast<std::size_t>(end - position) >= length &&
+                std::equal(symbol.first, symbol.first + length, position))
+            {
+                longest_match = length;
+                value = symbol.second;
+            }
+        }
+        position += longest_match;
+        return longest_match > 0;
+    }
+
+    // Decimal digits without a sign, fails on overflow
+    template <typename T> bool Unsigned(T &value)
+    {
+        static_assert(std::is_unsigned<T>::value, "use Signed for signed types");
+        return Digits<10>(value, 1, std::numeric_limits<std::size_t>::max());
+    }
+
+    // Exactly two hex digits, e.g. of a percent encoding. Fails if the value overflows T.
+    template <typename T> bool Hex(T &value) { return Digits<16>(value, 2, 2); }
+
+    // Decimal digits with an optional sign, fails on overflow
+    template <typename T> bool Signed(T &value)
+    {
+        static_assert(std::is_signed<T>::value, "use Unsigned for unsigned types");
+        const auto begin = position;
+        const bool negative = Char('-');
+        if (!negative)
+        {
+            Char('+');
+        }
+
+        std::uint64_t magnitude = 0;
+        const std::uint64_t limit =
+            static_cast<std::uint64_t>(std::numeric_limits<T>::max()) + (negative ? 1 : 0);
+        if (!Digits<10>(magnitude, 1, std::numeric_limits<std::size_t>::max()) ||
+            magnitude > limit)
+        {
+            position = begin;
+            return false;
+        }
+        value = negative ? static_cast<T>(-static_cast<std::int64_t>(magnitude))
+                         : static_cast<T>(magnitude);
+        return true;
+    }
+
+    // Floating point number with optional exponent, nan and inf
+    bool Double(double &value) { return Real<false>(value); }
+
+    // Floating point number without exponent, nan and inf. A dot followed by a format name
+    // ("json" or "cbor") is not parsed as decimal point, so "1,2;3,4.json" ends the last
+    // coordinate at the 4.
+    bool JsonDouble(double &value) { return Real<true>(value); }
+
+  private:
+    static int DigitValue(const char character, const unsigned radix)
+    {
+        int digit = -1;
+        if (character >= '0' && character <= '9')
+            digit = character - '0';
+        else if (character >= 'a' && character <= 'z')
+            digit = character - 'a' + 10;
+        else if (character >= 'A' && character <= 'Z')
+            digit = character - 'A' + 10;
+        return digit < static_cast<int>(radix) ? digit : -1;
+    }
+
+    template <unsigned Radix, typename T>
+    bool Digits(T &value, const std::size_t min_digits, const std::size_t max_digits)
+    {
+        auto iter = position;
+        T result = 0;
+        std::size_t count = 0;
+        for (; iter != end && count < max_digits; ++iter, ++count)
+        {
+            const auto digit = DigitValue(*iter, Radix);
+            if (digit < 0)
+            {
+                break;
+            }
+            if (result > (std::numeric_limits<T>::max() - digit) / static_cast<T>(Radix))
+            {
+                return false;
+            }
+            result = static_cast<T>(result * Radix + digit);
+        }
+        if (count < min_digits)
+        {
+            return false;
+        }
+        position = iter;
+        value = result;
+        return true;
+    }
+
+    // Correctly rounded powers of ten up to the largest finite one
+    static double Pow10(const int exponent)
+    {
+        static const auto powers = [] {
+            std::array<double, std::numeric_limits<double>::max_exponent10 + 1> powers;
+            for (std::size_t index = 0; index < powers.size(); ++index)
+            {
+                powers[index] = std::strtod(("1e" + std::to_string(index)).c_str(), nullptr);
+            }
+            return powers;
+        }();
+        return powers[exponent];
+    }
+
+    // Scales the significand by 10^exponent, fails if the result is out of range. Very small
+    // values are divided in two steps and keep the first quotient on failure.
+    static bool Scale(int exponent, const std::uint64_t significand, double &value)
+    {
+        const int max_exponent = std::numeric_limits<double>::max_exponent10;
+        const int min_exponent = std::numeric_limits<double>::min_exponent10;
+        if (exponent >= 0)
+        {
+            if (exponent > max_exponent)
+                return false;
+            value = significand * Pow10(exponent);
+        }
+        else if (exponent < min_exponent)
+        {
+            value = static_cast<double>((significand / 10) * 10);
+            value += static_cast<double>(significand % 10);
+            value /= Pow10(-min_exponent);
+            exponent -= min_exponent;
+            if (exponent < min_exponent)
+                return false;
+            value /= Pow10(-exponent);
+        }
+        else
+        {
+            value = static_cast<double>(significand) / Pow10(-exponent);
+        }
+        return true;
+    }
+
+    // Accumulates up to `max_digits` decimal digits into `significand`, stopping early if it
+    // would overflow. Returns the number of accumulated digits.
+    std::size_t Significand(std::uint64_t &significand, const std::size_t max_digits)
+    {
+        std::size_t count = 0;
+        for (; position != end && count < max_digits && *position >= '0' && *position <= '9';
+             ++position, ++count)
+        {
+            const unsigned digit = *position - '0';
+            if (significand > (std::numeric_limits<std::uint64_t>::max() - digit) / 10)
+            {
+                break;
+            }
+            significand = significand * 10 + digit;
+        }
+        return count;
+    }
+
+    // Skips decimal digits that do not fit into the significand, returns how many
+    int SkipDigits()
+    {
+        const auto begin = position;
+        while (position != end && *position >= '0' && *position <= '9')
+        {
+            ++position;
+        }
+        return static_cast<int>(position - begin);
+    }
+
+    bool CaseInsensitiveLiteral(const char *literal)
+    {
+        auto iter = position;
+        for (; *literal != '\0'; ++literal, ++iter)
+        {
+            if (iter == end || (*iter != *literal && *iter != *literal - 'a' + 'A'))
+            {
+                return false;
+            }
+        }
+        position = iter;
+        return true;
+    }
+
+    bool NanOrInf(double &value)
+    {
+        const auto begin = position;
+        if (CaseInsensitiveLiteral("nan"))
+        {
+            // an optional payload nan(...) has to be closed
+            if (Char('('))
+            {
+                position = std::find(position, end, ')');
+                if (!Char(')'))
+                {
+                    position = begin;
+                    return false;
+                }
+            }
+            value = std::numeric_limits<double>::quiet_NaN();
+            return true;
+        }
+        if (CaseInsensitiveLiteral("inf"))
+        {
+            CaseInsensitiveLiteral("inity");
+            value = std::numeric_limits<double>::infinity();
+            return true;
+        }
+        return false;
+    }
+
+    // Follows the rules of the Spirit real parsers the service grammars used to be written
+    // with, including their quirks, so requests keep parsing to the same values.
+    template <bool JsonPolicy> bool Real(double &value)
+    {
+        // the significand holds at most as many digits as a double can represent
+        const std::size_t max_integer_digits = 2 + std::numeric_limits<double>::digits * 30103l /
+                                                       100000l;
+
+        const auto begin = position;
+        bool negative = false;
+        if (position != end && (*position == '-' || *position == '+'))
+        {
+            negative = *position == '-';
+            ++position;
+        }
+
+        std::uint64_t significand = 0;
+        const bool got_a_number = Significand(significand, max_integer_digits) > 0;
+        int excess_digits = 0;
+        if (got_a_number)
+        {
+            excess_digits = SkipDigits();
+        }
+        else if (!JsonPolicy && NanOrInf(value))
+        {
+            value = negative ? -value : value;
+            return true;
+        }
+
+        int fraction_digits = 0;
+        const bool format_suffix = JsonPolicy && end - position > 4 &&
+                                   (std::equal(position + 1, position + 5, "json") ||
+                                    std::equal(position + 1, position + 5, "cbor"));
+        if (!format_suffix && Char('.'))
+        {
+            if (excess_digits != 0)
+            {
+                SkipDigits();
+            }
+            else if (position != end && *position >= '0' && *position <= '9')
+            {
+                fraction_digits = static_cast<int>(
+                    Significand(significand, std::numeric_limits<std::size_t>::max()));
+                SkipDigits();
+            }
+            else if (!got_a_number)
+            {
+                position = begin;
+                return false;
+            }
+        }
+        else if (!got_a_number)
+        {
+            position = begin;
+            return false;
+        }
+
+        const auto exponent_begin = position;
+        if (!JsonPolicy && (Char('e') || Char('E')))
+        {
+            int exponent = 0;
+            if (Signed(exponent))
+            {
+                // out of range values fail without resetting the position
+                if (!Scale(exponent + excess_digits - fraction_digits, significand, value))
+                    return false;
+            }
+            else
+            {
+                // no exponent after all, the e belongs to whatever follows
+                position = exponent_begin;
+                Scale(-fraction_digits, significand, value);
+            }
+        }
+        else if (fraction_digits != 0)
+        {
+            Scale(-fraction_digits, significand, value);
+        }
+        else if (excess_digits != 0)
+        {
+            if (!Scale(excess_digits, significand, value))
+                return false;
+        }
+        else
+        {
+            value = static_cast<double>(significand);
+        }
+
+        value = negative ? -value : value;
+        return true;
+    }
+
+    Iterator position;
+    const Iterator end;
+};
+}
+}
+}
+
+#endif
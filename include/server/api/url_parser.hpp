@@ -22,6 +22,17 @@ inline boost::optional<ParsedURL> parseURL(std::string url_string)
     auto iter = url_string.begin();
     return parseURL(iter, url_string.end());
 }
+
+// Parses the URL of a request that sends its coordinates in the body: the query holds only
+// the format and the options and is either empty or starts with '.' or '?'
+boost::optional<ParsedURL> parseBodyURL(std::string::iterator &iter,
+                                        const std::string::iterator end);
+
+inline boost::optional<ParsedURL> parseBodyURL(std::string url_string)
+{
+    auto iter = url_string.begin();
+    return parseBodyURL(iter, url_string.end());
+}
 }
 }
 }
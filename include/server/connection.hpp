@@ -52,6 +52,14 @@ class Connection : public std::enable_shared_from_this<Connection>
     /// Handle completion of a write operation.
     void handle_write(const boost::system::error_code &e);
 
+    /// Continue reading the request body after the 100 Continue response has been sent.
+    void handle_continue(const boost::system::error_code &e);
+
+    void read_some();
+
+    /// Returns true if the client closed the connection while its request is handled.
+    bool is_closed();
+
     std::vector<char> compress_buffers(const std::vector<char> &uncompressed_data,
                                        const http::compression_type compression_type);
 
@@ -62,6 +70,7 @@ class Connection : public std::enable_shared_from_this<Connection>
     boost::array<char, 8192> incoming_data_buffer;
     http::request current_request;
     http::reply current_reply;
+    bool sent_continue;
     std::vector<char> compressed_output;
     // Header compression_header;
     std::vector<boost::asio::const_buffer> output_buffer;
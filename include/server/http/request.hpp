@@ -3,6 +3,7 @@
 
 #include <boost/asio.hpp>
 
+#include <chrono>
 #include <string>
 
 namespace osrm
@@ -14,10 +15,14 @@ namespace http
 
 struct request
 {
+    std::string method;
     std::string uri;
     std::string referrer;
     std::string agent;
+    std::string body;
     boost::asio::ip::address endpoint;
+    // when the connection was accepted, the epoch if unknown
+    std::chrono::steady_clock::time_point accept_time;
 };
 }
 }
@@ -3,6 +3,7 @@
 
 #include "server/service_handler.hpp"
 
+#include <functional>
 #include <string>
 
 namespace osrm
@@ -20,16 +21,26 @@ class RequestHandler
 {
 
   public:
-    RequestHandler() = default;
+    // Requests that take longer than `max_request_duration` milliseconds are given up, -1 for no
+    // limit
+    explicit RequestHandler(const int max_request_duration = -1)
+        : max_request_duration(max_request_duration)
+    {
+    }
     RequestHandler(const RequestHandler &) = delete;
     RequestHandler &operator=(const RequestHandler &) = delete;
 
     void RegisterServiceHandler(std::unique_ptr<ServiceHandlerInterface> service_handler);
 
-    void HandleRequest(const http::request &current_request, http::reply &current_reply);
+    // The request is given up once `is_connection_closed` returns true, it is polled while the
+    // query runs
+    void HandleRequest(const http::request &current_request,
+                       http::reply &current_reply,
+                       std::function<bool()> is_connection_closed = {});
 
   private:
     std::unique_ptr<ServiceHandlerInterface> service_handler;
+    const int max_request_duration;
 };
 }
 }
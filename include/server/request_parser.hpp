@@ -4,6 +4,7 @@
 #include "server/http/compression_type.hpp"
 #include "server/http/header.hpp"
 
+#include <cstddef>
 #include <tuple>
 
 namespace osrm
@@ -28,9 +29,15 @@ class RequestParser
         indeterminate
     };
 
+    // Requests with a body larger than this are rejected as invalid
+    static const constexpr std::size_t MAX_CONTENT_LENGTH = 16 * 1024 * 1024;
+
     std::tuple<RequestStatus, http::compression_type>
     parse(http::request &current_request, char *begin, char *end);
 
+    // True if the client waits for a 100 Continue response before it sends the body
+    bool expects_continue() const;
+
   private:
     RequestStatus consume(http::request &current_request, const char input);
 
@@ -64,11 +71,14 @@ class RequestParser
         space_before_header_value,
         header_value,
         expecting_newline_2,
-        expecting_newline_3
+        expecting_newline_3,
+        content
     } state;
 
     http::header current_header;
     http::compression_type selected_compression;
+    std::size_t content_length;
+    bool expect_continue;
 };
 }
 }
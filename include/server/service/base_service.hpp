@@ -1,9 +1,13 @@
 #ifndef SERVER_SERVICE_BASE_SERVICE_HPP
 #define SERVER_SERVICE_BASE_SERVICE_HPP
 
+#include "engine/api/base_parameters.hpp"
+#include "engine/cancellation_token.hpp"
 #include "engine/status.hpp"
 #include "osrm/osrm.hpp"
+#include "util/cbor_renderer.hpp"
 #include "util/coordinate.hpp"
+#include "util/json_container.hpp"
 
 #include <mapbox/variant.hpp>
 
@@ -20,17 +24,61 @@ namespace service
 class BaseService
 {
   public:
-    using ResultT = mapbox::util::variant<util::json::Object, std::string>;
+    using ResultT =
+        mapbox::util::variant<util::json::Object, std::string, util::cbor::Document>;
 
     BaseService(OSRM &routing_machine) : routing_machine(routing_machine) {}
     virtual ~BaseService() = default;
 
-    virtual engine::Status
-    RunQuery(std::size_t prefix_length, std::string &query, ResultT &result) = 0;
+    // The query is given up with engine::Status::Timeout once the token is cancelled
+    virtual engine::Status RunQuery(std::size_t prefix_length,
+                                    std::string &query,
+                                    ResultT &result,
+                                    const engine::CancellationToken &token)
+    {
+        return Run(prefix_length, query, nullptr, result, token);
+    }
+
+    // Runs a query whose coordinates were sent in the request body, see api::parseBodyURL
+    virtual engine::Status RunBodyQuery(std::size_t prefix_length,
+                                        std::string &query,
+                                        const std::string &body,
+                                        ResultT &result,
+                                        const engine::CancellationToken &token)
+    {
+        return Run(prefix_length, query, &body, result, token);
+    }
 
     virtual unsigned GetVersion() = 0;
 
   protected:
+    // Services that accept coordinates in the request body implement this instead of RunQuery,
+    // it reads the coordinates from the body if there is one and from the query otherwise
+    virtual engine::Status Run(std::size_t /*prefix_length*/,
+                               std::string & /*query*/,
+                               const std::string * /*body*/,
+                               ResultT &result,
+                               const engine::CancellationToken & /*token*/)
+    {
+        result = util::json::Object();
+        auto &json_result = result.get<util::json::Object>();
+        json_result.values["code"] = "InvalidService";
+        json_result.values["message"] = "Service does not accept coordinates in the request body";
+        return engine::Status::Error;
+    }
+
+    // Replaces a JSON result by its encoding in the output format requested by the client
+    static void EncodeResult(const engine::api::BaseParameters::OutputFormatType format,
+                             ResultT &result)
+    {
+        if (format == engine::api::BaseParameters::OutputFormatType::CBOR)
+        {
+            util::cbor::Document document;
+            util::cbor::render(document.buffer, result.get<util::json::Object>());
+            result = std::move(document);
+        }
+    }
+
     OSRM &routing_machine;
 };
 }
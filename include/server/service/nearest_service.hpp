@@ -22,8 +22,10 @@ class NearestService final : public BaseService
   public:
     NearestService(OSRM &routing_machine) : BaseService(routing_machine) {}
 
-    engine::Status
-    RunQuery(std::size_t prefix_length, std::string &query, ResultT &result) final override;
+    engine::Status RunQuery(std::size_t prefix_length,
+                            std::string &query,
+                            ResultT &result,
+                            const engine::CancellationToken &token) final override;
 
     unsigned GetVersion() final override { return 1; }
 };
@@ -22,10 +22,14 @@ class TableService final : public BaseService
   public:
     TableService(OSRM &routing_machine) : BaseService(routing_machine) {}
 
-    engine::Status
-    RunQuery(std::size_t prefix_length, std::string &query, ResultT &result) final override;
-
     unsigned GetVersion() final override { return 1; }
+
+  private:
+    engine::Status Run(std::size_t prefix_length,
+                       std::string &query,
+                       const std::string *body,
+                       ResultT &result,
+                       const engine::CancellationToken &token) final override;
 };
 }
 }
@@ -5,6 +5,7 @@
 
 #include "osrm/osrm.hpp"
 
+#include <string>
 #include <unordered_map>
 
 namespace osrm
@@ -28,7 +29,13 @@ class ServiceHandlerInterface
   public:
     virtual ~ServiceHandlerInterface() {}
     virtual engine::Status RunQuery(api::ParsedURL parsed_url,
-                                    service::BaseService::ResultT &result) = 0;
+                                    service::BaseService::ResultT &result,
+                                    const engine::CancellationToken &token) = 0;
+    // Runs a query that sent its coordinates in the request body
+    virtual engine::Status RunQuery(api::ParsedURL parsed_url,
+                                    const std::string &body,
+                                    service::BaseService::ResultT &result,
+                                    const engine::CancellationToken &token) = 0;
 };
 
 class ServiceHandler final : public ServiceHandlerInterface
@@ -37,9 +44,17 @@ class ServiceHandler final : public ServiceHandlerInterface
     ServiceHandler(osrm::EngineConfig &config);
     using ResultT = service::BaseService::ResultT;
 
-    virtual engine::Status RunQuery(api::ParsedURL parsed_url, ResultT &result) override;
+    virtual engine::Status RunQuery(api::ParsedURL parsed_url,
+                                    ResultT &result,
+                                    const engine::CancellationToken &token) override;
+    virtual engine::Status RunQuery(api::ParsedURL parsed_url,
+                                    const std::string &body,
+                                    ResultT &result,
+                                    const engine::CancellationToken &token) override;
 
   private:
+    service::BaseService *FindService(const api::ParsedURL &parsed_url, ResultT &result);
+
     std::unordered_map<std::string, std::unique_ptr<service::BaseService>> service_map;
     OSRM routing_machine;
 };
@@ -1,6 +1,7 @@
 #ifndef OSRM_STORAGE_SERIALIZATION_HPP_
 #define OSRM_STORAGE_SERIALIZATION_HPP_
 
+#include "contractor/compact_query_graph.hpp"
 #include "contractor/query_edge.hpp"
 #include "extractor/extractor.hpp"
 #include "extractor/original_edge_data.hpp"
@@ -9,15 +10,18 @@
 #include "util/exception.hpp"
 #include "util/fingerprint.hpp"
 #include "util/log.hpp"
+#include "util/packed_coordinate_vector.hpp"
 #include "util/static_graph.hpp"
 
 #include <boost/filesystem/fstream.hpp>
 #include <boost/iostreams/seek.hpp>
 
+#include <algorithm>
 #include <cerrno>
 #include <cstring>
 #include <tuple>
 #include <type_traits>
+#include <vector>
 
 namespace osrm
 {
@@ -61,20 +65,36 @@ inline HSGRHeader readHSGRHeader(io::FileReader &input_file)
     return header;
 }
 
-// Reads the graph data of a `.hsgr` file into memory
+// Reads the graph data of a `.hsgr` file into the split edge arrays of a CompactQueryGraph
 // Needs to be called after readHSGRHeader() to get the correct offset in the stream
-using NodeT = typename util::StaticGraph<contractor::QueryEdge::EdgeData>::NodeArrayEntry;
 using EdgeT = typename util::StaticGraph<contractor::QueryEdge::EdgeData>::EdgeArrayEntry;
+using CompactGraph = contractor::CompactQueryGraph<true>;
 inline void readHSGR(io::FileReader &input_file,
-                     NodeT *node_buffer,
+                     CompactGraph::NodeArrayEntry *node_buffer,
                      const std::uint64_t number_of_nodes,
-                     EdgeT *edge_buffer,
+                     CompactGraph::EdgeArrayEntry *edge_buffer,
+                     CompactGraph::EdgeIDEntry *edge_id_buffer,
                      const std::uint64_t number_of_edges)
 {
     BOOST_ASSERT(node_buffer);
     BOOST_ASSERT(edge_buffer);
+    BOOST_ASSERT(edge_id_buffer);
     input_file.ReadInto(node_buffer, number_of_nodes);
-    input_file.ReadInto(edge_buffer, number_of_edges);
+
+    // the edges are split in chunks, so we don't need to hold the whole edge list of the file
+    const constexpr std::uint64_t CHUNK_SIZE = 1024 * 1024;
+    std::vector<EdgeT> chunk;
+    for (std::uint64_t begin = 0; begin < number_of_edges; begin += CHUNK_SIZE)
+    {
+        const auto size = std::min(CHUNK_SIZE, number_of_edges - begin);
+        chunk.resize(size);
+        input_file.ReadInto(chunk.data(), size);
+        for (std::uint64_t index = 0; index < size; ++index)
+        {
+            CompactGraph::Split(
+                chunk[index], edge_buffer[begin + index], edge_id_buffer[begin + index]);
+        }
+    }
 }
 
 // Loads datasource_indexes from .datasource_indexes into memory
@@ -123,6 +143,22 @@ inline void readEdges(io::FileReader &edges_input_file,
     }
 }
 
+// Returns the number of words the coordinates of a .nodes file take when packed into a
+// util::PackedCoordinateVector
+// Needs to be called after readElementCount() to get the correct offset in the stream
+inline std::uint64_t readPackedCoordinatesSize(io::FileReader &nodes_file,
+                                               const std::uint64_t number_of_coordinates)
+{
+    util::PackedCoordinateEncoder encoder(number_of_coordinates);
+    extractor::QueryNode current_node;
+    for (std::uint64_t i = 0; i < number_of_coordinates; ++i)
+    {
+        nodes_file.ReadInto(current_node);
+        encoder.push_back(util::Coordinate(current_node.lon, current_node.lat));
+    }
+    return encoder.Finish();
+}
+
 // Loads coordinates and OSM node IDs from .nodes files into memory
 // Needs to be called after readElementCount() to get the correct offset in the stream
 template <typename OSMNodeIDVectorT>
@@ -142,6 +178,29 @@ void readNodes(io::FileReader &nodes_file,
     }
 }
 
+// Loads coordinates and OSM node IDs from .nodes files into memory, the coordinates are packed
+// into the words of a util::PackedCoordinateVector
+// Needs to be called after readElementCount() to get the correct offset in the stream
+template <typename OSMNodeIDVectorT>
+void readNodes(io::FileReader &nodes_file,
+               std::uint64_t *packed_coordinates,
+               OSMNodeIDVectorT &osmnodeid_list,
+               const std::uint64_t number_of_coordinates)
+{
+    BOOST_ASSERT(packed_coordinates);
+    util::PackedCoordinateEncoder encoder(number_of_coordinates, packed_coordinates);
+    extractor::QueryNode current_node;
+    for (std::uint64_t i = 0; i < number_of_coordinates; ++i)
+    {
+        nodes_file.ReadInto(current_node);
+        const util::Coordinate coordinate(current_node.lon, current_node.lat);
+        BOOST_ASSERT(coordinate.IsValid());
+        encoder.push_back(coordinate);
+        osmnodeid_list.push_back(current_node.node_id);
+    }
+    encoder.Finish();
+}
+
 // Reads datasource names out of .datasource_names files and metadata such as
 // the length and offset of each name
 struct DatasourceNamesData
@@ -1,34 +1,23 @@
 #ifndef SHARED_BARRIERS_HPP
 #define SHARED_BARRIERS_HPP
 
-#include <boost/interprocess/sync/named_sharable_mutex.hpp>
-#include <boost/interprocess/sync/named_upgradable_mutex.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
 
 namespace osrm
 {
 namespace storage
 {
 
+// Serializes osrm-datastore processes that update the shared memory regions. Queries do not
+// lock anything, they read the current regions from SharedCurrentRegions.
 struct SharedBarriers
 {
 
-    SharedBarriers()
-        : current_regions_mutex(boost::interprocess::open_or_create, "current_regions"),
-          regions_1_mutex(boost::interprocess::open_or_create, "regions_1"),
-          regions_2_mutex(boost::interprocess::open_or_create, "regions_2")
-    {
-    }
+    SharedBarriers() : datastore_mutex(boost::interprocess::open_or_create, "osrm-datastore") {}
 
-    static void resetCurrentRegions()
-    {
-        boost::interprocess::named_sharable_mutex::remove("current_regions");
-    }
-    static void resetRegions1() { boost::interprocess::named_sharable_mutex::remove("regions_1"); }
-    static void resetRegions2() { boost::interprocess::named_sharable_mutex::remove("regions_2"); }
+    static void resetDatastore() { boost::interprocess::named_mutex::remove("osrm-datastore"); }
 
-    boost::interprocess::named_upgradable_mutex current_regions_mutex;
-    boost::interprocess::named_sharable_mutex regions_1_mutex;
-    boost::interprocess::named_sharable_mutex regions_2_mutex;
+    boost::interprocess::named_mutex datastore_mutex;
 };
 }
 }
@@ -3,9 +3,11 @@
 
 #include "util/exception.hpp"
 #include "util/exception_utils.hpp"
+#include "util/fingerprint.hpp"
 #include "util/log.hpp"
 
 #include <array>
+#include <atomic>
 #include <cstdint>
 
 namespace osrm
@@ -52,7 +54,10 @@ const constexpr char *block_id_to_name[] = {"NAME_OFFSETS",
                                             "POST_TURN_BEARING",
                                             "TURN_LANE_DATA",
                                             "LANE_DESCRIPTION_OFFSETS",
-                                            "LANE_DESCRIPTION_MASKS"};
+                                            "LANE_DESCRIPTION_MASKS",
+                                            "CORE_LANDMARK_RANKS",
+                                            "CORE_LANDMARK_DISTANCES",
+                                            "GRAPH_EDGE_ID_LIST"};
 
 struct DataLayout
 {
@@ -95,14 +100,25 @@ struct DataLayout
         TURN_LANE_DATA,
         LANE_DESCRIPTION_OFFSETS,
         LANE_DESCRIPTION_MASKS,
+        CORE_LANDMARK_RANKS,
+        CORE_LANDMARK_DISTANCES,
+        GRAPH_EDGE_ID_LIST,
         NUM_BLOCKS
     };
 
     std::array<std::uint64_t, NUM_BLOCKS> num_entries;
     std::array<std::size_t, NUM_BLOCKS> entry_size;
     std::array<std::size_t, NUM_BLOCKS> entry_align;
+    // bit width of the node IDs in GEOMETRIES_NODE_LIST
+    std::uint8_t geometry_node_bits;
+    // COORDINATE_LIST holds the words of a util::PackedCoordinateVector instead of coordinates
+    bool packed_coordinates;
 
-    DataLayout() : num_entries(), entry_size(), entry_align() {}
+    DataLayout()
+        : num_entries(), entry_size(), entry_align(), geometry_node_bits(0),
+          packed_coordinates(false)
+    {
+    }
 
     template <typename T> inline void SetBlockSize(BlockID bid, uint64_t entries)
     {
@@ -190,6 +206,22 @@ struct DataLayout
     }
 };
 
+// Header of a dataset file written by osrm-datastore --dataset. The data block is laid out
+// exactly like the shared memory block and starts at a page aligned offset, so the file can be
+// mapped and used in place.
+struct DatasetHeader
+{
+    // offset of the data block, large enough for the header on all platforms
+    static constexpr std::uint64_t DATA_OFFSET = 64 * 1024;
+
+    util::FingerPrint fingerprint;
+    std::uint64_t data_offset;
+    std::uint64_t data_size;
+    DataLayout layout;
+};
+static_assert(sizeof(DatasetHeader) <= DatasetHeader::DATA_OFFSET,
+              "DatasetHeader does not fit in front of the data block");
+
 enum SharedDataType
 {
     CURRENT_REGIONS,
@@ -208,6 +240,36 @@ struct SharedDataTimestamp
     unsigned timestamp;
 };
 
+// Contents of the CURRENT_REGIONS block. The regions of the newest dataset are packed into a
+// single word, so osrm-datastore can publish a new dataset with one store and queries can read
+// a consistent snapshot without taking a cross-process lock.
+class SharedCurrentRegions
+{
+  public:
+    SharedDataTimestamp Load() const
+    {
+        const std::uint64_t value = packed.load(std::memory_order_acquire);
+        return SharedDataTimestamp{static_cast<SharedDataType>(value >> 48),
+                                   static_cast<SharedDataType>((value >> 32) & 0xffff),
+                                   static_cast<unsigned>(value & 0xffffffff)};
+    }
+
+    // All writes to the regions need to happen before they are published here
+    void Store(const SharedDataTimestamp &timestamp)
+    {
+        const std::uint64_t value = static_cast<std::uint64_t>(timestamp.layout) << 48 |
+                                    static_cast<std::uint64_t>(timestamp.data) << 32 |
+                                    static_cast<std::uint32_t>(timestamp.timestamp);
+        packed.store(value, std::memory_order_release);
+    }
+
+  private:
+    std::atomic<std::uint64_t> packed;
+};
+
+static_assert(ATOMIC_LLONG_LOCK_FREE == 2,
+              "The current regions need lock-free 64 bit atomics to be shared between processes");
+
 inline std::string regionToString(const SharedDataType region)
 {
     switch (region)
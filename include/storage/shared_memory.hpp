@@ -15,14 +15,19 @@
 #endif
 
 #ifdef __linux__
+#include <linux/mempolicy.h>
 #include <sys/ipc.h>
 #include <sys/shm.h>
+#include <sys/syscall.h>
+#include <unistd.h>
 #endif
 
 // #include <cstring>
 #include <cstdint>
 
 #include <algorithm>
+#include <cerrno>
+#include <cstring>
 #include <exception>
 
 namespace osrm
@@ -40,6 +45,28 @@ struct OSRMLockFile
     }
 };
 
+// How newly created shared memory regions are backed. Huge pages need to be reserved by the
+// administrator (vm.nr_hugepages), interleaving spreads the pages over all NUMA nodes the process
+// may allocate from. Both only have an effect on Linux.
+struct MemoryPlacement
+{
+    enum class HugePages
+    {
+        None,
+        Pages2MB,
+        Pages1GB
+    };
+
+    enum class NUMAPolicy
+    {
+        Local,
+        Interleave
+    };
+
+    HugePages huge_pages = HugePages::None;
+    NUMAPolicy numa_policy = NUMAPolicy::Local;
+};
+
 #ifndef _WIN32
 class SharedMemory
 {
@@ -53,7 +80,8 @@ class SharedMemory
     SharedMemory(const boost::filesystem::path &lock_file,
                  const IdentifierT id,
                  const uint64_t size = 0,
-                 bool read_write = false)
+                 bool read_write = false,
+                 const MemoryPlacement placement = {})
         : key(lock_file.string().c_str(), id)
     {
         const auto access =
@@ -70,6 +98,12 @@ class SharedMemory
         // open or create
         else
         {
+#ifdef __linux__
+            if (placement.huge_pages != MemoryPlacement::HugePages::None)
+            {
+                CreateWithHugePages(size, placement.huge_pages);
+            }
+#endif
             shm = boost::interprocess::xsi_shared_memory(
                 boost::interprocess::open_or_create, key, size);
             util::Log(logDEBUG) << "opening/creating " << shm.get_shmid() << " from id " << id
@@ -84,15 +118,23 @@ class SharedMemory
             }
 #endif
             region = boost::interprocess::mapped_region(shm, access);
+#ifdef __linux__
+            // pages are only allocated on first touch, so the policy applies to all of them
+            if (placement.numa_policy == MemoryPlacement::NUMAPolicy::Interleave)
+            {
+                Interleave();
+            }
+#endif
         }
     }
 
-    template <typename IdentifierT> static bool RegionExists(const IdentifierT id)
+    template <typename IdentifierT, typename LockFileT = OSRMLockFile>
+    static bool RegionExists(const IdentifierT id)
     {
         bool result = true;
         try
         {
-            OSRMLockFile lock_file;
+            LockFileT lock_file;
             boost::interprocess::xsi_key key(lock_file().string().c_str(), id);
             result = RegionExists(key);
         }
@@ -103,14 +145,59 @@ class SharedMemory
         return result;
     }
 
-    template <typename IdentifierT> static bool Remove(const IdentifierT id)
+    template <typename IdentifierT, typename LockFileT = OSRMLockFile>
+    static bool Remove(const IdentifierT id)
     {
-        OSRMLockFile lock_file;
+        LockFileT lock_file;
         boost::interprocess::xsi_key key(lock_file().string().c_str(), id);
         return Remove(key);
     }
 
   private:
+#ifdef __linux__
+    // Creates the region backed by huge pages. If the kernel can not provide them the region is
+    // created with normal pages afterwards.
+    void CreateWithHugePages(const uint64_t size, const MemoryPlacement::HugePages huge_pages)
+    {
+        const bool use_1gb_pages = huge_pages == MemoryPlacement::HugePages::Pages1GB;
+        const uint64_t page_size = use_1gb_pages ? (1ULL << 30) : (1ULL << 21);
+        const uint64_t rounded_size = (size + page_size - 1) / page_size * page_size;
+
+        // the page size is encoded in the flags, see shmget(2)
+        const int page_size_flag = (use_1gb_pages ? 30 : 21) << 26;
+        const int flags = IPC_CREAT | 0644 | SHM_HUGETLB | page_size_flag;
+        if (-1 == shmget(key.get_key(), rounded_size, flags))
+        {
+            util::Log(logWARNING) << "could not allocate shared memory in huge pages ("
+                                  << std::strerror(errno) << "), using normal pages";
+        }
+    }
+
+    // Interleaves the pages of the region over all NUMA nodes we are allowed to use
+    void Interleave()
+    {
+        unsigned long nodemask[16] = {};
+        const unsigned long maxnode = sizeof(nodemask) * 8;
+        if (-1 == syscall(SYS_get_mempolicy,
+                          nullptr,
+                          nodemask,
+                          maxnode,
+                          nullptr,
+                          MPOL_F_MEMS_ALLOWED) ||
+            -1 == syscall(SYS_mbind,
+                          region.get_address(),
+                          region.get_size(),
+                          MPOL_INTERLEAVE,
+                          nodemask,
+                          maxnode,
+                          0))
+        {
+            util::Log(logWARNING) << "could not interleave shared memory over NUMA nodes ("
+                                  << std::strerror(errno) << ")";
+        }
+    }
+#endif
+
     static bool RegionExists(const boost::interprocess::xsi_key &key)
     {
         bool result = true;
@@ -154,8 +241,15 @@ class SharedMemory
     SharedMemory(const boost::filesystem::path &lock_file,
                  const int id,
                  const uint64_t size = 0,
-                 bool read_write = false)
+                 bool read_write = false,
+                 const MemoryPlacement placement = {})
     {
+        if (placement.huge_pages != MemoryPlacement::HugePages::None ||
+            placement.numa_policy != MemoryPlacement::NUMAPolicy::Local)
+        {
+            util::Log(logWARNING) << "memory placement options are not supported on Windows";
+        }
+
         sprintf(key, "%s.%d", "osrm.lock", id);
         auto access = read_write ? boost::interprocess::read_write : boost::interprocess::read_only;
         if (0 == size)
@@ -231,8 +325,10 @@ class SharedMemory
 #endif
 
 template <typename IdentifierT, typename LockFileT = OSRMLockFile>
-std::unique_ptr<SharedMemory>
-makeSharedMemory(const IdentifierT &id, const uint64_t size = 0, bool read_write = false)
+std::unique_ptr<SharedMemory> makeSharedMemory(const IdentifierT &id,
+                                               const uint64_t size = 0,
+                                               bool read_write = false,
+                                               const MemoryPlacement placement = {})
 {
     try
     {
@@ -248,7 +344,7 @@ makeSharedMemory(const IdentifierT &id, const uint64_t size = 0, bool read_write
                 boost::filesystem::ofstream ofs(lock_file());
             }
         }
-        return std::make_unique<SharedMemory>(lock_file(), id, size, read_write);
+        return std::make_unique<SharedMemory>(lock_file(), id, size, read_write, placement);
     }
     catch (const boost::interprocess::interprocess_exception &e)
     {
@@ -29,6 +29,7 @@ SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #define STORAGE_HPP
 
 #include "storage/shared_datatype.hpp"
+#include "storage/shared_memory.hpp"
 #include "storage/storage_config.hpp"
 
 #include <boost/filesystem/path.hpp>
@@ -42,22 +43,25 @@ namespace storage
 class Storage
 {
   public:
-    Storage(StorageConfig config);
+    Storage(StorageConfig config, MemoryPlacement placement = {});
 
     enum ReturnCode
     {
         Ok,
-        Error,
-        Retry
+        Error
     };
 
-    ReturnCode Run(int max_wait);
+    ReturnCode Run();
 
     void PopulateLayout(DataLayout &layout);
     void PopulateData(const DataLayout &layout, char *memory_ptr);
 
+    // Writes the layout and the data into a dataset file that can be mapped directly
+    void WriteDataset(const boost::filesystem::path &dataset_path);
+
   private:
     StorageConfig config;
+    MemoryPlacement placement;
 };
 }
 }
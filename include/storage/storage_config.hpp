@@ -58,6 +58,7 @@ struct StorageConfig final
     boost::filesystem::path nodes_data_path;
     boost::filesystem::path edges_data_path;
     boost::filesystem::path core_data_path;
+    boost::filesystem::path core_landmarks_path;
     boost::filesystem::path geometries_path;
     boost::filesystem::path timestamp_path;
     boost::filesystem::path datasource_names_path;
@@ -67,6 +68,7 @@ struct StorageConfig final
     boost::filesystem::path intersection_class_path;
     boost::filesystem::path turn_lane_data_path;
     boost::filesystem::path turn_lane_description_path;
+    boost::filesystem::path dataset_path;
 };
 }
 }
@@ -0,0 +1,121 @@
+#ifndef OSRM_UTIL_BIT_PACKED_VECTOR_HPP
+#define OSRM_UTIL_BIT_PACKED_VECTOR_HPP
+
+#include "util/shared_memory_vector_wrapper.hpp"
+
+#include <boost/assert.hpp>
+
+#include <cstdint>
+#include <type_traits>
+
+namespace osrm
+{
+namespace util
+{
+
+/**
+ * Stores unsigned integers with a fixed number of bits chosen at runtime, e.g. node IDs with
+ * just enough bits for the number of nodes of a dataset. Elements may span two 64 bit words, so
+ * an access reads at most two words.
+ *
+ * Unlike PackedVector elements can be written in any order, which allows filling a shared memory
+ * block of known size in place.
+ */
+template <typename T, bool UseSharedMemory = false> class BitPackedVector
+{
+    static const constexpr std::uint64_t WORD_BITS = 64;
+
+  public:
+    // Number of bits needed to store all values up to and including `max_value`
+    static std::uint8_t GetBitsFor(std::uint64_t max_value)
+    {
+        std::uint8_t bits = 1;
+        while (bits < WORD_BITS && (max_value >> bits) != 0)
+        {
+            ++bits;
+        }
+        return bits;
+    }
+
+    static std::uint64_t GetNumberOfWords(const std::uint64_t number_of_elements,
+                                          const std::uint8_t bits)
+    {
+        return (number_of_elements * bits + WORD_BITS - 1) / WORD_BITS;
+    }
+
+    BitPackedVector() = default;
+
+    template <bool enabled = UseSharedMemory>
+    BitPackedVector(typename std::enable_if<!enabled, std::uint64_t>::type number_of_elements,
+                    const std::uint8_t bits)
+        : words(GetNumberOfWords(number_of_elements, bits)), number_of_elements(number_of_elements),
+          bits(bits)
+    {
+        BOOST_ASSERT(bits > 0 && bits <= WORD_BITS);
+    }
+
+    template <bool enabled = UseSharedMemory>
+    void reset(typename std::enable_if<enabled, std::uint64_t>::type *ptr,
+               const std::uint64_t number_of_elements_,
+               const std::uint8_t bits_)
+    {
+        BOOST_ASSERT(bits_ > 0 && bits_ <= WORD_BITS);
+        words.reset(ptr, GetNumberOfWords(number_of_elements_, bits_));
+        number_of_elements = number_of_elements_;
+        bits = bits_;
+    }
+
+    T operator[](const std::uint64_t index) const
+    {
+        BOOST_ASSERT(index < number_of_elements);
+        const std::uint64_t first_bit = index * bits;
+        const std::uint64_t word = first_bit / WORD_BITS;
+        const std::uint64_t offset = first_bit % WORD_BITS;
+
+        std::uint64_t value = words[word] >> offset;
+        if (offset + bits > WORD_BITS)
+        {
+            value |= words[word + 1] << (WORD_BITS - offset);
+        }
+        return static_cast<T>(value & Mask());
+    }
+
+    void set(const std::uint64_t index, const T element)
+    {
+        BOOST_ASSERT(index < number_of_elements);
+        const std::uint64_t value = static_cast<std::uint64_t>(element);
+        BOOST_ASSERT_MSG((value & ~Mask()) == 0, "value does not fit into the packed bits");
+
+        const std::uint64_t first_bit = index * bits;
+        const std::uint64_t word = first_bit / WORD_BITS;
+        const std::uint64_t offset = first_bit % WORD_BITS;
+
+        words[word] = (words[word] & ~(Mask() << offset)) | (value << offset);
+        if (offset + bits > WORD_BITS)
+        {
+            const std::uint64_t written_bits = WORD_BITS - offset;
+            words[word + 1] = (words[word + 1] & ~(Mask() >> written_bits)) |
+                              (value >> written_bits);
+        }
+    }
+
+    std::uint64_t size() const { return number_of_elements; }
+
+    bool empty() const { return number_of_elements == 0; }
+
+    std::uint8_t GetBits() const { return bits; }
+
+  private:
+    std::uint64_t Mask() const
+    {
+        return bits == WORD_BITS ? ~std::uint64_t{0} : (std::uint64_t{1} << bits) - 1;
+    }
+
+    typename util::ShM<std::uint64_t, UseSharedMemory>::vector words;
+    std::uint64_t number_of_elements = 0;
+    std::uint8_t bits = WORD_BITS;
+};
+}
+}
+
+#endif
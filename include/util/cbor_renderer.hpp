@@ -0,0 +1,159 @@
+#ifndef CBOR_RENDERER_HPP
+#define CBOR_RENDERER_HPP
+
+#include "osrm/json_container.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+namespace cbor
+{
+
+// A response encoded as CBOR (RFC 7049)
+struct Document
+{
+    std::vector<char> buffer;
+};
+
+// Encodes the JSON types as their CBOR counterparts. Numbers without a fractional part are
+// written as integers and all others as single precision floats if that is lossless and as
+// double precision floats otherwise. Unlike rendering JSON text no number is formatted.
+struct Renderer
+{
+    explicit Renderer(std::vector<char> &_out) : out(_out) {}
+
+    void operator()(const json::String &string) const
+    {
+        head(TEXT_STRING, string.value.size());
+        out.insert(out.end(), string.value.begin(), string.value.end());
+    }
+
+    void operator()(const json::Number &number) const
+    {
+        const auto value = number.value;
+        // integers up to 2^53 are exactly representable as double
+        if (std::abs(value) <= 9007199254740992. && std::trunc(value) == value)
+        {
+            if (value >= 0)
+            {
+                head(UNSIGNED_INTEGER, static_cast<std::uint64_t>(value));
+            }
+            else
+            {
+                head(NEGATIVE_INTEGER, static_cast<std::uint64_t>(-1. - value));
+            }
+            return;
+        }
+
+        const auto single_value = static_cast<float>(value);
+        if (static_cast<double>(single_value) == value || std::isnan(value))
+        {
+            std::uint32_t bits;
+            std::memcpy(&bits, &single_value, sizeof(bits));
+            out.push_back(static_cast<char>(SIMPLE << 5 | 26));
+            bigEndian(bits, sizeof(bits));
+        }
+        else
+        {
+            std::uint64_t bits;
+            std::memcpy(&bits, &value, sizeof(bits));
+            out.push_back(static_cast<char>(SIMPLE << 5 | 27));
+            bigEndian(bits, sizeof(bits));
+        }
+    }
+
+    void operator()(const json::Object &object) const
+    {
+        head(MAP, object.values.size());
+        for (const auto &member : object.values)
+        {
+            head(TEXT_STRING, member.first.size());
+            out.insert(out.end(), member.first.begin(), member.first.end());
+            mapbox::util::apply_visitor(Renderer(out), member.second);
+        }
+    }
+
+    void operator()(const json::Array &array) const
+    {
+        head(ARRAY, array.values.size());
+        for (const auto &value : array.values)
+        {
+            mapbox::util::apply_visitor(Renderer(out), value);
+        }
+    }
+
+    void operator()(const json::True &) const { out.push_back(static_cast<char>(0xf5)); }
+
+    void operator()(const json::False &) const { out.push_back(static_cast<char>(0xf4)); }
+
+    void operator()(const json::Null &) const { out.push_back(static_cast<char>(0xf6)); }
+
+  private:
+    enum MajorType : std::uint8_t
+    {
+        UNSIGNED_INTEGER = 0,
+        NEGATIVE_INTEGER = 1,
+        TEXT_STRING = 3,
+        ARRAY = 4,
+        MAP = 5,
+        SIMPLE = 7
+    };
+
+    // Initial byte of a data item and its argument in the shortest encoding
+    void head(const MajorType type, const std::uint64_t value) const
+    {
+        const auto initial = static_cast<std::uint8_t>(type << 5);
+        if (value < 24)
+        {
+            out.push_back(static_cast<char>(initial | value));
+        }
+        else if (value <= 0xff)
+        {
+            out.push_back(static_cast<char>(initial | 24));
+            bigEndian(value, 1);
+        }
+        else if (value <= 0xffff)
+        {
+            out.push_back(static_cast<char>(initial | 25));
+            bigEndian(value, 2);
+        }
+        else if (value <= 0xffffffff)
+        {
+            out.push_back(static_cast<char>(initial | 26));
+            bigEndian(value, 4);
+        }
+        else
+        {
+            out.push_back(static_cast<char>(initial | 27));
+            bigEndian(value, 8);
+        }
+    }
+
+    void bigEndian(const std::uint64_t value, const std::size_t bytes) const
+    {
+        for (std::size_t index = bytes; index > 0; --index)
+        {
+            out.push_back(static_cast<char>(value >> (8 * (index - 1))));
+        }
+    }
+
+    std::vector<char> &out;
+};
+
+inline void render(std::vector<char> &out, const json::Object &object)
+{
+    Renderer renderer(out);
+    renderer(object);
+}
+
+} // namespace cbor
+} // namespace util
+} // namespace osrm
+
+#endif // CBOR_RENDERER_HPP
@@ -0,0 +1,111 @@
+#ifndef OSRM_UTIL_LRU_CACHE_HPP
+#define OSRM_UTIL_LRU_CACHE_HPP
+
+#include <boost/assert.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <list>
+#include <unordered_map>
+#include <utility>
+
+namespace osrm
+{
+namespace util
+{
+
+/**
+ * Fixed capacity key-value cache that evicts the least recently used entries. Every entry has a
+ * cost, 1 by default, and the capacity bounds the total cost of all entries, e.g. the size of
+ * the cached values. Not thread-safe, callers have to synchronize.
+ */
+template <typename KeyT, typename ValueT, typename HashT = std::hash<KeyT>> class LRUCache
+{
+  public:
+    explicit LRUCache(const std::size_t capacity_) : capacity(capacity_), cost(0)
+    {
+        BOOST_ASSERT(capacity > 0);
+    }
+
+    // Copies the value of `key` into `value` and marks it as most recently used
+    bool Get(const KeyT &key, ValueT &value)
+    {
+        const auto iter = index.find(key);
+        if (iter == index.end())
+        {
+            return false;
+        }
+
+        entries.splice(entries.begin(), entries, iter->second);
+        value = iter->second->value;
+        return true;
+    }
+
+    // Inserts or replaces the value of `key`, evicts the least recently used entries until the
+    // new entry fits. Entries that cost more than the whole capacity are not cached.
+    void Insert(const KeyT &key, ValueT value, const std::size_t entry_cost = 1)
+    {
+        const auto iter = index.find(key);
+        if (iter != index.end())
+        {
+            Erase(iter->second);
+        }
+
+        if (entry_cost > capacity)
+        {
+            return;
+        }
+
+        while (cost + entry_cost > capacity)
+        {
+            Erase(std::prev(entries.end()));
+        }
+
+        entries.push_front(Entry{key, std::move(value), entry_cost});
+        index.emplace(key, entries.begin());
+        cost += entry_cost;
+    }
+
+    bool Contains(const KeyT &key) const { return index.find(key) != index.end(); }
+
+    // Number of entries
+    std::size_t Size() const { return entries.size(); }
+
+    // Total cost of all entries
+    std::size_t Cost() const { return cost; }
+
+    std::size_t Capacity() const { return capacity; }
+
+    void Clear()
+    {
+        index.clear();
+        entries.clear();
+        cost = 0;
+    }
+
+  private:
+    struct Entry
+    {
+        KeyT key;
+        ValueT value;
+        std::size_t cost;
+    };
+    using EntryList = std::list<Entry>;
+
+    void Erase(const typename EntryList::iterator entry)
+    {
+        cost -= entry->cost;
+        index.erase(entry->key);
+        entries.erase(entry);
+    }
+
+    const std::size_t capacity;
+    std::size_t cost;
+    EntryList entries;
+    std::unordered_map<KeyT, typename EntryList::iterator, HashT> index;
+};
+}
+}
+
+#endif
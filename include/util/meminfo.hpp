@@ -8,10 +8,31 @@
 #include <sys/resource.h>
 #endif
 
+#include <cstddef>
+
 namespace osrm
 {
 namespace util
 {
+
+// Returns the peak resident set size of the process in bytes, or 0 if not available
+inline std::size_t GetPeakRAMUsage()
+{
+#ifndef _WIN32
+    rusage usage;
+    getrusage(RUSAGE_SELF, &usage);
+#ifdef __linux__
+    // Under linux, ru.maxrss is in kb
+    return static_cast<std::size_t>(usage.ru_maxrss) * 1024;
+#else  // __linux__
+    // Under BSD systems (OSX), it's in bytes
+    return static_cast<std::size_t>(usage.ru_maxrss);
+#endif // __linux__
+#else  // _WIN32
+    return 0;
+#endif // _WIN32
+}
+
 inline void DumpMemoryStats()
 {
 #if STXXL_VERSION_MAJOR > 1 || (STXXL_VERSION_MAJOR == 1 && STXXL_VERSION_MINOR >= 4)
@@ -24,15 +45,7 @@ inline void DumpMemoryStats()
 #endif
 
 #ifndef _WIN32
-    rusage usage;
-    getrusage(RUSAGE_SELF, &usage);
-#ifdef __linux__
-    // Under linux, ru.maxrss is in kb
-    util::Log() << "RAM: peak bytes used: " << usage.ru_maxrss * 1024;
-#else  // __linux__
-    // Under BSD systems (OSX), it's in bytes
-    util::Log() << "RAM: peak bytes used: " << usage.ru_maxrss;
-#endif // __linux__
+    util::Log() << "RAM: peak bytes used: " << GetPeakRAMUsage();
 #else  // _WIN32
     util::Log() << "RAM: peak bytes used: <not implemented on Windows>";
 #endif // _WIN32
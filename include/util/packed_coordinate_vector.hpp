@@ -0,0 +1,277 @@
+#ifndef OSRM_UTIL_PACKED_COORDINATE_VECTOR_HPP
+#define OSRM_UTIL_PACKED_COORDINATE_VECTOR_HPP
+
+#include "util/coordinate.hpp"
+#include "util/shared_memory_vector_wrapper.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include <vector>
+
+namespace osrm
+{
+namespace util
+{
+
+namespace detail
+{
+const constexpr std::uint64_t COORDINATE_BLOCK_SIZE = 64;
+const constexpr std::uint64_t COORDINATE_WORD_BITS = 64;
+const constexpr std::uint64_t COORDINATE_OFFSET_BITS = 52;
+
+inline std::uint64_t getCoordinateBlockCount(const std::uint64_t number_of_coordinates)
+{
+    return (number_of_coordinates + COORDINATE_BLOCK_SIZE - 1) / COORDINATE_BLOCK_SIZE;
+}
+
+// the number of coordinates, followed by two words per block
+inline std::uint64_t getCoordinateHeaderWords(const std::uint64_t number_of_coordinates)
+{
+    return 1 + 2 * getCoordinateBlockCount(number_of_coordinates);
+}
+}
+
+/**
+ * Packs a stream of coordinates into the word layout of PackedCoordinateVector, a block of
+ * coordinates at a time. Without an output buffer the encoder only computes the number of words
+ * needed, which allows sizing a shared memory block before filling it in a second pass.
+ */
+class PackedCoordinateEncoder
+{
+  public:
+    PackedCoordinateEncoder(const std::uint64_t number_of_coordinates_,
+                            std::uint64_t *words_ = nullptr)
+        : number_of_coordinates(number_of_coordinates_), words(words_),
+          data_words(detail::getCoordinateHeaderWords(number_of_coordinates_))
+    {
+        if (words != nullptr)
+        {
+            words[0] = number_of_coordinates;
+        }
+    }
+
+    void push_back(const Coordinate coordinate)
+    {
+        BOOST_ASSERT(coordinates_seen < number_of_coordinates);
+        block[block_size++] = coordinate;
+        ++coordinates_seen;
+        if (block_size == detail::COORDINATE_BLOCK_SIZE)
+        {
+            FlushBlock();
+        }
+    }
+
+    // Returns the total number of words, call after all coordinates were added
+    std::uint64_t Finish()
+    {
+        BOOST_ASSERT(coordinates_seen == number_of_coordinates);
+        if (block_size > 0)
+        {
+            FlushBlock();
+        }
+        return data_words + packed_words;
+    }
+
+  private:
+    static std::uint64_t GetBits(const std::uint64_t range)
+    {
+        std::uint64_t bits = 0;
+        while (bits < 32 && (range >> bits) != 0)
+        {
+            ++bits;
+        }
+        return bits;
+    }
+
+    void FlushBlock()
+    {
+        const auto block_end = block.begin() + block_size;
+        const auto lon_range = std::minmax_element(
+            block.begin(), block_end, [](const Coordinate lhs, const Coordinate rhs) {
+                return lhs.lon < rhs.lon;
+            });
+        const auto lat_range = std::minmax_element(
+            block.begin(), block_end, [](const Coordinate lhs, const Coordinate rhs) {
+                return lhs.lat < rhs.lat;
+            });
+        const std::int64_t lon_base = static_cast<std::int32_t>(lon_range.first->lon);
+        const std::int64_t lat_base = static_cast<std::int32_t>(lat_range.first->lat);
+        const std::uint64_t lon_bits =
+            GetBits(static_cast<std::int32_t>(lon_range.second->lon) - lon_base);
+        const std::uint64_t lat_bits =
+            GetBits(static_cast<std::int32_t>(lat_range.second->lat) - lat_base);
+        const std::uint64_t coordinate_bits = lon_bits + lat_bits;
+        const std::uint64_t block_words =
+            (block_size * coordinate_bits + detail::COORDINATE_WORD_BITS - 1) /
+            detail::COORDINATE_WORD_BITS;
+
+        if (words != nullptr)
+        {
+            BOOST_ASSERT(packed_words < (std::uint64_t{1} << detail::COORDINATE_OFFSET_BITS));
+            std::uint64_t *header = words + 1 + 2 * block_index;
+            header[0] = static_cast<std::uint32_t>(lon_base) |
+                        (static_cast<std::uint64_t>(static_cast<std::uint32_t>(lat_base)) << 32);
+            header[1] = packed_words | (lon_bits << detail::COORDINATE_OFFSET_BITS) |
+                        (lat_bits << (detail::COORDINATE_OFFSET_BITS + 6));
+
+            std::array<std::uint64_t, detail::COORDINATE_BLOCK_SIZE> packed = {};
+            for (std::uint64_t index = 0; index < block_size; ++index)
+            {
+                const std::uint64_t value =
+                    static_cast<std::uint64_t>(static_cast<std::int32_t>(block[index].lon) -
+                                               lon_base) |
+                    (static_cast<std::uint64_t>(static_cast<std::int32_t>(block[index].lat) -
+                                                lat_base)
+                     << lon_bits);
+                const std::uint64_t first_bit = index * coordinate_bits;
+                const std::uint64_t word = first_bit / detail::COORDINATE_WORD_BITS;
+                const std::uint64_t offset = first_bit % detail::COORDINATE_WORD_BITS;
+                packed[word] |= value << offset;
+                if (offset + coordinate_bits > detail::COORDINATE_WORD_BITS)
+                {
+                    packed[word + 1] |= value >> (detail::COORDINATE_WORD_BITS - offset);
+                }
+            }
+            std::copy(packed.begin(),
+                      packed.begin() + block_words,
+                      words + data_words + packed_words);
+        }
+
+        packed_words += block_words;
+        block_size = 0;
+        ++block_index;
+    }
+
+    const std::uint64_t number_of_coordinates;
+    std::uint64_t *const words;
+    const std::uint64_t data_words;
+
+    std::array<Coordinate, detail::COORDINATE_BLOCK_SIZE> block;
+    std::uint64_t block_size = 0;
+    std::uint64_t block_index = 0;
+    std::uint64_t coordinates_seen = 0;
+    std::uint64_t packed_words = 0;
+};
+
+/**
+ * Read-only list of coordinates stored as blocks of 64 consecutive coordinates. Every block keeps
+ * the minimum longitude and latitude of its coordinates and the number of bits needed for the
+ * offsets to them, nearby nodes (which have nearby IDs) need far less than the 64 bits of
+ * util::Coordinate. An access decodes a single coordinate from its block header and at most two
+ * data words, there is no sequential decoding.
+ *
+ * The words are self-describing: the number of coordinates, then two header words per block,
+ * then the packed offsets. Use PackedCoordinateEncoder to fill them.
+ */
+template <bool UseSharedMemory = false> class PackedCoordinateVector
+{
+  public:
+    PackedCoordinateVector() = default;
+
+    template <bool enabled = UseSharedMemory,
+              typename = typename std::enable_if<!enabled>::type>
+    explicit PackedCoordinateVector(const std::vector<Coordinate> &coordinates)
+    {
+        PackedCoordinateEncoder counter(coordinates.size());
+        for (const auto coordinate : coordinates)
+        {
+            counter.push_back(coordinate);
+        }
+        words.resize(counter.Finish());
+
+        PackedCoordinateEncoder encoder(coordinates.size(), words.data());
+        for (const auto coordinate : coordinates)
+        {
+            encoder.push_back(coordinate);
+        }
+        encoder.Finish();
+        Initialize();
+    }
+
+    template <bool enabled = UseSharedMemory>
+    void reset(typename std::enable_if<enabled, std::uint64_t>::type *ptr,
+               const std::uint64_t number_of_words)
+    {
+        words.reset(ptr, number_of_words);
+        Initialize();
+    }
+
+    Coordinate operator[](const std::uint64_t index) const
+    {
+        BOOST_ASSERT(index < number_of_coordinates);
+        const std::uint64_t block = index / detail::COORDINATE_BLOCK_SIZE;
+        const std::uint64_t base = words[1 + 2 * block];
+        const std::uint64_t layout = words[2 + 2 * block];
+
+        const std::uint64_t block_offset =
+            layout & ((std::uint64_t{1} << detail::COORDINATE_OFFSET_BITS) - 1);
+        const std::uint64_t lon_bits = (layout >> detail::COORDINATE_OFFSET_BITS) & 0x3f;
+        const std::uint64_t lat_bits = (layout >> (detail::COORDINATE_OFFSET_BITS + 6)) & 0x3f;
+        const std::uint64_t coordinate_bits = lon_bits + lat_bits;
+        const std::uint64_t first_bit = (index % detail::COORDINATE_BLOCK_SIZE) * coordinate_bits;
+        const std::uint64_t word =
+            data_begin + block_offset + first_bit / detail::COORDINATE_WORD_BITS;
+        const std::uint64_t offset = first_bit % detail::COORDINATE_WORD_BITS;
+
+        std::uint64_t value = 0;
+        if (coordinate_bits > 0)
+        {
+            value = words[word] >> offset;
+            if (offset + coordinate_bits > detail::COORDINATE_WORD_BITS)
+            {
+                value |= words[word + 1] << (detail::COORDINATE_WORD_BITS - offset);
+            }
+        }
+
+        const std::int64_t lon =
+            static_cast<std::int32_t>(base & 0xffffffff) +
+            static_cast<std::int64_t>(value & ((std::uint64_t{1} << lon_bits) - 1));
+        const std::int64_t lat =
+            static_cast<std::int32_t>(base >> 32) +
+            static_cast<std::int64_t>((value >> lon_bits) & ((std::uint64_t{1} << lat_bits) - 1));
+        return Coordinate{FixedLongitude{static_cast<std::int32_t>(lon)},
+                          FixedLatitude{static_cast<std::int32_t>(lat)}};
+    }
+
+    std::uint64_t size() const { return number_of_coordinates; }
+
+    bool empty() const { return number_of_coordinates == 0; }
+
+    // Memory used by the packed representation in bytes
+    std::uint64_t GetSizeInBytes() const { return words.size() * sizeof(std::uint64_t); }
+
+  private:
+    void Initialize()
+    {
+        BOOST_ASSERT(!words.empty());
+        number_of_coordinates = words[0];
+        data_begin = detail::getCoordinateHeaderWords(number_of_coordinates);
+        BOOST_ASSERT(data_begin <= words.size());
+    }
+
+    typename util::ShM<std::uint64_t, UseSharedMemory>::vector words;
+    std::uint64_t number_of_coordinates = 0;
+    std::uint64_t data_begin = 0;
+};
+
+// Coordinate list of the datasets and the type of the entries of its memory block. Bit-packing
+// the coordinates halves their memory, but a random access takes about 2.5 times as long. It is
+// enabled with the ENABLE_PACKED_COORDINATES build option.
+#ifdef OSRM_PACKED_COORDINATES
+template <bool UseSharedMemory> using CoordinateList = PackedCoordinateVector<UseSharedMemory>;
+using CoordinateListEntry = std::uint64_t;
+const constexpr bool PACKED_COORDINATE_LIST = true;
+#else
+template <bool UseSharedMemory>
+using CoordinateList = typename ShM<Coordinate, UseSharedMemory>::vector;
+using CoordinateListEntry = Coordinate;
+const constexpr bool PACKED_COORDINATE_LIST = false;
+#endif
+}
+}
+
+#endif
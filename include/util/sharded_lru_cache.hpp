@@ -0,0 +1,100 @@
+#ifndef OSRM_UTIL_SHARDED_LRU_CACHE_HPP
+#define OSRM_UTIL_SHARDED_LRU_CACHE_HPP
+
+#include "util/lru_cache.hpp"
+
+#include <boost/assert.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace osrm
+{
+namespace util
+{
+
+/**
+ * LRUCache that is safe to use from many threads: the entries are spread over NumberOfShards
+ * independently locked caches by the hash of their key, so concurrent lookups rarely wait for
+ * each other. Values are copied out under the lock and should be cheap to copy, e.g. shared
+ * pointers to immutable data. Counts its hits and misses.
+ *
+ * Like LRUCache every entry has a cost, the capacity bounds the total cost of the entries of
+ * each shard to 1/NumberOfShards of the capacity.
+ */
+template <typename KeyT,
+          typename ValueT,
+          typename HashT = std::hash<KeyT>,
+          std::size_t NumberOfShards = 16>
+class ShardedLRUCache
+{
+  public:
+    // `capacity` is the maximal total cost of the entries over all shards
+    explicit ShardedLRUCache(const std::size_t capacity)
+    {
+        BOOST_ASSERT(capacity > 0);
+        const auto shard_capacity = std::max<std::size_t>(1, capacity / NumberOfShards);
+        for (auto &shard : shards)
+        {
+            shard.reset(new Shard(shard_capacity));
+        }
+    }
+
+    // Copies the value of `key` into `value` and marks it as most recently used
+    bool Get(const KeyT &key, ValueT &value) const
+    {
+        auto &shard = GetShard(key);
+        bool found;
+        {
+            std::lock_guard<std::mutex> lock(shard.mutex);
+            found = shard.cache.Get(key, value);
+        }
+
+        (found ? hits : misses).fetch_add(1, std::memory_order_relaxed);
+        return found;
+    }
+
+    // Inserts or replaces the value of `key`, evicts the least recently used entries of its shard
+    void Insert(const KeyT &key, ValueT value, const std::size_t cost = 1)
+    {
+        auto &shard = GetShard(key);
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        shard.cache.Insert(key, std::move(value), cost);
+    }
+
+    std::uint64_t GetNumberOfHits() const { return hits.load(std::memory_order_relaxed); }
+    std::uint64_t GetNumberOfMisses() const { return misses.load(std::memory_order_relaxed); }
+
+  private:
+    struct Shard
+    {
+        explicit Shard(const std::size_t capacity) : cache(capacity) {}
+
+        std::mutex mutex;
+        LRUCache<KeyT, ValueT, HashT> cache;
+    };
+
+    Shard &GetShard(const KeyT &key) const
+    {
+        // the low bits of the hash index the buckets of the shard, mix the high bits into the
+        // shard index so consecutive keys end up in different shards
+        const auto hash = static_cast<std::uint64_t>(hasher(key));
+        return *shards[((hash * 0x9E3779B97F4A7C15ull) >> 32) % NumberOfShards];
+    }
+
+    HashT hasher;
+    std::array<std::unique_ptr<Shard>, NumberOfShards> shards;
+    mutable std::atomic<std::uint64_t> hits{0};
+    mutable std::atomic<std::uint64_t> misses{0};
+};
+}
+}
+
+#endif
@@ -8,6 +8,7 @@
 #include <cstddef>
 
 #include <algorithm>
+#include <bitset>
 #include <iterator>
 #include <type_traits>
 #include <utility>
@@ -145,6 +146,15 @@ template <> class SharedMemoryWrapper<bool>
         return m_ptr[bucket] & (1u << offset);
     }
 
+    // number of set bits in the 32 bit bucket of index that come before index
+    unsigned rank_in_bucket(const std::size_t index) const
+    {
+        const std::size_t bucket = index / 32;
+        const unsigned offset = static_cast<unsigned>(index % 32);
+        const unsigned lower_bits = m_ptr[bucket] & ((1u << offset) - 1u);
+        return static_cast<unsigned>(std::bitset<32>(lower_bits).count());
+    }
+
     void reset(unsigned *ptr, std::size_t size)
     {
         m_ptr = ptr;
@@ -24,12 +24,21 @@
 #include <tbb/parallel_for.h>
 #include <tbb/parallel_sort.h>
 
+#ifdef __linux__
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <unistd.h>
+#endif
+
 #include <algorithm>
 #include <array>
+#include <atomic>
 #include <limits>
 #include <memory>
 #include <queue>
 #include <string>
+#include <unordered_map>
+#include <utility>
 #include <vector>
 
 // An extended alignment is implementation-defined, so use compiler attributes
@@ -152,6 +161,10 @@ class StaticRTree
         Coordinate fixed_projected_coordinate;
     };
 
+    // Web Mercator projections of the segments of visited leaves, by leaf index
+    using ProjectedSegment = std::pair<FloatCoordinate, FloatCoordinate>;
+    using ProjectedLeaves = std::unordered_map<std::uint32_t, std::vector<ProjectedSegment>>;
+
     typename ShM<TreeNode, UseSharedMemory>::vector m_search_tree;
     const CoordinateListT &m_coordinate_list;
 
@@ -159,10 +172,43 @@ class StaticRTree
     // read-only view of leaves
     typename ShM<const LeafNode, true>::vector m_leaves;
 
+    // number of leaves read by queries and page faults that had to read from disk meanwhile,
+    // only counted with EnableLeafStatistics since it costs two syscalls per query
+    bool m_count_leaf_statistics = false;
+    mutable std::atomic<std::uint64_t> m_leaf_accesses{0};
+    mutable std::atomic<std::uint64_t> m_leaf_page_faults{0};
+
   public:
     StaticRTree(const StaticRTree &) = delete;
     StaticRTree &operator=(const StaticRTree &) = delete;
 
+    // Nearest queries for a group of nearby coordinates. Segments of leaves that were visited
+    // before are not projected again. Not thread-safe, every thread needs its own batch.
+    class NearestBatch
+    {
+      public:
+        explicit NearestBatch(const StaticRTree &rtree_) : rtree(rtree_) {}
+
+        template <typename FilterT, typename TerminationT>
+        std::vector<EdgeDataT> Nearest(const Coordinate input_coordinate,
+                                       const FilterT filter,
+                                       const TerminationT terminate)
+        {
+            return rtree.Nearest(
+                input_coordinate, filter, terminate, &projected_leaves, leaf_accesses);
+        }
+
+      private:
+        friend class StaticRTree;
+
+        const StaticRTree &rtree;
+        ProjectedLeaves projected_leaves;
+        std::uint64_t leaf_accesses = 0;
+    };
+
+    // Number of coordinates adjacent on the Hilbert curve that share a NearestBatch
+    static constexpr std::size_t BATCH_GROUP_SIZE = 64;
+
     template <typename CoordinateT>
     // Construct a packed Hilbert-R-Tree with Kamel-Faloutsos algorithm [1]
     explicit StaticRTree(const std::vector<EdgeDataT> &input_data_vector,
@@ -383,6 +429,67 @@ class StaticRTree
         }
     }
 
+    // Reads the whole leaves file into memory, so the first queries don't wait for page faults.
+    // The kernel reads ahead asynchronously and every page is touched once to map it.
+    void WarmUpLeaves() const
+    {
+#ifdef __linux__
+        const auto leaves = const_cast<char *>(m_leaves_region.data());
+        const std::size_t page_size = sysconf(_SC_PAGESIZE);
+        madvise(leaves, m_leaves_region.size(), MADV_WILLNEED);
+        for (std::size_t offset = 0; offset < m_leaves_region.size(); offset += page_size)
+        {
+            static_cast<void>(*static_cast<const volatile char *>(leaves + offset));
+        }
+#endif
+    }
+
+    std::size_t GetNumberOfLeafPages() const
+    {
+#ifdef __linux__
+        const std::size_t page_size = sysconf(_SC_PAGESIZE);
+        return (m_leaves_region.size() + page_size - 1) / page_size;
+#else
+        return 0;
+#endif
+    }
+
+    // Number of pages of the leaves file that are in RAM, i.e. can be read without page fault
+    std::size_t GetNumberOfResidentLeafPages() const
+    {
+#ifdef __linux__
+        std::vector<unsigned char> residency(GetNumberOfLeafPages());
+        if (residency.empty() ||
+            mincore(const_cast<char *>(m_leaves_region.data()),
+                    m_leaves_region.size(),
+                    residency.data()) != 0)
+        {
+            return 0;
+        }
+        return std::count_if(residency.begin(), residency.end(), [](const unsigned char page) {
+            return page & 1;
+        });
+#else
+        return 0;
+#endif
+    }
+
+    // Counts the leaf accesses and page faults of all following queries. Has to be called before
+    // the rtree is shared with other threads.
+    void EnableLeafStatistics() { m_count_leaf_statistics = true; }
+
+    std::uint64_t GetNumberOfLeafAccesses() const
+    {
+        return m_leaf_accesses.load(std::memory_order_relaxed);
+    }
+
+    // Page faults that had to read from disk while queries were running. Almost all of them are
+    // caused by leaves, the other data is usually in RAM.
+    std::uint64_t GetNumberOfLeafPageFaults() const
+    {
+        return m_leaf_page_faults.load(std::memory_order_relaxed);
+    }
+
     /* Returns all features inside the bounding box.
        Rectangle needs to be projected!*/
     std::vector<EdgeDataT> SearchInBox(const Rectangle &search_rectangle) const
@@ -396,6 +503,9 @@ class StaticRTree
                 web_mercator::latToY(toFloating(FixedLatitude(search_rectangle.max_lat)))})};
         std::vector<EdgeDataT> results;
 
+        const auto page_faults = m_count_leaf_statistics ? GetPageFaults() : 0;
+        std::uint64_t leaf_accesses = 0;
+
         std::queue<TreeIndex> traversal_queue;
         traversal_queue.push(TreeIndex{});
 
@@ -407,6 +517,7 @@ class StaticRTree
             if (current_tree_index.is_leaf)
             {
                 const LeafNode &current_leaf_node = m_leaves[current_tree_index.index];
+                ++leaf_accesses;
 
                 for (const auto i : irange(0u, current_leaf_node.object_count))
                 {
@@ -450,6 +561,8 @@ class StaticRTree
                 }
             }
         }
+
+        CountLeafAccesses(leaf_accesses, page_faults);
         return results;
     }
 
@@ -469,6 +582,74 @@ class StaticRTree
     std::vector<EdgeDataT> Nearest(const Coordinate input_coordinate,
                                    const FilterT filter,
                                    const TerminationT terminate) const
+    {
+        const auto page_faults = m_count_leaf_statistics ? GetPageFaults() : 0;
+        std::uint64_t leaf_accesses = 0;
+        auto results = Nearest(input_coordinate, filter, terminate, nullptr, leaf_accesses);
+        CountLeafAccesses(leaf_accesses, page_faults);
+        return results;
+    }
+
+    // Calls query(index, batch) for every input coordinate with a NearestBatch that is shared by
+    // up to BATCH_GROUP_SIZE coordinates that are adjacent on the Hilbert curve, so nearby
+    // coordinates reuse the visited leaves. The groups are processed in parallel, `query` has to
+    // be thread-safe. Inputs that fit into one group are queried inline in their own order.
+    template <typename QueryT>
+    void Nearest(const std::vector<Coordinate> &input_coordinates, const QueryT &query) const
+    {
+        if (input_coordinates.size() <= BATCH_GROUP_SIZE)
+        {
+            const auto page_faults = m_count_leaf_statistics ? GetPageFaults() : 0;
+            NearestBatch batch(*this);
+            for (const auto index : irange<std::size_t>(0, input_coordinates.size()))
+            {
+                query(index, batch);
+            }
+            CountLeafAccesses(batch.leaf_accesses, page_faults);
+            return;
+        }
+
+        std::vector<WrappedInputElement> ordered_coordinates(input_coordinates.size());
+        for (const auto index : irange<std::size_t>(0, input_coordinates.size()))
+        {
+            Coordinate projected_coordinate = input_coordinates[index];
+            projected_coordinate.lat = FixedLatitude{static_cast<std::int32_t>(
+                COORDINATE_PRECISION *
+                web_mercator::latToY(toFloating(projected_coordinate.lat)))};
+            ordered_coordinates[index] =
+                WrappedInputElement{GetHilbertCode(projected_coordinate),
+                                    static_cast<std::uint32_t>(index)};
+        }
+        std::sort(ordered_coordinates.begin(), ordered_coordinates.end());
+
+        const auto number_of_groups =
+            (ordered_coordinates.size() + BATCH_GROUP_SIZE - 1) / BATCH_GROUP_SIZE;
+        tbb::parallel_for(
+            tbb::blocked_range<std::size_t>(0, number_of_groups),
+            [&](const tbb::blocked_range<std::size_t> &range) {
+                for (auto group = range.begin(); group != range.end(); ++group)
+                {
+                    const auto page_faults = m_count_leaf_statistics ? GetPageFaults() : 0;
+                    NearestBatch batch(*this);
+                    const auto begin = group * BATCH_GROUP_SIZE;
+                    const auto end =
+                        std::min(begin + BATCH_GROUP_SIZE, ordered_coordinates.size());
+                    for (auto position = begin; position != end; ++position)
+                    {
+                        query(ordered_coordinates[position].m_array_index, batch);
+                    }
+                    CountLeafAccesses(batch.leaf_accesses, page_faults);
+                }
+            });
+    }
+
+  private:
+    template <typename FilterT, typename TerminationT>
+    std::vector<EdgeDataT> Nearest(const Coordinate input_coordinate,
+                                   const FilterT filter,
+                                   const TerminationT terminate,
+                                   ProjectedLeaves *projected_leaves,
+                                   std::uint64_t &leaf_accesses) const
     {
         std::vector<EdgeDataT> results;
         auto projected_coordinate = web_mercator::fromWGS84(input_coordinate);
@@ -488,10 +669,12 @@ class StaticRTree
             { // current object is a tree node
                 if (current_tree_index.is_leaf)
                 {
+                    ++leaf_accesses;
                     ExploreLeafNode(current_tree_index,
                                     fixed_projected_coordinate,
                                     projected_coordinate,
-                                    traversal_queue);
+                                    traversal_queue,
+                                    projected_leaves);
                 }
                 else
                 {
@@ -530,21 +713,64 @@ class StaticRTree
         return results;
     }
 
-  private:
+    // Page faults of the calling thread that had to read from disk, 0 if not supported
+    static std::uint64_t GetPageFaults()
+    {
+#if defined(__linux__) && defined(RUSAGE_THREAD)
+        rusage usage;
+        getrusage(RUSAGE_THREAD, &usage);
+        return usage.ru_majflt;
+#else
+        return 0;
+#endif
+    }
+
+    void CountLeafAccesses(const std::uint64_t leaf_accesses, const std::uint64_t page_faults) const
+    {
+        if (!m_count_leaf_statistics)
+        {
+            return;
+        }
+        m_leaf_accesses.fetch_add(leaf_accesses, std::memory_order_relaxed);
+        m_leaf_page_faults.fetch_add(GetPageFaults() - page_faults, std::memory_order_relaxed);
+    }
+
     template <typename QueueT>
     void ExploreLeafNode(const TreeIndex &leaf_id,
                          const Coordinate &projected_input_coordinate_fixed,
                          const FloatCoordinate &projected_input_coordinate,
-                         QueueT &traversal_queue) const
+                         QueueT &traversal_queue,
+                         ProjectedLeaves *projected_leaves) const
     {
         const LeafNode &current_leaf_node = m_leaves[leaf_id.index];
 
+        const auto project_segment = [this, &current_leaf_node](const std::uint32_t i) {
+            const auto &current_edge = current_leaf_node.objects[i];
+            return ProjectedSegment{web_mercator::fromWGS84(m_coordinate_list[current_edge.u]),
+                                    web_mercator::fromWGS84(m_coordinate_list[current_edge.v])};
+        };
+
+        std::vector<ProjectedSegment> *projected_segments = nullptr;
+        if (projected_leaves)
+        {
+            projected_segments = &(*projected_leaves)[leaf_id.index];
+            if (projected_segments->empty())
+            {
+                projected_segments->reserve(current_leaf_node.object_count);
+                for (const auto i : irange(0u, current_leaf_node.object_count))
+                {
+                    projected_segments->push_back(project_segment(i));
+                }
+            }
+        }
+
         // current object represents a block on disk
         for (const auto i : irange(0u, current_leaf_node.object_count))
         {
-            const auto &current_edge = current_leaf_node.objects[i];
-            const auto projected_u = web_mercator::fromWGS84(m_coordinate_list[current_edge.u]);
-            const auto projected_v = web_mercator::fromWGS84(m_coordinate_list[current_edge.v]);
+            const auto projected_segment =
+                projected_segments ? (*projected_segments)[i] : project_segment(i);
+            const auto &projected_u = projected_segment.first;
+            const auto &projected_v = projected_segment.second;
 
             FloatCoordinate projected_nearest;
             std::tie(std::ignore, projected_nearest) =
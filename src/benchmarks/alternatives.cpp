@@ -0,0 +1,107 @@
+#include "util/timing_util.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+#include "osrm/osrm.hpp"
+#include "osrm/route_parameters.hpp"
+#include "osrm/status.hpp"
+
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace osrm;
+
+// Measures the latency of random /route queries with an increasing number of requested
+// alternatives, all alternatives come from the same pair of searches so the cost of every
+// additional alternative should be small compared to the first one.
+int main(int argc, const char *argv[]) try
+{
+    if (argc < 6)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " data.osrm min_lon min_lat max_lon max_lat [number of queries]"
+                     " [max alternatives]\n";
+        return EXIT_FAILURE;
+    }
+
+    const double min_lon = std::stod(argv[2]);
+    const double min_lat = std::stod(argv[3]);
+    const double max_lon = std::stod(argv[4]);
+    const double max_lat = std::stod(argv[5]);
+    const std::size_t number_of_queries = argc > 6 ? std::stoul(argv[6]) : 1000;
+    const unsigned max_alternatives = argc > 7 ? std::stoul(argv[7]) : 3;
+
+    EngineConfig config;
+    config.storage_config = {argv[1]};
+    config.use_shared_memory = false;
+    config.max_alternatives = max_alternatives;
+    OSRM osrm{config};
+
+    // fixed seed, so every run uses the same coordinates
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> lon_distribution(min_lon, max_lon);
+    std::uniform_real_distribution<double> lat_distribution(min_lat, max_lat);
+    const auto random_coordinate = [&]() {
+        return util::Coordinate{util::FloatLongitude{lon_distribution(generator)},
+                                util::FloatLatitude{lat_distribution(generator)}};
+    };
+
+    std::vector<std::vector<util::Coordinate>> coordinates(number_of_queries);
+    for (auto &query_coordinates : coordinates)
+    {
+        query_coordinates = {random_coordinate(), random_coordinate()};
+    }
+
+    double baseline = 0;
+    for (unsigned number_of_alternatives = 0; number_of_alternatives <= max_alternatives;
+         ++number_of_alternatives)
+    {
+        std::size_t routes = 0;
+        std::size_t failed = 0;
+
+        TIMER_START(queries);
+        for (const auto &query_coordinates : coordinates)
+        {
+            RouteParameters params;
+            params.overview = RouteParameters::OverviewType::False;
+            params.generate_hints = false;
+            params.alternatives = number_of_alternatives > 0;
+            params.number_of_alternatives = number_of_alternatives;
+            params.coordinates = query_coordinates;
+
+            json::Object result;
+            if (osrm.Route(params, result) == Status::Ok)
+            {
+                routes += result.values["routes"].get<json::Array>().values.size();
+            }
+            else
+            {
+                ++failed;
+            }
+        }
+        TIMER_STOP(queries);
+
+        const double mean = TIMER_MSEC(queries) / number_of_queries;
+        if (number_of_alternatives == 0)
+        {
+            baseline = mean;
+        }
+        const auto succeeded = number_of_queries - failed;
+        std::cout << "alternatives=" << number_of_alternatives << ": mean " << mean << "ms ("
+                  << (baseline > 0 ? mean / baseline : 0) << "x), "
+                  << (succeeded > 0 ? static_cast<double>(routes) / succeeded : 0)
+                  << " routes/query, " << failed << " failed" << std::endl;
+    }
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
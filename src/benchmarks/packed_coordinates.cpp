@@ -0,0 +1,127 @@
+#include "extractor/query_node.hpp"
+#include "storage/io.hpp"
+#include "util/coordinate.hpp"
+#include "util/packed_coordinate_vector.hpp"
+#include "util/timing_util.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace osrm;
+
+namespace
+{
+std::vector<util::Coordinate> loadCoordinates(const boost::filesystem::path &nodes_path)
+{
+    storage::io::FileReader nodes_file(nodes_path, storage::io::FileReader::HasNoFingerprint);
+    const auto number_of_nodes = nodes_file.ReadElementCount64();
+    std::vector<util::Coordinate> coordinates;
+    coordinates.reserve(number_of_nodes);
+    extractor::QueryNode node;
+    for (std::uint64_t index = 0; index < number_of_nodes; ++index)
+    {
+        nodes_file.ReadInto(node);
+        coordinates.emplace_back(node.lon, node.lat);
+    }
+    return coordinates;
+}
+
+// A random walk through Germany, consecutive nodes are close to each other like in an extract
+std::vector<util::Coordinate> generateCoordinates(const std::size_t number_of_coordinates)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> step(-500, 500);
+    std::uniform_int_distribution<int> jump(0, 999);
+    std::uniform_int_distribution<int> lon_distribution(6000000, 15000000);
+    std::uniform_int_distribution<int> lat_distribution(47000000, 55000000);
+
+    std::vector<util::Coordinate> coordinates;
+    coordinates.reserve(number_of_coordinates);
+    int lon = lon_distribution(generator), lat = lat_distribution(generator);
+    for (std::size_t index = 0; index < number_of_coordinates; ++index)
+    {
+        // a new way starts somewhere else once in a while
+        if (jump(generator) == 0)
+        {
+            lon = lon_distribution(generator);
+            lat = lat_distribution(generator);
+        }
+        lon += step(generator);
+        lat += step(generator);
+        coordinates.emplace_back(util::FixedLongitude{lon}, util::FixedLatitude{lat});
+    }
+    return coordinates;
+}
+
+// Returns the mean time per access in nanoseconds
+template <typename CoordinateList>
+double measureAccess(const CoordinateList &coordinates, const std::vector<std::uint32_t> &order)
+{
+    std::int64_t checksum = 0;
+    TIMER_START(access);
+    for (const auto index : order)
+    {
+        const util::Coordinate coordinate = coordinates[index];
+        checksum += static_cast<std::int32_t>(coordinate.lon);
+    }
+    TIMER_STOP(access);
+
+    // use the result, so the loop can not be removed
+    if (checksum == 42)
+    {
+        std::cout << checksum;
+    }
+    return TIMER_NSEC(access) / static_cast<double>(order.size());
+}
+}
+
+// Compares memory usage and access latency of util::PackedCoordinateVector with a plain vector of
+// coordinates, either for the coordinates of a .nodes file or for generated ones.
+int main(int argc, const char *argv[]) try
+{
+    const auto coordinates = argc > 1 ? loadCoordinates(argv[1]) : generateCoordinates(20000000);
+    if (coordinates.empty())
+    {
+        std::cerr << "No coordinates" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    TIMER_START(packing);
+    const util::PackedCoordinateVector<> packed(coordinates);
+    TIMER_STOP(packing);
+
+    const auto unpacked_bytes = coordinates.size() * sizeof(util::Coordinate);
+    std::cout << coordinates.size() << " coordinates packed in " << TIMER_MSEC(packing) << "ms"
+              << std::endl;
+    std::cout << "unpacked: " << unpacked_bytes << " bytes, packed: " << packed.GetSizeInBytes()
+              << " bytes (" << 8. * packed.GetSizeInBytes() / coordinates.size()
+              << " bits per coordinate)" << std::endl;
+
+    std::vector<std::uint32_t> sequential(coordinates.size());
+    for (std::uint32_t index = 0; index < sequential.size(); ++index)
+    {
+        sequential[index] = index;
+    }
+    auto random = sequential;
+    std::shuffle(random.begin(), random.end(), std::mt19937(1337));
+
+    std::cout << "sequential access: " << measureAccess(coordinates, sequential)
+              << "ns unpacked, " << measureAccess(packed, sequential) << "ns packed" << std::endl;
+    std::cout << "random access: " << measureAccess(coordinates, random) << "ns unpacked, "
+              << measureAccess(packed, random) << "ns packed" << std::endl;
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
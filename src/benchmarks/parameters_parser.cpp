@@ -0,0 +1,129 @@
+#include "engine/api/route_parameters.hpp"
+#include "engine/api/table_parameters.hpp"
+#include "server/api/parameters_parser.hpp"
+#include "server/api/url_parser.hpp"
+#include "util/timing_util.hpp"
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+using namespace osrm;
+
+namespace
+{
+// lon,lat;lon,lat;... with the six decimal places clients usually send
+std::string generateLocations(const std::size_t number_of_locations)
+{
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> lon_distribution(6000000, 15000000);
+    std::uniform_int_distribution<int> lat_distribution(47000000, 55000000);
+
+    std::string locations;
+    for (std::size_t index = 0; index < number_of_locations; ++index)
+    {
+        const auto lon = lon_distribution(generator) / 1e6;
+        const auto lat = lat_distribution(generator) / 1e6;
+        locations += (index > 0 ? ";" : "") + std::to_string(lon) + "," + std::to_string(lat);
+    }
+    return locations;
+}
+
+// Returns the mean time per parse in microseconds
+template <typename Parse> double measureParse(std::string input, Parse &&parse)
+{
+    const std::size_t iterations = std::max<std::size_t>(10, 20000000 / input.size());
+    std::size_t checksum = 0;
+    TIMER_START(parse);
+    for (std::size_t iteration = 0; iteration < iterations; ++iteration)
+    {
+        checksum += parse(input);
+    }
+    TIMER_STOP(parse);
+
+    // use the result, so the loop can not be removed
+    if (checksum != iterations)
+    {
+        throw std::runtime_error("Failed to parse " + input.substr(0, 100));
+    }
+    return TIMER_USEC(parse) / iterations;
+}
+
+void report(const std::string &name, const std::string &input, const double microseconds)
+{
+    std::cout << name << ": " << input.size() << " bytes in " << microseconds << "us ("
+              << input.size() / microseconds << " MB/s)" << std::endl;
+}
+}
+
+// Measures parsing the URL and the parameters of large table and route requests, the first
+// thing osrm-routed does for every request.
+int main(int argc, const char *argv[]) try
+{
+    const std::size_t number_of_locations = argc > 1 ? std::stoul(argv[1]) : 1000;
+
+    const auto locations = generateLocations(number_of_locations);
+    std::string options = "?generate_hints=false&radiuses=";
+    for (std::size_t index = 0; index < number_of_locations; ++index)
+    {
+        options += (index > 0 ? ";" : "") + std::string(index % 2 ? "unlimited" : "25.5");
+    }
+    options += "&bearings=";
+    for (std::size_t index = 0; index < number_of_locations; ++index)
+    {
+        options += (index > 0 ? ";" : "") + std::to_string(index % 360) + ",20";
+    }
+
+    const auto url = "/table/v1/driving/" + locations + options;
+    report("url", url, measureParse(url, [](std::string &input) {
+               auto iter = input.begin();
+               return server::api::parseURL(iter, input.end()) ? 1 : 0;
+           }));
+
+    const auto table_query = locations + "?sources=0;1;2&destinations=all";
+    report("table", table_query, measureParse(table_query, [](std::string &input) {
+               auto iter = input.begin();
+               const auto parameters =
+                   server::api::parseParameters<engine::api::TableParameters>(iter, input.end());
+               return parameters ? 1 : 0;
+           }));
+
+    // the same coordinates as a POST body, only the options are left to parse
+    std::string body;
+    for (std::size_t index = 0; index < number_of_locations * 2; ++index)
+    {
+        const std::int32_t value = index % 2 ? 52517037 : 13388860;
+        for (std::size_t byte = 0; byte < sizeof(value); ++byte)
+        {
+            body.push_back(static_cast<char>((static_cast<std::uint32_t>(value) >> 8 * byte)));
+        }
+    }
+    report("table body", body, measureParse(body, [](std::string &input) {
+               std::string options = "?sources=0;1;2&destinations=all";
+               auto iter = options.begin();
+               const auto parameters = server::api::parseParameters<engine::api::TableParameters>(
+                   iter, options.end(), input);
+               return parameters ? 1 : 0;
+           }));
+
+    const auto route_query = locations + options + "&steps=true&overview=full&geometries=polyline6";
+    report("route", route_query, measureParse(route_query, [](std::string &input) {
+               auto iter = input.begin();
+               const auto parameters =
+                   server::api::parseParameters<engine::api::RouteParameters>(iter, input.end());
+               return parameters ? 1 : 0;
+           }));
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
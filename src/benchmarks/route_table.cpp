@@ -0,0 +1,199 @@
+#include "util/timing_util.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+#include "osrm/osrm.hpp"
+#include "osrm/route_parameters.hpp"
+#include "osrm/status.hpp"
+#include "osrm/table_parameters.hpp"
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <functional>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace osrm;
+
+namespace
+{
+// Counts the hardware cache misses of this thread, reports -1 if the counter is not available
+// (e.g. perf_event_paranoid or virtualized hardware)
+class CacheMissCounter
+{
+  public:
+    CacheMissCounter()
+    {
+#ifdef __linux__
+        perf_event_attr attributes = {};
+        attributes.type = PERF_TYPE_HARDWARE;
+        attributes.size = sizeof(attributes);
+        attributes.config = PERF_COUNT_HW_CACHE_MISSES;
+        attributes.disabled = 1;
+        attributes.exclude_kernel = 1;
+        attributes.exclude_hv = 1;
+        fd = syscall(SYS_perf_event_open, &attributes, 0, -1, -1, 0);
+#endif
+    }
+
+    ~CacheMissCounter()
+    {
+#ifdef __linux__
+        if (fd != -1)
+        {
+            close(fd);
+        }
+#endif
+    }
+
+    void Start()
+    {
+#ifdef __linux__
+        if (fd != -1)
+        {
+            ioctl(fd, PERF_EVENT_IOC_RESET, 0);
+            ioctl(fd, PERF_EVENT_IOC_ENABLE, 0);
+        }
+#endif
+    }
+
+    std::int64_t Stop()
+    {
+#ifdef __linux__
+        std::int64_t count = 0;
+        if (fd != -1)
+        {
+            ioctl(fd, PERF_EVENT_IOC_DISABLE, 0);
+            if (read(fd, &count, sizeof(count)) == sizeof(count))
+            {
+                return count;
+            }
+        }
+#endif
+        return -1;
+    }
+
+  private:
+    int fd = -1;
+};
+
+void runBenchmark(const std::string &name,
+                  const std::size_t number_of_queries,
+                  const std::function<Status(std::size_t)> &query)
+{
+    CacheMissCounter counter;
+    std::vector<double> latencies;
+    latencies.reserve(number_of_queries);
+    std::size_t failed = 0;
+
+    counter.Start();
+    for (std::size_t index = 0; index < number_of_queries; ++index)
+    {
+        TIMER_START(query);
+        if (query(index) != Status::Ok)
+        {
+            ++failed;
+        }
+        TIMER_STOP(query);
+        latencies.push_back(TIMER_MSEC(query));
+    }
+    const auto cache_misses = counter.Stop();
+
+    std::sort(latencies.begin(), latencies.end());
+    double total = 0;
+    for (const auto latency : latencies)
+    {
+        total += latency;
+    }
+
+    std::cout << name << ": " << number_of_queries << " queries (" << failed << " failed), mean "
+              << total / number_of_queries << "ms, median " << latencies[latencies.size() / 2]
+              << "ms, p99 " << latencies[latencies.size() * 99 / 100] << "ms";
+    if (cache_misses >= 0)
+    {
+        std::cout << ", " << cache_misses / number_of_queries << " cache misses/query";
+    }
+    std::cout << std::endl;
+}
+}
+
+// Measures the latency and cache misses of random /route and /table queries. Run it on the same
+// extract with and without `osrm-extract --renumber-nodes` to compare node orderings.
+int main(int argc, const char *argv[]) try
+{
+    if (argc < 6)
+    {
+        std::cerr << "Usage: " << argv[0]
+                  << " data.osrm min_lon min_lat max_lon max_lat [number of queries]\n";
+        return EXIT_FAILURE;
+    }
+
+    const double min_lon = std::stod(argv[2]);
+    const double min_lat = std::stod(argv[3]);
+    const double max_lon = std::stod(argv[4]);
+    const double max_lat = std::stod(argv[5]);
+    const std::size_t number_of_queries = argc > 6 ? std::stoul(argv[6]) : 1000;
+    const std::size_t table_size = 10;
+
+    EngineConfig config;
+    config.storage_config = {argv[1]};
+    config.use_shared_memory = false;
+    OSRM osrm{config};
+
+    // fixed seed, so runs on different datasets use the same coordinates
+    std::mt19937 generator(42);
+    std::uniform_real_distribution<double> lon_distribution(min_lon, max_lon);
+    std::uniform_real_distribution<double> lat_distribution(min_lat, max_lat);
+    const auto random_coordinate = [&]() {
+        return util::Coordinate{util::FloatLongitude{lon_distribution(generator)},
+                                util::FloatLatitude{lat_distribution(generator)}};
+    };
+
+    std::vector<RouteParameters> route_queries(number_of_queries);
+    for (auto &params : route_queries)
+    {
+        params.overview = RouteParameters::OverviewType::False;
+        params.generate_hints = false;
+        params.coordinates = {random_coordinate(), random_coordinate()};
+    }
+
+    std::vector<TableParameters> table_queries(number_of_queries);
+    for (auto &params : table_queries)
+    {
+        for (std::size_t index = 0; index < table_size; ++index)
+        {
+            params.coordinates.push_back(random_coordinate());
+        }
+    }
+
+    runBenchmark("route", number_of_queries, [&](const std::size_t index) {
+        json::Object result;
+        return osrm.Route(route_queries[index], result);
+    });
+
+    runBenchmark("table " + std::to_string(table_size) + "x" + std::to_string(table_size),
+                 number_of_queries,
+                 [&](const std::size_t index) {
+                     json::Object result;
+                     return osrm.Table(table_queries[index], result);
+                 });
+
+    return EXIT_SUCCESS;
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
@@ -0,0 +1,119 @@
+#include "storage/shared_memory.hpp"
+#include "util/log.hpp"
+#include "util/timing_util.hpp"
+
+#include <boost/filesystem.hpp>
+
+#include <cstdint>
+#include <cstdlib>
+#include <exception>
+#include <iostream>
+#include <random>
+#include <string>
+#include <utility>
+#include <vector>
+
+using namespace osrm;
+
+namespace
+{
+// keeps the benchmark regions apart from the ones of osrm-datastore
+struct BenchmarkLockFile
+{
+    boost::filesystem::path operator()()
+    {
+        return boost::filesystem::temp_directory_path() / "osrm-shm-bench.lock";
+    }
+};
+
+const constexpr int BENCHMARK_REGION = 0;
+
+// Random reads that depend on each other, similar to the accesses of a query into the graph
+// and geometry arrays. Returns the mean latency in nanoseconds.
+double measureRandomAccess(const storage::MemoryPlacement placement,
+                           const std::uint64_t size,
+                           const std::size_t number_of_accesses)
+{
+    if (storage::SharedMemory::RegionExists<int, BenchmarkLockFile>(BENCHMARK_REGION))
+    {
+        storage::SharedMemory::Remove<int, BenchmarkLockFile>(BENCHMARK_REGION);
+    }
+
+    double latency = 0;
+    {
+        auto memory = storage::makeSharedMemory<int, BenchmarkLockFile>(
+            BENCHMARK_REGION, size, true, placement);
+        auto *slots = static_cast<std::uint32_t *>(memory->Ptr());
+        const std::uint32_t number_of_slots = size / sizeof(std::uint32_t);
+
+        // Sattolo's algorithm: a random permutation that is a single cycle
+        std::mt19937 generator(42);
+        for (std::uint32_t slot = 0; slot < number_of_slots; ++slot)
+        {
+            slots[slot] = slot;
+        }
+        for (std::uint32_t slot = number_of_slots - 1; slot > 0; --slot)
+        {
+            std::uniform_int_distribution<std::uint32_t> distribution(0, slot - 1);
+            std::swap(slots[slot], slots[distribution(generator)]);
+        }
+
+        std::uint32_t current = 0;
+        TIMER_START(random_access);
+        for (std::size_t access = 0; access < number_of_accesses; ++access)
+        {
+            current = slots[current];
+        }
+        TIMER_STOP(random_access);
+
+        // use the result, so the loop can not be removed
+        if (current == number_of_slots)
+        {
+            std::cout << current;
+        }
+        latency = TIMER_NSEC(random_access) / static_cast<double>(number_of_accesses);
+    }
+
+    storage::SharedMemory::Remove<int, BenchmarkLockFile>(BENCHMARK_REGION);
+    return latency;
+}
+}
+
+int main(int argc, const char *argv[]) try
+{
+#ifndef __linux__
+    std::cerr << "Memory placement is only supported on Linux\n";
+    return EXIT_SUCCESS;
+#else
+    util::LogPolicy::GetInstance().Unmute();
+
+    const std::uint64_t size_in_mb = argc > 1 ? std::stoull(argv[1]) : 1024;
+    const std::size_t number_of_accesses = 20 * 1000 * 1000;
+    const std::uint64_t size = size_in_mb * 1024 * 1024;
+
+    using Placement = storage::MemoryPlacement;
+    const std::vector<std::pair<std::string, Placement>> placements = {
+        {"4KB pages, local", {Placement::HugePages::None, Placement::NUMAPolicy::Local}},
+        {"4KB pages, interleave", {Placement::HugePages::None, Placement::NUMAPolicy::Interleave}},
+        {"2MB pages, local", {Placement::HugePages::Pages2MB, Placement::NUMAPolicy::Local}},
+        {"2MB pages, interleave",
+         {Placement::HugePages::Pages2MB, Placement::NUMAPolicy::Interleave}},
+        {"1GB pages, local", {Placement::HugePages::Pages1GB, Placement::NUMAPolicy::Local}},
+        {"1GB pages, interleave",
+         {Placement::HugePages::Pages1GB, Placement::NUMAPolicy::Interleave}}};
+
+    std::cout << "random access latency on " << size_in_mb << "MB of shared memory\n";
+    for (const auto &placement : placements)
+    {
+        const auto latency = measureRandomAccess(placement.second, size, number_of_accesses);
+        std::cout << placement.first << ": " << latency << "ns\n";
+    }
+
+    return EXIT_SUCCESS;
+#endif
+}
+catch (const std::exception &e)
+{
+    std::cerr << "Error: " << e.what() << std::endl;
+    return EXIT_FAILURE;
+}
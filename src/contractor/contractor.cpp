@@ -1,4 +1,5 @@
 #include "contractor/contractor.hpp"
+#include "contractor/core_landmarks.hpp"
 #include "contractor/crc32_processor.hpp"
 #include "contractor/graph_contractor.hpp"
 
@@ -21,6 +22,7 @@
 
 #include <boost/assert.hpp>
 #include <boost/filesystem/fstream.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <boost/functional/hash.hpp>
 #include <boost/interprocess/file_mapping.hpp>
 #include <boost/interprocess/mapped_region.hpp>
@@ -33,16 +35,17 @@
 #include <tbb/parallel_for_each.h>
 #include <tbb/parallel_invoke.h>
 #include <tbb/parallel_sort.h>
-#include <tbb/spin_mutex.h>
 
 #include <algorithm>
 #include <bitset>
+#include <cctype>
 #include <cstdint>
 #include <fstream>
 #include <iterator>
 #include <memory>
 #include <thread>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace std
@@ -163,7 +166,8 @@ int Contractor::Run()
                                                config.datasource_names_path,
                                                config.datasource_indexes_path,
                                                config.rtree_leaf_path,
-                                               config.log_edge_updates_factor);
+                                               config.log_edge_updates_factor,
+                                               config.cache_lookup_files);
 
     // Contracting the edge-expanded graph
 
@@ -187,12 +191,16 @@ int Contractor::Run()
     util::Log() << "Contraction took " << TIMER_SEC(contraction) << " sec";
 
     std::size_t number_of_used_edges = WriteContractedGraph(max_edge_id, contracted_edge_list);
+    WriteCoreLandmarks(contracted_edge_list, is_core_node);
     WriteCoreNodeMarker(std::move(is_core_node));
     if (!config.use_cached_priority)
     {
         WriteNodeLevels(std::move(node_levels));
     }
 
+    // all outputs are written, the checkpoint is not needed anymore
+    boost::filesystem::remove(config.checkpoint_path);
+
     TIMER_STOP(preparing);
 
     const auto nodes_per_second =
@@ -232,6 +240,9 @@ struct SegmentSpeedSource final
 {
     Segment segment;
     SpeedSource speed_source;
+
+    void SetSource(const std::uint8_t source) { speed_source.source = source; }
+
     // < operator is overloaded here to return a > comparison to be used by the
     // std::lower_bound() call in the find() function
     bool operator<(const SegmentSpeedSource &other) const
@@ -258,6 +269,9 @@ struct TurnPenaltySource final
 {
     Turn segment;
     PenaltySource penalty_source;
+
+    void SetSource(const std::uint8_t source) { penalty_source.source = source; }
+
     // < operator is overloaded here to return a > comparison to be used by the
     // std::lower_bound() call in the find() function
     bool operator<(const TurnPenaltySource &other) const
@@ -286,190 +300,332 @@ auto find(const FlatMap &map, const SegmentKey &key)
 
 // Functions for parsing files and creating lookup tables
 
-SegmentSpeedSourceFlatMap
-parse_segment_lookup_from_csv_files(const std::vector<std::string> &segment_speed_filenames)
+// Lookup files are memory mapped and cut into chunks of roughly this size, which are parsed in
+// parallel. Chunks always end at a line break.
+const constexpr std::size_t LOOKUP_FILE_CHUNK_SIZE = 4 * 1024 * 1024;
+
+// Parses all lines of a lookup file in parallel. ParseLine is called with the boundaries of a
+// single line (without the line break) and returns false if the line is malformed.
+// Returns one vector of values per chunk, in file order.
+template <typename Value, typename ParseLine>
+std::vector<std::vector<Value>> parse_lookup_file(const std::string &filename,
+                                                  const std::string &description,
+                                                  const ParseLine &parse_line)
 {
-    // TODO: shares code with turn penalty lookup parse function
+    std::vector<std::vector<Value>> chunk_values;
+    if (boost::filesystem::file_size(filename) == 0)
+    {
+        return chunk_values;
+    }
 
-    using Mutex = tbb::spin_mutex;
+    using boost::interprocess::file_mapping;
+    using boost::interprocess::mapped_region;
+    using boost::interprocess::read_only;
 
-    // Loaded and parsed in parallel, at the end we combine results in a flattened map-ish view
-    SegmentSpeedSourceFlatMap flatten;
-    Mutex flatten_mutex;
+    const file_mapping mapping{filename.c_str(), read_only};
+    mapped_region region{mapping, read_only};
+    region.advise(mapped_region::advice_sequential);
 
-    const auto parse_segment_speed_file = [&](const std::size_t idx) {
-        const auto file_id = idx + 1; // starts at one, zero means we assigned the weight
-        const auto filename = segment_speed_filenames[idx];
+    const char *const file_begin = static_cast<const char *>(region.get_address());
+    const char *const file_end = file_begin + region.get_size();
 
-        storage::io::FileReader segment_speed_file_reader(
-            filename, storage::io::FileReader::HasNoFingerprint);
+    std::vector<const char *> chunk_boundaries{file_begin};
+    for (std::size_t offset = LOOKUP_FILE_CHUNK_SIZE; offset < region.get_size();
+         offset += LOOKUP_FILE_CHUNK_SIZE)
+    {
+        const auto search_begin = std::max(file_begin + offset, chunk_boundaries.back());
+        const auto boundary = std::find(search_begin, file_end, '\n');
+        if (boundary == file_end || boundary + 1 == file_end)
+        {
+            break;
+        }
+        chunk_boundaries.push_back(boundary + 1);
+    }
+    chunk_boundaries.push_back(file_end);
 
-        SegmentSpeedSourceFlatMap local;
+    chunk_values.resize(chunk_boundaries.size() - 1);
+    tbb::parallel_for(std::size_t{0}, chunk_values.size(), [&](const std::size_t chunk) {
+        auto &values = chunk_values[chunk];
+        values.reserve((chunk_boundaries[chunk + 1] - chunk_boundaries[chunk]) / 16);
 
-        std::uint64_t from_node_id{};
-        std::uint64_t to_node_id{};
-        unsigned speed{};
+        const char *line_begin = chunk_boundaries[chunk];
+        const char *const chunk_end = chunk_boundaries[chunk + 1];
+        while (line_begin != chunk_end)
+        {
+            const char *const line_end = std::find(line_begin, chunk_end, '\n');
+            const char *const next_line = line_end == chunk_end ? chunk_end : line_end + 1;
 
-        std::size_t line_number = 0;
+            // tolerate files with Windows line endings
+            const char *const content_end =
+                (line_end != line_begin && *(line_end - 1) == '\r') ? line_end - 1 : line_end;
 
-        std::for_each(
-            segment_speed_file_reader.GetLineIteratorBegin(),
-            segment_speed_file_reader.GetLineIteratorEnd(),
-            [&](const std::string &line) {
-                ++line_number;
+            Value value;
+            if (!parse_line(line_begin, content_end, value))
+            {
+                // only count lines on error, this is not needed for regular parsing
+                const auto line_number = std::count(file_begin, line_begin, '\n') + 1;
+                std::string message = description + " " + filename + " malformed on line " +
+                                      std::to_string(line_number);
+                message.front() = std::toupper(message.front());
+                throw util::exception(message + SOURCE_REF);
+            }
+            values.push_back(std::move(value));
 
-                using namespace boost::spirit::qi;
+            line_begin = next_line;
+        }
+    });
 
-                auto it = begin(line);
-                const auto last = end(line);
+    return chunk_values;
+}
 
-                // The ulong_long -> uint64_t will likely break on 32bit platforms
-                const auto ok =
-                    parse(it,
-                          last,                                                                  //
-                          (ulong_long >> ',' >> ulong_long >> ',' >> uint_ >> *(',' >> *char_)), //
-                          from_node_id,
-                          to_node_id,
-                          speed); //
+// Sorts all chunks and merges them pairwise in parallel. Merging only ever combines a chunk with
+// its successor and prefers values from the left side, so the result is the same as a stable
+// sort of all chunks concatenated in order.
+template <typename Value, typename Compare>
+std::vector<Value> sort_merge_chunks(std::vector<std::vector<Value>> chunks, const Compare &compare)
+{
+    if (chunks.empty())
+    {
+        return {};
+    }
 
-                if (!ok || it != last)
-                {
-                    const std::string message{"Segment speed file " + filename +
-                                              " malformed on line " + std::to_string(line_number)};
-                    throw util::exception(message + SOURCE_REF);
-                }
+    tbb::parallel_for(std::size_t{0}, chunks.size(), [&](const std::size_t chunk) {
+        std::stable_sort(begin(chunks[chunk]), end(chunks[chunk]), compare);
+    });
 
-                SegmentSpeedSource val{{OSMNodeID{from_node_id}, OSMNodeID{to_node_id}},
-                                       {speed, static_cast<std::uint8_t>(file_id)}};
+    while (chunks.size() > 1)
+    {
+        std::vector<std::vector<Value>> merged((chunks.size() + 1) / 2);
+        tbb::parallel_for(std::size_t{0}, merged.size(), [&](const std::size_t index) {
+            auto &lhs = chunks[2 * index];
+            if (2 * index + 1 == chunks.size())
+            {
+                merged[index] = std::move(lhs);
+                return;
+            }
+            auto &rhs = chunks[2 * index + 1];
+
+            merged[index].reserve(lhs.size() + rhs.size());
+            std::merge(begin(lhs),
+                       end(lhs),
+                       begin(rhs),
+                       end(rhs),
+                       std::back_inserter(merged[index]),
+                       compare);
+
+            std::vector<Value>().swap(lhs);
+            std::vector<Value>().swap(rhs);
+        });
+        chunks.swap(merged);
+    }
 
-                local.push_back(std::move(val));
-            });
+    return std::move(chunks.front());
+}
 
-        util::Log() << "Loaded speed file " << filename << " with " << local.size() << " speeds";
+// Binary cache of a parsed lookup file, stored next to it. The cache records the size and the
+// modification time of the file it was created from and is only used if both still match.
+using LookupFileVersion = std::pair<std::uint64_t, std::int64_t>;
 
+LookupFileVersion get_lookup_file_version(const std::string &filename)
+{
+    return {boost::filesystem::file_size(filename), boost::filesystem::last_write_time(filename)};
+}
+
+template <typename Value>
+bool read_lookup_file_cache(const std::string &filename, std::vector<Value> &values)
+{
+    const std::string cache_filename = filename + ".bin";
+    if (!boost::filesystem::exists(cache_filename))
+    {
+        return false;
+    }
+
+    storage::io::FileReader cache_reader(cache_filename,
+                                         storage::io::FileReader::VerifyFingerprint);
+    LookupFileVersion cached_version;
+    cached_version.first = cache_reader.ReadOne<std::uint64_t>();
+    cached_version.second = cache_reader.ReadOne<std::int64_t>();
+    if (cached_version != get_lookup_file_version(filename))
+    {
+        return false;
+    }
+    cache_reader.DeserializeVector(values);
+    return true;
+}
+
+template <typename Value>
+void write_lookup_file_cache(const std::string &filename, std::vector<Value> &values)
+{
+    const std::string cache_filename = filename + ".bin";
+    try
+    {
+        storage::io::FileWriter cache_writer(cache_filename,
+                                             storage::io::FileWriter::GenerateFingerprint);
+        const auto version = get_lookup_file_version(filename);
+        cache_writer.WriteOne(version.first);
+        cache_writer.WriteOne(version.second);
+        cache_writer.SerializeVector(values);
+    }
+    catch (const util::exception &e)
+    {
+        // the cache is optional, e.g. the directory might be read-only
+        util::Log(logWARNING) << "Could not write " << cache_filename << ": " << e.what();
+        boost::system::error_code ignored;
+        boost::filesystem::remove(cache_filename, ignored);
+    }
+}
+
+// Loads all lookup files, later files take precedence over earlier ones. Within a file the
+// first occurrence of a key wins.
+template <typename Value, typename ParseLine, typename SortBy, typename UniqueBy>
+std::vector<Value> parse_lookup_files(const std::vector<std::string> &filenames,
+                                      const std::string &description,
+                                      const bool use_cache,
+                                      const ParseLine &parse_line,
+                                      const SortBy &sort_by,
+                                      const UniqueBy &unique_by)
+{
+    std::vector<std::vector<std::vector<Value>>> file_chunks(filenames.size());
+
+    const auto load_file = [&](const std::size_t idx) {
+        const auto file_id = idx + 1; // starts at one, zero means we assigned the weight
+        const auto &filename = filenames[idx];
+        if (!boost::filesystem::exists(filename))
         {
-            Mutex::scoped_lock _{flatten_mutex};
+            std::string message = description + " " + filename + " not found";
+            message.front() = std::toupper(message.front());
+            throw util::exception(message + SOURCE_REF);
+        }
+
+        auto &chunks = file_chunks[idx];
+        std::vector<Value> cached;
+        if (use_cache && read_lookup_file_cache(filename, cached))
+        {
+            chunks.push_back(std::move(cached));
+        }
+        else
+        {
+            chunks = parse_lookup_file<Value>(filename, description, parse_line);
+            if (use_cache)
+            {
+                std::vector<Value> values;
+                for (const auto &chunk : chunks)
+                {
+                    values.insert(end(values), begin(chunk), end(chunk));
+                }
+                write_lookup_file_cache(filename, values);
+            }
+        }
 
-            flatten.insert(end(flatten),
-                           std::make_move_iterator(begin(local)),
-                           std::make_move_iterator(end(local)));
+        std::size_t number_of_values = 0;
+        for (auto &chunk : chunks)
+        {
+            for (auto &value : chunk)
+            {
+                value.SetSource(static_cast<std::uint8_t>(file_id));
+            }
+            number_of_values += chunk.size();
         }
+
+        util::Log() << "Loaded " << description << " " << filename << " with "
+                    << number_of_values << " values";
     };
 
     try
     {
-        tbb::parallel_for(std::size_t{0}, segment_speed_filenames.size(), parse_segment_speed_file);
+        tbb::parallel_for(std::size_t{0}, filenames.size(), load_file);
     }
     catch (const tbb::captured_exception &e)
     {
         throw util::exception(e.what() + SOURCE_REF);
     }
 
-    // With flattened map-ish view of all the files, sort and unique them on from,to,source
+    std::vector<std::vector<Value>> chunks;
+    for (auto &file : file_chunks)
+    {
+        std::move(begin(file), end(file), std::back_inserter(chunks));
+    }
+    file_chunks.clear();
+
+    // With flattened map-ish view of all the files, sort and unique them on key and source
+    auto values = sort_merge_chunks(std::move(chunks), sort_by);
+
+    // Unique only on the key to take the source precedence into account and remove duplicates
+    const auto it = std::unique(begin(values), end(values), unique_by);
+    values.erase(it, end(values));
+
+    util::Log() << "In total loaded " << filenames.size() << " " << description
+                << "(s) with a total of " << values.size() << " unique values";
+
+    return values;
+}
+
+SegmentSpeedSourceFlatMap
+parse_segment_lookup_from_csv_files(const std::vector<std::string> &segment_speed_filenames,
+                                    const bool use_cache)
+{
+    const auto parse_line = [](const char *first, const char *last, SegmentSpeedSource &value) {
+        using namespace boost::spirit::qi;
+
+        std::uint64_t from_node_id{};
+        std::uint64_t to_node_id{};
+        unsigned speed{};
+
+        // The ulong_long -> uint64_t will likely break on 32bit platforms
+        const auto ok = parse(first,
+                              last,                                                                  //
+                              (ulong_long >> ',' >> ulong_long >> ',' >> uint_ >> *(',' >> *char_)), //
+                              from_node_id,
+                              to_node_id,
+                              speed); //
+
+        value = SegmentSpeedSource{{OSMNodeID{from_node_id}, OSMNodeID{to_node_id}}, {speed, 0}};
+        return ok && first == last;
+    };
+
     // The greater '>' is used here since we want to give files later on higher precedence
     const auto sort_by = [](const SegmentSpeedSource &lhs, const SegmentSpeedSource &rhs) {
         return std::tie(lhs.segment.from, lhs.segment.to, lhs.speed_source.source) >
                std::tie(rhs.segment.from, rhs.segment.to, rhs.speed_source.source);
     };
 
-    std::stable_sort(begin(flatten), end(flatten), sort_by);
-
-    // Unique only on from,to to take the source precedence into account and remove duplicates
     const auto unique_by = [](const SegmentSpeedSource &lhs, const SegmentSpeedSource &rhs) {
         return std::tie(lhs.segment.from, lhs.segment.to) ==
                std::tie(rhs.segment.from, rhs.segment.to);
     };
 
-    const auto it = std::unique(begin(flatten), end(flatten), unique_by);
-
-    flatten.erase(it, end(flatten));
-
-    util::Log() << "In total loaded " << segment_speed_filenames.size()
-                << " speed file(s) with a total of " << flatten.size() << " unique values";
-
-    return flatten;
+    return parse_lookup_files<SegmentSpeedSource>(
+        segment_speed_filenames, "segment speed file", use_cache, parse_line, sort_by, unique_by);
 }
 
 TurnPenaltySourceFlatMap
-parse_turn_penalty_lookup_from_csv_files(const std::vector<std::string> &turn_penalty_filenames)
+parse_turn_penalty_lookup_from_csv_files(const std::vector<std::string> &turn_penalty_filenames,
+                                         const bool use_cache)
 {
-    using Mutex = tbb::spin_mutex;
-
-    // TODO: shares code with turn penalty lookup parse function
-    TurnPenaltySourceFlatMap map;
-    Mutex flatten_mutex;
-
-    const auto parse_turn_penalty_file = [&](const std::size_t idx) {
-        const auto file_id = idx + 1; // starts at one, zero means we assigned the weight
-        const auto filename = turn_penalty_filenames[idx];
-
-        storage::io::FileReader turn_penalty_file_reader(filename,
-                                                         storage::io::FileReader::HasNoFingerprint);
-        TurnPenaltySourceFlatMap local;
+    const auto parse_line = [](const char *first, const char *last, TurnPenaltySource &value) {
+        using namespace boost::spirit::qi;
 
         std::uint64_t from_node_id{};
         std::uint64_t via_node_id{};
         std::uint64_t to_node_id{};
         double penalty{};
 
-        std::size_t line_number = 0;
-
-        std::for_each(
-            turn_penalty_file_reader.GetLineIteratorBegin(),
-            turn_penalty_file_reader.GetLineIteratorEnd(),
-            [&](const std::string &line) {
-                ++line_number;
-
-                using namespace boost::spirit::qi;
-
-                auto it = begin(line);
-                const auto last = end(line);
-
-                // The ulong_long -> uint64_t will likely break on 32bit platforms
-                const auto ok = parse(it,
-                                      last, //
-                                      (ulong_long >> ',' >> ulong_long >> ',' >> ulong_long >>
-                                       ',' >> double_ >> *(',' >> *char_)), //
-                                      from_node_id,
-                                      via_node_id,
-                                      to_node_id,
-                                      penalty); //
-
-                if (!ok || it != last)
-                {
-                    const std::string message{"Turn penalty file " + filename +
-                                              " malformed on line " + std::to_string(line_number)};
-                    throw util::exception(message + SOURCE_REF);
-                }
-
-                TurnPenaltySource val{
-                    {OSMNodeID{from_node_id}, OSMNodeID{via_node_id}, OSMNodeID{to_node_id}},
-                    {penalty, static_cast<std::uint8_t>(file_id)}};
-                local.push_back(std::move(val));
-            });
-
-        util::Log() << "Loaded penalty file " << filename << " with " << local.size()
-                    << " turn penalties";
-
-        {
-            Mutex::scoped_lock _{flatten_mutex};
-
-            map.insert(end(map),
-                       std::make_move_iterator(begin(local)),
-                       std::make_move_iterator(end(local)));
-        }
+        // The ulong_long -> uint64_t will likely break on 32bit platforms
+        const auto ok = parse(first,
+                              last, //
+                              (ulong_long >> ',' >> ulong_long >> ',' >> ulong_long >> ',' >>
+                               double_ >> *(',' >> *char_)), //
+                              from_node_id,
+                              via_node_id,
+                              to_node_id,
+                              penalty); //
+
+        value = TurnPenaltySource{
+            {OSMNodeID{from_node_id}, OSMNodeID{via_node_id}, OSMNodeID{to_node_id}},
+            {penalty, 0}};
+        return ok && first == last;
     };
 
-    try
-    {
-        tbb::parallel_for(std::size_t{0}, turn_penalty_filenames.size(), parse_turn_penalty_file);
-    }
-    catch (const tbb::captured_exception &e)
-    {
-        throw util::exception(e.what() + SOURCE_REF);
-    }
-
-    // With flattened map-ish view of all the files, sort and unique them on from,to,source
     // The greater '>' is used here since we want to give files later on higher precedence
     const auto sort_by = [](const TurnPenaltySource &lhs, const TurnPenaltySource &rhs) {
         return std::tie(
@@ -478,22 +634,13 @@ parse_turn_penalty_lookup_from_csv_files(const std::vector<std::string> &turn_pe
                    rhs.segment.from, rhs.segment.via, rhs.segment.to, rhs.penalty_source.source);
     };
 
-    std::stable_sort(begin(map), end(map), sort_by);
-
-    // Unique only on from,to to take the source precedence into account and remove duplicates
     const auto unique_by = [](const TurnPenaltySource &lhs, const TurnPenaltySource &rhs) {
         return std::tie(lhs.segment.from, lhs.segment.via, lhs.segment.to) ==
                std::tie(rhs.segment.from, rhs.segment.via, rhs.segment.to);
     };
 
-    const auto it = std::unique(begin(map), end(map), unique_by);
-
-    map.erase(it, end(map));
-
-    util::Log() << "In total loaded " << turn_penalty_filenames.size()
-                << " turn penalty file(s) with a total of " << map.size() << " unique values";
-
-    return map;
+    return parse_lookup_files<TurnPenaltySource>(
+        turn_penalty_filenames, "turn penalty file", use_cache, parse_line, sort_by, unique_by);
 }
 } // anon ns
 
@@ -510,7 +657,8 @@ EdgeID Contractor::LoadEdgeExpandedGraph(
     const std::string &datasource_names_filename,
     const std::string &datasource_indexes_filename,
     const std::string &rtree_leaf_filename,
-    const double log_edge_updates_factor)
+    const double log_edge_updates_factor,
+    const bool cache_lookup_files)
 {
     if (segment_speed_filenames.size() > 255 || turn_penalty_filenames.size() > 255)
         throw util::exception("Limit of 255 segment speed and turn penalty files each reached" +
@@ -585,12 +733,14 @@ EdgeID Contractor::LoadEdgeExpandedGraph(
 
     const auto parse_segment_speeds = [&] {
         if (update_edge_weights)
-            segment_speed_lookup = parse_segment_lookup_from_csv_files(segment_speed_filenames);
+            segment_speed_lookup =
+                parse_segment_lookup_from_csv_files(segment_speed_filenames, cache_lookup_files);
     };
 
     const auto parse_turn_penalties = [&] {
         if (update_turn_penalties)
-            turn_penalty_lookup = parse_turn_penalty_lookup_from_csv_files(turn_penalty_filenames);
+            turn_penalty_lookup =
+                parse_turn_penalty_lookup_from_csv_files(turn_penalty_filenames, cache_lookup_files);
     };
 
     // If we update the edge weights, this file will hold the datasource information for each
@@ -1002,6 +1152,27 @@ void Contractor::WriteCoreNodeMarker(std::vector<bool> &&in_is_core_node) const
                                     sizeof(char) * unpacked_bool_flags.size());
 }
 
+void Contractor::WriteCoreLandmarks(const util::DeallocatingVector<QueryEdge> &contracted_edge_list,
+                                    const std::vector<bool> &is_core_node) const
+{
+    TIMER_START(landmarks);
+    auto landmarks =
+        ComputeCoreLandmarks(contracted_edge_list, is_core_node, config.number_of_core_landmarks);
+    TIMER_STOP(landmarks);
+
+    // An empty file is written if there is no core, so the dataset stays complete
+    storage::io::FileWriter landmarks_file(config.core_landmarks_output_path,
+                                           storage::io::FileWriter::GenerateFingerprint);
+    landmarks_file.WriteOne(landmarks.number_of_landmarks);
+    landmarks_file.SerializeVector(landmarks.bucket_ranks);
+    landmarks_file.SerializeVector(landmarks.distances);
+
+    if (landmarks.number_of_landmarks > 0)
+    {
+        util::Log() << "Core landmarks took " << TIMER_SEC(landmarks) << " sec";
+    }
+}
+
 std::size_t
 Contractor::WriteContractedGraph(unsigned max_node_id,
                                  const util::DeallocatingVector<QueryEdge> &contracted_edge_list)
@@ -1134,6 +1305,11 @@ void Contractor::ContractGraph(
 
     GraphContractor graph_contractor(
         max_edge_id + 1, edge_based_edge_list, std::move(node_levels), std::move(node_weights));
+    if (config.checkpoint_interval > 0 || config.resume_from_checkpoint)
+    {
+        graph_contractor.SetCheckpointing(
+            config.checkpoint_path, config.checkpoint_interval, config.resume_from_checkpoint);
+    }
     graph_contractor.Run(config.core_factor);
     graph_contractor.GetEdges(contracted_edge_list);
     graph_contractor.GetCoreMarker(is_core_node);
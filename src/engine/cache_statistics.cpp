@@ -0,0 +1,14 @@
+#include "engine/cache_statistics.hpp"
+
+namespace osrm
+{
+namespace engine
+{
+
+CacheStatistics &CacheStatistics::GetInstance()
+{
+    static CacheStatistics statistics;
+    return statistics;
+}
+}
+}
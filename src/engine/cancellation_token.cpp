@@ -0,0 +1,43 @@
+#include "engine/cancellation_token.hpp"
+
+#include <boost/thread/tss.hpp>
+
+namespace osrm
+{
+namespace engine
+{
+
+constexpr std::uint32_t CancellationToken::CHECK_INTERVAL;
+
+namespace
+{
+boost::thread_specific_ptr<CancellationState> cancellation_state;
+}
+
+CancellationScope::CancellationScope(const CancellationToken &token)
+    : previous_token(GetState().token)
+{
+    GetState().token = &token;
+}
+
+CancellationScope::~CancellationScope() { GetState().token = previous_token; }
+
+void CancellationScope::Check()
+{
+    const auto token = GetState().token;
+    if (token)
+    {
+        token->ThrowIfCancelled();
+    }
+}
+
+CancellationState &CancellationScope::GetState()
+{
+    if (!cancellation_state.get())
+    {
+        cancellation_state.reset(new CancellationState);
+    }
+    return *cancellation_state;
+}
+}
+}
@@ -1,28 +1,41 @@
 #include "engine/engine.hpp"
 #include "engine/api/route_parameters.hpp"
+#include "engine/cancellation_token.hpp"
 #include "engine/engine_config.hpp"
 #include "engine/status.hpp"
 
+#include "engine/datafacade/mmap_memory_datafacade.hpp"
 #include "engine/datafacade/process_memory_datafacade.hpp"
 #include "engine/datafacade/shared_memory_datafacade.hpp"
 
-#include "storage/shared_barriers.hpp"
 #include "util/log.hpp"
 
 #include <boost/assert.hpp>
-#include <boost/interprocess/sync/named_condition.hpp>
-#include <boost/interprocess/sync/scoped_lock.hpp>
-#include <boost/interprocess/sync/sharable_lock.hpp>
 
 #include <algorithm>
 #include <fstream>
 #include <memory>
+#include <string>
 #include <utility>
 #include <vector>
 
 namespace
 {
-// Abstracted away the query locking into a template function
+// Replaces the partial result of a query that was given up
+void setCancelledResult(const osrm::engine::RequestCancelled &cancelled,
+                        osrm::util::json::Object &result)
+{
+    result.values.clear();
+    result.values["code"] = "Timeout";
+    result.values["message"] = cancelled.what();
+}
+
+void setCancelledResult(const osrm::engine::RequestCancelled &, std::string &result)
+{
+    result.clear();
+}
+
+// Abstracted away picking the data facade into a template function
 // Works the same for every plugin.
 template <typename ParameterT, typename PluginT, typename ResultT>
 osrm::engine::Status
@@ -30,19 +43,34 @@ RunQuery(const std::unique_ptr<osrm::engine::DataWatchdog> &watchdog,
          const std::shared_ptr<osrm::engine::datafacade::BaseDataFacade> &facade,
          const ParameterT &parameters,
          PluginT &plugin,
-         ResultT &result)
+         ResultT &result,
+         const osrm::engine::CancellationToken &token)
 {
-    if (watchdog)
+    // the searches of the plugin check the token of their thread
+    const osrm::engine::CancellationScope cancellation_scope(token);
+    try
     {
-        BOOST_ASSERT(!facade);
-        auto lock_and_facade = watchdog->GetDataFacade();
+        // don't start queries that waited for longer than their deadline
+        token.ThrowIfCancelled();
 
-        return plugin.HandleRequest(lock_and_facade.second, parameters, result);
-    }
+        if (watchdog)
+        {
+            BOOST_ASSERT(!facade);
+            // pins the current dataset for the duration of the request
+            const auto current_facade = watchdog->GetDataFacade();
 
-    BOOST_ASSERT(facade);
+            return plugin.HandleRequest(current_facade, parameters, result);
+        }
+
+        BOOST_ASSERT(facade);
 
-    return plugin.HandleRequest(facade, parameters, result);
+        return plugin.HandleRequest(facade, parameters, result);
+    }
+    catch (const osrm::engine::RequestCancelled &cancelled)
+    {
+        setCancelledResult(cancelled, result);
+        return osrm::engine::Status::Timeout;
+    }
 }
 
 } // anon. ns
@@ -53,14 +81,12 @@ namespace engine
 {
 
 Engine::Engine(const EngineConfig &config)
-    : lock(config.use_shared_memory ? std::make_unique<storage::SharedBarriers>()
-                                    : std::unique_ptr<storage::SharedBarriers>()),
-      route_plugin(config.max_locations_viaroute),       //
-      table_plugin(config.max_locations_distance_table), //
-      nearest_plugin(config.max_results_nearest),        //
-      trip_plugin(config.max_locations_trip),            //
-      match_plugin(config.max_locations_map_matching),   //
-      tile_plugin()                                      //
+    : route_plugin(config.max_locations_viaroute, config.max_alternatives), //
+      table_plugin(config.max_locations_distance_table),                    //
+      nearest_plugin(config.max_results_nearest),                           //
+      trip_plugin(config.max_locations_trip),                               //
+      match_plugin(config.max_locations_map_matching),                      //
+      tile_plugin()                                                         //
 
 {
     if (config.use_shared_memory)
@@ -73,48 +99,68 @@ Engine::Engine(const EngineConfig &config)
                 SOURCE_REF);
         }
 
-        watchdog = std::make_unique<DataWatchdog>();
+        watchdog = std::make_unique<DataWatchdog>(config);
         BOOST_ASSERT(watchdog);
     }
+    else if (config.use_mmap)
+    {
+        auto facade =
+            std::make_shared<datafacade::MMapMemoryDataFacade>(config.storage_config.dataset_path);
+        facade->Configure(config);
+        immutable_data_facade = std::move(facade);
+    }
     else
     {
         if (!config.storage_config.IsValid())
         {
             throw util::exception("Invalid file paths given!" + SOURCE_REF);
         }
-        immutable_data_facade =
-            std::make_shared<datafacade::ProcessMemoryDataFacade>(config.storage_config);
+        auto facade = std::make_shared<datafacade::ProcessMemoryDataFacade>(config.storage_config);
+        facade->Configure(config);
+        immutable_data_facade = std::move(facade);
     }
 }
 
-Status Engine::Route(const api::RouteParameters &params, util::json::Object &result) const
+Status Engine::Route(const api::RouteParameters &params,
+                     util::json::Object &result,
+                     const CancellationToken &token) const
 {
-    return RunQuery(watchdog, immutable_data_facade, params, route_plugin, result);
+    return RunQuery(watchdog, immutable_data_facade, params, route_plugin, result, token);
 }
 
-Status Engine::Table(const api::TableParameters &params, util::json::Object &result) const
+Status Engine::Table(const api::TableParameters &params,
+                     util::json::Object &result,
+                     const CancellationToken &token) const
 {
-    return RunQuery(watchdog, immutable_data_facade, params, table_plugin, result);
+    return RunQuery(watchdog, immutable_data_facade, params, table_plugin, result, token);
 }
 
-Status Engine::Nearest(const api::NearestParameters &params, util::json::Object &result) const
+Status Engine::Nearest(const api::NearestParameters &params,
+                       util::json::Object &result,
+                       const CancellationToken &token) const
 {
-    return RunQuery(watchdog, immutable_data_facade, params, nearest_plugin, result);
+    return RunQuery(watchdog, immutable_data_facade, params, nearest_plugin, result, token);
 }
 
-Status Engine::Trip(const api::TripParameters &params, util::json::Object &result) const
+Status Engine::Trip(const api::TripParameters &params,
+                    util::json::Object &result,
+                    const CancellationToken &token) const
 {
-    return RunQuery(watchdog, immutable_data_facade, params, trip_plugin, result);
+    return RunQuery(watchdog, immutable_data_facade, params, trip_plugin, result, token);
 }
 
-Status Engine::Match(const api::MatchParameters &params, util::json::Object &result) const
+Status Engine::Match(const api::MatchParameters &params,
+                     util::json::Object &result,
+                     const CancellationToken &token) const
 {
-    return RunQuery(watchdog, immutable_data_facade, params, match_plugin, result);
+    return RunQuery(watchdog, immutable_data_facade, params, match_plugin, result, token);
 }
 
-Status Engine::Tile(const api::TileParameters &params, std::string &result) const
+Status Engine::Tile(const api::TileParameters &params,
+                    std::string &result,
+                    const CancellationToken &token) const
 {
-    return RunQuery(watchdog, immutable_data_facade, params, tile_plugin, result);
+    return RunQuery(watchdog, immutable_data_facade, params, tile_plugin, result, token);
 }
 
 } // engine ns
@@ -1,5 +1,7 @@
 #include "engine/engine_config.hpp"
 
+#include <boost/filesystem/operations.hpp>
+
 namespace osrm
 {
 namespace engine
@@ -23,9 +25,20 @@ bool EngineConfig::IsValid() const
                               unlimited_or_more_than(max_locations_map_matching, 2) &&
                               unlimited_or_more_than(max_locations_trip, 2) &&
                               unlimited_or_more_than(max_locations_viaroute, 2) &&
-                              unlimited_or_more_than(max_results_nearest, 0);
+                              unlimited_or_more_than(max_results_nearest, 0) &&
+                              unlimited_or_more_than(max_alternatives, -1);
+
+    // a mapped dataset contains everything but the leaves of the r-tree
+    const bool dataset_valid = use_mmap &&
+                               boost::filesystem::is_regular_file(storage_config.dataset_path) &&
+                               boost::filesystem::is_regular_file(storage_config.file_index_path);
+
+    // the data is either in shared memory or in a mapped dataset
+    const bool source_valid = !(use_shared_memory && use_mmap);
 
-    return ((use_shared_memory && all_path_are_empty) || storage_config.IsValid()) && limits_valid;
+    return ((use_shared_memory && all_path_are_empty) || dataset_valid ||
+            storage_config.IsValid()) &&
+           source_valid && limits_valid;
 }
 }
 }
@@ -1,5 +1,6 @@
 #include "engine/hint.hpp"
 #include "engine/base64.hpp"
+#include "engine/hint_statistics.hpp"
 #include "engine/datafacade/datafacade_base.hpp"
 
 #include <boost/assert.hpp>
@@ -16,11 +17,18 @@ namespace engine
 
 bool Hint::IsValid(const util::Coordinate new_input_coordinates,
                    const datafacade::BaseDataFacade &facade) const
+{
+    return IsValid(new_input_coordinates, facade.GetCheckSum(), facade.GetNumberOfNodes());
+}
+
+bool Hint::IsValid(const util::Coordinate new_input_coordinates,
+                   const std::uint32_t checksum,
+                   const unsigned number_of_nodes) const
 {
     auto is_same_input_coordinate = new_input_coordinates.lon == phantom.input_location.lon &&
                                     new_input_coordinates.lat == phantom.input_location.lat;
-    return is_same_input_coordinate && phantom.IsValid(facade.GetNumberOfNodes()) &&
-           facade.GetCheckSum() == data_checksum;
+    return is_same_input_coordinate && data_checksum == checksum &&
+           phantom.IsValid(number_of_nodes);
 }
 
 std::string Hint::ToBase64() const
@@ -38,14 +46,14 @@ Hint Hint::FromBase64(const std::string &base64Hint)
 {
     BOOST_ASSERT_MSG(base64Hint.size() == ENCODED_HINT_SIZE, "Hint has invalid size");
 
-    // We need mutability but don't want to change the API
-    auto encoded = base64Hint;
-
-    // Reverses above encoding we need for GET parameters in URL
-    std::replace(begin(encoded), end(encoded), '-', '+');
-    std::replace(begin(encoded), end(encoded), '_', '/');
+    // The decoder accepts the URL safe characters of above encoding as well
+    return decodeBase64Bytewise<Hint>(base64Hint);
+}
 
-    return decodeBase64Bytewise<Hint>(encoded);
+HintStatistics &HintStatistics::GetInstance()
+{
+    static HintStatistics statistics;
+    return statistics;
 }
 
 bool operator==(const Hint &lhs, const Hint &rhs)
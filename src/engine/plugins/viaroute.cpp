@@ -21,9 +21,9 @@ namespace engine
 namespace plugins
 {
 
-ViaRoutePlugin::ViaRoutePlugin(int max_locations_viaroute)
+ViaRoutePlugin::ViaRoutePlugin(int max_locations_viaroute, int max_alternatives)
     : shortest_path(heaps), alternative_path(heaps), direct_shortest_path(heaps),
-      max_locations_viaroute(max_locations_viaroute)
+      max_locations_viaroute(max_locations_viaroute), max_alternatives(max_alternatives)
 {
 }
 
@@ -43,6 +43,19 @@ Status ViaRoutePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataF
                      json_result);
     }
 
+    // alternatives=true without a number asks for a single alternative
+    const unsigned number_of_alternatives =
+        route_parameters.alternatives ? std::max(1u, route_parameters.number_of_alternatives) : 0;
+    if (max_alternatives >= 0 && static_cast<int>(number_of_alternatives) > max_alternatives)
+    {
+        return Error("TooBig",
+                     "Requested number of alternatives " +
+                         std::to_string(number_of_alternatives) +
+                         " is higher than current maximum (" + std::to_string(max_alternatives) +
+                         ")",
+                     json_result);
+    }
+
     if (!CheckAllCoordinates(route_parameters.coordinates))
     {
         return Error("InvalidValue", "Invalid coordinate value.", json_result);
@@ -86,9 +99,12 @@ Status ViaRoutePlugin::HandleRequest(const std::shared_ptr<datafacade::BaseDataF
 
     if (1 == raw_route.segment_end_coordinates.size())
     {
-        if (route_parameters.alternatives && facade->GetCoreSize() == 0)
+        if (number_of_alternatives > 0 && facade->GetCoreSize() == 0)
         {
-            alternative_path(*facade, raw_route.segment_end_coordinates.front(), raw_route);
+            alternative_path(*facade,
+                             raw_route.segment_end_coordinates.front(),
+                             number_of_alternatives,
+                             raw_route);
         }
         else
         {
@@ -18,6 +18,9 @@
 #include <boost/assert.hpp>
 #include <boost/numeric/conversion/cast.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
 #include <algorithm>
 #include <cmath>
 #include <fstream>
@@ -305,6 +308,27 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedNodes()
     util::Log() << "Generated " << m_edge_based_node_list.size() << " nodes in edge-expanded graph";
 }
 
+namespace
+{
+// Turns of a single edge entering an intersection. These are computed in parallel and merged
+// in node order afterwards, so the output does not depend on the scheduling.
+struct IntersectionTurns
+{
+    static constexpr std::int32_t INVALID_TURN_PENALTY = std::numeric_limits<std::int32_t>::min();
+
+    NodeID node_at_center_of_intersection;
+    NodeID node_along_road_entering;
+    EdgeID incoming_edge;
+    guidance::Intersection intersection;
+    // turn penalties of the profile by road index, only computed for allowed turns
+    std::vector<std::int32_t> turn_penalties;
+    // serialized lookup::SegmentHeaderBlock and lookup::SegmentBlocks of the incoming edge
+    std::vector<char> segment_lookup;
+};
+
+constexpr std::int32_t IntersectionTurns::INVALID_TURN_PENALTY;
+}
+
 /// Actually it also generates OriginalEdgeData and serializes them...
 void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
     ScriptingEnvironment &scripting_environment,
@@ -364,17 +388,13 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
     bearing_class_by_node_based_node.resize(m_node_based_graph->GetNumberOfNodes(),
                                             std::numeric_limits<std::uint32_t>::max());
 
-    {
-        util::UnbufferedLog log;
-
-        util::Percent progress(log, m_node_based_graph->GetNumberOfNodes());
-        // going over all nodes (which form the center of an intersection), we compute all
-        // possible turns along these intersections.
-        for (const auto node_at_center_of_intersection :
-             util::irange(0u, m_node_based_graph->GetNumberOfNodes()))
+    // Computes the intersection, the turn types and the turn penalties for every edge entering
+    // one of the nodes in [begin, end). This is the expensive part and only reads shared state.
+    const auto compute_intersection_turns = [&](const NodeID begin,
+                                                const NodeID end,
+                                                std::vector<IntersectionTurns> &buffer) {
+        for (const auto node_at_center_of_intersection : util::irange(begin, end))
         {
-            progress.PrintStatus(node_at_center_of_intersection);
-
             const auto shape_result =
                 turn_analysis.ComputeIntersectionShapes(node_at_center_of_intersection);
 
@@ -409,8 +429,6 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
                 if (m_node_based_graph->GetEdgeData(incoming_edge).reversed)
                     continue;
 
-                ++node_based_edge_counter;
-
                 auto intersection_with_flags_and_angles =
                     turn_analysis.GetIntersectionGenerator().TransformIntersectionShapeIntoView(
                         node_along_road_entering,
@@ -424,207 +442,296 @@ void EdgeBasedGraphFactory::GenerateEdgeExpandedEdges(
 
                 BOOST_ASSERT(intersection.valid());
 
-                intersection = turn_lane_handler.assignTurnLanes(
-                    node_along_road_entering, incoming_edge, std::move(intersection));
-
-                // the entry class depends on the turn, so we have to classify the interesction for
-                // every edge
-                const auto turn_classification = classifyIntersection(intersection);
+                std::vector<std::int32_t> turn_penalties(intersection.size(),
+                                                         IntersectionTurns::INVALID_TURN_PENALTY);
+                for (const auto road_index : util::irange<std::size_t>(0, intersection.size()))
+                {
+                    if (intersection[road_index].entry_allowed)
+                        turn_penalties[road_index] = scripting_environment.GetTurnPenalty(
+                            180. - intersection[road_index].angle);
+                }
 
-                const auto entry_class_id = [&](const util::guidance::EntryClass entry_class) {
-                    if (0 == entry_class_hash.count(entry_class))
-                    {
-                        const auto id = static_cast<std::uint16_t>(entry_class_hash.size());
-                        entry_class_hash[entry_class] = id;
-                        return id;
-                    }
-                    else
-                    {
-                        return entry_class_hash.find(entry_class)->second;
-                    }
-                }(turn_classification.first);
-
-                const auto bearing_class_id =
-                    [&](const util::guidance::BearingClass bearing_class) {
-                        if (0 == bearing_class_hash.count(bearing_class))
-                        {
-                            const auto id = static_cast<std::uint32_t>(bearing_class_hash.size());
-                            bearing_class_hash[bearing_class] = id;
-                            return id;
-                        }
-                        else
-                        {
-                            return bearing_class_hash.find(bearing_class)->second;
-                        }
-                    }(turn_classification.second);
-                bearing_class_by_node_based_node[node_at_center_of_intersection] = bearing_class_id;
-
-                for (const auto &turn : intersection)
+                // The segments of the incoming edge are written once for every turn. They only
+                // depend on the edge, so we serialize them once up front.
+                std::vector<char> segment_lookup;
+                if (generate_edge_lookup)
                 {
-                    // only keep valid turns
-                    if (!turn.entry_allowed)
-                        continue;
-
-                    // only add an edge if turn is not prohibited
-                    const EdgeData &edge_data1 = m_node_based_graph->GetEdgeData(incoming_edge);
-                    const EdgeData &edge_data2 = m_node_based_graph->GetEdgeData(turn.eid);
-
-                    BOOST_ASSERT(edge_data1.edge_id != edge_data2.edge_id);
-                    BOOST_ASSERT(!edge_data1.reversed);
-                    BOOST_ASSERT(!edge_data2.reversed);
-
-                    // the following is the core of the loop.
-                    unsigned distance = edge_data1.distance;
-                    if (m_traffic_lights.find(node_at_center_of_intersection) !=
-                        m_traffic_lights.end())
-                    {
-                        distance += profile_properties.traffic_signal_penalty;
-                    }
+                    const auto node_based_edges =
+                        m_compressed_edge_container.GetBucketReference(incoming_edge);
+                    NodeID previous = node_along_road_entering;
 
-                    const int32_t turn_penalty =
-                        scripting_environment.GetTurnPenalty(180. - turn.angle);
+                    const unsigned node_count = node_based_edges.size() + 1;
+                    const QueryNode &first_node = m_node_info_list[previous];
 
-                    const auto turn_instruction = turn.instruction;
-                    if (turn_instruction.direction_modifier == guidance::DirectionModifier::UTurn)
-                    {
-                        distance += profile_properties.u_turn_penalty;
-                    }
+                    lookup::SegmentHeaderBlock header = {node_count, first_node.node_id};
 
-                    // don't add turn penalty if it is not an actual turn. This heuristic is
-                    // necessary
-                    // since OSRM cannot handle looping roads/parallel roads
-                    if (turn_instruction.type != guidance::TurnType::NoTurn)
-                        distance += turn_penalty;
-
-                    const bool is_encoded_forwards =
-                        m_compressed_edge_container.HasZippedEntryForForwardID(incoming_edge);
-                    const bool is_encoded_backwards =
-                        m_compressed_edge_container.HasZippedEntryForReverseID(incoming_edge);
-                    BOOST_ASSERT(is_encoded_forwards || is_encoded_backwards);
-                    if (is_encoded_forwards)
-                    {
-                        original_edge_data_vector.emplace_back(
-                            GeometryID{m_compressed_edge_container.GetZippedPositionForForwardID(
-                                           incoming_edge),
-                                       true},
-                            edge_data1.name_id,
-                            turn.lane_data_id,
-                            turn_instruction,
-                            entry_class_id,
-                            edge_data1.travel_mode,
-                            util::guidance::TurnBearing(intersection[0].bearing),
-                            util::guidance::TurnBearing(turn.bearing));
-                    }
-                    else if (is_encoded_backwards)
+                    segment_lookup.reserve(sizeof(header) +
+                                           node_based_edges.size() * sizeof(lookup::SegmentBlock));
+                    segment_lookup.insert(segment_lookup.end(),
+                                          reinterpret_cast<const char *>(&header),
+                                          reinterpret_cast<const char *>(&header) + sizeof(header));
+
+                    for (auto target_node : node_based_edges)
                     {
-                        original_edge_data_vector.emplace_back(
-                            GeometryID{m_compressed_edge_container.GetZippedPositionForReverseID(
-                                           incoming_edge),
-                                       false},
-                            edge_data1.name_id,
-                            turn.lane_data_id,
-                            turn_instruction,
-                            entry_class_id,
-                            edge_data1.travel_mode,
-                            util::guidance::TurnBearing(intersection[0].bearing),
-                            util::guidance::TurnBearing(turn.bearing));
+                        const QueryNode &from = m_node_info_list[previous];
+                        const QueryNode &to = m_node_info_list[target_node.node_id];
+                        const double segment_length =
+                            util::coordinate_calculation::greatCircleDistance(from, to);
+
+                        lookup::SegmentBlock nodeblock = {
+                            to.node_id, segment_length, target_node.weight};
+
+                        segment_lookup.insert(segment_lookup.end(),
+                                              reinterpret_cast<const char *>(&nodeblock),
+                                              reinterpret_cast<const char *>(&nodeblock) +
+                                                  sizeof(nodeblock));
+                        previous = target_node.node_id;
                     }
+                }
 
-                    ++original_edges_counter;
+                buffer.push_back(IntersectionTurns{node_at_center_of_intersection,
+                                                   node_along_road_entering,
+                                                   incoming_edge,
+                                                   std::move(intersection),
+                                                   std::move(turn_penalties),
+                                                   std::move(segment_lookup)});
+            }
+        }
+    };
 
-                    if (original_edge_data_vector.size() > 1024 * 1024 * 10)
-                    {
-                        FlushVectorToStream(edge_data_file, original_edge_data_vector);
-                    }
+    // Assigns turn lanes, entry and bearing classes and edge ids and writes the turns. All ids
+    // are handed out in order of first use, so this has to run in node order.
+    const auto merge_intersection_turns = [&](IntersectionTurns &turns) {
+        const auto node_at_center_of_intersection = turns.node_at_center_of_intersection;
+        const auto node_along_road_entering = turns.node_along_road_entering;
+        const auto incoming_edge = turns.incoming_edge;
 
-                    BOOST_ASSERT(SPECIAL_NODEID != edge_data1.edge_id);
-                    BOOST_ASSERT(SPECIAL_NODEID != edge_data2.edge_id);
-
-                    // NOTE: potential overflow here if we hit 2^32 routable edges
-                    BOOST_ASSERT(m_edge_based_edge_list.size() <=
-                                 std::numeric_limits<NodeID>::max());
-                    m_edge_based_edge_list.emplace_back(edge_data1.edge_id,
-                                                        edge_data2.edge_id,
-                                                        m_edge_based_edge_list.size(),
-                                                        distance,
-                                                        true,
-                                                        false);
-                    BOOST_ASSERT(original_edges_counter == m_edge_based_edge_list.size());
-
-                    // Here is where we write out the mapping between the edge-expanded edges, and
-                    // the node-based edges that are originally used to calculate the `distance`
-                    // for the edge-expanded edges.  About 40 lines back, there is:
-                    //
-                    //                 unsigned distance = edge_data1.distance;
-                    //
-                    // This tells us that the weight for an edge-expanded-edge is based on the
-                    // weight
-                    // of the *source* node-based edge.  Therefore, we will look up the individual
-                    // segments of the source node-based edge, and write out a mapping between
-                    // those and the edge-based-edge ID.
-                    // External programs can then use this mapping to quickly perform
-                    // updates to the edge-expanded-edge based directly on its ID.
-                    if (generate_edge_lookup)
-                    {
-                        const auto node_based_edges =
-                            m_compressed_edge_container.GetBucketReference(incoming_edge);
-                        NodeID previous = node_along_road_entering;
-
-                        const unsigned node_count = node_based_edges.size() + 1;
-                        const QueryNode &first_node = m_node_info_list[previous];
-
-                        lookup::SegmentHeaderBlock header = {node_count, first_node.node_id};
-
-                        edge_segment_file.write(reinterpret_cast<const char *>(&header),
-                                                sizeof(header));
-
-                        for (auto target_node : node_based_edges)
-                        {
-                            const QueryNode &from = m_node_info_list[previous];
-                            const QueryNode &to = m_node_info_list[target_node.node_id];
-                            const double segment_length =
-                                util::coordinate_calculation::greatCircleDistance(from, to);
-
-                            lookup::SegmentBlock nodeblock = {
-                                to.node_id, segment_length, target_node.weight};
-
-                            edge_segment_file.write(reinterpret_cast<const char *>(&nodeblock),
-                                                    sizeof(nodeblock));
-                            previous = target_node.node_id;
-                        }
-
-                        // We also now write out the mapping between the edge-expanded edges and the
-                        // original nodes. Since each edge represents a possible maneuver, external
-                        // programs can use this to quickly perform updates to edge weights in order
-                        // to penalize certain turns.
-
-                        // If this edge is 'trivial' -- where the compressed edge corresponds
-                        // exactly to an original OSM segment -- we can pull the turn's preceding
-                        // node ID directly with `node_along_road_entering`; otherwise, we need to
-                        // look
-                        // up the node
-                        // immediately preceding the turn from the compressed edge container.
-                        const bool isTrivial = m_compressed_edge_container.IsTrivial(incoming_edge);
-
-                        const auto &from_node =
-                            isTrivial
-                                ? m_node_info_list[node_along_road_entering]
-                                : m_node_info_list[m_compressed_edge_container.GetLastEdgeSourceID(
-                                      incoming_edge)];
-                        const auto &via_node =
-                            m_node_info_list[m_compressed_edge_container.GetLastEdgeTargetID(
-                                incoming_edge)];
-                        const auto &to_node =
-                            m_node_info_list[m_compressed_edge_container.GetFirstEdgeTargetID(
-                                turn.eid)];
-
-                        const unsigned fixed_penalty = distance - edge_data1.distance;
-                        lookup::PenaltyBlock penaltyblock = {
-                            fixed_penalty, from_node.node_id, via_node.node_id, to_node.node_id};
-                        edge_penalty_file.write(reinterpret_cast<const char *>(&penaltyblock),
-                                                sizeof(penaltyblock));
-                    }
+        ++node_based_edge_counter;
+
+        auto intersection = turn_lane_handler.assignTurnLanes(
+            node_along_road_entering, incoming_edge, std::move(turns.intersection));
+        BOOST_ASSERT(intersection.size() == turns.turn_penalties.size());
+
+        // the entry class depends on the turn, so we have to classify the interesction for
+        // every edge
+        const auto turn_classification = classifyIntersection(intersection);
+
+        const auto entry_class_id = [&](const util::guidance::EntryClass entry_class) {
+            if (0 == entry_class_hash.count(entry_class))
+            {
+                const auto id = static_cast<std::uint16_t>(entry_class_hash.size());
+                entry_class_hash[entry_class] = id;
+                return id;
+            }
+            else
+            {
+                return entry_class_hash.find(entry_class)->second;
+            }
+        }(turn_classification.first);
+
+        const auto bearing_class_id = [&](const util::guidance::BearingClass bearing_class) {
+            if (0 == bearing_class_hash.count(bearing_class))
+            {
+                const auto id = static_cast<std::uint32_t>(bearing_class_hash.size());
+                bearing_class_hash[bearing_class] = id;
+                return id;
+            }
+            else
+            {
+                return bearing_class_hash.find(bearing_class)->second;
+            }
+        }(turn_classification.second);
+        bearing_class_by_node_based_node[node_at_center_of_intersection] = bearing_class_id;
+
+        for (const auto road_index : util::irange<std::size_t>(0, intersection.size()))
+        {
+            const auto &turn = intersection[road_index];
+
+            // only keep valid turns
+            if (!turn.entry_allowed)
+                continue;
+
+            // only add an edge if turn is not prohibited
+            const EdgeData &edge_data1 = m_node_based_graph->GetEdgeData(incoming_edge);
+            const EdgeData &edge_data2 = m_node_based_graph->GetEdgeData(turn.eid);
+
+            BOOST_ASSERT(edge_data1.edge_id != edge_data2.edge_id);
+            BOOST_ASSERT(!edge_data1.reversed);
+            BOOST_ASSERT(!edge_data2.reversed);
+
+            // the following is the core of the loop.
+            unsigned distance = edge_data1.distance;
+            if (m_traffic_lights.find(node_at_center_of_intersection) != m_traffic_lights.end())
+            {
+                distance += profile_properties.traffic_signal_penalty;
+            }
+
+            // turn lanes may allow additional u-turns, these have not been looked at before
+            const int32_t turn_penalty =
+                turns.turn_penalties[road_index] != IntersectionTurns::INVALID_TURN_PENALTY
+                    ? turns.turn_penalties[road_index]
+                    : scripting_environment.GetTurnPenalty(180. - turn.angle);
+
+            const auto turn_instruction = turn.instruction;
+            if (turn_instruction.direction_modifier == guidance::DirectionModifier::UTurn)
+            {
+                distance += profile_properties.u_turn_penalty;
+            }
+
+            // don't add turn penalty if it is not an actual turn. This heuristic is
+            // necessary
+            // since OSRM cannot handle looping roads/parallel roads
+            if (turn_instruction.type != guidance::TurnType::NoTurn)
+                distance += turn_penalty;
+
+            const bool is_encoded_forwards =
+                m_compressed_edge_container.HasZippedEntryForForwardID(incoming_edge);
+            const bool is_encoded_backwards =
+                m_compressed_edge_container.HasZippedEntryForReverseID(incoming_edge);
+            BOOST_ASSERT(is_encoded_forwards || is_encoded_backwards);
+            if (is_encoded_forwards)
+            {
+                original_edge_data_vector.emplace_back(
+                    GeometryID{m_compressed_edge_container.GetZippedPositionForForwardID(
+                                   incoming_edge),
+                               true},
+                    edge_data1.name_id,
+                    turn.lane_data_id,
+                    turn_instruction,
+                    entry_class_id,
+                    edge_data1.travel_mode,
+                    util::guidance::TurnBearing(intersection[0].bearing),
+                    util::guidance::TurnBearing(turn.bearing));
+            }
+            else if (is_encoded_backwards)
+            {
+                original_edge_data_vector.emplace_back(
+                    GeometryID{m_compressed_edge_container.GetZippedPositionForReverseID(
+                                   incoming_edge),
+                               false},
+                    edge_data1.name_id,
+                    turn.lane_data_id,
+                    turn_instruction,
+                    entry_class_id,
+                    edge_data1.travel_mode,
+                    util::guidance::TurnBearing(intersection[0].bearing),
+                    util::guidance::TurnBearing(turn.bearing));
+            }
+
+            ++original_edges_counter;
+
+            if (original_edge_data_vector.size() > 1024 * 1024 * 10)
+            {
+                FlushVectorToStream(edge_data_file, original_edge_data_vector);
+            }
+
+            BOOST_ASSERT(SPECIAL_NODEID != edge_data1.edge_id);
+            BOOST_ASSERT(SPECIAL_NODEID != edge_data2.edge_id);
+
+            // NOTE: potential overflow here if we hit 2^32 routable edges
+            BOOST_ASSERT(m_edge_based_edge_list.size() <= std::numeric_limits<NodeID>::max());
+            m_edge_based_edge_list.emplace_back(edge_data1.edge_id,
+                                                edge_data2.edge_id,
+                                                m_edge_based_edge_list.size(),
+                                                distance,
+                                                true,
+                                                false);
+            BOOST_ASSERT(original_edges_counter == m_edge_based_edge_list.size());
+
+            // Here is where we write out the mapping between the edge-expanded edges, and
+            // the node-based edges that are originally used to calculate the `distance`
+            // for the edge-expanded edges.  About 40 lines back, there is:
+            //
+            //                 unsigned distance = edge_data1.distance;
+            //
+            // This tells us that the weight for an edge-expanded-edge is based on the
+            // weight
+            // of the *source* node-based edge.  Therefore, we will look up the individual
+            // segments of the source node-based edge, and write out a mapping between
+            // those and the edge-based-edge ID.
+            // External programs can then use this mapping to quickly perform
+            // updates to the edge-expanded-edge based directly on its ID.
+            if (generate_edge_lookup)
+            {
+                edge_segment_file.write(turns.segment_lookup.data(), turns.segment_lookup.size());
+
+                // We also now write out the mapping between the edge-expanded edges and the
+                // original nodes. Since each edge represents a possible maneuver, external
+                // programs can use this to quickly perform updates to edge weights in order
+                // to penalize certain turns.
+
+                // If this edge is 'trivial' -- where the compressed edge corresponds
+                // exactly to an original OSM segment -- we can pull the turn's preceding
+                // node ID directly with `node_along_road_entering`; otherwise, we need to
+                // look
+                // up the node
+                // immediately preceding the turn from the compressed edge container.
+                const bool isTrivial = m_compressed_edge_container.IsTrivial(incoming_edge);
+
+                const auto &from_node =
+                    isTrivial ? m_node_info_list[node_along_road_entering]
+                              : m_node_info_list[m_compressed_edge_container.GetLastEdgeSourceID(
+                                    incoming_edge)];
+                const auto &via_node =
+                    m_node_info_list[m_compressed_edge_container.GetLastEdgeTargetID(
+                        incoming_edge)];
+                const auto &to_node =
+                    m_node_info_list[m_compressed_edge_container.GetFirstEdgeTargetID(turn.eid)];
+
+                const unsigned fixed_penalty = distance - edge_data1.distance;
+                lookup::PenaltyBlock penaltyblock = {
+                    fixed_penalty, from_node.node_id, via_node.node_id, to_node.node_id};
+                edge_penalty_file.write(reinterpret_cast<const char *>(&penaltyblock),
+                                        sizeof(penaltyblock));
+            }
+        }
+    };
+
+    {
+        util::UnbufferedLog log;
+
+        const auto number_of_nodes = m_node_based_graph->GetNumberOfNodes();
+        util::Percent progress(log, number_of_nodes);
+
+        // going over all nodes (which form the center of an intersection), we compute all
+        // possible turns along these intersections. Nodes are processed in batches: the chunks of
+        // a batch are analysed in parallel and then merged in order, which bounds the memory
+        // needed for the buffered turns.
+        const constexpr NodeID CHUNK_SIZE = 128;
+        const constexpr NodeID BATCH_SIZE = 256 * CHUNK_SIZE;
+
+        std::vector<std::vector<IntersectionTurns>> chunk_buffers(BATCH_SIZE / CHUNK_SIZE);
+        for (NodeID batch_begin = 0; batch_begin < number_of_nodes; batch_begin += BATCH_SIZE)
+        {
+            const NodeID batch_end = std::min(number_of_nodes, batch_begin + BATCH_SIZE);
+            const std::size_t number_of_chunks =
+                (batch_end - batch_begin + CHUNK_SIZE - 1) / CHUNK_SIZE;
+
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0, number_of_chunks),
+                              [&](const tbb::blocked_range<std::size_t> &range) {
+                                  for (auto chunk = range.begin(); chunk != range.end(); ++chunk)
+                                  {
+                                      const NodeID chunk_begin = batch_begin + chunk * CHUNK_SIZE;
+                                      const NodeID chunk_end =
+                                          std::min(batch_end, chunk_begin + CHUNK_SIZE);
+                                      chunk_buffers[chunk].clear();
+                                      compute_intersection_turns(
+                                          chunk_begin, chunk_end, chunk_buffers[chunk]);
+                                  }
+                              });
+
+            for (const auto chunk : util::irange<std::size_t>(0, number_of_chunks))
+            {
+                for (auto &turns : chunk_buffers[chunk])
+                {
+                    merge_intersection_turns(turns);
                 }
+                chunk_buffers[chunk].clear();
+            }
+
+            for (const auto node : util::irange(batch_begin, batch_end))
+            {
+                progress.PrintStatus(node);
             }
         }
     }
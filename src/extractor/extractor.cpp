@@ -1,6 +1,7 @@
 #include "extractor/extractor.hpp"
 
 #include "extractor/edge_based_edge.hpp"
+#include "extractor/edge_based_node_renumbering.hpp"
 #include "extractor/extraction_containers.hpp"
 #include "extractor/extraction_node.hpp"
 #include "extractor/extraction_way.hpp"
@@ -264,6 +265,19 @@ int Extractor::run(ScriptingEnvironment &scripting_environment)
 
         TIMER_STOP(expansion);
 
+        if (config.renumber_nodes)
+        {
+            util::Log() << "Renumbering edge-based nodes along a Hilbert curve ...";
+            TIMER_START(renumbering);
+            const auto old_to_new = ComputeHilbertNodeOrder(edge_based_node_list,
+                                                            internal_to_external_node_map,
+                                                            edge_based_node_weights.size());
+            RenumberEdgeBasedNodes(
+                old_to_new, edge_based_node_list, edge_based_node_weights, edge_based_edge_list);
+            TIMER_STOP(renumbering);
+            util::Log() << "Done renumbering. (" << TIMER_SEC(renumbering) << ")";
+        }
+
         util::Log() << "Saving edge-based node weights to file.";
         TIMER_START(timer_write_node_weights);
         util::serializeVector(config.edge_based_node_weights_output_path, edge_based_node_weights);
@@ -25,33 +25,81 @@ OSRM &OSRM::operator=(OSRM &&) noexcept = default;
 engine::Status OSRM::Route(const engine::api::RouteParameters &params,
                            util::json::Object &result) const
 {
-    return engine_->Route(params, result);
+    const engine::CancellationToken token;
+    return engine_->Route(params, result, token);
+}
+
+engine::Status OSRM::Route(const engine::api::RouteParameters &params,
+                           json::Object &result,
+                           const engine::CancellationToken &token) const
+{
+    return engine_->Route(params, result, token);
 }
 
 engine::Status OSRM::Table(const engine::api::TableParameters &params, json::Object &result) const
 {
-    return engine_->Table(params, result);
+    const engine::CancellationToken token;
+    return engine_->Table(params, result, token);
+}
+
+engine::Status OSRM::Table(const engine::api::TableParameters &params,
+                           json::Object &result,
+                           const engine::CancellationToken &token) const
+{
+    return engine_->Table(params, result, token);
 }
 
 engine::Status OSRM::Nearest(const engine::api::NearestParameters &params,
                              json::Object &result) const
 {
-    return engine_->Nearest(params, result);
+    const engine::CancellationToken token;
+    return engine_->Nearest(params, result, token);
+}
+
+engine::Status OSRM::Nearest(const engine::api::NearestParameters &params,
+                             json::Object &result,
+                             const engine::CancellationToken &token) const
+{
+    return engine_->Nearest(params, result, token);
 }
 
 engine::Status OSRM::Trip(const engine::api::TripParameters &params, json::Object &result) const
 {
-    return engine_->Trip(params, result);
+    const engine::CancellationToken token;
+    return engine_->Trip(params, result, token);
+}
+
+engine::Status OSRM::Trip(const engine::api::TripParameters &params,
+                          json::Object &result,
+                          const engine::CancellationToken &token) const
+{
+    return engine_->Trip(params, result, token);
 }
 
 engine::Status OSRM::Match(const engine::api::MatchParameters &params, json::Object &result) const
 {
-    return engine_->Match(params, result);
+    const engine::CancellationToken token;
+    return engine_->Match(params, result, token);
+}
+
+engine::Status OSRM::Match(const engine::api::MatchParameters &params,
+                           json::Object &result,
+                           const engine::CancellationToken &token) const
+{
+    return engine_->Match(params, result, token);
 }
 
 engine::Status OSRM::Tile(const engine::api::TileParameters &params, std::string &result) const
 {
-    return engine_->Tile(params, result);
+    const engine::CancellationToken token;
+    return engine_->Tile(params, result, token);
+}
+
+engine::Status OSRM::Tile(const engine::api::TileParameters &params,
+                          std::string &result,
+                          const engine::CancellationToken &token) const
+{
+    return engine_->Tile(params, result, token);
 }
 
 } // ns osrm
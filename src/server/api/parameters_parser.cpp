@@ -1,13 +1,26 @@
 #include "server/api/parameters_parser.hpp"
+#include "server/api/query_parser.hpp"
 
-#include "server/api/match_parameter_grammar.hpp"
-#include "server/api/nearest_parameter_grammar.hpp"
-#include "server/api/route_parameters_grammar.hpp"
-#include "server/api/table_parameter_grammar.hpp"
-#include "server/api/tile_parameter_grammar.hpp"
-#include "server/api/trip_parameter_grammar.hpp"
+#include "engine/api/match_parameters.hpp"
+#include "engine/api/nearest_parameters.hpp"
+#include "engine/api/route_parameters.hpp"
+#include "engine/api/table_parameters.hpp"
+#include "engine/api/tile_parameters.hpp"
+#include "engine/api/trip_parameters.hpp"
+#include "engine/bearing.hpp"
+#include "engine/hint.hpp"
+#include "engine/polyline_compressor.hpp"
+#include "util/coordinate.hpp"
 
+#include <boost/numeric/conversion/cast.hpp>
+
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
 #include <type_traits>
+#include <utility>
+#include <vector>
 
 namespace osrm
 {
@@ -16,44 +29,415 @@ namespace server
 namespace api
 {
 
-namespace detail
+namespace
+{
+using Iterator = std::string::iterator;
+
+bool isAlphaNumeral(const char character)
+{
+    return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') ||
+           (character >= '0' && character <= '9');
+}
+
+bool isPolylineChar(const char character)
+{
+    return isAlphaNumeral(character) ||
+           (character != '\0' && std::strchr("%-?@[\\]^_`{|}~", character) != nullptr);
+}
+
+bool isBase64Char(const char character)
 {
-template <typename T>
-using is_grammar_t =
-    std::integral_constant<bool,
-                           std::is_same<RouteParametersGrammar<>, T>::value ||
-                               std::is_same<TableParametersGrammar<>, T>::value ||
-                               std::is_same<NearestParametersGrammar<>, T>::value ||
-                               std::is_same<TripParametersGrammar<>, T>::value ||
-                               std::is_same<MatchParametersGrammar<>, T>::value ||
-                               std::is_same<TileParametersGrammar<>, T>::value>;
+    return isAlphaNumeral(character) || character == '-' || character == '_' || character == '=';
+}
+
+// Parses `element % ';'`, at least one element separated by semicolons
+template <typename T, typename ElementParser>
+bool parseList(QueryParser &parser, std::vector<T> &values, ElementParser &&parse_element)
+{
+    T value;
+    if (!parse_element(value))
+    {
+        return false;
+    }
+    values.push_back(value);
+
+    auto separator = parser.Position();
+    while (parser.Char(';') && parse_element(value))
+    {
+        values.push_back(value);
+        separator = parser.Position();
+    }
+    parser.Reset(separator);
+    return true;
+}
+
+// Parses `-element % ';'`, every empty element is added as boost::none
+template <typename T, typename ElementParser>
+void parseOptionalList(QueryParser &parser,
+                       std::vector<boost::optional<T>> &values,
+                       ElementParser &&parse_element)
+{
+    do
+    {
+        T value;
+        if (parse_element(value))
+        {
+            values.push_back(std::move(value));
+        }
+        else
+        {
+            values.push_back(boost::none);
+        }
+    } while (parser.Char(';'));
+}
+
+// lon,lat
+bool parseLocation(QueryParser &parser, util::Coordinate &coordinate)
+{
+    const auto begin = parser.Position();
+    double lon, lat;
+    if (!parser.JsonDouble(lon))
+    {
+        parser.Reset(begin);
+        return false;
+    }
+    parser.Expect(parser.Char(','));
+    parser.Expect(parser.JsonDouble(lat));
+
+    coordinate = util::Coordinate(util::toFixed(util::FloatLongitude{lon}),
+                                  util::toFixed(util::FloatLatitude{lat}));
+    return true;
+}
+
+// Either a list of lon,lat separated by semicolons or polyline(...)
+bool parseQuery(QueryParser &parser, engine::api::BaseParameters &parameters)
+{
+    const auto parse_location = [&parser](util::Coordinate &coordinate) {
+        return parseLocation(parser, coordinate);
+    };
+    if (parseList(parser, parameters.coordinates, parse_location))
+    {
+        return true;
+    }
+
+    if (!parser.Literal("polyline("))
+    {
+        return false;
+    }
+    const auto polyline_begin = parser.Position();
+    parser.Expect(parser.Many(isPolylineChar));
+    const auto polyline_end = parser.Position();
+    parser.Expect(parser.Char(')'));
+
+    parameters.coordinates = engine::decodePolyline(std::string(polyline_begin, polyline_end));
+    return true;
+}
+
+bool parseBaseOption(QueryParser &parser, engine::api::BaseParameters &parameters)
+{
+    if (parser.Literal("radiuses="))
+    {
+        std::vector<boost::optional<double>> radiuses;
+        parseOptionalList(parser, radiuses, [&parser](double &radius) {
+            if (parser.Double(radius))
+            {
+                return true;
+            }
+            radius = std::numeric_limits<double>::infinity();
+            return parser.Literal("unlimited");
+        });
+        parameters.radiuses = std::move(radiuses);
+        return true;
+    }
+
+    if (parser.Literal("hints="))
+    {
+        parseOptionalList(parser, parameters.hints, [&parser](engine::Hint &hint) {
+            const auto begin = parser.Position();
+            if (!parser.Repeat(engine::ENCODED_HINT_SIZE, isBase64Char))
+            {
+                return false;
+            }
+            hint = engine::Hint::FromBase64(std::string(begin, parser.Position()));
+            return true;
+        });
+        return true;
+    }
 
+    if (parser.Literal("bearings="))
+    {
+        parseOptionalList(parser, parameters.bearings, [&parser](engine::Bearing &bearing) {
+            short value, range;
+            if (!parser.Signed(value))
+            {
+                return false;
+            }
+            parser.Expect(parser.Char(','));
+            parser.Expect(parser.Signed(range));
+            bearing = engine::Bearing{value, range};
+            return true;
+        });
+        return true;
+    }
+
+    if (parser.Literal("generate_hints="))
+    {
+        parser.Expect(parser.Bool(parameters.generate_hints));
+        return true;
+    }
+
+    return false;
+}
+
+// Options shared by the route, trip and match services
+bool parseRouteBaseOption(QueryParser &parser, engine::api::RouteParameters &parameters)
+{
+    using GeometriesType = engine::api::RouteParameters::GeometriesType;
+    using OverviewType = engine::api::RouteParameters::OverviewType;
+    static const std::pair<const char *, GeometriesType> geometries_types[] = {
+        {"geojson", GeometriesType::GeoJSON},
+        {"polyline", GeometriesType::Polyline},
+        {"polyline6", GeometriesType::Polyline6}};
+    static const std::pair<const char *, OverviewType> overview_types[] = {
+        {"simplified", OverviewType::Simplified},
+        {"full", OverviewType::Full},
+        {"false", OverviewType::False}};
+
+    if (parseBaseOption(parser, parameters))
+    {
+        return true;
+    }
+
+    if (parser.Literal("steps="))
+    {
+        parser.Expect(parser.Bool(parameters.steps));
+        return true;
+    }
+
+    if (parser.Literal("annotations="))
+    {
+        parser.Expect(parser.Bool(parameters.annotations));
+        return true;
+    }
+
+    if (parser.Literal("geometries="))
+    {
+        parser.Expect(parser.Symbol(geometries_types, parameters.geometries));
+        return true;
+    }
+
+    if (parser.Literal("overview="))
+    {
+        parser.Expect(parser.Symbol(overview_types, parameters.overview));
+        return true;
+    }
+
+    return false;
+}
+
+bool parseOption(QueryParser &parser, engine::api::RouteParameters &parameters)
+{
+    if (parser.Literal("alternatives="))
+    {
+        bool alternatives;
+        unsigned number_of_alternatives;
+        if (parser.Bool(alternatives))
+        {
+            parameters.alternatives = alternatives;
+        }
+        else
+        {
+            parser.Expect(parser.Unsigned(number_of_alternatives));
+            parameters.alternatives = number_of_alternatives > 0u;
+            parameters.number_of_alternatives = number_of_alternatives;
+        }
+        return true;
+    }
+
+    if (parser.Literal("continue_straight="))
+    {
+        bool continue_straight;
+        if (parser.Bool(continue_straight))
+        {
+            parameters.continue_straight = continue_straight;
+        }
+        else
+        {
+            parser.Expect(parser.Literal("default"));
+        }
+        return true;
+    }
+
+    return parseRouteBaseOption(parser, parameters);
+}
+
+bool parseOption(QueryParser &parser, engine::api::TripParameters &parameters)
+{
+    return parseRouteBaseOption(parser, parameters);
+}
+
+bool parseOption(QueryParser &parser, engine::api::MatchParameters &parameters)
+{
+    if (parser.Literal("timestamps="))
+    {
+        std::vector<unsigned> timestamps;
+        parser.Expect(parseList(parser, timestamps, [&parser](unsigned &timestamp) {
+            return parser.Unsigned(timestamp);
+        }));
+        parameters.timestamps = std::move(timestamps);
+        return true;
+    }
+
+    return parseRouteBaseOption(parser, parameters);
+}
+
+bool parseOption(QueryParser &parser, engine::api::TableParameters &parameters)
+{
+    const auto parse_indices = [&parser](std::vector<std::size_t> &indices) {
+        if (parser.Literal("all"))
+        {
+            return;
+        }
+        std::vector<std::size_t> values;
+        parser.Expect(parseList(
+            parser, values, [&parser](std::size_t &index) { return parser.Unsigned(index); }));
+        indices = std::move(values);
+    };
+
+    if (parser.Literal("destinations="))
+    {
+        parse_indices(parameters.destinations);
+        return true;
+    }
+
+    if (parser.Literal("sources="))
+    {
+        parse_indices(parameters.sources);
+        return true;
+    }
+
+    return parseBaseOption(parser, parameters);
+}
+
+bool parseOption(QueryParser &parser, engine::api::NearestParameters &parameters)
+{
+    if (parser.Literal("number="))
+    {
+        parser.Expect(parser.Unsigned(parameters.number_of_results));
+        return true;
+    }
+
+    return parseBaseOption(parser, parameters);
+}
+
+// [?option(&option)*]
+template <typename ParameterT> void parseOptions(QueryParser &parser, ParameterT &parameters)
+{
+    if (parser.Char('?'))
+    {
+        parser.Expect(parseOption(parser, parameters));
+
+        auto separator = parser.Position();
+        while (parser.Char('&') && parseOption(parser, parameters))
+        {
+            separator = parser.Position();
+        }
+        parser.Reset(separator);
+    }
+}
+
+// [.json|.cbor]
+void parseFormat(QueryParser &parser, engine::api::BaseParameters &parameters)
+{
+    using OutputFormatType = engine::api::BaseParameters::OutputFormatType;
+    static const std::pair<const char *, OutputFormatType> format_types[] = {
+        {".json", OutputFormatType::JSON}, {".cbor", OutputFormatType::CBOR}};
+
+    parser.Symbol(format_types, parameters.format);
+}
+
+// query[.format][?option(&option)*]
+template <typename ParameterT> bool parseService(QueryParser &parser, ParameterT &parameters)
+{
+    if (!parseQuery(parser, parameters))
+    {
+        return false;
+    }
+
+    parseFormat(parser, parameters);
+
+    parseOptions(parser, parameters);
+    return true;
+}
+
+std::int32_t readInt32(const char *bytes)
+{
+    std::uint32_t value = 0;
+    for (std::size_t index = 0; index < sizeof(value); ++index)
+    {
+        value |= static_cast<std::uint32_t>(static_cast<unsigned char>(bytes[index]))
+                 << (8 * index);
+    }
+    return static_cast<std::int32_t>(value);
+}
+
+// Little-endian lon,lat pairs in fixed point, independent of the host byte order
+std::vector<util::Coordinate> decodeCoordinates(const std::string &body)
+{
+    std::vector<util::Coordinate> coordinates;
+    coordinates.reserve(body.size() / BODY_COORDINATE_SIZE);
+    for (std::size_t offset = 0; offset + BODY_COORDINATE_SIZE <= body.size();
+         offset += BODY_COORDINATE_SIZE)
+    {
+        const auto bytes = body.data() + offset;
+        coordinates.emplace_back(util::FixedLongitude{readInt32(bytes)},
+                                 util::FixedLatitude{readInt32(bytes + sizeof(std::int32_t))});
+    }
+    return coordinates;
+}
+
+// tile(x,y,z).mvt
+bool parseService(QueryParser &parser, engine::api::TileParameters &parameters)
+{
+    if (!parser.Literal("tile("))
+    {
+        return false;
+    }
+    parser.Expect(parser.Unsigned(parameters.x));
+    parser.Expect(parser.Char(','));
+    parser.Expect(parser.Unsigned(parameters.y));
+    parser.Expect(parser.Char(','));
+    parser.Expect(parser.Unsigned(parameters.z));
+    parser.Expect(parser.Literal(").mvt"));
+    return true;
+}
+} // anon.
+
+namespace detail
+{
 template <typename ParameterT,
-          typename GrammarT,
-          typename std::enable_if<detail::is_parameter_t<ParameterT>::value, int>::type = 0,
-          typename std::enable_if<detail::is_grammar_t<GrammarT>::value, int>::type = 0>
+          typename std::enable_if<detail::is_parameter_t<ParameterT>::value, int>::type = 0>
 boost::optional<ParameterT> parseParameters(std::string::iterator &iter,
                                             const std::string::iterator end)
 {
-    using It = std::decay<decltype(iter)>::type;
-
-    static const GrammarT grammar;
+    QueryParser parser(iter, end);
 
     try
     {
         ParameterT parameters;
-        const auto ok =
-            boost::spirit::qi::parse(iter, end, grammar(boost::phoenix::ref(parameters)));
+        if (!parseService(parser, parameters))
+        {
+            return boost::none;
+        }
 
+        iter = parser.Position();
         // return move(a.b) is needed to move b out of a and then return the rvalue by implicit move
-        if (ok && iter == end)
+        if (iter == end)
             return std::move(parameters);
     }
-    catch (const qi::expectation_failure<It> &failure)
+    catch (const QueryParser::ExpectationFailure &failure)
     {
-        // The grammar above using expectation parsers ">" does not automatically increment the
-        // iterator to the failing position. Extract the position from the exception ourselves.
-        iter = failure.first;
+        iter = failure.position;
     }
     catch (const boost::numeric::bad_numeric_cast &e)
     {
@@ -63,52 +447,107 @@ boost::optional<ParameterT> parseParameters(std::string::iterator &iter,
 
     return boost::none;
 }
+
+template <typename ParameterT>
+boost::optional<ParameterT> parseParameters(std::string::iterator &iter,
+                                            const std::string::iterator end,
+                                            const std::string &body)
+{
+    if (body.size() % BODY_COORDINATE_SIZE != 0)
+    {
+        return boost::none;
+    }
+
+    QueryParser parser(iter, end);
+
+    try
+    {
+        ParameterT parameters;
+        parameters.coordinates = decodeCoordinates(body);
+        parseFormat(parser, parameters);
+        parseOptions(parser, parameters);
+
+        iter = parser.Position();
+        if (iter == end)
+            return std::move(parameters);
+    }
+    catch (const QueryParser::ExpectationFailure &failure)
+    {
+        iter = failure.position;
+    }
+    catch (const boost::numeric::bad_numeric_cast &e)
+    {
+        // see above
+    }
+
+    return boost::none;
+}
 } // ns detail
 
 template <>
 boost::optional<engine::api::RouteParameters> parseParameters(std::string::iterator &iter,
                                                               const std::string::iterator end)
 {
-    return detail::parseParameters<engine::api::RouteParameters, RouteParametersGrammar<>>(iter,
-                                                                                           end);
+    return detail::parseParameters<engine::api::RouteParameters>(iter, end);
 }
 
 template <>
 boost::optional<engine::api::TableParameters> parseParameters(std::string::iterator &iter,
                                                               const std::string::iterator end)
 {
-    return detail::parseParameters<engine::api::TableParameters, TableParametersGrammar<>>(iter,
-                                                                                           end);
+    return detail::parseParameters<engine::api::TableParameters>(iter, end);
 }
 
 template <>
 boost::optional<engine::api::NearestParameters> parseParameters(std::string::iterator &iter,
                                                                 const std::string::iterator end)
 {
-    return detail::parseParameters<engine::api::NearestParameters, NearestParametersGrammar<>>(iter,
-                                                                                               end);
+    return detail::parseParameters<engine::api::NearestParameters>(iter, end);
 }
 
 template <>
 boost::optional<engine::api::TripParameters> parseParameters(std::string::iterator &iter,
                                                              const std::string::iterator end)
 {
-    return detail::parseParameters<engine::api::TripParameters, TripParametersGrammar<>>(iter, end);
+    return detail::parseParameters<engine::api::TripParameters>(iter, end);
 }
 
 template <>
 boost::optional<engine::api::MatchParameters> parseParameters(std::string::iterator &iter,
                                                               const std::string::iterator end)
 {
-    return detail::parseParameters<engine::api::MatchParameters, MatchParametersGrammar<>>(iter,
-                                                                                           end);
+    return detail::parseParameters<engine::api::MatchParameters>(iter, end);
 }
 
 template <>
 boost::optional<engine::api::TileParameters> parseParameters(std::string::iterator &iter,
                                                              const std::string::iterator end)
 {
-    return detail::parseParameters<engine::api::TileParameters, TileParametersGrammar<>>(iter, end);
+    return detail::parseParameters<engine::api::TileParameters>(iter, end);
+}
+
+template <>
+boost::optional<engine::api::TableParameters> parseParameters(std::string::iterator &iter,
+                                                              const std::string::iterator end,
+                                                              const std::string &body)
+{
+    return detail::parseParameters<engine::api::TableParameters>(iter, end, body);
+}
+
+template <>
+boost::optional<engine::api::TripParameters> parseParameters(std::string::iterator &iter,
+                                                             const std::string::iterator end,
+                                                             const std::string &body)
+{
+    return detail::parseParameters<engine::api::TripParameters>(iter, end, body);
+}
+
+template <>
+boost::optional<engine::api::MatchParameters> parseParameters(std::string::iterator &iter,
+                                                              const std::string::iterator end,
+                                                              const std::string &body)
+{
+    return detail::parseParameters<engine::api::MatchParameters>(iter, end, body);
 }
 
 } // ns api
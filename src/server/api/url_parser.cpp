@@ -1,64 +1,69 @@
 #include "server/api/url_parser.hpp"
-#include "engine/polyline_compressor.hpp"
-
-#include <boost/fusion/include/adapt_struct.hpp>
-#include <boost/spirit/include/phoenix.hpp>
-#include <boost/spirit/include/qi.hpp>
-#include <boost/spirit/repository/include/qi_iter_pos.hpp>
+#include "server/api/query_parser.hpp"
 
+#include <cstring>
 #include <string>
-#include <type_traits>
-
-BOOST_FUSION_ADAPT_STRUCT(osrm::server::api::ParsedURL,
-                          (std::string, service)(unsigned, version)(std::string,
-                                                                    profile)(std::string, query))
 
 // Keep impl. TU local
 namespace
 {
-namespace ph = boost::phoenix;
-namespace qi = boost::spirit::qi;
+using osrm::server::api::QueryParser;
 
-template <typename Iterator, typename Into> //
-struct URLParser final : qi::grammar<Iterator, Into>
+bool isAlphaNumeral(const char character)
 {
-    URLParser() : URLParser::base_type(start)
-    {
-        using boost::spirit::repository::qi::iter_pos;
-
-        alpha_numeral = qi::char_("a-zA-Z0-9");
-        percent_encoding = qi::char_('%') > qi::uint_parser<char, 16, 2, 2>()[qi::_val = qi::_1];
-        polyline_chars = qi::char_("a-zA-Z0-9_.--[]{}@?|\\~`^") | percent_encoding;
-        all_chars = polyline_chars | qi::char_("=,;:&().");
-
-        service = +alpha_numeral;
-        version = qi::uint_;
-        profile = +alpha_numeral;
-        query = +all_chars;
-
-        // Example input: /route/v1/driving/7.416351,43.731205;7.420363,43.736189
+    return (character >= 'a' && character <= 'z') || (character >= 'A' && character <= 'Z') ||
+           (character >= '0' && character <= '9');
+}
 
-        start = qi::lit('/') > service > qi::lit('/') > qi::lit('v') > version > qi::lit('/') >
-                profile > qi::lit('/') >
-                qi::omit[iter_pos[ph::bind(&osrm::server::api::ParsedURL::prefix_length, qi::_val) =
-                                      qi::_1 - qi::_r1]] > query;
+bool isQueryChar(const char character)
+{
+    return isAlphaNumeral(character) ||
+           (character != '\0' && std::strchr("&(),-.:;=?@[\\]^_`{|}~", character) != nullptr);
+}
 
-        BOOST_SPIRIT_DEBUG_NODES((start)(service)(version)(profile)(query))
+// Appends the longest run of query characters to `query`, decoding percent encodings
+void parseQuery(QueryParser &parser, std::string &query)
+{
+    while (!parser.AtEnd())
+    {
+        const auto begin = parser.Position();
+        if (parser.Many(isQueryChar))
+        {
+            query.append(begin, parser.Position());
+        }
+        else if (parser.Char('%'))
+        {
+            unsigned char decoded;
+            parser.Expect(parser.Hex(decoded));
+            query.push_back(static_cast<char>(decoded));
+        }
+        else
+        {
+            break;
+        }
     }
+}
 
-    qi::rule<Iterator, Into> start;
-
-    qi::rule<Iterator, std::string()> service;
-    qi::rule<Iterator, unsigned()> version;
-    qi::rule<Iterator, std::string()> profile;
-    qi::rule<Iterator, std::string()> query;
-
-    qi::rule<Iterator, char()> alpha_numeral;
-    qi::rule<Iterator, char()> all_chars;
-    qi::rule<Iterator, char()> polyline_chars;
-    qi::rule<Iterator, char()> percent_encoding;
-};
-
+// /service/vN/profile
+bool parsePrefix(QueryParser &parser, osrm::server::api::ParsedURL &out)
+{
+    if (!parser.Char('/'))
+        return false;
+
+    auto begin = parser.Position();
+    parser.Expect(parser.Many(isAlphaNumeral));
+    out.service.assign(begin, parser.Position());
+
+    parser.Expect(parser.Char('/'));
+    parser.Expect(parser.Char('v'));
+    parser.Expect(parser.Unsigned(out.version));
+    parser.Expect(parser.Char('/'));
+
+    begin = parser.Position();
+    parser.Expect(parser.Many(isAlphaNumeral));
+    out.profile.assign(begin, parser.Position());
+    return true;
+}
 } // anon.
 
 namespace osrm
@@ -68,25 +73,66 @@ namespace server
 namespace api
 {
 
+// Example input: /route/v1/driving/7.416351,43.731205;7.420363,43.736189
 boost::optional<ParsedURL> parseURL(std::string::iterator &iter, const std::string::iterator end)
 {
-    using It = std::decay<decltype(iter)>::type;
-
-    static URLParser<It, ParsedURL(It)> const parser;
+    QueryParser parser(iter, end);
     ParsedURL out;
 
     try
     {
-        const auto ok = boost::spirit::qi::parse(iter, end, parser(boost::phoenix::val(iter)), out);
+        if (!parsePrefix(parser, out))
+            return boost::none;
+
+        parser.Expect(parser.Char('/'));
+        out.prefix_length = parser.Position() - iter;
+
+        out.query.reserve(end - parser.Position());
+        parseQuery(parser, out.query);
+        parser.Expect(!out.query.empty());
+
+        iter = parser.Position();
+        if (iter == end)
+            return boost::make_optional(out);
+    }
+    catch (const QueryParser::ExpectationFailure &failure)
+    {
+        iter = failure.position;
+    }
 
-        if (ok && iter == end)
+    return boost::none;
+}
+
+// Example input: /table/v1/driving.cbor?sources=0
+boost::optional<ParsedURL> parseBodyURL(std::string::iterator &iter,
+                                        const std::string::iterator end)
+{
+    QueryParser parser(iter, end);
+    ParsedURL out;
+
+    try
+    {
+        if (!parsePrefix(parser, out))
+            return boost::none;
+
+        out.prefix_length = parser.Position() - iter;
+
+        // the coordinates are in the body, only the format and the options are left
+        if (!parser.AtEnd())
+        {
+            const auto begin = parser.Position();
+            parser.Expect(parser.Char('.') || parser.Char('?'));
+            parser.Reset(begin);
+            parseQuery(parser, out.query);
+        }
+
+        iter = parser.Position();
+        if (iter == end)
             return boost::make_optional(out);
     }
-    catch (const qi::expectation_failure<It> &failure)
+    catch (const QueryParser::ExpectationFailure &failure)
     {
-        // The grammar above using expectation parsers ">" does not automatically increment the
-        // iterator to the failing position. Extract the position from the exception ourselves.
-        iter = failure.first;
+        iter = failure.position;
     }
 
     return boost::none;
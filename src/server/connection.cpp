@@ -16,8 +16,13 @@ namespace osrm
 namespace server
 {
 
+namespace
+{
+const constexpr char CONTINUE_RESPONSE[] = "HTTP/1.1 100 Continue\r\n\r\n";
+}
+
 Connection::Connection(boost::asio::io_service &io_service, RequestHandler &handler)
-    : strand(io_service), TCP_socket(io_service), request_handler(handler)
+    : strand(io_service), TCP_socket(io_service), request_handler(handler), sent_continue(false)
 {
 }
 
@@ -25,6 +30,13 @@ boost::asio::ip::tcp::socket &Connection::socket() { return TCP_socket; }
 
 /// Start the first asynchronous operation for the connection.
 void Connection::start()
+{
+    // the deadline of the request includes the time it spends waiting to be read
+    current_request.accept_time = std::chrono::steady_clock::now();
+    read_some();
+}
+
+void Connection::read_some()
 {
     TCP_socket.async_read_some(
         boost::asio::buffer(incoming_data_buffer),
@@ -53,7 +65,11 @@ void Connection::handle_read(const boost::system::error_code &error, std::size_t
     if (result == RequestParser::RequestStatus::valid)
     {
         current_request.endpoint = TCP_socket.remote_endpoint().address();
-        request_handler.HandleRequest(current_request, current_reply);
+        // is_closed peeks at the socket while the request is handled and must not block
+        boost::system::error_code non_blocking_error;
+        TCP_socket.non_blocking(true, non_blocking_error);
+        request_handler.HandleRequest(
+            current_request, current_reply, [this] { return this->is_closed(); });
 
         // compress the result w/ gzip/deflate if requested
         switch (compression_type)
@@ -99,15 +115,42 @@ void Connection::handle_read(const boost::system::error_code &error, std::size_t
                                                          this->shared_from_this(),
                                                          boost::asio::placeholders::error)));
     }
+    else if (request_parser.expects_continue() && !sent_continue)
+    {
+        // the client waits for our go before it sends the request body
+        sent_continue = true;
+        boost::asio::async_write(
+            TCP_socket,
+            boost::asio::buffer(CONTINUE_RESPONSE, sizeof(CONTINUE_RESPONSE) - 1),
+            strand.wrap(boost::bind(&Connection::handle_continue,
+                                    this->shared_from_this(),
+                                    boost::asio::placeholders::error)));
+    }
     else
     {
         // we don't have a result yet, so continue reading
-        TCP_socket.async_read_some(
-            boost::asio::buffer(incoming_data_buffer),
-            strand.wrap(boost::bind(&Connection::handle_read,
-                                    this->shared_from_this(),
-                                    boost::asio::placeholders::error,
-                                    boost::asio::placeholders::bytes_transferred)));
+        read_some();
+    }
+}
+
+bool Connection::is_closed()
+{
+    // only a reset connection means the client gave up on the request: a client that shut down
+    // its sending side (eof) still waits for the reply and data sent after the request is ignored
+    char byte;
+    boost::system::error_code error;
+    TCP_socket.receive(
+        boost::asio::buffer(&byte, 1), boost::asio::socket_base::message_peek, error);
+    return error == boost::asio::error::connection_reset ||
+           error == boost::asio::error::connection_aborted ||
+           error == boost::asio::error::broken_pipe || error == boost::asio::error::not_connected;
+}
+
+void Connection::handle_continue(const boost::system::error_code &error)
+{
+    if (!error)
+    {
+        read_some();
     }
 }
 
@@ -5,12 +5,14 @@
 #include "server/http/reply.hpp"
 #include "server/http/request.hpp"
 
+#include "util/cbor_renderer.hpp"
 #include "util/json_renderer.hpp"
 #include "util/log.hpp"
 #include "util/string_util.hpp"
 #include "util/timing_util.hpp"
 #include "util/typedefs.hpp"
 
+#include "engine/cancellation_token.hpp"
 #include "engine/status.hpp"
 #include "osrm/osrm.hpp"
 #include "util/json_container.hpp"
@@ -22,9 +24,12 @@
 #include <ctime>
 
 #include <algorithm>
+#include <chrono>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <string>
+#include <utility>
 
 namespace osrm
 {
@@ -37,8 +42,20 @@ void RequestHandler::RegisterServiceHandler(
     service_handler = std::move(service_handler_);
 }
 
-void RequestHandler::HandleRequest(const http::request &current_request, http::reply &current_reply)
+void RequestHandler::HandleRequest(const http::request &current_request,
+                                   http::reply &current_reply,
+                                   std::function<bool()> is_connection_closed)
 {
+    using Clock = engine::CancellationToken::Clock;
+    // count the time since the connection was accepted, so queued requests time out as well
+    const auto start_time = current_request.accept_time == Clock::time_point()
+                                ? Clock::now()
+                                : current_request.accept_time;
+    const auto deadline = max_request_duration >= 0
+                              ? start_time + std::chrono::milliseconds(max_request_duration)
+                              : Clock::time_point::max();
+    const engine::CancellationToken token(deadline, std::move(is_connection_closed));
+
     if (!service_handler)
     {
         current_reply = http::reply::stock_reply(http::reply::internal_server_error);
@@ -54,8 +71,13 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
         util::URIDecode(current_request.uri, request_string);
         util::Log(logDEBUG) << "req: " << request_string;
 
+        // POST requests send their coordinates in the body instead of the URL
+        const bool has_body = current_request.method == "POST";
+
         auto api_iterator = request_string.begin();
-        auto maybe_parsed_url = api::parseURL(api_iterator, request_string.end());
+        auto maybe_parsed_url = has_body
+                                    ? api::parseBodyURL(api_iterator, request_string.end())
+                                    : api::parseURL(api_iterator, request_string.end());
         ServiceHandler::ResultT result;
 
         // check if the was an error with the request
@@ -63,8 +85,15 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
         {
 
             const engine::Status status =
-                service_handler->RunQuery(*std::move(maybe_parsed_url), result);
-            if (status != engine::Status::Ok)
+                has_body ? service_handler->RunQuery(
+                               *std::move(maybe_parsed_url), current_request.body, result, token)
+                         : service_handler->RunQuery(*std::move(maybe_parsed_url), result, token);
+            if (status == engine::Status::Timeout)
+            {
+                // 5xx so clients and load balancers retry elsewhere or later
+                current_reply.status = http::reply::service_unavailable;
+            }
+            else if (status != engine::Status::Ok)
             {
                 // 4xx bad request return code
                 current_reply.status = http::reply::bad_request;
@@ -95,7 +124,7 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
         }
 
         current_reply.headers.emplace_back("Access-Control-Allow-Origin", "*");
-        current_reply.headers.emplace_back("Access-Control-Allow-Methods", "GET");
+        current_reply.headers.emplace_back("Access-Control-Allow-Methods", "GET, POST");
         current_reply.headers.emplace_back("Access-Control-Allow-Headers",
                                            "X-Requested-With, Content-Type");
         if (result.is<util::json::Object>())
@@ -106,6 +135,14 @@ void RequestHandler::HandleRequest(const http::request &current_request, http::r
 
             util::json::render(current_reply.content, result.get<util::json::Object>());
         }
+        else if (result.is<util::cbor::Document>())
+        {
+            current_reply.headers.emplace_back("Content-Type", "application/cbor");
+            current_reply.headers.emplace_back("Content-Disposition",
+                                               "inline; filename=\"response.cbor\"");
+
+            current_reply.content = std::move(result.get<util::cbor::Document>().buffer);
+        }
         else
         {
             BOOST_ASSERT(result.is<std::string>());
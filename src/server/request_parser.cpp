@@ -6,6 +6,7 @@
 
 #include <boost/algorithm/string/predicate.hpp>
 
+#include <algorithm>
 #include <string>
 
 namespace osrm
@@ -15,7 +16,7 @@ namespace server
 
 RequestParser::RequestParser()
     : state(internal_state::method_start), current_header({"", ""}),
-      selected_compression(http::no_compression)
+      selected_compression(http::no_compression), content_length(0), expect_continue(false)
 {
 }
 
@@ -24,6 +25,20 @@ RequestParser::parse(http::request &current_request, char *begin, char *end)
 {
     while (begin != end)
     {
+        // the body is copied as a whole instead of going through the state machine
+        if (state == internal_state::content)
+        {
+            const auto length = std::min<std::size_t>(
+                content_length - current_request.body.size(), end - begin);
+            current_request.body.append(begin, length);
+            begin += length;
+            if (current_request.body.size() == content_length)
+            {
+                return std::make_tuple(RequestStatus::valid, selected_compression);
+            }
+            continue;
+        }
+
         RequestStatus result = consume(current_request, *begin++);
         if (result != RequestStatus::indeterminate)
         {
@@ -35,6 +50,11 @@ RequestParser::parse(http::request &current_request, char *begin, char *end)
     return std::make_tuple(result, selected_compression);
 }
 
+bool RequestParser::expects_continue() const
+{
+    return state == internal_state::content && expect_continue;
+}
+
 RequestParser::RequestStatus RequestParser::consume(http::request &current_request,
                                                     const char input)
 {
@@ -46,6 +66,7 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
             return RequestStatus::invalid;
         }
         state = internal_state::method;
+        current_request.method.push_back(input);
         return RequestStatus::indeterminate;
     case internal_state::method:
         if (input == ' ')
@@ -57,6 +78,7 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
         {
             return RequestStatus::invalid;
         }
+        current_request.method.push_back(input);
         return RequestStatus::indeterminate;
     case internal_state::uri_start:
         if (is_CTL(input))
@@ -180,6 +202,28 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
             current_request.agent = current_header.value;
         }
 
+        if (boost::iequals(current_header.name, "Content-Length"))
+        {
+            const auto &value = current_header.value;
+            if (value.empty() || value.size() > 9 ||
+                !std::all_of(value.begin(), value.end(), [this](const char character) {
+                    return is_digit(character);
+                }))
+            {
+                return RequestStatus::invalid;
+            }
+            content_length = std::stoul(value);
+            if (content_length > MAX_CONTENT_LENGTH)
+            {
+                return RequestStatus::invalid;
+            }
+        }
+
+        if (boost::iequals(current_header.name, "Expect"))
+        {
+            expect_continue = boost::iequals(current_header.value, "100-continue");
+        }
+
         if (input == '\r')
         {
             state = internal_state::expecting_newline_3;
@@ -247,8 +291,20 @@ RequestParser::RequestStatus RequestParser::consume(http::request &current_reque
             return RequestStatus::indeterminate;
         }
         return RequestStatus::invalid;
-    default: // expecting_newline_3
-        return input == '\n' ? RequestStatus::valid : RequestStatus::invalid;
+    case internal_state::expecting_newline_3:
+        if (input != '\n')
+        {
+            return RequestStatus::invalid;
+        }
+        if (content_length == 0)
+        {
+            return RequestStatus::valid;
+        }
+        state = internal_state::content;
+        current_request.body.reserve(content_length);
+        return RequestStatus::indeterminate;
+    default: // content is consumed by parse
+        return RequestStatus::invalid;
     }
 }
 
@@ -40,8 +40,10 @@ std::string getWrongOptionHelp(const engine::api::NearestParameters &parameters)
 }
 } // anon. ns
 
-engine::Status
-NearestService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &result)
+engine::Status NearestService::RunQuery(std::size_t prefix_length,
+                                        std::string &query,
+                                        ResultT &result,
+                                        const engine::CancellationToken &token)
 {
     result = util::json::Object();
     auto &json_result = result.get<util::json::Object>();
@@ -67,7 +69,9 @@ NearestService::RunQuery(std::size_t prefix_length, std::string &query, ResultT
     }
     BOOST_ASSERT(parameters->IsValid());
 
-    return BaseService::routing_machine.Nearest(*parameters, json_result);
+    const auto status = BaseService::routing_machine.Nearest(*parameters, json_result, token);
+    EncodeResult(parameters->format, result);
+    return status;
 }
 }
 }
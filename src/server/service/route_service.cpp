@@ -37,8 +37,10 @@ std::string getWrongOptionHelp(const engine::api::RouteParameters &parameters)
 }
 } // anon. ns
 
-engine::Status
-RouteService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &result)
+engine::Status RouteService::RunQuery(std::size_t prefix_length,
+                                      std::string &query,
+                                      ResultT &result,
+                                      const engine::CancellationToken &token)
 {
     result = util::json::Object();
     auto &json_result = result.get<util::json::Object>();
@@ -64,7 +66,9 @@ RouteService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &r
     }
     BOOST_ASSERT(parameters->IsValid());
 
-    return BaseService::routing_machine.Route(*parameters, json_result);
+    const auto status = BaseService::routing_machine.Route(*parameters, json_result, token);
+    EncodeResult(parameters->format, result);
+    return status;
 }
 }
 }
@@ -58,15 +58,19 @@ std::string getWrongOptionHelp(const engine::api::TableParameters &parameters)
 }
 } // anon. ns
 
-engine::Status
-TableService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &result)
+engine::Status TableService::Run(std::size_t prefix_length,
+                                 std::string &query,
+                                 const std::string *body,
+                                 ResultT &result,
+                                 const engine::CancellationToken &token)
 {
     result = util::json::Object();
     auto &json_result = result.get<util::json::Object>();
 
     auto query_iterator = query.begin();
-    auto parameters =
-        api::parseParameters<engine::api::TableParameters>(query_iterator, query.end());
+    using ParameterT = engine::api::TableParameters;
+    auto parameters = body ? api::parseParameters<ParameterT>(query_iterator, query.end(), *body)
+                           : api::parseParameters<ParameterT>(query_iterator, query.end());
     if (!parameters || query_iterator != query.end())
     {
         const auto position = std::distance(query.begin(), query_iterator);
@@ -85,7 +89,9 @@ TableService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &r
     }
     BOOST_ASSERT(parameters->IsValid());
 
-    return BaseService::routing_machine.Table(*parameters, json_result);
+    const auto status = BaseService::routing_machine.Table(*parameters, json_result, token);
+    EncodeResult(parameters->format, result);
+    return status;
 }
 }
 }
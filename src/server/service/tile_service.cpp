@@ -15,7 +15,10 @@ namespace server
 namespace service
 {
 
-engine::Status TileService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &result)
+engine::Status TileService::RunQuery(std::size_t prefix_length,
+                                     std::string &query,
+                                     ResultT &result,
+                                     const engine::CancellationToken &token)
 {
     auto query_iterator = query.begin();
     auto parameters =
@@ -44,7 +47,7 @@ engine::Status TileService::RunQuery(std::size_t prefix_length, std::string &que
 
     result = std::string();
     auto &string_result = result.get<std::string>();
-    return BaseService::routing_machine.Tile(*parameters, string_result);
+    return BaseService::routing_machine.Tile(*parameters, string_result, token);
 }
 }
 }
@@ -39,14 +39,19 @@ std::string getWrongOptionHelp(const engine::api::TripParameters &parameters)
 }
 } // anon. ns
 
-engine::Status TripService::RunQuery(std::size_t prefix_length, std::string &query, ResultT &result)
+engine::Status TripService::Run(std::size_t prefix_length,
+                                std::string &query,
+                                const std::string *body,
+                                ResultT &result,
+                                const engine::CancellationToken &token)
 {
     result = util::json::Object();
     auto &json_result = result.get<util::json::Object>();
 
     auto query_iterator = query.begin();
-    auto parameters =
-        api::parseParameters<engine::api::TripParameters>(query_iterator, query.end());
+    using ParameterT = engine::api::TripParameters;
+    auto parameters = body ? api::parseParameters<ParameterT>(query_iterator, query.end(), *body)
+                           : api::parseParameters<ParameterT>(query_iterator, query.end());
     if (!parameters || query_iterator != query.end())
     {
         const auto position = std::distance(query.begin(), query_iterator);
@@ -67,7 +72,9 @@ engine::Status TripService::RunQuery(std::size_t prefix_length, std::string &que
     }
     BOOST_ASSERT(parameters->IsValid());
 
-    return BaseService::routing_machine.Trip(*parameters, json_result);
+    const auto status = BaseService::routing_machine.Trip(*parameters, json_result, token);
+    EncodeResult(parameters->format, result);
+    return status;
 }
 }
 }
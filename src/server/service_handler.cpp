@@ -7,6 +7,7 @@
 #include "server/service/tile_service.hpp"
 #include "server/service/trip_service.hpp"
 
+#include "server/api/parameters_parser.hpp"
 #include "server/api/parsed_url.hpp"
 #include "util/json_util.hpp"
 
@@ -26,8 +27,8 @@ ServiceHandler::ServiceHandler(osrm::EngineConfig &config) : routing_machine(con
     service_map["tile"] = std::make_unique<service::TileService>(routing_machine);
 }
 
-engine::Status ServiceHandler::RunQuery(api::ParsedURL parsed_url,
-                                        service::BaseService::ResultT &result)
+service::BaseService *ServiceHandler::FindService(const api::ParsedURL &parsed_url,
+                                                  ResultT &result)
 {
     const auto &service_iter = service_map.find(parsed_url.service);
     if (service_iter == service_map.end())
@@ -36,7 +37,7 @@ engine::Status ServiceHandler::RunQuery(api::ParsedURL parsed_url,
         auto &json_result = result.get<util::json::Object>();
         json_result.values["code"] = "InvalidService";
         json_result.values["message"] = "Service " + parsed_url.service + " not found!";
-        return engine::Status::Error;
+        return nullptr;
     }
     auto &service = service_iter->second;
 
@@ -46,10 +47,49 @@ engine::Status ServiceHandler::RunQuery(api::ParsedURL parsed_url,
         auto &json_result = result.get<util::json::Object>();
         json_result.values["code"] = "InvalidVersion";
         json_result.values["message"] = "Service " + parsed_url.service + " not found!";
+        return nullptr;
+    }
+
+    return service.get();
+}
+
+engine::Status ServiceHandler::RunQuery(api::ParsedURL parsed_url,
+                                        service::BaseService::ResultT &result,
+                                        const engine::CancellationToken &token)
+{
+    auto service = FindService(parsed_url, result);
+    if (!service)
+    {
+        return engine::Status::Error;
+    }
+
+    return service->RunQuery(parsed_url.prefix_length, parsed_url.query, result, token);
+}
+
+engine::Status ServiceHandler::RunQuery(api::ParsedURL parsed_url,
+                                        const std::string &body,
+                                        service::BaseService::ResultT &result,
+                                        const engine::CancellationToken &token)
+{
+    auto service = FindService(parsed_url, result);
+    if (!service)
+    {
+        return engine::Status::Error;
+    }
+
+    if (body.size() % api::BODY_COORDINATE_SIZE != 0)
+    {
+        result = util::json::Object();
+        auto &json_result = result.get<util::json::Object>();
+        json_result.values["code"] = "InvalidBody";
+        json_result.values["message"] = "Body size " + std::to_string(body.size()) +
+                                        " is not a multiple of the coordinate size " +
+                                        std::to_string(api::BODY_COORDINATE_SIZE);
         return engine::Status::Error;
     }
 
-    return service->RunQuery(parsed_url.prefix_length, parsed_url.query, result);
+    return service->RunBodyQuery(
+        parsed_url.prefix_length, parsed_url.query, body, result, token);
 }
 }
 }
@@ -1,4 +1,5 @@
 #include "storage/storage.hpp"
+#include "contractor/compact_query_graph.hpp"
 #include "contractor/query_edge.hpp"
 #include "extractor/compressed_edge_container.hpp"
 #include "extractor/guidance/turn_instruction.hpp"
@@ -12,17 +13,21 @@
 #include "storage/shared_datatype.hpp"
 #include "storage/shared_memory.hpp"
 #include "engine/datafacade/datafacade_base.hpp"
+#include "util/bit_packed_vector.hpp"
 #include "util/coordinate.hpp"
 #include "util/exception.hpp"
 #include "util/exception_utils.hpp"
 #include "util/fingerprint.hpp"
+#include "util/integer_range.hpp"
 #include "util/io.hpp"
 #include "util/log.hpp"
+#include "util/packed_coordinate_vector.hpp"
 #include "util/packed_vector.hpp"
 #include "util/range_table.hpp"
 #include "util/shared_memory_vector_wrapper.hpp"
 #include "util/static_graph.hpp"
 #include "util/static_rtree.hpp"
+#include "util/timing_util.hpp"
 #include "util/typedefs.hpp"
 
 #ifdef __linux__
@@ -30,19 +35,26 @@
 #endif
 
 #include <boost/date_time/posix_time/posix_time.hpp>
+#include <boost/filesystem/operations.hpp>
 #include <boost/interprocess/exceptions.hpp>
-#include <boost/interprocess/sync/named_sharable_mutex.hpp>
-#include <boost/interprocess/sync/named_upgradable_mutex.hpp>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <boost/interprocess/sync/named_mutex.hpp>
 #include <boost/interprocess/sync/scoped_lock.hpp>
-#include <boost/interprocess/sync/upgradable_lock.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/parallel_for.h>
+
+#include <algorithm>
 #include <cstdint>
 
 #include <fstream>
+#include <functional>
 #include <iostream>
 #include <iterator>
 #include <new>
 #include <string>
+#include <vector>
 
 namespace osrm
 {
@@ -51,48 +63,46 @@ namespace storage
 
 using RTreeLeaf = engine::datafacade::BaseDataFacade::RTreeLeaf;
 using RTreeNode =
-    util::StaticRTree<RTreeLeaf, util::ShM<util::Coordinate, true>::vector, true>::TreeNode;
-using QueryGraph = util::StaticGraph<contractor::QueryEdge::EdgeData>;
+    util::StaticRTree<RTreeLeaf, util::CoordinateList<true>, true>::TreeNode;
+using QueryGraph = contractor::CompactQueryGraph<true>;
+using GeometryNodeList = util::BitPackedVector<NodeID, true>;
 
-Storage::Storage(StorageConfig config_) : config(std::move(config_)) {}
+Storage::Storage(StorageConfig config_, MemoryPlacement placement_)
+    : config(std::move(config_)), placement(placement_)
+{
+}
 
 struct RegionsLayout
 {
     SharedDataType current_layout_region;
     SharedDataType current_data_region;
-    boost::interprocess::named_sharable_mutex &current_regions_mutex;
     SharedDataType old_layout_region;
     SharedDataType old_data_region;
-    boost::interprocess::named_sharable_mutex &old_regions_mutex;
+    unsigned current_timestamp;
 };
 
-RegionsLayout getRegionsLayout(SharedBarriers &barriers)
+RegionsLayout getRegionsLayout()
 {
     if (SharedMemory::RegionExists(CURRENT_REGIONS))
     {
         auto shared_regions = makeSharedMemory(CURRENT_REGIONS);
         const auto shared_timestamp =
-            static_cast<const SharedDataTimestamp *>(shared_regions->Ptr());
-        if (shared_timestamp->data == DATA_1)
+            static_cast<const SharedCurrentRegions *>(shared_regions->Ptr())->Load();
+        if (shared_timestamp.data == DATA_1)
         {
-            BOOST_ASSERT(shared_timestamp->layout == LAYOUT_1);
-            return RegionsLayout{LAYOUT_1,
-                                 DATA_1,
-                                 barriers.regions_1_mutex,
-                                 LAYOUT_2,
-                                 DATA_2,
-                                 barriers.regions_2_mutex};
+            BOOST_ASSERT(shared_timestamp.layout == LAYOUT_1);
+            return RegionsLayout{LAYOUT_1, DATA_1, LAYOUT_2, DATA_2, shared_timestamp.timestamp};
         }
 
-        BOOST_ASSERT(shared_timestamp->data == DATA_2);
-        BOOST_ASSERT(shared_timestamp->layout == LAYOUT_2);
+        BOOST_ASSERT(shared_timestamp.data == DATA_2);
+        BOOST_ASSERT(shared_timestamp.layout == LAYOUT_2);
+        return RegionsLayout{LAYOUT_2, DATA_2, LAYOUT_1, DATA_1, shared_timestamp.timestamp};
     }
 
-    return RegionsLayout{
-        LAYOUT_2, DATA_2, barriers.regions_2_mutex, LAYOUT_1, DATA_1, barriers.regions_1_mutex};
+    return RegionsLayout{LAYOUT_2, DATA_2, LAYOUT_1, DATA_1, 0};
 }
 
-Storage::ReturnCode Storage::Run(int max_wait)
+Storage::ReturnCode Storage::Run()
 {
     BOOST_ASSERT_MSG(config.IsValid(), "Invalid storage config");
 
@@ -100,22 +110,12 @@ Storage::ReturnCode Storage::Run(int max_wait)
 
     SharedBarriers barriers;
 
-    boost::interprocess::upgradable_lock<boost::interprocess::named_upgradable_mutex>
-        current_regions_lock(barriers.current_regions_mutex, boost::interprocess::defer_lock);
-    try
-    {
-        if (!current_regions_lock.try_lock())
-        {
-            util::Log(logWARNING) << "A data update is in progress";
-            return ReturnCode::Error;
-        }
-    }
-    // hard unlock in case of any exception.
-    catch (boost::interprocess::lock_exception &ex)
+    boost::interprocess::scoped_lock<boost::interprocess::named_mutex> datastore_lock(
+        barriers.datastore_mutex, boost::interprocess::try_to_lock);
+    if (!datastore_lock.owns())
     {
-        barriers.current_regions_mutex.unlock_upgradable();
-        // make sure we exit here because this is bad
-        throw;
+        util::Log(logWARNING) << "A data update is in progress";
+        return ReturnCode::Error;
     }
 
 #ifdef __linux__
@@ -127,53 +127,12 @@ Storage::ReturnCode Storage::Run(int max_wait)
     }
 #endif
 
-    auto regions_layout = getRegionsLayout(barriers);
+    const auto regions_layout = getRegionsLayout();
     const SharedDataType layout_region = regions_layout.old_layout_region;
     const SharedDataType data_region = regions_layout.old_data_region;
 
-    if (max_wait > 0)
-    {
-        util::Log() << "Waiting for " << max_wait
-                    << " second for all queries on the old dataset to finish:";
-    }
-    else
-    {
-        util::Log() << "Waiting for all queries on the old dataset to finish:";
-    }
-
-    boost::interprocess::scoped_lock<boost::interprocess::named_sharable_mutex> regions_lock(
-        regions_layout.old_regions_mutex, boost::interprocess::defer_lock);
-
-    if (max_wait > 0)
-    {
-        if (!regions_lock.timed_lock(boost::posix_time::microsec_clock::universal_time() +
-                                     boost::posix_time::seconds(max_wait)))
-        {
-            util::Log(logWARNING) << "Queries did not finish in " << max_wait
-                                  << " seconds. Claiming the lock by force.";
-            // WARNING: if queries are still using the old dataset they might crash
-            if (regions_layout.old_layout_region == LAYOUT_1)
-            {
-                BOOST_ASSERT(regions_layout.old_data_region == DATA_1);
-                barriers.resetRegions1();
-            }
-            else
-            {
-                BOOST_ASSERT(regions_layout.old_layout_region == LAYOUT_2);
-                BOOST_ASSERT(regions_layout.old_data_region == DATA_2);
-                barriers.resetRegions2();
-            }
-
-            return ReturnCode::Retry;
-        }
-    }
-    else
-    {
-        regions_lock.lock();
-    }
-    util::Log() << "Ok.";
-
-    // since we can't change the size of a shared memory regions we delete and reallocate
+    // The old regions are normally removed when a dataset is replaced, this only cleans up after
+    // an interrupted update. Removing is safe even if a query still has them attached.
     if (SharedMemory::RegionExists(layout_region) && !SharedMemory::Remove(layout_region))
     {
         throw util::exception("Could not remove shared memory region " +
@@ -194,53 +153,30 @@ Storage::ReturnCode Storage::Run(int max_wait)
     // allocate shared memory block
     util::Log() << "allocating shared memory of " << shared_layout_ptr->GetSizeOfLayout()
                 << " bytes";
-    auto shared_memory = makeSharedMemory(data_region, shared_layout_ptr->GetSizeOfLayout(), true);
+    auto shared_memory =
+        makeSharedMemory(data_region, shared_layout_ptr->GetSizeOfLayout(), true, placement);
     char *shared_memory_ptr = static_cast<char *>(shared_memory->Ptr());
 
     PopulateData(*shared_layout_ptr, shared_memory_ptr);
 
-    auto data_type_memory = makeSharedMemory(CURRENT_REGIONS, sizeof(SharedDataTimestamp), true);
-    SharedDataTimestamp *data_timestamp_ptr =
-        static_cast<SharedDataTimestamp *>(data_type_memory->Ptr());
+    auto current_regions_memory =
+        makeSharedMemory(CURRENT_REGIONS, sizeof(SharedCurrentRegions), true);
+    auto current_regions = static_cast<SharedCurrentRegions *>(current_regions_memory->Ptr());
+    current_regions->Store(
+        SharedDataTimestamp{layout_region, data_region, regions_layout.current_timestamp + 1});
+    util::Log() << "All data loaded.";
 
+    // New queries only pick up the regions we just published. The kernel keeps the previous
+    // regions alive until the last query still using them detached.
+    for (const auto region :
+         {regions_layout.current_layout_region, regions_layout.current_data_region})
     {
-
-        boost::interprocess::scoped_lock<boost::interprocess::named_upgradable_mutex>
-            current_regions_exclusive_lock;
-
-        if (max_wait > 0)
-        {
-            util::Log() << "Waiting for " << max_wait << " seconds to write new dataset timestamp";
-            auto end_time = boost::posix_time::microsec_clock::universal_time() +
-                            boost::posix_time::seconds(max_wait);
-            current_regions_exclusive_lock =
-                boost::interprocess::scoped_lock<boost::interprocess::named_upgradable_mutex>(
-                    std::move(current_regions_lock), end_time);
-
-            if (!current_regions_exclusive_lock.owns())
-            {
-                util::Log(logWARNING) << "Aquiring the lock timed out after " << max_wait
-                                      << " seconds. Claiming the lock by force.";
-                current_regions_lock.unlock();
-                current_regions_lock.release();
-                storage::SharedBarriers::resetCurrentRegions();
-                return ReturnCode::Retry;
-            }
-        }
-        else
+        if (SharedMemory::RegionExists(region) && !SharedMemory::Remove(region))
         {
-            util::Log() << "Waiting to write new dataset timestamp";
-            current_regions_exclusive_lock =
-                boost::interprocess::scoped_lock<boost::interprocess::named_upgradable_mutex>(
-                    std::move(current_regions_lock));
+            util::Log(logWARNING) << "Could not remove shared memory region "
+                                  << regionToString(region);
         }
-
-        util::Log() << "Ok.";
-        data_timestamp_ptr->layout = layout_region;
-        data_timestamp_ptr->data = data_region;
-        data_timestamp_ptr->timestamp += 1;
     }
-    util::Log() << "All data loaded.";
 
     return ReturnCode::Ok;
 }
@@ -316,6 +252,8 @@ void Storage::PopulateLayout(DataLayout &layout)
                                                         hsgr_header.number_of_nodes);
         layout.SetBlockSize<QueryGraph::EdgeArrayEntry>(DataLayout::GRAPH_EDGE_LIST,
                                                         hsgr_header.number_of_edges);
+        layout.SetBlockSize<QueryGraph::EdgeIDEntry>(DataLayout::GRAPH_EDGE_ID_LIST,
+                                                     hsgr_header.number_of_edges);
     }
 
     // load rsearch tree size
@@ -346,11 +284,44 @@ void Storage::PopulateLayout(DataLayout &layout)
         layout.SetBlockSize<unsigned>(DataLayout::CORE_MARKER, number_of_core_markers);
     }
 
+    // load core landmark sizes, datasets without landmarks use the plain core search
+    {
+        std::uint64_t number_of_ranks = 0;
+        std::uint64_t number_of_distances = 0;
+        if (boost::filesystem::exists(config.core_landmarks_path))
+        {
+            io::FileReader landmarks_file(config.core_landmarks_path,
+                                          io::FileReader::VerifyFingerprint);
+            landmarks_file.Skip<std::uint32_t>(1);
+            number_of_ranks = landmarks_file.ReadElementCount64();
+            landmarks_file.Skip<std::uint32_t>(number_of_ranks);
+            number_of_distances = landmarks_file.ReadElementCount64();
+        }
+        layout.SetBlockSize<std::uint32_t>(DataLayout::CORE_LANDMARK_RANKS, number_of_ranks);
+        layout.SetBlockSize<EdgeWeight>(DataLayout::CORE_LANDMARK_DISTANCES, number_of_distances);
+    }
+
     // load coordinate size
     {
         io::FileReader node_file(config.nodes_data_path, io::FileReader::HasNoFingerprint);
         const auto coordinate_list_size = node_file.ReadElementCount64();
+        layout.packed_coordinates = util::PACKED_COORDINATE_LIST;
+#ifdef OSRM_PACKED_COORDINATES
+        // the size of the packed coordinates depends on how close consecutive nodes are, so this
+        // needs a pass over all of them
+        const auto packed_coordinate_words =
+            serialization::readPackedCoordinatesSize(node_file, coordinate_list_size);
+        layout.SetBlockSize<std::uint64_t>(DataLayout::COORDINATE_LIST, packed_coordinate_words);
+        util::Log() << "packed " << coordinate_list_size << " coordinates into "
+                    << packed_coordinate_words * sizeof(std::uint64_t) << " bytes (unpacked "
+                    << coordinate_list_size * sizeof(util::Coordinate) << " bytes)";
+#else
         layout.SetBlockSize<util::Coordinate>(DataLayout::COORDINATE_LIST, coordinate_list_size);
+#endif
+        // geometries store node-based node IDs, they are packed with just enough bits for the
+        // number of nodes
+        layout.geometry_node_bits =
+            GeometryNodeList::GetBitsFor(std::max<std::uint64_t>(coordinate_list_size, 1) - 1);
         // we'll read a list of OSM node IDs from the same data, so set the block size for the same
         // number of items:
         layout.SetBlockSize<std::uint64_t>(
@@ -368,8 +339,10 @@ void Storage::PopulateLayout(DataLayout &layout)
         geometry_file.Skip<unsigned>(number_of_geometries_indices);
 
         const auto number_of_compressed_geometries = geometry_file.ReadElementCount32();
-        layout.SetBlockSize<NodeID>(DataLayout::GEOMETRIES_NODE_LIST,
-                                    number_of_compressed_geometries);
+        layout.SetBlockSize<std::uint64_t>(
+            DataLayout::GEOMETRIES_NODE_LIST,
+            GeometryNodeList::GetNumberOfWords(number_of_compressed_geometries,
+                                               layout.geometry_node_bits));
         layout.SetBlockSize<EdgeWeight>(DataLayout::GEOMETRIES_FWD_WEIGHT_LIST,
                                         number_of_compressed_geometries);
         layout.SetBlockSize<EdgeWeight>(DataLayout::GEOMETRIES_REV_WEIGHT_LIST,
@@ -451,10 +424,20 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
 {
     BOOST_ASSERT(memory_ptr != nullptr);
 
+    // Every loader reads one file into its own blocks of the memory region, so they are
+    // independent of each other and can run concurrently.
+    struct BlockLoader
+    {
+        const char *name;
+        boost::filesystem::path path;
+        std::function<void()> load;
+    };
+    std::vector<BlockLoader> loaders;
+
     // read actual data into shared memory object //
 
     // Load the HSGR file
-    {
+    const auto load_graph = [&] {
         io::FileReader hsgr_file(config.hsgr_data_path, io::FileReader::HasNoFingerprint);
         auto hsgr_header = serialization::readHSGRHeader(hsgr_file);
         unsigned *checksum_ptr =
@@ -471,15 +454,22 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             layout.GetBlockPtr<QueryGraph::EdgeArrayEntry, true>(memory_ptr,
                                                                  DataLayout::GRAPH_EDGE_LIST);
 
+        // the IDs are split off the edges, they are only needed to unpack paths
+        QueryGraph::EdgeIDEntry *graph_edge_id_list_ptr =
+            layout.GetBlockPtr<QueryGraph::EdgeIDEntry, true>(memory_ptr,
+                                                              DataLayout::GRAPH_EDGE_ID_LIST);
+
         serialization::readHSGR(hsgr_file,
                                 graph_node_list_ptr,
                                 hsgr_header.number_of_nodes,
                                 graph_edge_list_ptr,
+                                graph_edge_id_list_ptr,
                                 hsgr_header.number_of_edges);
-    }
+    };
+    loaders.push_back({"graph", config.hsgr_data_path, load_graph});
 
     // store the filename of the on-disk portion of the RTree
-    {
+    const auto load_file_index_path = [&] {
         const auto file_index_path_ptr =
             layout.GetBlockPtr<char, true>(memory_ptr, DataLayout::FILE_INDEX_PATH);
         // make sure we have 0 ending
@@ -492,10 +482,11 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                      absolute_file_index_path.size());
         std::copy(
             absolute_file_index_path.begin(), absolute_file_index_path.end(), file_index_path_ptr);
-    }
+    };
+    loaders.push_back({"file index path", boost::filesystem::path{}, load_file_index_path});
 
     // Name data
-    {
+    const auto load_names = [&] {
         io::FileReader name_file(config.names_data_path, io::FileReader::HasNoFingerprint);
         const auto name_blocks_count = name_file.ReadElementCount32();
         name_file.Skip<std::uint32_t>(1); // name_char_list_count
@@ -526,10 +517,11 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                          "Name file corrupted!");
 
         name_file.ReadInto(name_char_ptr, temp_count);
-    }
+    };
+    loaders.push_back({"names", config.names_data_path, load_names});
 
     // Turn lane data
-    {
+    const auto load_turn_lane_data = [&] {
         io::FileReader lane_data_file(config.turn_lane_data_path, io::FileReader::HasNoFingerprint);
 
         const auto lane_tuple_count = lane_data_file.ReadElementCount64();
@@ -541,10 +533,11 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
         BOOST_ASSERT(lane_tuple_count * sizeof(util::guidance::LaneTupleIdPair) ==
                      layout.GetBlockSize(DataLayout::TURN_LANE_DATA));
         lane_data_file.ReadInto(turn_lane_data_ptr, lane_tuple_count);
-    }
+    };
+    loaders.push_back({"turn lane data", config.turn_lane_data_path, load_turn_lane_data});
 
     // Turn lane descriptions
-    {
+    const auto load_turn_lane_descriptions = [&] {
         std::vector<std::uint32_t> lane_description_offsets;
         std::vector<extractor::guidance::TurnLaneType::Mask> lane_description_masks;
         util::deserializeAdjacencyArray(config.turn_lane_description_path.string(),
@@ -577,10 +570,12 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             std::copy(
                 lane_description_masks.begin(), lane_description_masks.end(), turn_lane_mask_ptr);
         }
-    }
+    };
+    loaders.push_back(
+        {"turn lane descriptions", config.turn_lane_description_path, load_turn_lane_descriptions});
 
     // Load original edge data
-    {
+    const auto load_original_edges = [&] {
         io::FileReader edges_input_file(config.edges_data_path, io::FileReader::HasNoFingerprint);
 
         const auto number_of_original_edges = edges_input_file.ReadElementCount64();
@@ -618,10 +613,11 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                                  pre_turn_bearing_ptr,
                                  post_turn_bearing_ptr,
                                  number_of_original_edges);
-    }
+    };
+    loaders.push_back({"original edges", config.edges_data_path, load_original_edges});
 
     // load compressed geometry
-    {
+    const auto load_geometries = [&] {
         io::FileReader geometry_input_file(config.geometries_path,
                                            io::FileReader::HasNoFingerprint);
 
@@ -631,12 +627,28 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
         BOOST_ASSERT(geometry_index_count == layout.num_entries[DataLayout::GEOMETRIES_INDEX]);
         geometry_input_file.ReadInto(geometries_index_ptr, geometry_index_count);
 
-        const auto geometries_node_id_list_ptr =
-            layout.GetBlockPtr<NodeID, true>(memory_ptr, DataLayout::GEOMETRIES_NODE_LIST);
+        const auto geometries_node_id_list_ptr = layout.GetBlockPtr<std::uint64_t, true>(
+            memory_ptr, DataLayout::GEOMETRIES_NODE_LIST);
         const auto geometry_node_lists_count = geometry_input_file.ReadElementCount32();
-        BOOST_ASSERT(geometry_node_lists_count ==
+        GeometryNodeList geometry_node_list;
+        geometry_node_list.reset(
+            geometries_node_id_list_ptr, geometry_node_lists_count, layout.geometry_node_bits);
+        BOOST_ASSERT(GeometryNodeList::GetNumberOfWords(geometry_node_lists_count,
+                                                        geometry_node_list.GetBits()) ==
                      layout.num_entries[DataLayout::GEOMETRIES_NODE_LIST]);
-        geometry_input_file.ReadInto(geometries_node_id_list_ptr, geometry_node_lists_count);
+        {
+            std::vector<NodeID> buffer(1024 * 1024);
+            for (std::uint64_t begin = 0; begin < geometry_node_lists_count; begin += buffer.size())
+            {
+                const auto count =
+                    std::min<std::uint64_t>(buffer.size(), geometry_node_lists_count - begin);
+                geometry_input_file.ReadInto(buffer.data(), count);
+                for (const auto index : util::irange<std::uint64_t>(0, count))
+                {
+                    geometry_node_list.set(begin + index, buffer[index]);
+                }
+            }
+        }
 
         const auto geometries_fwd_weight_list_ptr = layout.GetBlockPtr<EdgeWeight, true>(
             memory_ptr, DataLayout::GEOMETRIES_FWD_WEIGHT_LIST);
@@ -649,9 +661,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
         BOOST_ASSERT(geometry_node_lists_count ==
                      layout.num_entries[DataLayout::GEOMETRIES_REV_WEIGHT_LIST]);
         geometry_input_file.ReadInto(geometries_rev_weight_list_ptr, geometry_node_lists_count);
-    }
+    };
+    loaders.push_back({"geometries", config.geometries_path, load_geometries});
 
-    {
+    const auto load_datasource_indexes = [&] {
         io::FileReader geometry_datasource_file(config.datasource_indexes_path,
                                                 io::FileReader::HasNoFingerprint);
         const auto number_of_compressed_datasources = geometry_datasource_file.ReadElementCount64();
@@ -664,9 +677,11 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             serialization::readDatasourceIndexes(
                 geometry_datasource_file, datasources_list_ptr, number_of_compressed_datasources);
         }
-    }
+    };
+    loaders.push_back(
+        {"datasource indexes", config.datasource_indexes_path, load_datasource_indexes});
 
-    {
+    const auto load_datasource_names = [&] {
         /* Load names */
         io::FileReader datasource_names_file(config.datasource_names_path,
                                              io::FileReader::HasNoFingerprint);
@@ -713,28 +728,28 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                       datasource_names_data.lengths.end(),
                       datasource_name_lengths_ptr);
         }
-    }
+    };
+    loaders.push_back({"datasource names", config.datasource_names_path, load_datasource_names});
 
     // Loading list of coordinates
-    {
+    const auto load_coordinates = [&] {
         io::FileReader nodes_file(config.nodes_data_path, io::FileReader::HasNoFingerprint);
-        nodes_file.Skip<std::uint64_t>(1); // node_count
-        const auto coordinates_ptr =
-            layout.GetBlockPtr<util::Coordinate, true>(memory_ptr, DataLayout::COORDINATE_LIST);
+        const auto number_of_coordinates = nodes_file.ReadElementCount64();
+        const auto coordinates_ptr = layout.GetBlockPtr<util::CoordinateListEntry, true>(
+            memory_ptr, DataLayout::COORDINATE_LIST);
         const auto osmnodeid_ptr =
             layout.GetBlockPtr<std::uint64_t, true>(memory_ptr, DataLayout::OSM_NODE_ID_LIST);
         util::PackedVector<OSMNodeID, true> osmnodeid_list;
 
         osmnodeid_list.reset(osmnodeid_ptr, layout.num_entries[DataLayout::OSM_NODE_ID_LIST]);
 
-        serialization::readNodes(nodes_file,
-                                 coordinates_ptr,
-                                 osmnodeid_list,
-                                 layout.num_entries[DataLayout::COORDINATE_LIST]);
-    }
+        serialization::readNodes(
+            nodes_file, coordinates_ptr, osmnodeid_list, number_of_coordinates);
+    };
+    loaders.push_back({"coordinates", config.nodes_data_path, load_coordinates});
 
     // store timestamp
-    {
+    const auto load_timestamp = [&] {
         io::FileReader timestamp_file(config.timestamp_path, io::FileReader::HasNoFingerprint);
         const auto timestamp_size = timestamp_file.Size();
 
@@ -742,10 +757,11 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             layout.GetBlockPtr<char, true>(memory_ptr, DataLayout::TIMESTAMP);
         BOOST_ASSERT(timestamp_size == layout.num_entries[DataLayout::TIMESTAMP]);
         timestamp_file.ReadInto(timestamp_ptr, timestamp_size);
-    }
+    };
+    loaders.push_back({"timestamp", config.timestamp_path, load_timestamp});
 
     // store search tree portion of rtree
-    {
+    const auto load_search_tree = [&] {
         io::FileReader tree_node_file(config.ram_index_path, io::FileReader::HasNoFingerprint);
         // perform this read so that we're at the right stream position for the next
         // read.
@@ -754,9 +770,10 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
             layout.GetBlockPtr<RTreeNode, true>(memory_ptr, DataLayout::R_SEARCH_TREE);
 
         tree_node_file.ReadInto(rtree_ptr, layout.num_entries[DataLayout::R_SEARCH_TREE]);
-    }
+    };
+    loaders.push_back({"search tree", config.ram_index_path, load_search_tree});
 
-    {
+    const auto load_core_markers = [&] {
         io::FileReader core_marker_file(config.core_data_path, io::FileReader::HasNoFingerprint);
         const auto number_of_core_markers = core_marker_file.ReadElementCount32();
 
@@ -787,20 +804,44 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                 core_marker_ptr[bucket] = (value | (1u << offset));
             }
         }
-    }
+    };
+    loaders.push_back({"core markers", config.core_data_path, load_core_markers});
+
+    // load core landmarks
+    const auto load_core_landmarks = [&] {
+        const auto ranks_ptr =
+            layout.GetBlockPtr<std::uint32_t, true>(memory_ptr, DataLayout::CORE_LANDMARK_RANKS);
+        const auto distances_ptr =
+            layout.GetBlockPtr<EdgeWeight, true>(memory_ptr, DataLayout::CORE_LANDMARK_DISTANCES);
+
+        if (layout.num_entries[DataLayout::CORE_LANDMARK_RANKS] > 0)
+        {
+            io::FileReader landmarks_file(config.core_landmarks_path,
+                                          io::FileReader::VerifyFingerprint);
+            landmarks_file.Skip<std::uint32_t>(1);
+            landmarks_file.Skip<std::uint64_t>(1);
+            landmarks_file.ReadInto(ranks_ptr,
+                                    layout.num_entries[DataLayout::CORE_LANDMARK_RANKS]);
+            landmarks_file.Skip<std::uint64_t>(1);
+            landmarks_file.ReadInto(distances_ptr,
+                                    layout.num_entries[DataLayout::CORE_LANDMARK_DISTANCES]);
+        }
+    };
+    loaders.push_back({"core landmarks", config.core_landmarks_path, load_core_landmarks});
 
     // load profile properties
-    {
+    const auto load_profile_properties = [&] {
         io::FileReader profile_properties_file(config.properties_path,
                                                io::FileReader::HasNoFingerprint);
         const auto profile_properties_ptr = layout.GetBlockPtr<extractor::ProfileProperties, true>(
             memory_ptr, DataLayout::PROPERTIES);
         profile_properties_file.ReadInto(profile_properties_ptr,
                                          layout.num_entries[DataLayout::PROPERTIES]);
-    }
+    };
+    loaders.push_back({"profile properties", config.properties_path, load_profile_properties});
 
     // Load intersection data
-    {
+    const auto load_intersection_classes = [&] {
         io::FileReader intersection_file(config.intersection_class_path,
                                          io::FileReader::VerifyFingerprint);
 
@@ -881,7 +922,74 @@ void Storage::PopulateData(const DataLayout &layout, char *memory_ptr)
                              sizeof(decltype(entry_class_table)::value_type));
             std::copy(entry_class_table.begin(), entry_class_table.end(), entry_class_ptr);
         }
+    };
+    loaders.push_back(
+        {"intersection classes", config.intersection_class_path, load_intersection_classes});
+
+    std::vector<double> load_seconds(loaders.size(), 0.);
+    TIMER_START(load_data);
+    tbb::parallel_for(tbb::blocked_range<std::size_t>(0, loaders.size(), 1),
+                      [&](const tbb::blocked_range<std::size_t> &range) {
+                          for (auto index = range.begin(); index != range.end(); ++index)
+                          {
+                              TIMER_START(load_block);
+                              loaders[index].load();
+                              TIMER_STOP(load_block);
+                              load_seconds[index] = TIMER_SEC(load_block);
+                          }
+                      },
+                      tbb::simple_partitioner());
+    TIMER_STOP(load_data);
+
+    std::uint64_t total_bytes = 0;
+    for (const auto index : util::irange<std::size_t>(0, loaders.size()))
+    {
+        const auto &path = loaders[index].path;
+        const std::uint64_t bytes =
+            boost::filesystem::is_regular_file(path) ? boost::filesystem::file_size(path) : 0;
+        total_bytes += bytes;
+        util::Log() << "loaded " << loaders[index].name << " (" << bytes << " bytes) in "
+                    << load_seconds[index] << "s";
+    }
+    util::Log() << "loaded " << total_bytes << " bytes in " << TIMER_SEC(load_data) << "s ("
+                << total_bytes / std::max(TIMER_SEC(load_data), 1e-6) / (1024 * 1024)
+                << " MB/s)";
+}
+
+void Storage::WriteDataset(const boost::filesystem::path &dataset_path)
+{
+    DatasetHeader header;
+    header.fingerprint = util::FingerPrint::GetValid();
+    PopulateLayout(header.layout);
+    header.data_offset = DatasetHeader::DATA_OFFSET;
+    header.data_size = header.layout.GetSizeOfLayout();
+
+    util::Log() << "writing dataset of " << header.data_offset + header.data_size << " bytes to "
+                << dataset_path.string();
+
+    // The data is written through a mapping of the file itself, so it never needs to fit into
+    // memory twice. The file is moved into place once complete.
+    const boost::filesystem::path temporary_path = dataset_path.string() + ".tmp";
+    {
+        std::ofstream(temporary_path.string(), std::ios::binary | std::ios::trunc);
+        boost::filesystem::resize_file(temporary_path, header.data_offset + header.data_size);
+
+        boost::interprocess::file_mapping mapping(temporary_path.string().c_str(),
+                                                  boost::interprocess::read_write);
+        boost::interprocess::mapped_region region(mapping, boost::interprocess::read_write);
+        char *memory_ptr = static_cast<char *>(region.get_address());
+
+        PopulateData(header.layout, memory_ptr + header.data_offset);
+        std::copy(reinterpret_cast<const char *>(&header),
+                  reinterpret_cast<const char *>(&header) + sizeof(header),
+                  memory_ptr);
+
+        if (!region.flush())
+        {
+            throw util::exception("Could not write " + temporary_path.string() + SOURCE_REF);
+        }
     }
+    boost::filesystem::rename(temporary_path, dataset_path);
 }
 }
 }
@@ -42,6 +42,19 @@ return_code parseArguments(int argc, char *argv[], contractor::ContractorConfig
         "core,k",
         boost::program_options::value<double>(&contractor_config.core_factor)->default_value(1.0),
         "Percentage of the graph (in vertices) to contract [0..1]")(
+        "core-landmarks",
+        boost::program_options::value<unsigned>(&contractor_config.number_of_core_landmarks)
+            ->default_value(16),
+        "Number of landmarks used to speed up queries on the core, 0 disables landmarks")(
+        "checkpoint-interval",
+        boost::program_options::value<double>(&contractor_config.checkpoint_interval)
+            ->default_value(0),
+        "Seconds between checkpoints of the contraction state, 0 disables checkpoints")(
+        "resume",
+        boost::program_options::value<bool>(&contractor_config.resume_from_checkpoint)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Resume the contraction from the last checkpoint")(
         "segment-speed-file",
         boost::program_options::value<std::vector<std::string>>(
             &contractor_config.segment_speed_lookup_paths)
@@ -52,6 +65,14 @@ return_code parseArguments(int argc, char *argv[], contractor::ContractorConfig
             &contractor_config.turn_penalty_lookup_paths)
             ->composing(),
         "Lookup files containing from_, to_, via_nodes, and turn penalties to adjust turn weights")(
+        "cache-lookup-files",
+        boost::program_options::value<bool>(&contractor_config.cache_lookup_files)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Store parsed speed and penalty files as <file>.bin and reuse them as long as the size and "
+        "modification time of the file they were created from are unchanged. Modification times "
+        "have a resolution of 1 s, a file rewritten with the same size within the same second is "
+        "not detected")(
         "level-cache,o",
         boost::program_options::value<bool>(&contractor_config.use_cached_priority)
             ->default_value(false),
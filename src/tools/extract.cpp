@@ -46,6 +46,12 @@ return_code parseArguments(int argc, char *argv[], extractor::ExtractorConfig &e
             ->implicit_value(true)
             ->default_value(false),
         "Generate a lookup table for internal edge-expanded-edge IDs to OSM node pairs")(
+        "renumber-nodes",
+        boost::program_options::value<bool>(&extractor_config.renumber_nodes)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Number the edge-based nodes along a Hilbert curve to improve memory locality of "
+        "queries")(
         "small-component-size",
         boost::program_options::value<unsigned int>(&extractor_config.small_component_size)
             ->default_value(1000),
@@ -1,3 +1,5 @@
+#include "engine/cache_statistics.hpp"
+#include "engine/hint_statistics.hpp"
 #include "server/server.hpp"
 #include "util/log.hpp"
 #include "util/version.hpp"
@@ -14,6 +16,7 @@
 #include <sys/mman.h>
 #endif
 
+#include <cstddef>
 #include <cstdlib>
 
 #include <signal.h>
@@ -59,12 +62,19 @@ inline unsigned generateServerProgramOptions(const int argc,
                                              int &ip_port,
                                              int &requested_num_threads,
                                              bool &use_shared_memory,
+                                             bool &use_mmap,
                                              bool &trial,
                                              int &max_locations_trip,
                                              int &max_locations_viaroute,
                                              int &max_locations_distance_table,
                                              int &max_locations_map_matching,
-                                             int &max_results_nearest)
+                                             int &max_results_nearest,
+                                             int &max_alternatives,
+                                             int &max_request_duration,
+                                             std::size_t &shortcut_cache_size,
+                                             std::size_t &snapping_cache_size,
+                                             bool &warmup_rtree,
+                                             bool &rtree_statistics)
 {
     using boost::program_options::value;
     using boost::filesystem::path;
@@ -90,6 +100,9 @@ inline unsigned generateServerProgramOptions(const int argc,
         ("shared-memory,s",
          value<bool>(&use_shared_memory)->implicit_value(true)->default_value(false),
          "Load data from shared memory") //
+        ("mmap",
+         value<bool>(&use_mmap)->implicit_value(true)->default_value(false),
+         "Map the dataset file written by osrm-datastore --dataset instead of loading the data") //
         ("max-viaroute-size",
          value<int>(&max_locations_viaroute)->default_value(500),
          "Max. locations supported in viaroute query") //
@@ -104,7 +117,29 @@ inline unsigned generateServerProgramOptions(const int argc,
          "Max. locations supported in map matching query") //
         ("max-nearest-size",
          value<int>(&max_results_nearest)->default_value(100),
-         "Max. results supported in nearest query");
+         "Max. results supported in nearest query") //
+        ("max-alternatives",
+         value<int>(&max_alternatives)->default_value(3),
+         "Max. number of alternatives supported in route query, -1 for unlimited") //
+        ("max-request-duration",
+         value<int>(&max_request_duration)->default_value(-1),
+         "Max. duration of a request in milliseconds, longer requests fail with HTTP 503. -1 "
+         "disables the limit") //
+        ("shortcut-cache-size",
+         value<std::size_t>(&shortcut_cache_size)->default_value(0),
+         "Number of original edges of long shortcuts to cache unpacked, 16 bytes each. "
+         "Speeds up long routes. 0 disables the cache") //
+        ("snapping-cache-size",
+         value<std::size_t>(&snapping_cache_size)->default_value(0),
+         "Number of coordinates to cache the snapped locations of, speeds up requests for "
+         "recurring coordinates. 0 disables the cache") //
+        ("warmup-rtree",
+         value<bool>(&warmup_rtree)->implicit_value(true)->default_value(false),
+         "Read the rtree leaves into RAM on load instead of on demand by the first requests") //
+        ("rtree-statistics",
+         value<bool>(&rtree_statistics)->implicit_value(true)->default_value(false),
+         "Count the rtree leaf accesses and page faults of all requests and log them when the "
+         "data is unloaded");
 
     // hidden options, will be allowed on command line, but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
@@ -154,6 +189,12 @@ inline unsigned generateServerProgramOptions(const int argc,
 
     boost::program_options::notify(option_variables);
 
+    if (use_shared_memory && use_mmap)
+    {
+        util::Log(logERROR) << "--shared-memory and --mmap can't be used together";
+        return INIT_FAILED;
+    }
+
     if (!use_shared_memory && option_variables.count("base"))
     {
         return INIT_OK_START_ENGINE;
@@ -177,7 +218,7 @@ int main(int argc, const char *argv[]) try
 
     bool trial_run = false;
     std::string ip_address;
-    int ip_port, requested_thread_num;
+    int ip_port, requested_thread_num, max_request_duration;
 
     EngineConfig config;
     boost::filesystem::path base_path;
@@ -188,12 +229,19 @@ int main(int argc, const char *argv[]) try
                                                               ip_port,
                                                               requested_thread_num,
                                                               config.use_shared_memory,
+                                                              config.use_mmap,
                                                               trial_run,
                                                               config.max_locations_trip,
                                                               config.max_locations_viaroute,
                                                               config.max_locations_distance_table,
                                                               config.max_locations_map_matching,
-                                                              config.max_results_nearest);
+                                                              config.max_results_nearest,
+                                                              config.max_alternatives,
+                                                              max_request_duration,
+                                                              config.shortcut_cache_size,
+                                                              config.snapping_cache_size,
+                                                              config.warmup_rtree,
+                                                              config.rtree_statistics);
     if (init_result == INIT_OK_DO_NOT_START_ENGINE)
     {
         return EXIT_SUCCESS;
@@ -293,6 +341,10 @@ int main(int argc, const char *argv[]) try
     {
         util::Log() << "Loading from shared memory";
     }
+    else if (config.use_mmap)
+    {
+        util::Log() << "Mapping " << config.storage_config.dataset_path.string();
+    }
 
     util::Log() << "Threads: " << requested_thread_num;
     util::Log() << "IP address: " << ip_address;
@@ -306,7 +358,8 @@ int main(int argc, const char *argv[]) try
     pthread_sigmask(SIG_BLOCK, &new_mask, &old_mask);
 #endif
 
-    auto routing_server = server::Server::CreateServer(ip_address, ip_port, requested_thread_num);
+    auto routing_server = server::Server::CreateServer(
+        ip_address, ip_port, requested_thread_num, max_request_duration);
     auto service_handler = std::make_unique<server::ServiceHandler>(config);
 
     routing_server->RegisterServiceHandler(std::move(service_handler));
@@ -360,10 +413,28 @@ int main(int argc, const char *argv[]) try
             util::Log(logWARNING) << "Didn't exit within 2 seconds. Hard abort!";
             server_task.reset(); // just kill it
         }
+
+        const auto &hint_statistics = engine::HintStatistics::GetInstance();
+        util::Log() << "hints: " << hint_statistics.GetNumberOfValidHints() << " valid, "
+                    << hint_statistics.GetNumberOfInvalidHints() << " invalid, "
+                    << hint_statistics.GetNumberOfMissingHints() << " coordinates without hint";
     }
 
     util::Log() << "freeing objects";
     routing_server.reset();
+
+    const auto &cache_statistics = engine::CacheStatistics::GetInstance();
+    if (config.shortcut_cache_size > 0)
+    {
+        util::Log() << "shortcut unpacking cache: "
+                    << cache_statistics.GetNumberOfShortcutUnpackingHits() << " hits, "
+                    << cache_statistics.GetNumberOfShortcutUnpackingMisses() << " misses";
+    }
+    if (config.snapping_cache_size > 0)
+    {
+        util::Log() << "snapping cache: " << cache_statistics.GetNumberOfSnappingHits()
+                    << " hits, " << cache_statistics.GetNumberOfSnappingMisses() << " misses";
+    }
     util::Log() << "shutdown completed";
 }
 catch (const std::bad_alloc &e)
@@ -1,19 +1,151 @@
 #include "storage/storage.hpp"
 #include "util/exception.hpp"
+#include "util/integer_range.hpp"
 #include "util/log.hpp"
+#include "util/timing_util.hpp"
 #include "util/typedefs.hpp"
 #include "util/version.hpp"
 
 #include <boost/filesystem.hpp>
 #include <boost/program_options.hpp>
 
+#include <tbb/blocked_range.h>
+#include <tbb/enumerable_thread_specific.h>
+#include <tbb/parallel_for.h>
+#include <tbb/task_arena.h>
+
+#ifdef __linux__
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+#include <algorithm>
+#include <fstream>
+#include <memory>
+#include <string>
+#include <thread>
+#include <tuple>
+#include <vector>
+
 using namespace osrm;
 
+// Reads all files of the dataset with an increasing number of threads and reports the
+// throughput, which shows how much the parallel loading of osrm-datastore can gain.
+void runIOBenchmark(const storage::StorageConfig &config)
+{
+    const constexpr std::uint64_t CHUNK_SIZE = 16 * 1024 * 1024;
+
+    const boost::filesystem::path paths[] = {config.ram_index_path,
+                                             config.file_index_path,
+                                             config.hsgr_data_path,
+                                             config.nodes_data_path,
+                                             config.edges_data_path,
+                                             config.core_data_path,
+                                             config.core_landmarks_path,
+                                             config.geometries_path,
+                                             config.timestamp_path,
+                                             config.datasource_names_path,
+                                             config.datasource_indexes_path,
+                                             config.names_data_path,
+                                             config.properties_path,
+                                             config.intersection_class_path,
+                                             config.turn_lane_data_path,
+                                             config.turn_lane_description_path};
+
+    // (file, offset, size) of every chunk that is read
+    std::vector<std::tuple<boost::filesystem::path, std::uint64_t, std::uint64_t>> chunks;
+    std::uint64_t total_bytes = 0;
+    for (const auto &path : paths)
+    {
+        if (!boost::filesystem::is_regular_file(path))
+            continue;
+
+        const std::uint64_t size = boost::filesystem::file_size(path);
+        for (std::uint64_t offset = 0; offset < size; offset += CHUNK_SIZE)
+        {
+            chunks.emplace_back(path, offset, std::min(CHUNK_SIZE, size - offset));
+        }
+        total_bytes += size;
+    }
+
+    const auto drop_from_page_cache = [&paths]() {
+#ifdef __linux__
+        for (const auto &path : paths)
+        {
+            const auto fd = open(path.string().c_str(), O_RDONLY);
+            if (fd != -1)
+            {
+                posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+                close(fd);
+            }
+        }
+#endif
+    };
+#ifndef __linux__
+    util::Log(logWARNING) << "Can not drop the files from the page cache, results may include "
+                              "cached reads";
+#endif
+
+    util::Log() << "reading " << total_bytes << " bytes in " << chunks.size() << " chunks";
+
+    const unsigned max_threads = std::max(1u, std::thread::hardware_concurrency());
+    for (unsigned threads = 1;; threads = std::min(2 * threads, max_threads))
+    {
+        drop_from_page_cache();
+
+        // every thread allocates its buffer once and only opens a file when it moves on to the
+        // chunks of the next one, so mostly the reads themselves are timed
+        struct ChunkReader
+        {
+            std::unique_ptr<char[]> buffer{new char[CHUNK_SIZE]};
+            boost::filesystem::path path;
+            std::ifstream file;
+        };
+        tbb::enumerable_thread_specific<ChunkReader> readers;
+
+        tbb::task_arena arena(threads);
+        TIMER_START(read_all);
+        arena.execute([&] {
+            tbb::parallel_for(tbb::blocked_range<std::size_t>(0, chunks.size(), 1),
+                              [&](const tbb::blocked_range<std::size_t> &range) {
+                                  auto &reader = readers.local();
+                                  for (auto index = range.begin(); index != range.end(); ++index)
+                                  {
+                                      const auto &path = std::get<0>(chunks[index]);
+                                      if (reader.path != path)
+                                      {
+                                          reader.file.close();
+                                          reader.file.open(path.string(), std::ios::binary);
+                                          reader.path = path;
+                                      }
+                                      reader.file.clear();
+                                      reader.file.seekg(std::get<1>(chunks[index]));
+                                      reader.file.read(reader.buffer.get(),
+                                                       std::get<2>(chunks[index]));
+                                  }
+                              },
+                              tbb::simple_partitioner());
+        });
+        TIMER_STOP(read_all);
+
+        util::Log() << threads << " threads: "
+                    << total_bytes / std::max(TIMER_SEC(read_all), 1e-6) / (1024 * 1024)
+                    << " MB/s";
+
+        if (threads == max_threads)
+            break;
+    }
+}
+
 // generate boost::program_options object for the routing part
 bool generateDataStoreOptions(const int argc,
                               const char *argv[],
                               boost::filesystem::path &base_path,
-                              int &max_wait)
+                              int &max_wait,
+                              bool &write_dataset,
+                              bool &io_benchmark,
+                              std::string &huge_pages,
+                              std::string &numa_policy)
 {
     // declare a group of options that will be allowed only on command line
     boost::program_options::options_description generic_options("Options");
@@ -25,7 +157,24 @@ bool generateDataStoreOptions(const int argc,
     config_options.add_options()(
         "max-wait",
         boost::program_options::value<int>(&max_wait)->default_value(-1),
-        "Maximum number of seconds to wait on requests that use the old dataset.");
+        "Deprecated, has no effect. Queries no longer block loading a new dataset.")(
+        "dataset",
+        boost::program_options::value<bool>(&write_dataset)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Write a .dataset file for osrm-routed --mmap instead of loading into shared memory.")(
+        "io-benchmark",
+        boost::program_options::value<bool>(&io_benchmark)
+            ->implicit_value(true)
+            ->default_value(false),
+        "Measure the read throughput for the data files with an increasing number of threads.")(
+        "huge-pages",
+        boost::program_options::value<std::string>(&huge_pages)->default_value("none"),
+        "Back the shared memory with huge pages: none, 2MB or 1GB. The pages need to be "
+        "reserved with vm.nr_hugepages.")(
+        "numa",
+        boost::program_options::value<std::string>(&numa_policy)->default_value("local"),
+        "NUMA placement of the shared memory: local (first touch) or interleave.");
 
     // hidden options, will be allowed on command line but will not be shown to the user
     boost::program_options::options_description hidden_options("Hidden options");
@@ -93,36 +242,75 @@ int main(const int argc, const char *argv[]) try
 
     boost::filesystem::path base_path;
     int max_wait = -1;
-    if (!generateDataStoreOptions(argc, argv, base_path, max_wait))
+    bool write_dataset = false;
+    bool io_benchmark = false;
+    std::string huge_pages;
+    std::string numa_policy;
+    if (!generateDataStoreOptions(argc,
+                                  argv,
+                                  base_path,
+                                  max_wait,
+                                  write_dataset,
+                                  io_benchmark,
+                                  huge_pages,
+                                  numa_policy))
     {
         return EXIT_SUCCESS;
     }
+
+    storage::MemoryPlacement placement;
+    if (huge_pages == "2MB")
+    {
+        placement.huge_pages = storage::MemoryPlacement::HugePages::Pages2MB;
+    }
+    else if (huge_pages == "1GB")
+    {
+        placement.huge_pages = storage::MemoryPlacement::HugePages::Pages1GB;
+    }
+    else if (huge_pages != "none")
+    {
+        util::Log(logERROR) << "Unknown huge page size " << huge_pages << ". Exiting!";
+        return EXIT_FAILURE;
+    }
+
+    if (numa_policy == "interleave")
+    {
+        placement.numa_policy = storage::MemoryPlacement::NUMAPolicy::Interleave;
+    }
+    else if (numa_policy != "local")
+    {
+        util::Log(logERROR) << "Unknown NUMA policy " << numa_policy << ". Exiting!";
+        return EXIT_FAILURE;
+    }
+
     storage::StorageConfig config(base_path);
     if (!config.IsValid())
     {
         util::Log(logERROR) << "Config contains invalid file paths. Exiting!";
         return EXIT_FAILURE;
     }
-    storage::Storage storage(std::move(config));
+    if (io_benchmark)
+    {
+        runIOBenchmark(config);
+        return EXIT_SUCCESS;
+    }
+
+    const auto dataset_path = config.dataset_path;
+    storage::Storage storage(std::move(config), placement);
+
+    if (write_dataset)
+    {
+        storage.WriteDataset(dataset_path);
+        return EXIT_SUCCESS;
+    }
 
-    // We will attempt to load this dataset to memory several times if we encounter
-    // an error we can recover from. This is needed when we need to clear mutexes
-    // that have been left dangling by other processes.
-    const constexpr unsigned MAX_RETRIES = 3;
-    unsigned retry_counter = 0;
-    storage::Storage::ReturnCode code = storage::Storage::ReturnCode::Retry;
-    while (code == storage::Storage::ReturnCode::Retry && retry_counter < MAX_RETRIES)
+    if (max_wait >= 0)
     {
-        if (retry_counter > 0)
-        {
-            util::Log(logWARNING) << "Try number " << (retry_counter + 1)
-                                  << " to load the dataset.";
-        }
-        code = storage.Run(max_wait);
-        retry_counter++;
+        util::Log(logWARNING) << "--max-wait is deprecated and has no effect, queries on the old "
+                                 "dataset no longer block the update";
     }
 
-    if (code == storage::Storage::ReturnCode::Ok)
+    if (storage.Run() == storage::Storage::ReturnCode::Ok)
     {
         return EXIT_SUCCESS;
     }
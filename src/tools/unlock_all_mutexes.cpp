@@ -8,9 +8,7 @@ int main()
     osrm::util::LogPolicy::GetInstance().Unmute();
     osrm::util::Log() << "Releasing all locks";
 
-    osrm::storage::SharedBarriers::resetCurrentRegions();
-    osrm::storage::SharedBarriers::resetRegions1();
-    osrm::storage::SharedBarriers::resetRegions2();
+    osrm::storage::SharedBarriers::resetDatastore();
 
     return 0;
 }
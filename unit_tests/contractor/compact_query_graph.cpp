@@ -0,0 +1,109 @@
+#include "contractor/compact_query_graph.hpp"
+#include "contractor/query_edge.hpp"
+#include "util/static_graph.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(compact_query_graph)
+
+using namespace osrm;
+using namespace osrm::contractor;
+
+BOOST_AUTO_TEST_CASE(matches_static_graph)
+{
+    using EdgeData = QueryEdge::EdgeData;
+    using StaticGraph = util::StaticGraph<EdgeData>;
+
+    const unsigned number_of_nodes = 50;
+    std::mt19937 generator(15);
+    std::uniform_int_distribution<NodeID> node_distribution(0, number_of_nodes - 1);
+    std::uniform_int_distribution<int> weight_distribution(1, 100000);
+    std::uniform_int_distribution<int> flag_distribution(0, 3);
+
+    std::vector<StaticGraph::InputEdge> edges;
+    for (unsigned index = 0; index < 300; ++index)
+    {
+        EdgeData data;
+        data.id = node_distribution(generator) * 1000 + index;
+        data.shortcut = flag_distribution(generator) == 0;
+        data.weight = weight_distribution(generator);
+        const auto directions = flag_distribution(generator);
+        data.forward = directions != 1;
+        data.backward = directions != 2;
+        edges.emplace_back(node_distribution(generator), node_distribution(generator), data);
+    }
+    std::sort(edges.begin(), edges.end());
+
+    const StaticGraph static_graph(number_of_nodes, edges);
+    const CompactQueryGraph<> compact_graph(number_of_nodes, edges);
+
+    BOOST_CHECK_EQUAL(compact_graph.GetNumberOfNodes(), static_graph.GetNumberOfNodes());
+    BOOST_CHECK_EQUAL(compact_graph.GetNumberOfEdges(), static_graph.GetNumberOfEdges());
+
+    for (NodeID node = 0; node < number_of_nodes; ++node)
+    {
+        BOOST_REQUIRE_EQUAL(compact_graph.BeginEdges(node), static_graph.BeginEdges(node));
+        BOOST_REQUIRE_EQUAL(compact_graph.EndEdges(node), static_graph.EndEdges(node));
+
+        for (const auto edge : static_graph.GetAdjacentEdgeRange(node))
+        {
+            BOOST_CHECK_EQUAL(compact_graph.GetTarget(edge), static_graph.GetTarget(edge));
+
+            const auto &expected = static_graph.GetEdgeData(edge);
+            const auto data = compact_graph.GetEdgeData(edge);
+            BOOST_CHECK_EQUAL(data.id, expected.id);
+            BOOST_CHECK_EQUAL(data.shortcut, expected.shortcut);
+            BOOST_CHECK_EQUAL(data.weight, expected.weight);
+            BOOST_CHECK_EQUAL(data.forward, expected.forward);
+            BOOST_CHECK_EQUAL(data.backward, expected.backward);
+
+            const auto &search_data = compact_graph.GetEdgeSearchData(edge);
+            BOOST_CHECK_EQUAL(search_data.weight, expected.weight);
+            BOOST_CHECK_EQUAL(search_data.forward, expected.forward);
+            BOOST_CHECK_EQUAL(search_data.backward, expected.backward);
+        }
+
+        for (NodeID target = 0; target < number_of_nodes; ++target)
+        {
+            BOOST_CHECK_EQUAL(compact_graph.FindEdge(node, target),
+                              static_graph.FindEdge(node, target));
+            BOOST_CHECK_EQUAL(compact_graph.FindEdgeInEitherDirection(node, target),
+                              static_graph.FindEdgeInEitherDirection(node, target));
+
+            const auto forward_only = [](const EdgeData &data) { return data.forward; };
+            BOOST_CHECK_EQUAL(compact_graph.FindSmallestEdge(node, target, forward_only),
+                              static_graph.FindSmallestEdge(node, target, forward_only));
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(split_hsgr_edge)
+{
+    using Graph = CompactQueryGraph<>;
+
+    util::StaticGraph<QueryEdge::EdgeData>::EdgeArrayEntry edge;
+    edge.target = 42;
+    edge.data.id = (1u << 31) - 2;
+    edge.data.shortcut = true;
+    edge.data.weight = (1 << 29) - 1;
+    edge.data.forward = false;
+    edge.data.backward = true;
+
+    Graph::EdgeArrayEntry edge_entry;
+    Graph::EdgeIDEntry id_entry;
+    Graph::Split(edge, edge_entry, id_entry);
+
+    BOOST_CHECK_EQUAL(edge_entry.target, 42);
+    BOOST_CHECK_EQUAL(edge_entry.data.weight, (1 << 29) - 1);
+    BOOST_CHECK_EQUAL(edge_entry.data.forward, false);
+    BOOST_CHECK_EQUAL(edge_entry.data.backward, true);
+    BOOST_CHECK_EQUAL(id_entry.id, (1u << 31) - 2);
+    BOOST_CHECK_EQUAL(id_entry.shortcut, true);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
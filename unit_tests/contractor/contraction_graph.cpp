@@ -0,0 +1,174 @@
+#include "contractor/contraction_graph.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(contraction_graph)
+
+using namespace osrm;
+using namespace osrm::contractor;
+
+struct TestData
+{
+    EdgeID id;
+};
+
+typedef ContractionGraph<TestData> TestContractionGraph;
+typedef TestContractionGraph::InputEdge TestInputEdge;
+
+BOOST_AUTO_TEST_CASE(find_test)
+{
+    /*
+     *  (0) -1-> (1)
+     *  ^ ^
+     *  2 5
+     *  | |
+     *  (3) -3-> (4)
+     *      <-4-
+     */
+    std::vector<TestInputEdge> input_edges = {TestInputEdge{0, 1, TestData{1}},
+                                              TestInputEdge{3, 0, TestData{2}},
+                                              TestInputEdge{3, 0, TestData{5}},
+                                              TestInputEdge{3, 4, TestData{3}},
+                                              TestInputEdge{4, 3, TestData{4}}};
+    TestContractionGraph simple_graph(5, input_edges);
+
+    BOOST_CHECK_EQUAL(simple_graph.GetNumberOfNodes(), 5);
+    BOOST_CHECK_EQUAL(simple_graph.GetNumberOfEdges(), 5);
+
+    auto eit = simple_graph.FindEdge(0, 1);
+    BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(eit).id, 1);
+
+    eit = simple_graph.FindEdge(1, 0);
+    BOOST_CHECK_EQUAL(eit, SPECIAL_EDGEID);
+
+    eit = simple_graph.FindEdge(3, 4);
+    BOOST_CHECK_EQUAL(simple_graph.GetEdgeData(eit).id, 3);
+
+    BOOST_CHECK_EQUAL(simple_graph.GetOutDegree(3), 3);
+    BOOST_CHECK_EQUAL(simple_graph.GetOutDegree(2), 0);
+}
+
+BOOST_AUTO_TEST_CASE(insert_delete_test)
+{
+    std::vector<TestInputEdge> input_edges = {TestInputEdge{0, 1, TestData{1}},
+                                              TestInputEdge{1, 2, TestData{2}},
+                                              TestInputEdge{2, 0, TestData{3}}};
+    TestContractionGraph graph(3, input_edges);
+
+    // forces node 0 to move its edges to the end of the edge array
+    for (const auto i : util::irange<EdgeID>(0, 10))
+    {
+        graph.InsertEdge(0, 2, TestData{10 + i});
+    }
+    BOOST_CHECK_EQUAL(graph.GetOutDegree(0), 11);
+    BOOST_CHECK_EQUAL(graph.GetNumberOfEdges(), 13);
+    BOOST_CHECK_EQUAL(graph.GetEdgeData(graph.FindEdge(0, 1)).id, 1);
+    BOOST_CHECK_EQUAL(graph.GetEdgeData(graph.FindEdge(1, 2)).id, 2);
+
+    BOOST_CHECK_EQUAL(graph.DeleteEdgesTo(0, 2), 10);
+    BOOST_CHECK_EQUAL(graph.GetOutDegree(0), 1);
+    BOOST_CHECK_EQUAL(graph.GetNumberOfEdges(), 3);
+    BOOST_CHECK_EQUAL(graph.FindEdge(0, 2), SPECIAL_EDGEID);
+    BOOST_CHECK_EQUAL(graph.GetEdgeData(graph.FindEdge(0, 1)).id, 1);
+}
+
+BOOST_AUTO_TEST_CASE(compaction_test)
+{
+    std::vector<TestInputEdge> input_edges = {TestInputEdge{0, 1, TestData{1}},
+                                              TestInputEdge{1, 0, TestData{2}},
+                                              TestInputEdge{1, 2, TestData{3}},
+                                              TestInputEdge{2, 1, TestData{4}}};
+    TestContractionGraph graph(3, input_edges);
+
+    // alternate insertions so that slices keep getting moved
+    for (const auto i : util::irange<EdgeID>(0, 20))
+    {
+        graph.InsertEdge(i % 3, (i + 1) % 3, TestData{100 + i});
+    }
+    BOOST_CHECK(graph.NeedsCompaction(0.));
+
+    graph.Compact();
+    BOOST_CHECK(!graph.NeedsCompaction(0.));
+    BOOST_CHECK_EQUAL(graph.GetNumberOfEdges(), 24);
+
+    EdgeID number_of_edges = 0;
+    for (const auto node : util::irange<NodeID>(0, 3))
+    {
+        for (const auto edge : graph.GetAdjacentEdgeRange(node))
+        {
+            BOOST_CHECK_LT(graph.GetTarget(edge), 3);
+            ++number_of_edges;
+        }
+    }
+    BOOST_CHECK_EQUAL(number_of_edges, 24);
+    BOOST_CHECK_EQUAL(graph.GetEdgeData(graph.FindEdge(2, 1)).id, 4);
+
+    // graph stays usable after compaction
+    graph.InsertEdge(2, 2, TestData{42});
+    BOOST_CHECK_EQUAL(graph.GetEdgeData(graph.FindEdge(2, 2)).id, 42);
+    BOOST_CHECK_EQUAL(graph.GetNumberOfEdges(), 25);
+}
+
+BOOST_AUTO_TEST_CASE(compaction_with_isolated_nodes_test)
+{
+    // nodes 1 and 4 have no edges and share the first edge of their successors
+    std::vector<TestInputEdge> input_edges = {TestInputEdge{0, 2, TestData{1}},
+                                              TestInputEdge{2, 0, TestData{2}},
+                                              TestInputEdge{3, 0, TestData{3}}};
+    TestContractionGraph graph(5, input_edges);
+
+    for (const auto i : util::irange<EdgeID>(0, 10))
+    {
+        graph.InsertEdge(0, 3, TestData{100 + i});
+    }
+    BOOST_CHECK(graph.NeedsCompaction(0.));
+
+    graph.Compact();
+    BOOST_CHECK(!graph.NeedsCompaction(0.));
+    BOOST_CHECK_EQUAL(graph.GetNumberOfEdges(), 13);
+    BOOST_CHECK_EQUAL(graph.GetOutDegree(0), 11);
+    BOOST_CHECK_EQUAL(graph.GetOutDegree(1), 0);
+    BOOST_CHECK_EQUAL(graph.GetOutDegree(4), 0);
+    BOOST_CHECK_EQUAL(graph.GetEdgeData(graph.FindEdge(0, 2)).id, 1);
+    BOOST_CHECK_EQUAL(graph.GetEdgeData(graph.FindEdge(2, 0)).id, 2);
+    BOOST_CHECK_EQUAL(graph.GetEdgeData(graph.FindEdge(3, 0)).id, 3);
+
+    graph.InsertEdge(1, 4, TestData{42});
+    BOOST_CHECK_EQUAL(graph.GetEdgeData(graph.FindEdge(1, 4)).id, 42);
+}
+
+BOOST_AUTO_TEST_CASE(compaction_after_growing_in_place_test)
+{
+    // node 1 has no edges, its first edge is the end of the slice of node 0
+    std::vector<TestInputEdge> input_edges = {TestInputEdge{0, 1, TestData{1}}};
+    TestContractionGraph graph(2, input_edges);
+
+    // the last slice grows in place over the first edge of node 1
+    const auto first = graph.InsertEdge(0, 1, TestData{2});
+    const auto second = graph.InsertEdge(0, 1, TestData{3});
+    BOOST_CHECK_EQUAL(graph.GetEdgeData(first).id, 2);
+    BOOST_CHECK_EQUAL(graph.GetEdgeData(second).id, 3);
+
+    graph.Compact();
+    BOOST_CHECK_EQUAL(graph.GetNumberOfEdges(), 3);
+    BOOST_CHECK_EQUAL(graph.GetOutDegree(0), 3);
+    BOOST_CHECK_EQUAL(graph.GetOutDegree(1), 0);
+
+    const auto inserted = graph.InsertEdge(1, 0, TestData{42});
+    BOOST_CHECK_EQUAL(graph.GetTarget(inserted), 0);
+    BOOST_CHECK_EQUAL(graph.GetEdgeData(inserted).id, 42);
+    BOOST_CHECK_EQUAL(graph.GetOutDegree(0), 3);
+
+    std::vector<EdgeID> ids;
+    for (const auto edge : graph.GetAdjacentEdgeRange(0))
+    {
+        ids.push_back(graph.GetEdgeData(edge).id);
+    }
+    BOOST_CHECK((ids == std::vector<EdgeID>{1, 2, 3}));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,233 @@
+#include "contractor/core_landmarks.hpp"
+#include "contractor/query_edge.hpp"
+#include "util/deallocating_vector.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdint>
+#include <random>
+#include <set>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(core_landmarks)
+
+using namespace osrm;
+using namespace osrm::contractor;
+
+namespace
+{
+QueryEdge makeEdge(const NodeID source,
+                   const NodeID target,
+                   const int weight,
+                   const bool forward,
+                   const bool backward)
+{
+    QueryEdge::EdgeData data;
+    data.id = source;
+    data.shortcut = false;
+    data.weight = weight;
+    data.forward = forward;
+    data.backward = backward;
+    return {source, target, data};
+}
+
+// All pairs shortest paths between the core nodes, indexed by core rank
+std::vector<std::vector<EdgeWeight>> computeCoreDistances(
+    const util::DeallocatingVector<QueryEdge> &edges, const std::vector<bool> &is_core_node)
+{
+    std::vector<std::uint32_t> rank(is_core_node.size(), SPECIAL_NODEID);
+    std::uint32_t number_of_core_nodes = 0;
+    for (std::size_t node = 0; node < is_core_node.size(); ++node)
+    {
+        if (is_core_node[node])
+        {
+            rank[node] = number_of_core_nodes++;
+        }
+    }
+
+    std::vector<std::vector<EdgeWeight>> distances(
+        number_of_core_nodes, std::vector<EdgeWeight>(number_of_core_nodes, INVALID_EDGE_WEIGHT));
+    for (std::uint32_t node = 0; node < number_of_core_nodes; ++node)
+    {
+        distances[node][node] = 0;
+    }
+    for (const auto &edge : edges)
+    {
+        if (!is_core_node[edge.source] || !is_core_node[edge.target])
+        {
+            continue;
+        }
+        const auto source = rank[edge.source];
+        const auto target = rank[edge.target];
+        if (edge.data.forward)
+        {
+            distances[source][target] = std::min(distances[source][target], edge.data.weight);
+        }
+        if (edge.data.backward)
+        {
+            distances[target][source] = std::min(distances[target][source], edge.data.weight);
+        }
+    }
+
+    for (std::uint32_t via = 0; via < number_of_core_nodes; ++via)
+    {
+        for (std::uint32_t from = 0; from < number_of_core_nodes; ++from)
+        {
+            for (std::uint32_t to = 0; to < number_of_core_nodes; ++to)
+            {
+                if (distances[from][via] != INVALID_EDGE_WEIGHT &&
+                    distances[via][to] != INVALID_EDGE_WEIGHT)
+                {
+                    distances[from][to] =
+                        std::min(distances[from][to], distances[from][via] + distances[via][to]);
+                }
+            }
+        }
+    }
+    return distances;
+}
+
+// Landmark ranks, i.e. the core nodes at distance 0 of a landmark
+std::vector<std::uint32_t> getLandmarks(const CoreLandmarks &landmarks)
+{
+    const auto stride = 2 * landmarks.number_of_landmarks;
+    const auto number_of_core_nodes = landmarks.distances.size() / stride;
+    std::vector<std::uint32_t> landmark_ranks;
+    for (std::uint32_t landmark = 0; landmark < landmarks.number_of_landmarks; ++landmark)
+    {
+        for (std::uint32_t rank = 0; rank < number_of_core_nodes; ++rank)
+        {
+            if (landmarks.distances[rank * stride + landmark] == 0)
+            {
+                landmark_ranks.push_back(rank);
+            }
+        }
+    }
+    return landmark_ranks;
+}
+}
+
+BOOST_AUTO_TEST_CASE(distance_tables_match_dijkstra)
+{
+    // spans three buckets of core ranks
+    const NodeID number_of_nodes = 70;
+    std::mt19937 generator(7);
+    std::bernoulli_distribution core_distribution(0.6);
+    std::uniform_int_distribution<NodeID> node_distribution(0, number_of_nodes - 1);
+    std::uniform_int_distribution<int> weight_distribution(1, 100);
+    std::uniform_int_distribution<int> direction_distribution(0, 2);
+
+    std::vector<bool> is_core_node(number_of_nodes);
+    for (NodeID node = 0; node < number_of_nodes; ++node)
+    {
+        is_core_node[node] = core_distribution(generator);
+    }
+
+    util::DeallocatingVector<QueryEdge> edges;
+    for (unsigned index = 0; index < 250; ++index)
+    {
+        const auto source = node_distribution(generator);
+        const auto target = node_distribution(generator);
+        const auto directions = direction_distribution(generator);
+        if (source != target)
+        {
+            edges.push_back(makeEdge(
+                source, target, weight_distribution(generator), directions != 1, directions != 2));
+        }
+    }
+
+    const auto landmarks = ComputeCoreLandmarks(edges, is_core_node, 4);
+    const auto expected = computeCoreDistances(edges, is_core_node);
+    const auto number_of_core_nodes = expected.size();
+
+    // one rank per bucket and the total number of core nodes
+    BOOST_REQUIRE_EQUAL(landmarks.bucket_ranks.size(),
+                        (number_of_nodes + CoreLandmarks::BUCKET_SIZE - 1) /
+                                CoreLandmarks::BUCKET_SIZE +
+                            1);
+    BOOST_CHECK_EQUAL(landmarks.bucket_ranks.back(), number_of_core_nodes);
+    for (std::size_t bucket = 0; bucket + 1 < landmarks.bucket_ranks.size(); ++bucket)
+    {
+        const auto bucket_begin = is_core_node.begin() + bucket * CoreLandmarks::BUCKET_SIZE;
+        const auto bucket_end = std::min(bucket_begin + CoreLandmarks::BUCKET_SIZE,
+                                         is_core_node.end());
+        BOOST_CHECK_EQUAL(landmarks.bucket_ranks[bucket + 1] - landmarks.bucket_ranks[bucket],
+                          std::count(bucket_begin, bucket_end, true));
+    }
+
+    BOOST_REQUIRE_EQUAL(landmarks.number_of_landmarks, 4);
+    const auto stride = 2 * landmarks.number_of_landmarks;
+    BOOST_REQUIRE_EQUAL(landmarks.distances.size(), number_of_core_nodes * stride);
+
+    const auto landmark_ranks = getLandmarks(landmarks);
+    BOOST_REQUIRE_EQUAL(landmark_ranks.size(), landmarks.number_of_landmarks);
+    BOOST_CHECK_EQUAL(std::set<std::uint32_t>(landmark_ranks.begin(), landmark_ranks.end()).size(),
+                      landmark_ranks.size());
+
+    for (std::uint32_t landmark = 0; landmark < landmarks.number_of_landmarks; ++landmark)
+    {
+        const auto landmark_rank = landmark_ranks[landmark];
+        for (std::uint32_t rank = 0; rank < number_of_core_nodes; ++rank)
+        {
+            // first the distances from the landmarks, then the distances to them
+            BOOST_CHECK_EQUAL(landmarks.distances[rank * stride + landmark],
+                              expected[landmark_rank][rank]);
+            BOOST_CHECK_EQUAL(
+                landmarks.distances[rank * stride + landmarks.number_of_landmarks + landmark],
+                expected[rank][landmark_rank]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(farthest_landmarks)
+{
+    // two bidirectional paths 0 - 1 - ... - 9 and 10 - 11 - ... - 19, node 5 is not in the core
+    std::vector<bool> is_core_node(20, true);
+    is_core_node[5] = false;
+    util::DeallocatingVector<QueryEdge> edges;
+    for (NodeID node = 0; node + 1 < 20; ++node)
+    {
+        if (node != 9)
+        {
+            edges.push_back(makeEdge(node, node + 1, 1, true, true));
+        }
+    }
+    // shortcut over the contracted node
+    edges.push_back(makeEdge(4, 6, 2, true, true));
+
+    const auto landmarks = ComputeCoreLandmarks(edges, is_core_node, 3);
+    BOOST_REQUIRE_EQUAL(landmarks.number_of_landmarks, 3);
+    const auto landmark_ranks = getLandmarks(landmarks);
+    BOOST_REQUIRE_EQUAL(landmark_ranks.size(), 3);
+
+    // unreachable nodes count as farthest away: the first landmark is the first node of the
+    // component without rank 0, the second one rank 0 and the third one the far end of its path
+    BOOST_CHECK_EQUAL(landmark_ranks[0], 9);
+    BOOST_CHECK_EQUAL(landmark_ranks[1], 0);
+    BOOST_CHECK_EQUAL(landmark_ranks[2], 8);
+
+    // the components are not connected
+    const auto stride = 2 * landmarks.number_of_landmarks;
+    BOOST_CHECK_EQUAL(landmarks.distances[0 * stride + 0], INVALID_EDGE_WEIGHT);
+    BOOST_CHECK_EQUAL(landmarks.distances[9 * stride + 1], INVALID_EDGE_WEIGHT);
+    BOOST_CHECK_EQUAL(landmarks.distances[18 * stride + 0], 9);
+    // via the shortcut from 4 to 6, which has rank 5
+    BOOST_CHECK_EQUAL(landmarks.distances[8 * stride + 1], 9);
+    BOOST_CHECK_EQUAL(landmarks.distances[5 * stride + 1], 6);
+    BOOST_CHECK_EQUAL(landmarks.distances[5 * stride + 3 + 2], 3);
+}
+
+BOOST_AUTO_TEST_CASE(no_core)
+{
+    util::DeallocatingVector<QueryEdge> edges;
+    edges.push_back(makeEdge(0, 1, 1, true, true));
+
+    const auto landmarks = ComputeCoreLandmarks(edges, std::vector<bool>(2, false), 4);
+    BOOST_CHECK_EQUAL(landmarks.number_of_landmarks, 0);
+    BOOST_CHECK(landmarks.bucket_ranks.empty());
+    BOOST_CHECK(landmarks.distances.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,189 @@
+#include "contractor/graph_contractor.hpp"
+#include "contractor/query_edge.hpp"
+#include "extractor/edge_based_edge.hpp"
+#include "util/deallocating_vector.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/filesystem.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <tuple>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(graph_contractor)
+
+using namespace osrm;
+using namespace osrm::contractor;
+
+namespace
+{
+// grid of width x height nodes with bidirectional edges between horizontal and vertical neighbours
+util::DeallocatingVector<extractor::EdgeBasedEdge> makeGrid(const NodeID width, const NodeID height)
+{
+    util::DeallocatingVector<extractor::EdgeBasedEdge> edges;
+    NodeID edge_id = 0;
+    for (NodeID y = 0; y < height; ++y)
+    {
+        for (NodeID x = 0; x < width; ++x)
+        {
+            const NodeID node = y * width + x;
+            if (x + 1 < width)
+            {
+                edges.push_back({node, node + 1, edge_id++, 1 + (x * y) % 7, true, true});
+            }
+            if (y + 1 < height)
+            {
+                edges.push_back({node, node + width, edge_id++, 1 + (x + y) % 5, true, true});
+            }
+        }
+    }
+    return edges;
+}
+
+std::vector<std::tuple<NodeID, NodeID, int, NodeID, bool, bool, bool>>
+normalize(const util::DeallocatingVector<QueryEdge> &edges)
+{
+    std::vector<std::tuple<NodeID, NodeID, int, NodeID, bool, bool, bool>> result;
+    for (const auto &edge : edges)
+    {
+        result.emplace_back(edge.source,
+                            edge.target,
+                            static_cast<int>(edge.data.weight),
+                            static_cast<NodeID>(edge.data.id),
+                            static_cast<bool>(edge.data.shortcut),
+                            static_cast<bool>(edge.data.forward),
+                            static_cast<bool>(edge.data.backward));
+    }
+    std::sort(result.begin(), result.end());
+    return result;
+}
+}
+
+BOOST_AUTO_TEST_CASE(resume_from_checkpoint)
+{
+    const NodeID width = 20;
+    const NodeID height = 20;
+    const auto checkpoint_path =
+        (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path())
+            .string();
+
+    util::DeallocatingVector<QueryEdge> expected_edges;
+    {
+        auto input_edges = makeGrid(width, height);
+        GraphContractor contractor(
+            width * height, input_edges, {}, std::vector<EdgeWeight>(width * height, 1));
+        // checkpoint after every round, the last one holds the final state
+        contractor.SetCheckpointing(checkpoint_path, 1e-9, false);
+        contractor.Run();
+        contractor.GetEdges(expected_edges);
+    }
+    BOOST_REQUIRE(boost::filesystem::exists(checkpoint_path));
+
+    util::DeallocatingVector<QueryEdge> resumed_edges;
+    {
+        auto input_edges = makeGrid(width, height);
+        GraphContractor contractor(
+            width * height, input_edges, {}, std::vector<EdgeWeight>(width * height, 1));
+        contractor.SetCheckpointing(checkpoint_path, 0, true);
+        contractor.Run();
+        contractor.GetEdges(resumed_edges);
+    }
+    boost::filesystem::remove(checkpoint_path);
+
+    const auto expected = normalize(expected_edges);
+    const auto resumed = normalize(resumed_edges);
+    BOOST_CHECK_EQUAL(expected.size(), resumed.size());
+    BOOST_CHECK(expected == resumed);
+}
+
+BOOST_AUTO_TEST_CASE(resume_mid_contraction)
+{
+    const NodeID width = 20;
+    const NodeID height = 20;
+    const auto checkpoint_path =
+        (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path())
+            .string();
+
+    util::DeallocatingVector<QueryEdge> expected_edges;
+    {
+        auto input_edges = makeGrid(width, height);
+        GraphContractor contractor(
+            width * height, input_edges, {}, std::vector<EdgeWeight>(width * height, 1));
+        contractor.Run();
+        contractor.GetEdges(expected_edges);
+    }
+    const auto expected = normalize(expected_edges);
+
+    // before and after the contractor flushed contracted nodes out of the graph
+    for (const unsigned stop_level : {1, 10, 20, 40})
+    {
+        {
+            auto input_edges = makeGrid(width, height);
+            GraphContractor contractor(
+                width * height, input_edges, {}, std::vector<EdgeWeight>(width * height, 1));
+            contractor.SetCheckpointing(checkpoint_path, 0, false);
+            contractor.StopAfterLevel(stop_level);
+            contractor.Run();
+        }
+        BOOST_REQUIRE(boost::filesystem::exists(checkpoint_path));
+
+        util::DeallocatingVector<QueryEdge> resumed_edges;
+        {
+            auto input_edges = makeGrid(width, height);
+            GraphContractor contractor(
+                width * height, input_edges, {}, std::vector<EdgeWeight>(width * height, 1));
+            contractor.SetCheckpointing(checkpoint_path, 0, true);
+            contractor.Run();
+            contractor.GetEdges(resumed_edges);
+        }
+        boost::filesystem::remove(checkpoint_path);
+
+        const auto resumed = normalize(resumed_edges);
+        BOOST_CHECK_EQUAL(expected.size(), resumed.size());
+        BOOST_CHECK(expected == resumed);
+    }
+}
+
+BOOST_AUTO_TEST_CASE(resume_rejects_other_graph)
+{
+    const auto checkpoint_path =
+        (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path())
+            .string();
+    {
+        auto input_edges = makeGrid(10, 10);
+        GraphContractor contractor(10 * 10, input_edges, {}, std::vector<EdgeWeight>(10 * 10, 1));
+        contractor.SetCheckpointing(checkpoint_path, 1e-9, false);
+        contractor.Run();
+    }
+
+    auto input_edges = makeGrid(10, 11);
+    GraphContractor contractor(10 * 11, input_edges, {}, std::vector<EdgeWeight>(10 * 11, 1));
+    contractor.SetCheckpointing(checkpoint_path, 0, true);
+    BOOST_CHECK_THROW(contractor.Run(), util::exception);
+    boost::filesystem::remove(checkpoint_path);
+}
+
+BOOST_AUTO_TEST_CASE(resume_rejects_other_weights)
+{
+    const auto checkpoint_path =
+        (boost::filesystem::temp_directory_path() / boost::filesystem::unique_path())
+            .string();
+    {
+        auto input_edges = makeGrid(10, 10);
+        GraphContractor contractor(10 * 10, input_edges, {}, std::vector<EdgeWeight>(10 * 10, 1));
+        contractor.SetCheckpointing(checkpoint_path, 0, false);
+        contractor.StopAfterLevel(1);
+        contractor.Run();
+    }
+
+    // same number of nodes and edges, one edge got slower
+    auto input_edges = makeGrid(10, 10);
+    input_edges[0].weight += 5;
+    GraphContractor contractor(10 * 10, input_edges, {}, std::vector<EdgeWeight>(10 * 10, 1));
+    contractor.SetCheckpointing(checkpoint_path, 0, true);
+    BOOST_CHECK_THROW(contractor.Run(), util::exception);
+    boost::filesystem::remove(checkpoint_path);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
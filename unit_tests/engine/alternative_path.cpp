@@ -0,0 +1,279 @@
+#include "engine/datafacade/datafacade_base.hpp"
+#include "engine/routing_algorithms/alternative_path.hpp"
+#include "engine/search_engine_data.hpp"
+
+#include "mocks/mock_datafacade.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <set>
+#include <utility>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(alternative_path)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+// Grid of `rows` long streets that are connected by short streets at every column. The graph is
+// not contracted: every node is at the same level and keeps all of its edges, which the
+// bidirectional searches handle like plain Dijkstra.
+class GridDataFacade final : public test::MockDataFacade
+{
+  public:
+    static const constexpr EdgeWeight HORIZONTAL_WEIGHT = 100;
+    static const constexpr EdgeWeight VERTICAL_WEIGHT = 5;
+
+    GridDataFacade(const unsigned rows, const unsigned columns)
+        : number_of_nodes(rows * columns), first_edges(number_of_nodes + 1, 0)
+    {
+        std::vector<std::vector<Edge>> adjacency(number_of_nodes);
+        const auto connect = [&](const NodeID from, const NodeID to, const EdgeWeight weight) {
+            // every direction is an original edge of its own
+            const EdgeID forward_id = original_edges.size();
+            original_edges.push_back({from, to, weight});
+            const EdgeID backward_id = original_edges.size();
+            original_edges.push_back({to, from, weight});
+
+            adjacency[from].push_back({to, makeData(forward_id, weight, true)});
+            adjacency[from].push_back({to, makeData(backward_id, weight, false)});
+            adjacency[to].push_back({from, makeData(backward_id, weight, true)});
+            adjacency[to].push_back({from, makeData(forward_id, weight, false)});
+        };
+        for (unsigned row = 0; row < rows; ++row)
+        {
+            for (unsigned column = 0; column < columns; ++column)
+            {
+                const NodeID node = row * columns + column;
+                if (column + 1 < columns)
+                    connect(node, node + 1, HORIZONTAL_WEIGHT);
+                if (row + 1 < rows)
+                    connect(node, node + columns, VERTICAL_WEIGHT);
+            }
+        }
+
+        for (NodeID node = 0; node < number_of_nodes; ++node)
+        {
+            first_edges[node + 1] = first_edges[node] + adjacency[node].size();
+            for (const auto &edge : adjacency[node])
+            {
+                targets.push_back(edge.target);
+                edge_data.push_back(edge.data);
+                search_data.push_back({edge.data.weight, edge.data.forward, edge.data.backward});
+            }
+        }
+    }
+
+    unsigned GetNumberOfNodes() const override { return number_of_nodes; }
+    unsigned GetNumberOfEdges() const override { return targets.size(); }
+    NodeID GetTarget(const EdgeID edge) const override { return targets[edge]; }
+    EdgeData GetEdgeData(const EdgeID edge) const override { return edge_data[edge]; }
+    const EdgeSearchData &GetEdgeSearchData(const EdgeID edge) const override
+    {
+        return search_data[edge];
+    }
+    datafacade::EdgeRange GetAdjacentEdgeRange(const NodeID node) const override
+    {
+        return util::irange<EdgeID>(first_edges[node], first_edges[node + 1]);
+    }
+
+    EdgeID FindEdgeInEitherDirection(const NodeID from, const NodeID to) const override
+    {
+        for (const auto edge : GetAdjacentEdgeRange(from))
+        {
+            if (targets[edge] == to)
+                return edge;
+        }
+        return SPECIAL_EDGEID;
+    }
+    EdgeID FindSmallestEdge(const NodeID from,
+                            const NodeID to,
+                            const std::function<bool(EdgeData)> filter) const override
+    {
+        EdgeID smallest_edge = SPECIAL_EDGEID;
+        for (const auto edge : GetAdjacentEdgeRange(from))
+        {
+            if (targets[edge] == to && filter(edge_data[edge]) &&
+                (smallest_edge == SPECIAL_EDGEID ||
+                 edge_data[edge].weight < edge_data[smallest_edge].weight))
+            {
+                smallest_edge = edge;
+            }
+        }
+        return smallest_edge;
+    }
+
+    // every original edge is a single segment ending at the node it leads to
+    void GetOriginalEdgeSequence(const std::vector<EdgeID> &edge_ids,
+                                 datafacade::OriginalEdgeSequence &sequence) const override
+    {
+        test::MockDataFacade::GetOriginalEdgeSequence(edge_ids, sequence);
+        for (std::size_t index = 0; index < edge_ids.size(); ++index)
+        {
+            sequence.segment_nodes[index] = original_edges[edge_ids[index]].to;
+            sequence.segment_weights[index] = original_edges[edge_ids[index]].weight;
+        }
+    }
+
+  private:
+    struct OriginalEdge
+    {
+        NodeID from;
+        NodeID to;
+        EdgeWeight weight;
+    };
+
+    struct Edge
+    {
+        NodeID target;
+        EdgeData data;
+    };
+
+    static EdgeData makeData(const EdgeID id, const EdgeWeight weight, const bool forward)
+    {
+        EdgeData data;
+        data.id = id;
+        data.shortcut = false;
+        data.weight = weight;
+        data.forward = forward;
+        data.backward = !forward;
+        return data;
+    }
+
+    unsigned number_of_nodes;
+    std::vector<EdgeID> first_edges;
+    std::vector<NodeID> targets;
+    std::vector<EdgeData> edge_data;
+    std::vector<EdgeSearchData> search_data;
+    std::vector<OriginalEdge> original_edges;
+};
+
+PhantomNode makePhantom(const NodeID node)
+{
+    PhantomNode phantom;
+    phantom.forward_segment_id = {node, true};
+    phantom.reverse_segment_id = {SPECIAL_SEGMENTID, false};
+    phantom.forward_weight = 0;
+    phantom.forward_offset = 0;
+    phantom.fwd_segment_position = 0;
+    phantom.packed_geometry_id = node;
+    return phantom;
+}
+
+// Nodes of an unpacked route, starting with the source
+std::vector<NodeID> getNodes(const NodeID source, const std::vector<PathData> &path)
+{
+    std::vector<NodeID> nodes = {source};
+    for (const auto &data : path)
+    {
+        nodes.push_back(data.turn_via_node);
+    }
+    return nodes;
+}
+
+// Weight of the streets two routes both use in the same direction
+EdgeWeight computeSharing(const std::vector<NodeID> &route, const std::vector<NodeID> &other_route)
+{
+    std::set<std::pair<NodeID, NodeID>> other_edges;
+    for (std::size_t index = 1; index < other_route.size(); ++index)
+    {
+        other_edges.emplace(other_route[index - 1], other_route[index]);
+    }
+
+    EdgeWeight sharing = 0;
+    for (std::size_t index = 1; index < route.size(); ++index)
+    {
+        if (other_edges.count({route[index - 1], route[index]}) > 0)
+        {
+            // the grid has long streets between the columns and short ones between the rows
+            const bool is_horizontal = route[index] == route[index - 1] + 1 ||
+                                       route[index - 1] == route[index] + 1;
+            sharing += is_horizontal ? GridDataFacade::HORIZONTAL_WEIGHT
+                                     : GridDataFacade::VERTICAL_WEIGHT;
+        }
+    }
+    return sharing;
+}
+}
+
+BOOST_AUTO_TEST_CASE(alternatives_are_diverse)
+{
+    // 5 rows of 8 columns, the route runs along the middle row
+    const unsigned rows = 5;
+    const unsigned columns = 8;
+    const GridDataFacade facade(rows, columns);
+    const datafacade::BaseDataFacade &base_facade = facade;
+    SearchEngineData engine_working_data;
+    routing_algorithms::AlternativeRouting<datafacade::BaseDataFacade> alternatives(
+        engine_working_data);
+
+    const NodeID source = 2 * columns;
+    const NodeID target = 2 * columns + columns - 1;
+    const PhantomNodes phantoms{makePhantom(source), makePhantom(target)};
+
+    std::vector<std::vector<std::vector<NodeID>>> routes_by_number;
+    for (const unsigned number_of_alternatives : {0, 1, 2, 3, 4})
+    {
+        InternalRouteResult result;
+        alternatives(base_facade, phantoms, number_of_alternatives, result);
+
+        const auto shortest_length = (columns - 1) * GridDataFacade::HORIZONTAL_WEIGHT;
+        BOOST_REQUIRE_EQUAL(result.shortest_path_length, shortest_length);
+        BOOST_REQUIRE_EQUAL(result.unpacked_path_segments.size(), 1);
+        const auto shortest_route = getNodes(source, result.unpacked_path_segments.front());
+        BOOST_CHECK_EQUAL(shortest_route.size(), columns);
+        BOOST_CHECK_EQUAL(shortest_route.back(), target);
+
+        BOOST_CHECK_LE(result.unpacked_alternatives.size(), number_of_alternatives);
+        BOOST_REQUIRE_EQUAL(result.alternative_path_lengths.size(),
+                            result.unpacked_alternatives.size());
+
+        const auto maximum_allowed_sharing =
+            static_cast<EdgeWeight>(shortest_length * routing_algorithms::VIAPATH_GAMMA);
+        std::vector<std::vector<NodeID>> routes;
+        for (std::size_t index = 0; index < result.unpacked_alternatives.size(); ++index)
+        {
+            const auto route = getNodes(source, result.unpacked_alternatives[index]);
+            BOOST_CHECK_EQUAL(route.back(), target);
+            BOOST_CHECK_GT(result.alternative_path_lengths[index], shortest_length);
+            BOOST_CHECK_LE(result.alternative_path_lengths[index],
+                           shortest_length * (1 + routing_algorithms::VIAPATH_EPSILON));
+            BOOST_CHECK_LE(computeSharing(route, shortest_route), maximum_allowed_sharing);
+
+            // every alternative shares at most VIAPATH_GAMMA with each of the earlier ones and
+            // leaves all of them somewhere, since its via node is on none of them
+            for (const auto &earlier_route : routes)
+            {
+                BOOST_CHECK_LE(computeSharing(route, earlier_route), maximum_allowed_sharing);
+            }
+            const auto is_new_node = [&routes](const NodeID node) {
+                return std::none_of(
+                    routes.begin(), routes.end(), [node](const std::vector<NodeID> &earlier) {
+                        return std::find(earlier.begin(), earlier.end(), node) != earlier.end();
+                    });
+            };
+            const bool has_new_node = std::any_of(route.begin(), route.end(), is_new_node);
+            BOOST_CHECK(has_new_node);
+            routes.push_back(route);
+        }
+        routes_by_number.push_back(std::move(routes));
+    }
+
+    // the parallel streets next to the middle row and the outer rows are alternatives
+    BOOST_CHECK_EQUAL(routes_by_number[1].size(), 1);
+    BOOST_CHECK_GE(routes_by_number[4].size(), 2);
+
+    // asking for more alternatives only appends to the ones selected before
+    for (std::size_t number = 1; number < routes_by_number.size(); ++number)
+    {
+        const auto &fewer = routes_by_number[number - 1];
+        const auto &more = routes_by_number[number];
+        BOOST_REQUIRE_LE(fewer.size(), more.size());
+        BOOST_CHECK(std::equal(fewer.begin(), fewer.end(), more.begin()));
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
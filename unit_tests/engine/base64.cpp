@@ -36,6 +36,26 @@ BOOST_AUTO_TEST_CASE(rfc4648_test_vectors_roundtrip)
     BOOST_CHECK_EQUAL(decodeBase64(encodeBase64("foobar")), "foobar");
 }
 
+BOOST_AUTO_TEST_CASE(url_safe_alphabet)
+{
+    using namespace osrm::engine;
+
+    BOOST_CHECK_EQUAL(decodeBase64("-_-_"), decodeBase64("+/+/"));
+    BOOST_CHECK_EQUAL(decodeBase64("-_-_"), "\xfb\xff\xbf");
+    BOOST_CHECK_EQUAL(decodeBase64("Zm9vYmE"), "fooba");
+    BOOST_CHECK_EQUAL(decodeBase64(""), "");
+}
+
+BOOST_AUTO_TEST_CASE(invalid_input)
+{
+    using namespace osrm::engine;
+
+    BOOST_CHECK_THROW(decodeBase64("Zm9v!mFy"), osrm::util::exception);
+    BOOST_CHECK_THROW(decodeBase64("Zm9vY"), osrm::util::exception);
+    BOOST_CHECK_THROW(decodeBase64("Zm9 "), osrm::util::exception);
+    BOOST_CHECK_THROW(decodeBase64(std::string("Zm\0v", 4)), osrm::util::exception);
+}
+
 BOOST_AUTO_TEST_CASE(hint_encoding_decoding_roundtrip)
 {
     using namespace osrm::engine;
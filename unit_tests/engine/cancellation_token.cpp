@@ -0,0 +1,215 @@
+#include "engine/cancellation_token.hpp"
+#include "engine/datafacade/datafacade_base.hpp"
+#include "engine/routing_algorithms/alternative_path.hpp"
+#include "engine/routing_algorithms/many_to_many.hpp"
+#include "engine/routing_algorithms/shortest_path.hpp"
+#include "engine/search_engine_data.hpp"
+
+#include "mocks/mock_datafacade.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstdint>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(cancellation_token)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+RequestCancelled::Reason getReason(const CancellationToken &token)
+{
+    try
+    {
+        token.ThrowIfCancelled();
+    }
+    catch (const RequestCancelled &cancelled)
+    {
+        return cancelled.GetReason();
+    }
+    BOOST_FAIL("expected a RequestCancelled");
+    return RequestCancelled::Reason::Cancelled;
+}
+}
+
+BOOST_AUTO_TEST_CASE(cancelled_tokens)
+{
+    CancellationToken token;
+    BOOST_CHECK_NO_THROW(token.ThrowIfCancelled());
+    token.Cancel();
+    BOOST_CHECK(getReason(token) == RequestCancelled::Reason::Cancelled);
+
+    const CancellationToken expired_token(CancellationToken::Clock::now());
+    BOOST_CHECK(getReason(expired_token) == RequestCancelled::Reason::DeadlineExceeded);
+
+    bool connection_closed = false;
+    const CancellationToken checked_token(CancellationToken::Clock::time_point::max(),
+                                          [&connection_closed] { return connection_closed; });
+    BOOST_CHECK_NO_THROW(checked_token.ThrowIfCancelled());
+    connection_closed = true;
+    BOOST_CHECK(getReason(checked_token) == RequestCancelled::Reason::Cancelled);
+    // stays cancelled without asking again
+    connection_closed = false;
+    BOOST_CHECK(getReason(checked_token) == RequestCancelled::Reason::Cancelled);
+}
+
+BOOST_AUTO_TEST_CASE(searches_check_the_token_of_their_thread)
+{
+    const CancellationCheck check_cancellation;
+    const auto pop = [&check_cancellation](const std::uint32_t number_of_pops) {
+        for (std::uint32_t pops = 0; pops < number_of_pops; ++pops)
+        {
+            check_cancellation();
+        }
+    };
+
+    // no token outside of a scope
+    BOOST_CHECK_NO_THROW(pop(2 * CancellationToken::CHECK_INTERVAL));
+
+    CancellationToken token;
+    {
+        const CancellationScope scope(token);
+        BOOST_CHECK_NO_THROW(pop(2 * CancellationToken::CHECK_INTERVAL));
+
+        token.Cancel();
+        BOOST_CHECK_THROW(CancellationScope::Check(), RequestCancelled);
+        BOOST_CHECK_THROW(pop(CancellationToken::CHECK_INTERVAL), RequestCancelled);
+
+        const CancellationToken other_token;
+        {
+            const CancellationScope nested_scope(other_token);
+            BOOST_CHECK_NO_THROW(pop(2 * CancellationToken::CHECK_INTERVAL));
+        }
+        BOOST_CHECK_THROW(pop(CancellationToken::CHECK_INTERVAL), RequestCancelled);
+    }
+    BOOST_CHECK_NO_THROW(pop(2 * CancellationToken::CHECK_INTERVAL));
+}
+
+namespace
+{
+// Chain 0 -> 1 -> ... -> n-1 with unit weights, every search on it pops about n nodes
+class ChainDataFacade final : public test::MockDataFacade
+{
+  public:
+    explicit ChainDataFacade(const unsigned number_of_nodes) : number_of_nodes(number_of_nodes)
+    {
+        // node n has the forward edge 2n to n+1 and the backward edge 2n+1 to n-1
+        for (NodeID node = 0; node < number_of_nodes; ++node)
+        {
+            const bool has_next = node + 1 < number_of_nodes;
+            const bool has_previous = node > 0;
+            targets.push_back(has_next ? node + 1 : node);
+            targets.push_back(has_previous ? node - 1 : node);
+            search_data.push_back({1, has_next, false});
+            search_data.push_back({1, false, has_previous});
+        }
+    }
+
+    unsigned GetNumberOfNodes() const override { return number_of_nodes; }
+    unsigned GetNumberOfEdges() const override { return 2 * number_of_nodes; }
+    NodeID GetTarget(const EdgeID edge) const override { return targets[edge]; }
+    EdgeData GetEdgeData(const EdgeID edge) const override
+    {
+        EdgeData data;
+        data.id = edge / 2;
+        data.weight = search_data[edge].weight;
+        data.forward = search_data[edge].forward;
+        data.backward = search_data[edge].backward;
+        return data;
+    }
+    const EdgeSearchData &GetEdgeSearchData(const EdgeID edge) const override
+    {
+        return search_data[edge];
+    }
+    datafacade::EdgeRange GetAdjacentEdgeRange(const NodeID node) const override
+    {
+        return util::irange<EdgeID>(2 * node, 2 * node + 2);
+    }
+
+  private:
+    unsigned number_of_nodes;
+    std::vector<NodeID> targets;
+    std::vector<EdgeSearchData> search_data;
+};
+
+PhantomNode makePhantom(const NodeID node)
+{
+    PhantomNode phantom;
+    phantom.forward_segment_id = {node, true};
+    phantom.forward_weight = 0;
+    phantom.forward_offset = 0;
+    return phantom;
+}
+
+const constexpr unsigned CHAIN_LENGTH = 8 * CancellationToken::CHECK_INTERVAL;
+
+// Token that lets the first look at it pass and cancels the query on the second one, so it is
+// only cancelled if the search checks it repeatedly while running
+struct CancelOnSecondCheck
+{
+    CancelOnSecondCheck()
+        : token(CancellationToken::Clock::time_point::max(), [this] { return ++checks >= 2; })
+    {
+    }
+
+    unsigned checks = 0;
+    CancellationToken token;
+};
+}
+
+BOOST_AUTO_TEST_CASE(searches_are_cancelled_while_running)
+{
+    const ChainDataFacade facade(CHAIN_LENGTH);
+    const datafacade::BaseDataFacade &base_facade = facade;
+    SearchEngineData engine_working_data;
+
+    using ShortestPathRouting = routing_algorithms::ShortestPathRouting<datafacade::BaseDataFacade>;
+    const ShortestPathRouting shortest_path(engine_working_data);
+    const routing_algorithms::BasicRoutingInterface<datafacade::BaseDataFacade,
+                                                    ShortestPathRouting> &routing = shortest_path;
+    const auto search = [&] {
+        engine_working_data.InitializeOrClearFirstThreadLocalStorage(CHAIN_LENGTH);
+        auto &forward_heap = *engine_working_data.forward_heap_1;
+        auto &reverse_heap = *engine_working_data.reverse_heap_1;
+        forward_heap.Insert(0, 0, 0);
+        reverse_heap.Insert(CHAIN_LENGTH - 1, 0, CHAIN_LENGTH - 1);
+        std::int32_t weight = INVALID_EDGE_WEIGHT;
+        std::vector<NodeID> packed_path;
+        routing.Search(base_facade, forward_heap, reverse_heap, weight, packed_path, false, false);
+        return weight;
+    };
+    BOOST_CHECK_EQUAL(search(), CHAIN_LENGTH - 1);
+    {
+        CancelOnSecondCheck cancel;
+        const CancellationScope scope(cancel.token);
+        BOOST_CHECK_THROW(search(), RequestCancelled);
+        BOOST_CHECK_EQUAL(cancel.checks, 2);
+    }
+
+    routing_algorithms::ManyToManyRouting<datafacade::BaseDataFacade> many_to_many(
+        engine_working_data);
+    const std::vector<PhantomNode> phantoms = {makePhantom(0), makePhantom(CHAIN_LENGTH - 1)};
+    const auto table = [&] { return many_to_many(base_facade, phantoms, {0}, {1}); };
+    BOOST_CHECK_EQUAL(table().front(), CHAIN_LENGTH - 1);
+    {
+        CancelOnSecondCheck cancel;
+        const CancellationScope scope(cancel.token);
+        BOOST_CHECK_THROW(table(), RequestCancelled);
+        BOOST_CHECK_EQUAL(cancel.checks, 2);
+    }
+
+    routing_algorithms::AlternativeRouting<datafacade::BaseDataFacade> alternatives(
+        engine_working_data);
+    {
+        CancelOnSecondCheck cancel;
+        const CancellationScope scope(cancel.token);
+        InternalRouteResult result;
+        BOOST_CHECK_THROW(alternatives(base_facade, {phantoms[0], phantoms[1]}, 1, result),
+                          RequestCancelled);
+        BOOST_CHECK_EQUAL(cancel.checks, 2);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,329 @@
+#include "engine/core_landmark_potential.hpp"
+#include "contractor/core_landmarks.hpp"
+#include "contractor/query_edge.hpp"
+#include "engine/datafacade/datafacade_base.hpp"
+#include "engine/routing_algorithms/shortest_path.hpp"
+#include "engine/search_engine_data.hpp"
+#include "util/deallocating_vector.hpp"
+
+#include "mocks/mock_datafacade.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <queue>
+#include <random>
+#include <tuple>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(core_landmark_potential)
+
+using namespace osrm;
+using namespace osrm::engine;
+using contractor::QueryEdge;
+
+namespace
+{
+const constexpr unsigned GRID_SIZE = 8;
+const constexpr unsigned NUMBER_OF_NODES = GRID_SIZE * GRID_SIZE;
+
+// Grid with different weights in both directions of a street. The nodes with an even x + y
+// are contracted, all others form the core.
+struct Grid
+{
+    Grid()
+    {
+        std::mt19937 generator(13);
+        std::uniform_int_distribution<EdgeWeight> weight_distribution(1, 20);
+
+        neighbours.resize(NUMBER_OF_NODES);
+        const auto connect = [&](const NodeID from, const NodeID to) {
+            neighbours[from].emplace_back(to, weight_distribution(generator));
+            neighbours[to].emplace_back(from, weight_distribution(generator));
+        };
+        for (unsigned y = 0; y < GRID_SIZE; ++y)
+        {
+            for (unsigned x = 0; x < GRID_SIZE; ++x)
+            {
+                if (x + 1 < GRID_SIZE)
+                    connect(y * GRID_SIZE + x, y * GRID_SIZE + x + 1);
+                if (y + 1 < GRID_SIZE)
+                    connect(y * GRID_SIZE + x, (y + 1) * GRID_SIZE + x);
+                is_core_node.push_back((x + y) % 2 == 1);
+            }
+        }
+    }
+
+    EdgeWeight GetWeight(const NodeID from, const NodeID to) const
+    {
+        for (const auto &neighbour : neighbours[from])
+        {
+            if (neighbour.first == to)
+                return neighbour.second;
+        }
+        return INVALID_EDGE_WEIGHT;
+    }
+
+    // The contracted nodes only border core nodes and keep their edges, the core nodes are
+    // connected by shortcuts over the contracted nodes
+    util::DeallocatingVector<QueryEdge> Contract() const
+    {
+        util::DeallocatingVector<QueryEdge> edges;
+        const auto add_edge = [&edges](const NodeID source,
+                                       const NodeID target,
+                                       const EdgeWeight weight,
+                                       const NodeID id,
+                                       const bool shortcut,
+                                       const bool forward) {
+            QueryEdge::EdgeData data;
+            data.id = id;
+            data.shortcut = shortcut;
+            data.weight = weight;
+            data.forward = forward;
+            data.backward = !forward;
+            edges.push_back({source, target, data});
+        };
+
+        for (NodeID node = 0; node < NUMBER_OF_NODES; ++node)
+        {
+            if (is_core_node[node])
+                continue;
+
+            for (const auto &neighbour : neighbours[node])
+            {
+                add_edge(node, neighbour.first, neighbour.second, node, false, true);
+                const auto backward_weight = GetWeight(neighbour.first, node);
+                add_edge(node, neighbour.first, backward_weight, node, false, false);
+            }
+
+            for (const auto &from : neighbours[node])
+            {
+                for (const auto &to : neighbours[node])
+                {
+                    if (from.first == to.first)
+                        continue;
+                    const auto weight = GetWeight(from.first, node) + to.second;
+                    add_edge(from.first, to.first, weight, node, true, true);
+                    add_edge(to.first, from.first, weight, node, true, false);
+                }
+            }
+        }
+        return edges;
+    }
+
+    // Plain Dijkstra on the uncontracted grid
+    std::vector<EdgeWeight> Distances(const NodeID source, const bool forward) const
+    {
+        using QueueEntry = std::pair<EdgeWeight, NodeID>;
+        std::priority_queue<QueueEntry, std::vector<QueueEntry>, std::greater<QueueEntry>> queue;
+        std::vector<EdgeWeight> distances(NUMBER_OF_NODES, INVALID_EDGE_WEIGHT);
+        distances[source] = 0;
+        queue.emplace(0, source);
+        while (!queue.empty())
+        {
+            const auto weight = queue.top().first;
+            const auto node = queue.top().second;
+            queue.pop();
+            if (weight > distances[node])
+                continue;
+            for (const auto &neighbour : neighbours[node])
+            {
+                const auto to_weight =
+                    weight + (forward ? neighbour.second : GetWeight(neighbour.first, node));
+                if (to_weight < distances[neighbour.first])
+                {
+                    distances[neighbour.first] = to_weight;
+                    queue.emplace(to_weight, neighbour.first);
+                }
+            }
+        }
+        return distances;
+    }
+
+    std::vector<std::vector<std::pair<NodeID, EdgeWeight>>> neighbours;
+    std::vector<bool> is_core_node;
+};
+
+class CoreGridDataFacade final : public test::MockDataFacade
+{
+  public:
+    CoreGridDataFacade(const Grid &grid, const unsigned number_of_landmarks)
+        : is_core_node(grid.is_core_node)
+    {
+        const auto edges = grid.Contract();
+        landmarks = contractor::ComputeCoreLandmarks(edges, is_core_node, number_of_landmarks);
+
+        for (const auto &edge : edges)
+        {
+            sorted_edges.push_back(edge);
+        }
+        std::stable_sort(sorted_edges.begin(),
+                         sorted_edges.end(),
+                         [](const QueryEdge &lhs, const QueryEdge &rhs) {
+                             return lhs.source < rhs.source;
+                         });
+        first_edges.resize(NUMBER_OF_NODES + 1, 0);
+        for (const auto &edge : sorted_edges)
+        {
+            ++first_edges[edge.source + 1];
+            search_data.push_back({edge.data.weight, edge.data.forward, edge.data.backward});
+        }
+        std::partial_sum(first_edges.begin(), first_edges.end(), first_edges.begin());
+
+        NodeID rank = 0;
+        for (NodeID node = 0; node < NUMBER_OF_NODES; ++node)
+        {
+            core_ranks.push_back(is_core_node[node] ? rank++ : SPECIAL_NODEID);
+        }
+    }
+
+    void UseLandmarks(const bool use_landmarks_) { use_landmarks = use_landmarks_; }
+
+    unsigned GetNumberOfNodes() const override { return NUMBER_OF_NODES; }
+    unsigned GetNumberOfEdges() const override { return sorted_edges.size(); }
+    NodeID GetTarget(const EdgeID edge) const override { return sorted_edges[edge].target; }
+    EdgeData GetEdgeData(const EdgeID edge) const override { return sorted_edges[edge].data; }
+    const EdgeSearchData &GetEdgeSearchData(const EdgeID edge) const override
+    {
+        return search_data[edge];
+    }
+    datafacade::EdgeRange GetAdjacentEdgeRange(const NodeID node) const override
+    {
+        return util::irange<EdgeID>(first_edges[node], first_edges[node + 1]);
+    }
+
+    bool IsCoreNode(const NodeID id) const override { return is_core_node[id]; }
+    std::size_t GetCoreSize() const override
+    {
+        return std::count(is_core_node.begin(), is_core_node.end(), true);
+    }
+    unsigned GetNumberOfCoreLandmarks() const override
+    {
+        return use_landmarks ? landmarks.number_of_landmarks : 0;
+    }
+    const EdgeWeight *GetCoreLandmarkDistances(const NodeID id) const override
+    {
+        BOOST_REQUIRE(is_core_node[id]);
+        return &landmarks.distances[core_ranks[id] * 2 * landmarks.number_of_landmarks];
+    }
+
+  private:
+    std::vector<bool> is_core_node;
+    std::vector<NodeID> core_ranks;
+    contractor::CoreLandmarks landmarks;
+    std::vector<QueryEdge> sorted_edges;
+    std::vector<EdgeID> first_edges;
+    std::vector<EdgeSearchData> search_data;
+    bool use_landmarks = true;
+};
+}
+
+BOOST_AUTO_TEST_CASE(potential_is_a_lower_bound)
+{
+    const Grid grid;
+    const CoreGridDataFacade facade(grid, 4);
+
+    std::vector<NodeID> core_nodes;
+    for (NodeID node = 0; node < NUMBER_OF_NODES; ++node)
+    {
+        if (grid.is_core_node[node])
+            core_nodes.push_back(node);
+    }
+
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<std::size_t> node_distribution(0, core_nodes.size() - 1);
+    std::uniform_int_distribution<EdgeWeight> weight_distribution(0, 30);
+    std::uniform_int_distribution<unsigned> size_distribution(1, 4);
+    using Potential = CoreLandmarkPotential<CoreGridDataFacade>;
+
+    for (unsigned round = 0; round < 50; ++round)
+    {
+        std::vector<Potential::CoreEntryPoint> entry_points;
+        const auto number_of_entry_points = size_distribution(generator);
+        for (unsigned index = 0; index < number_of_entry_points; ++index)
+        {
+            const auto node = core_nodes[node_distribution(generator)];
+            entry_points.emplace_back(node, weight_distribution(generator), node);
+        }
+
+        for (const bool forward : {true, false})
+        {
+            // the forward potential bounds the weight to the (reverse) entry points, the
+            // reverse potential the weight from the (forward) entry points
+            std::vector<EdgeWeight> remaining(NUMBER_OF_NODES, INVALID_EDGE_WEIGHT);
+            for (const auto &entry_point : entry_points)
+            {
+                const auto distances = grid.Distances(std::get<0>(entry_point), !forward);
+                for (NodeID node = 0; node < NUMBER_OF_NODES; ++node)
+                {
+                    remaining[node] =
+                        std::min(remaining[node], distances[node] + std::get<1>(entry_point));
+                }
+            }
+
+            const Potential potential(facade, entry_points, forward);
+            for (const auto node : core_nodes)
+            {
+                const auto bound = potential(node);
+                BOOST_CHECK_NE(bound, INVALID_EDGE_WEIGHT);
+                BOOST_CHECK_LE(bound, remaining[node]);
+            }
+            for (const auto &entry_point : entry_points)
+            {
+                BOOST_CHECK_LE(potential(std::get<0>(entry_point)), std::get<1>(entry_point));
+            }
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(core_alt_matches_core_search)
+{
+    const Grid grid;
+    CoreGridDataFacade facade(grid, 4);
+    const datafacade::BaseDataFacade &base_facade = facade;
+    SearchEngineData engine_working_data;
+
+    using ShortestPathRouting = routing_algorithms::ShortestPathRouting<datafacade::BaseDataFacade>;
+    const ShortestPathRouting shortest_path(engine_working_data);
+    const routing_algorithms::BasicRoutingInterface<datafacade::BaseDataFacade,
+                                                    ShortestPathRouting> &routing = shortest_path;
+    const auto search = [&](const NodeID source, const NodeID target) {
+        engine_working_data.InitializeOrClearFirstThreadLocalStorage(NUMBER_OF_NODES);
+        engine_working_data.InitializeOrClearSecondThreadLocalStorage(NUMBER_OF_NODES);
+        auto &forward_heap = *engine_working_data.forward_heap_1;
+        auto &reverse_heap = *engine_working_data.reverse_heap_1;
+        forward_heap.Insert(source, 0, source);
+        reverse_heap.Insert(target, 0, target);
+        int weight = INVALID_EDGE_WEIGHT;
+        std::vector<NodeID> packed_path;
+        routing.SearchWithCore(base_facade,
+                               forward_heap,
+                               reverse_heap,
+                               *engine_working_data.forward_heap_2,
+                               *engine_working_data.reverse_heap_2,
+                               weight,
+                               packed_path,
+                               false,
+                               false);
+        return weight;
+    };
+
+    for (NodeID source = 0; source < NUMBER_OF_NODES; ++source)
+    {
+        const auto expected = grid.Distances(source, true);
+        for (NodeID target = 0; target < NUMBER_OF_NODES; ++target)
+        {
+            if (source == target)
+                continue;
+
+            facade.UseLandmarks(false);
+            BOOST_CHECK_EQUAL(search(source, target), expected[target]);
+            facade.UseLandmarks(true);
+            BOOST_CHECK_EQUAL(search(source, target), expected[target]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,196 @@
+#include "engine/cache_statistics.hpp"
+#include "engine/edge_unpacker.hpp"
+#include "engine/shortcut_unpacking_cache.hpp"
+
+#include "contractor/query_edge.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(shortcut_unpacking_cache)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+// A path of original edges 0 -> 1 -> ... -> n, contracted into a balanced hierarchy of
+// forward shortcuts. Edge i of `edges` goes from `sources[i]` to `targets[i]`.
+struct FakeFacade
+{
+    using EdgeData = contractor::QueryEdge::EdgeData;
+
+    explicit FakeFacade(const NodeID number_of_nodes, ShortcutUnpackingCache *cache_)
+        : cache(cache_)
+    {
+        AddEdge(0, number_of_nodes - 1);
+    }
+
+    void AddEdge(const NodeID from, const NodeID to)
+    {
+        EdgeData data;
+        data.weight = to - from;
+        data.forward = true;
+        data.backward = false;
+        data.shortcut = to - from > 1;
+        data.id = data.shortcut ? (from + to) / 2 : from;
+        sources.push_back(from);
+        targets.push_back(to);
+        edges.push_back(data);
+
+        if (data.shortcut)
+        {
+            AddEdge(from, data.id);
+            AddEdge(data.id, to);
+        }
+    }
+
+    template <typename FilterT>
+    EdgeID FindSmallestEdge(const NodeID from, const NodeID to, FilterT &&filter) const
+    {
+        for (EdgeID edge = 0; edge < edges.size(); ++edge)
+        {
+            if (sources[edge] == from && targets[edge] == to && filter(edges[edge]))
+                return edge;
+        }
+        return SPECIAL_EDGEID;
+    }
+
+    const EdgeData &GetEdgeData(const EdgeID edge) const { return edges[edge]; }
+
+    ShortcutUnpackingCache *GetShortcutUnpackingCache() const { return cache; }
+
+    std::vector<NodeID> sources;
+    std::vector<NodeID> targets;
+    std::vector<EdgeData> edges;
+    ShortcutUnpackingCache *cache;
+};
+
+std::vector<std::pair<NodeID, NodeID>> unpack(const FakeFacade &facade,
+                                              const std::vector<NodeID> &packed_path)
+{
+    std::vector<std::pair<NodeID, NodeID>> unpacked;
+    UnpackCHPath(facade,
+                 packed_path.begin(),
+                 packed_path.end(),
+                 [&](std::pair<NodeID, NodeID> &edge, const FakeFacade::EdgeData &data) {
+                     BOOST_CHECK(!data.shortcut);
+                     BOOST_CHECK_EQUAL(data.id, edge.first);
+                     unpacked.push_back(edge);
+                 });
+    return unpacked;
+}
+}
+
+BOOST_AUTO_TEST_CASE(cached_unpacking_matches_uncached)
+{
+    const NodeID number_of_nodes = 101;
+    const std::vector<NodeID> packed_path = {0, number_of_nodes - 1};
+
+    const FakeFacade uncached_facade(number_of_nodes, nullptr);
+    const auto expected = unpack(uncached_facade, packed_path);
+    BOOST_REQUIRE_EQUAL(expected.size(), number_of_nodes - 1);
+    for (NodeID node = 0; node + 1 < number_of_nodes; ++node)
+    {
+        BOOST_CHECK_EQUAL(expected[node].first, node);
+        BOOST_CHECK_EQUAL(expected[node].second, node + 1);
+    }
+
+    ShortcutUnpackingCache cache(16 * 1024);
+    const FakeFacade cached_facade(number_of_nodes, &cache);
+
+    const auto first = unpack(cached_facade, packed_path);
+    BOOST_CHECK_EQUAL(cache.GetNumberOfHits(), 0);
+    BOOST_CHECK_EQUAL(cache.GetNumberOfMisses(), 1);
+
+    const auto second = unpack(cached_facade, packed_path);
+    BOOST_CHECK_EQUAL(cache.GetNumberOfHits(), 1);
+    BOOST_CHECK_EQUAL(cache.GetNumberOfMisses(), 1);
+
+    BOOST_CHECK(first == expected);
+    BOOST_CHECK(second == expected);
+}
+
+BOOST_AUTO_TEST_CASE(only_shortcuts_are_looked_up)
+{
+    ShortcutUnpackingCache cache(16 * 1024);
+    const FakeFacade facade(101, &cache);
+
+    // 0 -> 1 -> 2 -> 3 are original edges of the hierarchy, 1 -> 3 is a shortcut over 2
+    const auto original = unpack(facade, {0, 1, 2, 3});
+    BOOST_CHECK_EQUAL(original.size(), 3);
+    BOOST_CHECK_EQUAL(cache.GetNumberOfHits() + cache.GetNumberOfMisses(), 0);
+
+    const auto mixed = unpack(facade, {0, 1, 3});
+    BOOST_CHECK(mixed == original);
+    BOOST_CHECK_EQUAL(cache.GetNumberOfHits(), 0);
+    BOOST_CHECK_EQUAL(cache.GetNumberOfMisses(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(lookups_are_counted_in_the_statistics)
+{
+    const auto &statistics = CacheStatistics::GetInstance();
+    const auto hits = statistics.GetNumberOfShortcutUnpackingHits();
+    const auto misses = statistics.GetNumberOfShortcutUnpackingMisses();
+
+    ShortcutUnpackingCache cache(16 * 1024);
+    const FakeFacade facade(101, &cache);
+    unpack(facade, {0, 100});
+    unpack(facade, {0, 100});
+    unpack(facade, {0, 100});
+
+    // while the cache is still in use
+    BOOST_CHECK_EQUAL(statistics.GetNumberOfShortcutUnpackingHits(), hits + 2);
+    BOOST_CHECK_EQUAL(statistics.GetNumberOfShortcutUnpackingMisses(), misses + 1);
+}
+
+BOOST_AUTO_TEST_CASE(short_expansions_are_not_cached)
+{
+    ShortcutUnpackingCache cache(16 * 1024);
+    const std::size_t min_original_edges = ShortcutUnpackingCache::MIN_ORIGINAL_EDGES;
+
+    ShortcutUnpackingCache::OriginalEdges edges(min_original_edges - 1);
+    cache.Insert(1, 2, edges);
+    BOOST_CHECK(!cache.Get(1, 2));
+
+    edges.resize(min_original_edges);
+    cache.Insert(1, 2, edges);
+    const auto cached = cache.Get(1, 2);
+    BOOST_REQUIRE(cached);
+    BOOST_CHECK_EQUAL(cached->size(), min_original_edges);
+    BOOST_CHECK(!cache.Get(2, 1));
+}
+
+BOOST_AUTO_TEST_CASE(capacity_bounds_the_number_of_cached_edges)
+{
+    // 64 edges per shard
+    ShortcutUnpackingCache cache(16 * 64);
+    const std::size_t min_original_edges = ShortcutUnpackingCache::MIN_ORIGINAL_EDGES;
+
+    const ShortcutUnpackingCache::OriginalEdges edges(min_original_edges);
+    for (NodeID from = 0; from < 1000; ++from)
+    {
+        cache.Insert(from, from + 1, edges);
+    }
+
+    std::size_t cached_edges = 0;
+    for (NodeID from = 0; from < 1000; ++from)
+    {
+        const auto cached = cache.Get(from, from + 1);
+        cached_edges += cached ? cached->size() : 0;
+    }
+    BOOST_CHECK_GT(cached_edges, 0);
+    BOOST_CHECK_LE(cached_edges, 16 * 64);
+    BOOST_CHECK(cache.Get(999, 1000));
+
+    // more edges than a shard can hold are not cached at all
+    cache.Insert(2000, 2001, ShortcutUnpackingCache::OriginalEdges(65));
+    BOOST_CHECK(!cache.Get(2000, 2001));
+    BOOST_CHECK(cache.Get(999, 1000));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,152 @@
+#include "engine/snapping_cache.hpp"
+
+#include "engine/cache_statistics.hpp"
+#include "engine/phantom_node.hpp"
+#include "util/coordinate.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(snapping_cache)
+
+using namespace osrm;
+using namespace osrm::engine;
+
+namespace
+{
+SnappingCache::PhantomNodes makePhantomNodes(const util::Coordinate location,
+                                             const double distance)
+{
+    PhantomNode phantom_node;
+    phantom_node.location = location;
+    phantom_node.input_location = location;
+    return {{phantom_node, distance}};
+}
+}
+
+BOOST_AUTO_TEST_CASE(cached_phantom_nodes)
+{
+    SnappingCache cache(64);
+    const util::Coordinate coordinate{util::FloatLongitude{7.41}, util::FloatLatitude{43.73}};
+
+    SnappingCache::Key key{coordinate, SnappingCache::QueryType::Nearest};
+    key.max_results = 1;
+    BOOST_CHECK(!cache.Get(key));
+
+    cache.Insert(key, makePhantomNodes(coordinate, 12.5));
+    const auto cached = cache.Get(key);
+    BOOST_REQUIRE(cached);
+    BOOST_REQUIRE_EQUAL(cached->size(), 1);
+    BOOST_CHECK(cached->front().phantom_node.location == coordinate);
+    BOOST_CHECK_EQUAL(cached->front().distance, 12.5);
+
+    BOOST_CHECK_EQUAL(cache.GetNumberOfHits(), 1);
+    BOOST_CHECK_EQUAL(cache.GetNumberOfMisses(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(lookups_are_counted_in_the_statistics)
+{
+    const auto &statistics = CacheStatistics::GetInstance();
+    const auto hits = statistics.GetNumberOfSnappingHits();
+    const auto misses = statistics.GetNumberOfSnappingMisses();
+
+    SnappingCache cache(64);
+    const util::Coordinate coordinate{util::FloatLongitude{7.41}, util::FloatLatitude{43.73}};
+    const SnappingCache::Key key{coordinate, SnappingCache::QueryType::Nearest};
+    cache.Get(key);
+    cache.Insert(key, makePhantomNodes(coordinate, 0));
+    cache.Get(key);
+
+    // while the cache is still in use
+    BOOST_CHECK_EQUAL(statistics.GetNumberOfSnappingHits(), hits + 1);
+    BOOST_CHECK_EQUAL(statistics.GetNumberOfSnappingMisses(), misses + 1);
+}
+
+BOOST_AUTO_TEST_CASE(all_parameters_are_part_of_the_key)
+{
+    SnappingCache cache(64);
+    const util::Coordinate coordinate{util::FloatLongitude{7.41}, util::FloatLatitude{43.73}};
+
+    SnappingCache::Key key{coordinate, SnappingCache::QueryType::Nearest};
+    key.max_results = 1;
+    key.max_distance = 100;
+    key.bearing = std::make_pair(90, 10);
+    cache.Insert(key, makePhantomNodes(coordinate, 0));
+    BOOST_CHECK(cache.Get(key));
+
+    auto other = key;
+    other.coordinate = {util::FixedLongitude{static_cast<std::int32_t>(coordinate.lon) + 1},
+                        coordinate.lat};
+    BOOST_CHECK(!cache.Get(other));
+
+    other = key;
+    other.type = SnappingCache::QueryType::NearestInRange;
+    BOOST_CHECK(!cache.Get(other));
+
+    other = key;
+    other.max_results = 2;
+    BOOST_CHECK(!cache.Get(other));
+
+    other = key;
+    other.max_distance = 101;
+    BOOST_CHECK(!cache.Get(other));
+
+    other = key;
+    other.bearing = std::make_pair(91, 10);
+    BOOST_CHECK(!cache.Get(other));
+
+    other = key;
+    other.bearing = std::make_pair(90, 11);
+    BOOST_CHECK(!cache.Get(other));
+}
+
+BOOST_AUTO_TEST_CASE(unset_parameters_are_part_of_the_key)
+{
+    SnappingCache cache(64);
+    const util::Coordinate coordinate{util::FloatLongitude{7.41}, util::FloatLatitude{43.73}};
+
+    // a query with a (bogus) radius of -1 or a bearing of 0 +/- -1 must not answer queries
+    // without a radius or bearing, which used these values as defaults
+    SnappingCache::Key key{coordinate, SnappingCache::QueryType::NearestInRange};
+    key.max_distance = -1.;
+    cache.Insert(key, {});
+    key = {coordinate, SnappingCache::QueryType::Nearest};
+    key.bearing = std::make_pair(0, -1);
+    cache.Insert(key, {});
+
+    BOOST_CHECK(!cache.Get({coordinate, SnappingCache::QueryType::NearestInRange}));
+    BOOST_CHECK(!cache.Get({coordinate, SnappingCache::QueryType::Nearest}));
+
+    key = {coordinate, SnappingCache::QueryType::NearestInRange};
+    key.max_distance = 0.;
+    BOOST_CHECK(!cache.Get(key));
+}
+
+BOOST_AUTO_TEST_CASE(least_recently_used_coordinates_are_evicted)
+{
+    // a single entry per shard
+    SnappingCache cache(1);
+
+    std::vector<SnappingCache::Key> keys;
+    for (int index = 0; index < 1000; ++index)
+    {
+        const util::Coordinate coordinate{util::FixedLongitude{index}, util::FixedLatitude{0}};
+        keys.push_back({coordinate, SnappingCache::QueryType::NearestWithAlternative});
+        cache.Insert(keys.back(), makePhantomNodes(coordinate, 0));
+    }
+
+    std::size_t cached = 0;
+    for (const auto &key : keys)
+    {
+        cached += cache.Get(key) ? 1 : 0;
+    }
+    BOOST_CHECK_GT(cached, 0);
+    BOOST_CHECK_LE(cached, 16);
+    BOOST_CHECK(cache.Get(keys.back()));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,93 @@
+#include "extractor/edge_based_node_renumbering.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <algorithm>
+#include <cstdlib>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(edge_based_node_renumbering)
+
+using namespace osrm;
+using namespace osrm::extractor;
+
+namespace
+{
+QueryNode MakeNode(const double lon, const double lat)
+{
+    return QueryNode{util::toFixed(util::FloatLongitude{lon}),
+                     util::toFixed(util::FloatLatitude{lat}),
+                     OSMNodeID{0}};
+}
+
+EdgeBasedNode
+MakeSegment(const NodeID forward, const NodeID reverse, const NodeID u, const NodeID v)
+{
+    return EdgeBasedNode{SegmentID{forward, true},
+                         SegmentID{reverse, reverse != SPECIAL_SEGMENTID},
+                         u,
+                         v,
+                         0,
+                         0,
+                         false,
+                         0,
+                         0,
+                         TRAVEL_MODE_DRIVING,
+                         TRAVEL_MODE_DRIVING};
+}
+}
+
+BOOST_AUTO_TEST_CASE(renumber_along_curve)
+{
+    // four coordinates far apart on a line and a road through all of them
+    const std::vector<QueryNode> coordinates = {
+        MakeNode(7.0, 43.0), MakeNode(7.1, 43.0), MakeNode(7.2, 43.0), MakeNode(7.3, 43.0)};
+
+    // the segments of node 0 and 1 are far from each other, node 2 is in between, node 3 has no
+    // segment at all
+    std::vector<EdgeBasedNode> segments = {MakeSegment(0, SPECIAL_SEGMENTID, 0, 1),
+                                           MakeSegment(1, SPECIAL_SEGMENTID, 2, 3),
+                                           MakeSegment(2, SPECIAL_SEGMENTID, 1, 2)};
+    std::vector<EdgeWeight> node_weights = {10, 11, 12, 13};
+    util::DeallocatingVector<EdgeBasedEdge> edges;
+    edges.push_back(EdgeBasedEdge{0, 2, 0, 1, true, false});
+    edges.push_back(EdgeBasedEdge{2, 1, 1, 1, true, false});
+    edges.push_back(EdgeBasedEdge{1, 3, 2, 1, true, false});
+
+    const auto old_to_new = ComputeHilbertNodeOrder(segments, coordinates, node_weights.size());
+
+    // the numbering is a permutation
+    auto sorted = old_to_new;
+    std::sort(sorted.begin(), sorted.end());
+    const std::vector<NodeID> identity = {0, 1, 2, 3};
+    BOOST_CHECK_EQUAL_COLLECTIONS(sorted.begin(), sorted.end(), identity.begin(), identity.end());
+
+    // neighbours along the road get consecutive IDs, the node without segments is last
+    BOOST_CHECK_EQUAL(old_to_new[3], 3);
+    BOOST_CHECK_EQUAL(std::abs(static_cast<int>(old_to_new[0]) - static_cast<int>(old_to_new[2])),
+                      1);
+    BOOST_CHECK_EQUAL(std::abs(static_cast<int>(old_to_new[2]) - static_cast<int>(old_to_new[1])),
+                      1);
+
+    RenumberEdgeBasedNodes(old_to_new, segments, node_weights, edges);
+
+    BOOST_CHECK_EQUAL(segments[0].forward_segment_id.id, old_to_new[0]);
+    BOOST_CHECK_EQUAL(segments[1].forward_segment_id.id, old_to_new[1]);
+    BOOST_CHECK_EQUAL(segments[2].forward_segment_id.id, old_to_new[2]);
+    BOOST_CHECK_EQUAL(segments[0].reverse_segment_id.id, SPECIAL_SEGMENTID);
+
+    for (const auto node : util::irange<NodeID>(0, 4))
+    {
+        BOOST_CHECK_EQUAL(node_weights[old_to_new[node]], 10 + static_cast<EdgeWeight>(node));
+    }
+
+    BOOST_CHECK_EQUAL(edges[0].source, old_to_new[0]);
+    BOOST_CHECK_EQUAL(edges[0].target, old_to_new[2]);
+    BOOST_CHECK_EQUAL(edges[1].source, old_to_new[2]);
+    BOOST_CHECK_EQUAL(edges[1].target, old_to_new[1]);
+    BOOST_CHECK_EQUAL(edges[2].source, old_to_new[1]);
+    BOOST_CHECK_EQUAL(edges[2].target, old_to_new[3]);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
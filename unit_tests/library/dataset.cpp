@@ -0,0 +1,78 @@
+#include <boost/filesystem.hpp>
+#include <boost/test/test_case_template.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include "args.hpp"
+#include "coordinates.hpp"
+#include "equal_json.hpp"
+#include "fixture.hpp"
+
+#include "storage/storage.hpp"
+#include "util/exception.hpp"
+
+#include "osrm/coordinate.hpp"
+#include "osrm/engine_config.hpp"
+#include "osrm/json_container.hpp"
+#include "osrm/osrm.hpp"
+#include "osrm/route_parameters.hpp"
+#include "osrm/status.hpp"
+
+BOOST_AUTO_TEST_SUITE(dataset)
+
+BOOST_AUTO_TEST_CASE(test_mapped_dataset_matches_process_memory)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    const auto dataset_path =
+        boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    {
+        storage::Storage storage{storage::StorageConfig{args[0]}};
+        storage.WriteDataset(dataset_path);
+    }
+
+    EngineConfig config;
+    config.storage_config = {args[0]};
+    config.storage_config.dataset_path = dataset_path;
+    config.use_shared_memory = false;
+    config.use_mmap = true;
+    BOOST_CHECK(config.IsValid());
+
+    const OSRM mapped_osrm{config};
+    const auto osrm = getOSRM(args[0]);
+
+    RouteParameters params;
+    params.steps = true;
+    params.coordinates = get_locations_in_big_component();
+
+    json::Object reference;
+    BOOST_CHECK(osrm.Route(params, reference) == Status::Ok);
+
+    json::Object result;
+    BOOST_CHECK(mapped_osrm.Route(params, result) == Status::Ok);
+
+    CHECK_EQUAL_JSON(reference, result);
+
+    boost::filesystem::remove(dataset_path);
+}
+
+BOOST_AUTO_TEST_CASE(test_mapped_dataset_missing)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {args[0]};
+    config.storage_config.dataset_path =
+        boost::filesystem::temp_directory_path() / boost::filesystem::unique_path();
+    config.use_shared_memory = false;
+    config.use_mmap = true;
+
+    BOOST_CHECK_THROW(OSRM{config}, util::exception);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
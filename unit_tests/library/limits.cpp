@@ -9,6 +9,7 @@
 #include "osrm/table_parameters.hpp"
 #include "osrm/trip_parameters.hpp"
 
+#include "osrm/cancellation_token.hpp"
 #include "osrm/coordinate.hpp"
 #include "osrm/engine_config.hpp"
 #include "osrm/json_container.hpp"
@@ -171,4 +172,37 @@ BOOST_AUTO_TEST_CASE(test_nearest_limits)
     BOOST_CHECK(code == "TooBig"); // per the New-Server API spec
 }
 
+BOOST_AUTO_TEST_CASE(test_request_deadline)
+{
+    const auto args = get_args();
+    BOOST_REQUIRE_EQUAL(args.size(), 1);
+
+    using namespace osrm;
+
+    EngineConfig config;
+    config.storage_config = {args[0]};
+    config.use_shared_memory = false;
+
+    OSRM osrm{config};
+
+    TableParameters params;
+    params.coordinates.emplace_back(getZeroCoordinate());
+    params.coordinates.emplace_back(getZeroCoordinate());
+
+    json::Object result;
+
+    const CancellationToken expired_token(CancellationToken::Clock::now());
+    const auto rc = osrm.Table(params, result, expired_token);
+
+    BOOST_CHECK(rc == Status::Timeout);
+
+    const auto code = result.values["code"].get<json::String>().value;
+    BOOST_CHECK(code == "Timeout");
+
+    CancellationToken cancelled_token;
+    cancelled_token.Cancel();
+    json::Object cancelled_result;
+    BOOST_CHECK(osrm.Table(params, cancelled_result, cancelled_token) == Status::Timeout);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
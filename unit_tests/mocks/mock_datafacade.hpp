@@ -17,17 +17,19 @@ namespace osrm
 namespace test
 {
 
-class MockDataFacade final : public engine::datafacade::BaseDataFacade
+class MockDataFacade : public engine::datafacade::BaseDataFacade
 {
   private:
     EdgeData foo;
+    EdgeSearchData bar;
 
   public:
     unsigned GetNumberOfNodes() const override { return 0; }
     unsigned GetNumberOfEdges() const override { return 0; }
     unsigned GetOutDegree(const NodeID /* n */) const override { return 0; }
     NodeID GetTarget(const EdgeID /* e */) const override { return SPECIAL_NODEID; }
-    const EdgeData &GetEdgeData(const EdgeID /* e */) const override { return foo; }
+    EdgeData GetEdgeData(const EdgeID /* e */) const override { return foo; }
+    const EdgeSearchData &GetEdgeSearchData(const EdgeID /* e */) const override { return bar; }
     EdgeID BeginEdges(const NodeID /* n */) const override { return SPECIAL_EDGEID; }
     EdgeID EndEdges(const NodeID /* n */) const override { return SPECIAL_EDGEID; }
     osrm::engine::datafacade::EdgeRange GetAdjacentEdgeRange(const NodeID /* node */) const override
@@ -96,6 +98,27 @@ class MockDataFacade final : public engine::datafacade::BaseDataFacade
     {
         return {};
     }
+    void GetOriginalEdgeSequence(const std::vector<EdgeID> &edge_ids,
+                                 engine::datafacade::OriginalEdgeSequence &sequence) const override
+    {
+        sequence = engine::datafacade::OriginalEdgeSequence{};
+        sequence.segment_offsets.push_back(0);
+        for (std::size_t index = 0; index < edge_ids.size(); ++index)
+        {
+            sequence.name_ids.push_back(0);
+            sequence.turn_instructions.push_back(extractor::guidance::TurnInstruction::NO_TURN());
+            sequence.travel_modes.push_back(TRAVEL_MODE_INACCESSIBLE);
+            sequence.entry_class_ids.push_back(INVALID_ENTRY_CLASSID);
+            sequence.pre_turn_bearings.push_back(util::guidance::TurnBearing{0.0});
+            sequence.post_turn_bearings.push_back(util::guidance::TurnBearing{0.0});
+            sequence.lane_data.push_back({{0, 0}, 0});
+            sequence.segment_nodes.push_back(0);
+            sequence.segment_weights.push_back(1);
+            sequence.segment_datasources.push_back(0);
+            sequence.segment_offsets.push_back(sequence.segment_nodes.size());
+        }
+    }
+    engine::ShortcutUnpackingCache *GetShortcutUnpackingCache() const override { return nullptr; }
     std::string GetDatasourceName(const uint8_t /*datasource_name_id*/) const override
     {
         return "";
@@ -196,6 +219,16 @@ class MockDataFacade final : public engine::datafacade::BaseDataFacade
         return {};
     }
 
+    std::vector<std::pair<engine::PhantomNode, engine::PhantomNode>>
+    NearestPhantomNodesWithAlternativeFromBigComponent(
+        const std::vector<util::Coordinate> &input_coordinates,
+        const std::vector<boost::optional<double>> & /*max_distances*/,
+        const std::vector<boost::optional<engine::Bearing>> & /*bearings*/) const override
+    {
+        return std::vector<std::pair<engine::PhantomNode, engine::PhantomNode>>(
+            input_coordinates.size());
+    }
+
     unsigned GetCheckSum() const override { return 0; }
     bool IsCoreNode(const NodeID /* id */) const override { return false; }
     unsigned GetNameIndexFromEdgeID(const unsigned /* id */) const override { return 0; }
@@ -204,6 +237,11 @@ class MockDataFacade final : public engine::datafacade::BaseDataFacade
     std::string GetPronunciationForID(const unsigned /* name_id */) const override { return ""; }
     std::string GetDestinationsForID(const unsigned /* name_id */) const override { return ""; }
     std::size_t GetCoreSize() const override { return 0; }
+    unsigned GetNumberOfCoreLandmarks() const override { return 0; }
+    const EdgeWeight *GetCoreLandmarkDistances(const NodeID /* id */) const override
+    {
+        return nullptr;
+    }
     std::string GetTimestamp() const override { return ""; }
     bool GetContinueStraightDefault() const override { return true; }
     double GetMapMatchingMaxSpeed() const override { return 180 / 3.6; }
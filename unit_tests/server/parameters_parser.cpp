@@ -14,6 +14,8 @@
 #include <boost/test/test_tools.hpp>
 #include <boost/test/unit_test.hpp>
 
+#include <limits>
+
 #define CHECK_EQUAL_RANGE(R1, R2)                                                                  \
     BOOST_CHECK_EQUAL_COLLECTIONS(R1.begin(), R1.end(), R2.begin(), R2.end());
 
@@ -65,10 +67,33 @@ BOOST_AUTO_TEST_CASE(invalid_route_urls)
     BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>(std::string{"1,2;3,4"} + '\0' + ".json"),
                       7);
     BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>(std::string{"1,2;3,"} + '\0'), 6);
+    BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("1,2;3,4?"), 8);
+    BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("1,2;3,4?steps=true&"), 18);
+    BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("1,2;3,4?bearings=9,"), 19);
+    BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("1,2;3,4?bearings=99999,1"), 17);
+    BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("1,2;3,4?geometries=polyline6x"), 28);
+    BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("polyline(a.b)"), 10);
 
     // BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>(), );
 }
 
+BOOST_AUTO_TEST_CASE(invalid_radiuses)
+{
+    const auto result_1 = parseParameters<RouteParameters>("1,2;3,4?radiuses=-1;unlimited");
+    BOOST_REQUIRE(result_1);
+    BOOST_CHECK(!result_1->IsValid());
+
+    const auto result_2 = parseParameters<RouteParameters>("1,2;3,4?radiuses=0;unlimited");
+    BOOST_REQUIRE(result_2);
+    BOOST_CHECK(result_2->IsValid());
+
+    RouteParameters parameters;
+    parameters.coordinates = {{util::FloatLongitude{1}, util::FloatLatitude{2}},
+                              {util::FloatLongitude{3}, util::FloatLatitude{4}}};
+    parameters.radiuses = {std::numeric_limits<double>::quiet_NaN(), boost::none};
+    BOOST_CHECK(!parameters.IsValid());
+}
+
 BOOST_AUTO_TEST_CASE(invalid_table_urls)
 {
     BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?sources=1&bla=foo"), 17UL);
@@ -77,6 +102,8 @@ BOOST_AUTO_TEST_CASE(invalid_table_urls)
         testInvalidOptions<TableParameters>("1,2;3,4?sources=1&destinations=1&bla=foo"), 32UL);
     BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?sources=foo"), 16UL);
     BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?destinations=foo"), 21UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?sources=1;"), 17UL);
+    BOOST_CHECK_EQUAL(testInvalidOptions<TableParameters>("1,2;3,4?sources=all;1"), 19UL);
 }
 
 BOOST_AUTO_TEST_CASE(valid_route_hint)
@@ -128,6 +155,19 @@ BOOST_AUTO_TEST_CASE(valid_route_urls)
     CHECK_EQUAL_RANGE(reference_2.coordinates, result_2->coordinates);
     CHECK_EQUAL_RANGE(reference_2.hints, result_2->hints);
 
+    auto result_alternatives = parseParameters<RouteParameters>("1,2;3,4?alternatives=3");
+    BOOST_CHECK(result_alternatives);
+    BOOST_CHECK_EQUAL(result_alternatives->alternatives, true);
+    BOOST_CHECK_EQUAL(result_alternatives->number_of_alternatives, 3);
+    result_alternatives = parseParameters<RouteParameters>("1,2;3,4?alternatives=0");
+    BOOST_CHECK(result_alternatives);
+    BOOST_CHECK_EQUAL(result_alternatives->alternatives, false);
+    BOOST_CHECK_EQUAL(result_alternatives->number_of_alternatives, 0);
+    result_alternatives = parseParameters<RouteParameters>("1,2;3,4?alternatives=true");
+    BOOST_CHECK(result_alternatives);
+    BOOST_CHECK_EQUAL(result_alternatives->alternatives, true);
+    BOOST_CHECK_EQUAL(result_alternatives->number_of_alternatives, 0);
+
     RouteParameters reference_3{false,
                                 false,
                                 false,
@@ -434,4 +474,80 @@ BOOST_AUTO_TEST_CASE(valid_trip_urls)
     CHECK_EQUAL_RANGE(reference_1.coordinates, result_1->coordinates);
 }
 
+BOOST_AUTO_TEST_CASE(output_formats)
+{
+    using OutputFormatType = BaseParameters::OutputFormatType;
+
+    auto result_1 = parseParameters<RouteParameters>("1,2;3,4");
+    BOOST_CHECK(result_1);
+    BOOST_CHECK(result_1->format == OutputFormatType::JSON);
+
+    auto result_2 = parseParameters<RouteParameters>("1,2;3,4.json?steps=true");
+    BOOST_CHECK(result_2);
+    BOOST_CHECK(result_2->format == OutputFormatType::JSON);
+
+    auto result_3 = parseParameters<TableParameters>("1,2;3,4.cbor?sources=0");
+    BOOST_CHECK(result_3);
+    BOOST_CHECK(result_3->format == OutputFormatType::CBOR);
+    BOOST_CHECK_EQUAL(result_3->coordinates.back(),
+                      util::Coordinate(util::FloatLongitude{3}, util::FloatLatitude{4}));
+
+    auto result_4 = parseParameters<NearestParameters>("polyline(_ibE?).cbor");
+    BOOST_CHECK(result_4);
+    BOOST_CHECK(result_4->format == OutputFormatType::CBOR);
+
+    auto result_5 = parseParameters<TableParameters>(".cbor?sources=0", std::string(8, '\0'));
+    BOOST_CHECK(result_5);
+    BOOST_CHECK(result_5->format == OutputFormatType::CBOR);
+
+    BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("1,2;3,4.cbo"), 8);
+    BOOST_CHECK_EQUAL(testInvalidOptions<RouteParameters>("1,2;3,4.cbor.json"), 12);
+}
+
+BOOST_AUTO_TEST_CASE(body_coordinates)
+{
+    // 1,2;-3,4 in fixed point, little-endian
+    const std::string body("\x40\x42\x0f\x00\x80\x84\x1e\x00"
+                           "\x40\x39\xd2\xff\x00\x09\x3d\x00",
+                           2 * BODY_COORDINATE_SIZE);
+    std::vector<util::Coordinate> coords_1 = {{util::FloatLongitude{1}, util::FloatLatitude{2}},
+                                              {util::FloatLongitude{-3}, util::FloatLatitude{4}}};
+
+    auto result_1 = parseParameters<TableParameters>("", body);
+    BOOST_CHECK(result_1);
+    CHECK_EQUAL_RANGE(coords_1, result_1->coordinates);
+
+    std::vector<std::size_t> sources_2 = {1};
+    auto result_2 = parseParameters<TableParameters>("?sources=1&generate_hints=false", body);
+    BOOST_CHECK(result_2);
+    CHECK_EQUAL_RANGE(sources_2, result_2->sources);
+    BOOST_CHECK_EQUAL(result_2->generate_hints, false);
+    CHECK_EQUAL_RANGE(coords_1, result_2->coordinates);
+
+    std::vector<unsigned> timestamps_3 = {5, 6};
+    auto result_3 = parseParameters<MatchParameters>("?timestamps=5;6", body);
+    BOOST_CHECK(result_3);
+    CHECK_EQUAL_RANGE(timestamps_3, result_3->timestamps);
+    CHECK_EQUAL_RANGE(coords_1, result_3->coordinates);
+
+    auto result_4 = parseParameters<TripParameters>("?steps=true", body);
+    BOOST_CHECK(result_4);
+    BOOST_CHECK_EQUAL(result_4->steps, true);
+    CHECK_EQUAL_RANGE(coords_1, result_4->coordinates);
+
+    // truncated coordinate
+    BOOST_CHECK(!parseParameters<TableParameters>("", body.substr(0, 12)));
+
+    // coordinates are not allowed in the query
+    std::string options_6 = "1,2;3,4?sources=1";
+    auto iter_6 = options_6.begin();
+    BOOST_CHECK(!parseParameters<TableParameters>(iter_6, options_6.end(), body));
+    BOOST_CHECK_EQUAL(std::distance(options_6.begin(), iter_6), 0);
+
+    std::string options_7 = "?sources=1&bearings=9,";
+    auto iter_7 = options_7.begin();
+    BOOST_CHECK(!parseParameters<TableParameters>(iter_7, options_7.end(), body));
+    BOOST_CHECK_EQUAL(std::distance(options_7.begin(), iter_7), 22);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,165 @@
+#include "server/api/query_parser.hpp"
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(api_query_parser)
+
+using namespace osrm;
+using namespace osrm::server::api;
+
+// returns the number of consumed characters or -1 if parsing failed
+template <typename T, typename Parse> int parse(std::string input, T &value, Parse &&parse_value)
+{
+    QueryParser parser(input.begin(), input.end());
+    const auto begin = parser.Position();
+    if (!parse_value(parser, value))
+    {
+        BOOST_CHECK(parser.Position() == begin);
+        return -1;
+    }
+    return static_cast<int>(parser.Position() - begin);
+}
+
+int parseDouble(const std::string &input, double &value)
+{
+    return parse(input, value, [](QueryParser &parser, double &v) { return parser.Double(v); });
+}
+
+int parseJsonDouble(const std::string &input, double &value)
+{
+    return parse(
+        input, value, [](QueryParser &parser, double &v) { return parser.JsonDouble(v); });
+}
+
+BOOST_AUTO_TEST_CASE(doubles)
+{
+    double value = 0;
+    BOOST_CHECK_EQUAL(parseDouble("13.388860", value), 9);
+    BOOST_CHECK_EQUAL(value, 13.388860);
+    BOOST_CHECK_EQUAL(parseDouble("-.5;", value), 3);
+    BOOST_CHECK_EQUAL(value, -.5);
+    BOOST_CHECK_EQUAL(parseDouble("+5.", value), 3);
+    BOOST_CHECK_EQUAL(value, 5.);
+    BOOST_CHECK_EQUAL(parseDouble("1.5e3", value), 5);
+    BOOST_CHECK_EQUAL(value, 1500.);
+    BOOST_CHECK_EQUAL(parseDouble("25E-1", value), 5);
+    BOOST_CHECK_EQUAL(value, 2.5);
+    // not an exponent
+    BOOST_CHECK_EQUAL(parseDouble("2e", value), 1);
+    BOOST_CHECK_EQUAL(value, 2.);
+    BOOST_CHECK_EQUAL(parseDouble("123456789012345678901", value), 21);
+    BOOST_CHECK_EQUAL(value, 123456789012345678901.);
+    BOOST_CHECK_EQUAL(parseDouble("inf", value), 3);
+    BOOST_CHECK(std::isinf(value));
+    BOOST_CHECK_EQUAL(parseDouble("-Infinity", value), 9);
+    BOOST_CHECK(std::isinf(value) && value < 0);
+    BOOST_CHECK_EQUAL(parseDouble("NaN(1)", value), 6);
+    BOOST_CHECK(std::isnan(value));
+
+    BOOST_CHECK_EQUAL(parseDouble(".", value), -1);
+    BOOST_CHECK_EQUAL(parseDouble("-", value), -1);
+    BOOST_CHECK_EQUAL(parseDouble("nan(", value), -1);
+    BOOST_CHECK_EQUAL(parseDouble("unlimited", value), -1);
+}
+
+BOOST_AUTO_TEST_CASE(json_doubles)
+{
+    double value = 0;
+    BOOST_CHECK_EQUAL(parseJsonDouble("7.416351,", value), 8);
+    BOOST_CHECK_EQUAL(value, 7.416351);
+    BOOST_CHECK_EQUAL(parseJsonDouble("4.json", value), 1);
+    BOOST_CHECK_EQUAL(value, 4.);
+    BOOST_CHECK_EQUAL(parseJsonDouble("4.jso", value), 2);
+    BOOST_CHECK_EQUAL(parseJsonDouble("4.cbor", value), 1);
+    BOOST_CHECK_EQUAL(parseJsonDouble("1e3", value), 1);
+    BOOST_CHECK_EQUAL(value, 1.);
+
+    BOOST_CHECK_EQUAL(parseJsonDouble("inf", value), -1);
+    BOOST_CHECK_EQUAL(parseJsonDouble(".json", value), -1);
+}
+
+BOOST_AUTO_TEST_CASE(integers)
+{
+    unsigned value = 0;
+    const auto parse_unsigned = [](QueryParser &parser, unsigned &v) {
+        return parser.Unsigned(v);
+    };
+    BOOST_CHECK_EQUAL(parse("4294967295", value, parse_unsigned), 10);
+    BOOST_CHECK_EQUAL(value, std::numeric_limits<unsigned>::max());
+    BOOST_CHECK_EQUAL(parse("007;", value, parse_unsigned), 3);
+    BOOST_CHECK_EQUAL(value, 7u);
+    BOOST_CHECK_EQUAL(parse("4294967296", value, parse_unsigned), -1);
+    BOOST_CHECK_EQUAL(parse("+1", value, parse_unsigned), -1);
+
+    short signed_value = 0;
+    const auto parse_signed = [](QueryParser &parser, short &v) { return parser.Signed(v); };
+    BOOST_CHECK_EQUAL(parse("-32768", signed_value, parse_signed), 6);
+    BOOST_CHECK_EQUAL(signed_value, -32768);
+    BOOST_CHECK_EQUAL(parse("+32767", signed_value, parse_signed), 6);
+    BOOST_CHECK_EQUAL(signed_value, 32767);
+    BOOST_CHECK_EQUAL(parse("32768", signed_value, parse_signed), -1);
+    BOOST_CHECK_EQUAL(parse("-", signed_value, parse_signed), -1);
+
+    unsigned char hex = 0;
+    const auto parse_hex = [](QueryParser &parser, unsigned char &v) { return parser.Hex(v); };
+    BOOST_CHECK_EQUAL(parse("e4", hex, parse_hex), 2);
+    BOOST_CHECK_EQUAL(hex, 0xe4);
+    BOOST_CHECK_EQUAL(parse("7Fa", hex, parse_hex), 2);
+    BOOST_CHECK_EQUAL(hex, 0x7f);
+    BOOST_CHECK_EQUAL(parse("f", hex, parse_hex), -1);
+    BOOST_CHECK_EQUAL(parse("fg", hex, parse_hex), -1);
+}
+
+BOOST_AUTO_TEST_CASE(symbols_and_literals)
+{
+    enum class Type
+    {
+        Polyline,
+        Polyline6
+    };
+    static const std::pair<const char *, Type> types[] = {{"polyline", Type::Polyline},
+                                                          {"polyline6", Type::Polyline6}};
+
+    Type type = Type::Polyline;
+    const auto parse_type = [](QueryParser &parser, Type &v) { return parser.Symbol(types, v); };
+    BOOST_CHECK_EQUAL(parse("polyline6&", type, parse_type), 9);
+    BOOST_CHECK(type == Type::Polyline6);
+    BOOST_CHECK_EQUAL(parse("polyline&", type, parse_type), 8);
+    BOOST_CHECK(type == Type::Polyline);
+    BOOST_CHECK_EQUAL(parse("polylin", type, parse_type), -1);
+
+    bool value = false;
+    const auto parse_bool = [](QueryParser &parser, bool &v) { return parser.Bool(v); };
+    BOOST_CHECK_EQUAL(parse("true", value, parse_bool), 4);
+    BOOST_CHECK(value);
+    BOOST_CHECK_EQUAL(parse("falsey", value, parse_bool), 5);
+    BOOST_CHECK(!value);
+    BOOST_CHECK_EQUAL(parse("True", value, parse_bool), -1);
+}
+
+BOOST_AUTO_TEST_CASE(expectation_failure)
+{
+    std::string input = "v1/";
+    QueryParser parser(input.begin(), input.end());
+    unsigned version;
+    parser.Expect(parser.Char('v'));
+    parser.Expect(parser.Unsigned(version));
+    BOOST_CHECK_EQUAL(version, 1u);
+    try
+    {
+        parser.Expect(parser.Char(','));
+        BOOST_FAIL("expected an ExpectationFailure");
+    }
+    catch (const QueryParser::ExpectationFailure &failure)
+    {
+        BOOST_CHECK(failure.position == input.begin() + 2);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
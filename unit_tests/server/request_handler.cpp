@@ -0,0 +1,105 @@
+#include "server/request_handler.hpp"
+#include "server/api/parsed_url.hpp"
+#include "server/http/reply.hpp"
+#include "server/http/request.hpp"
+#include "server/service_handler.hpp"
+
+#include "engine/cancellation_token.hpp"
+#include "engine/status.hpp"
+#include "util/json_container.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <chrono>
+#include <memory>
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(request_handler)
+
+using namespace osrm;
+using namespace osrm::server;
+
+namespace
+{
+// Answers every query like the Engine does: with Timeout if the token was cancelled before the
+// query finished, with Ok otherwise
+class TokenCheckingServiceHandler final : public ServiceHandlerInterface
+{
+  public:
+    engine::Status RunQuery(api::ParsedURL,
+                            service::BaseService::ResultT &result,
+                            const engine::CancellationToken &token) override
+    {
+        util::json::Object json_result;
+        try
+        {
+            token.ThrowIfCancelled();
+        }
+        catch (const engine::RequestCancelled &cancelled)
+        {
+            json_result.values["code"] = "Timeout";
+            json_result.values["message"] = cancelled.what();
+            result = std::move(json_result);
+            return engine::Status::Timeout;
+        }
+        json_result.values["code"] = "Ok";
+        result = std::move(json_result);
+        return engine::Status::Ok;
+    }
+
+    engine::Status RunQuery(api::ParsedURL parsed_url,
+                            const std::string &,
+                            service::BaseService::ResultT &result,
+                            const engine::CancellationToken &token) override
+    {
+        return RunQuery(std::move(parsed_url), result, token);
+    }
+};
+
+http::reply handle(RequestHandler &handler,
+                   const http::request &request,
+                   std::function<bool()> is_connection_closed = {})
+{
+    handler.RegisterServiceHandler(std::make_unique<TokenCheckingServiceHandler>());
+    http::reply reply;
+    handler.HandleRequest(request, reply, std::move(is_connection_closed));
+    return reply;
+}
+
+http::request makeRequest()
+{
+    http::request request;
+    request.method = "GET";
+    request.uri = "/route/v1/driving/7.41,43.73;7.42,43.74";
+    return request;
+}
+}
+
+BOOST_AUTO_TEST_CASE(timed_out_requests_are_unavailable)
+{
+    RequestHandler unlimited_handler;
+    BOOST_CHECK_EQUAL(handle(unlimited_handler, makeRequest()).status, http::reply::ok);
+
+    // the deadline counts from when the connection was accepted
+    auto queued_request = makeRequest();
+    queued_request.accept_time = std::chrono::steady_clock::now() - std::chrono::seconds(10);
+    BOOST_CHECK_EQUAL(handle(unlimited_handler, queued_request).status, http::reply::ok);
+
+    RequestHandler limited_handler(1000);
+    BOOST_CHECK_EQUAL(handle(limited_handler, makeRequest()).status, http::reply::ok);
+    const auto reply = handle(limited_handler, queued_request);
+    BOOST_CHECK_EQUAL(reply.status, http::reply::service_unavailable);
+    const std::string content(reply.content.begin(), reply.content.end());
+    BOOST_CHECK(content.find("\"Timeout\"") != std::string::npos);
+}
+
+BOOST_AUTO_TEST_CASE(requests_of_closed_connections_are_unavailable)
+{
+    RequestHandler handler;
+    BOOST_CHECK_EQUAL(handle(handler, makeRequest(), [] { return false; }).status,
+                      http::reply::ok);
+    BOOST_CHECK_EQUAL(handle(handler, makeRequest(), [] { return true; }).status,
+                      http::reply::service_unavailable);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
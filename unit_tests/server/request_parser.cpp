@@ -0,0 +1,91 @@
+#include "server/request_parser.hpp"
+#include "server/http/request.hpp"
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+#include <tuple>
+
+BOOST_AUTO_TEST_SUITE(request_parser)
+
+using namespace osrm;
+using namespace osrm::server;
+
+// feeds the input in chunks of chunk_size bytes, like the reads of a connection
+RequestParser::RequestStatus
+parse(std::string input, http::request &request, const std::size_t chunk_size)
+{
+    RequestParser parser;
+    auto status = RequestParser::RequestStatus::indeterminate;
+    for (std::size_t offset = 0;
+         offset < input.size() && status == RequestParser::RequestStatus::indeterminate;
+         offset += chunk_size)
+    {
+        const auto end = std::min(offset + chunk_size, input.size());
+        std::tie(status, std::ignore) = parser.parse(request, &input[offset], &input[0] + end);
+    }
+    return status;
+}
+
+BOOST_AUTO_TEST_CASE(get_request)
+{
+    http::request request;
+    const auto status = parse("GET /route/v1/car/1,2;3,4 HTTP/1.1\r\n"
+                              "User-Agent: test\r\n\r\n",
+                              request,
+                              1000);
+    BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+    BOOST_CHECK_EQUAL(request.method, "GET");
+    BOOST_CHECK_EQUAL(request.uri, "/route/v1/car/1,2;3,4");
+    BOOST_CHECK_EQUAL(request.agent, "test");
+    BOOST_CHECK(request.body.empty());
+}
+
+BOOST_AUTO_TEST_CASE(post_request)
+{
+    const std::string body("\x01\x02\x00\r\n\x06\x07\x08\x09", 9);
+    const std::string input = "POST /table/v1/car?sources=0 HTTP/1.1\r\n"
+                              "Content-Length: 9\r\n\r\n" +
+                              body;
+
+    for (const std::size_t chunk_size : {1, 7, 1000})
+    {
+        http::request request;
+        const auto status = parse(input, request, chunk_size);
+        BOOST_CHECK(status == RequestParser::RequestStatus::valid);
+        BOOST_CHECK_EQUAL(request.method, "POST");
+        BOOST_CHECK_EQUAL(request.uri, "/table/v1/car?sources=0");
+        BOOST_CHECK_EQUAL(request.body, body);
+    }
+
+    // the body is incomplete
+    http::request request;
+    BOOST_CHECK(parse(input.substr(0, input.size() - 1), request, 1000) ==
+                RequestParser::RequestStatus::indeterminate);
+}
+
+BOOST_AUTO_TEST_CASE(invalid_content_length)
+{
+    http::request request;
+    BOOST_CHECK(parse("POST /table/v1/car HTTP/1.1\r\nContent-Length: 1x\r\n\r\n", request, 1000) ==
+                RequestParser::RequestStatus::invalid);
+    BOOST_CHECK(parse("POST /table/v1/car HTTP/1.1\r\nContent-Length: 999999999\r\n\r\n",
+                      request,
+                      1000) == RequestParser::RequestStatus::invalid);
+}
+
+BOOST_AUTO_TEST_CASE(expect_continue)
+{
+    RequestParser parser;
+    http::request request;
+    std::string input = "POST /table/v1/car HTTP/1.1\r\nExpect: 100-continue\r\n"
+                        "Content-Length: 8\r\n\r\n";
+    RequestParser::RequestStatus status;
+    std::tie(status, std::ignore) =
+        parser.parse(request, &input[0], &input[0] + input.size());
+    BOOST_CHECK(status == RequestParser::RequestStatus::indeterminate);
+    BOOST_CHECK(parser.expects_continue());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
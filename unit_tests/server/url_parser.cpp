@@ -116,4 +116,34 @@ BOOST_AUTO_TEST_CASE(valid_urls)
     BOOST_CHECK_EQUAL(reference_7.prefix_length, result_7->prefix_length);
 }
 
+BOOST_AUTO_TEST_CASE(body_urls)
+{
+    auto result_1 = api::parseBodyURL("/table/v1/profile?sources=0;1&destinations=all");
+    BOOST_CHECK(result_1);
+    BOOST_CHECK_EQUAL(result_1->service, "table");
+    BOOST_CHECK_EQUAL(result_1->version, 1u);
+    BOOST_CHECK_EQUAL(result_1->profile, "profile");
+    BOOST_CHECK_EQUAL(result_1->query, "?sources=0;1&destinations=all");
+    BOOST_CHECK_EQUAL(result_1->prefix_length, 17UL);
+
+    // no options
+    auto result_2 = api::parseBodyURL("/match/v1/car");
+    BOOST_CHECK(result_2);
+    BOOST_CHECK_EQUAL(result_2->service, "match");
+    BOOST_CHECK_EQUAL(result_2->profile, "car");
+    BOOST_CHECK(result_2->query.empty());
+    BOOST_CHECK_EQUAL(result_2->prefix_length, 13UL);
+
+    auto result_3 = api::parseBodyURL("/table/v1/car.cbor");
+    BOOST_CHECK(result_3);
+    BOOST_CHECK_EQUAL(result_3->profile, "car");
+    BOOST_CHECK_EQUAL(result_3->query, ".cbor");
+
+    // coordinates belong into the body
+    std::string url_4 = "/table/v1/profile/1,2;3,4";
+    auto iter_4 = url_4.begin();
+    BOOST_CHECK(!api::parseBodyURL(iter_4, url_4.end()));
+    BOOST_CHECK_EQUAL(std::distance(url_4.begin(), iter_4), 17);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
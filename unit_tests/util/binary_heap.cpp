@@ -84,6 +84,9 @@ BOOST_FIXTURE_TEST_CASE_TEMPLATE(insert_test, T, storage_types, RandomDataFixtur
 
         const auto &w = heap.GetKey(id);
         BOOST_CHECK_EQUAL(w, weights[id]);
+
+        const auto &const_heap = heap;
+        BOOST_CHECK_EQUAL(const_heap.GetKey(id), weights[id]);
     }
 }
 
@@ -0,0 +1,77 @@
+#include "util/bit_packed_vector.hpp"
+#include "util/typedefs.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(bit_packed_vector_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(bits_for_max_value)
+{
+    BOOST_CHECK_EQUAL(BitPackedVector<NodeID>::GetBitsFor(0), 1);
+    BOOST_CHECK_EQUAL(BitPackedVector<NodeID>::GetBitsFor(1), 1);
+    BOOST_CHECK_EQUAL(BitPackedVector<NodeID>::GetBitsFor(2), 2);
+    BOOST_CHECK_EQUAL(BitPackedVector<NodeID>::GetBitsFor(1023), 10);
+    BOOST_CHECK_EQUAL(BitPackedVector<NodeID>::GetBitsFor(1024), 11);
+    BOOST_CHECK_EQUAL(BitPackedVector<NodeID>::GetBitsFor(SPECIAL_NODEID), 32);
+    BOOST_CHECK_EQUAL(BitPackedVector<std::uint64_t>::GetBitsFor(~std::uint64_t{0}), 64);
+}
+
+BOOST_AUTO_TEST_CASE(set_and_retrieve)
+{
+    std::mt19937 generator(7);
+    for (const std::uint8_t bits : {1, 7, 21, 32})
+    {
+        const std::uint64_t max_value = (std::uint64_t{1} << bits) - 1;
+        std::uniform_int_distribution<std::uint64_t> distribution(0, max_value);
+
+        const std::size_t number_of_elements = 333;
+        BitPackedVector<NodeID> packed(number_of_elements, bits);
+        std::vector<NodeID> original(number_of_elements);
+
+        // write in reverse order and twice, so every write has to clear the old bits
+        for (const auto pass : {0, 1})
+        {
+            for (std::size_t index = number_of_elements; index > 0; --index)
+            {
+                original[index - 1] = pass == 0 ? max_value : distribution(generator);
+                packed.set(index - 1, original[index - 1]);
+            }
+        }
+
+        BOOST_CHECK_EQUAL(packed.size(), number_of_elements);
+        for (std::size_t index = 0; index < number_of_elements; ++index)
+        {
+            BOOST_CHECK_EQUAL(packed[index], original[index]);
+        }
+    }
+}
+
+BOOST_AUTO_TEST_CASE(shared_memory_view)
+{
+    const std::uint8_t bits = 19;
+    const std::size_t number_of_elements = 100;
+    std::vector<std::uint64_t> memory(
+        BitPackedVector<NodeID, true>::GetNumberOfWords(number_of_elements, bits), ~0ull);
+
+    BitPackedVector<NodeID, true> writer;
+    writer.reset(memory.data(), number_of_elements, bits);
+    for (std::size_t index = 0; index < number_of_elements; ++index)
+    {
+        writer.set(index, index * 5000);
+    }
+
+    BitPackedVector<NodeID, true> reader;
+    reader.reset(memory.data(), number_of_elements, bits);
+    for (std::size_t index = 0; index < number_of_elements; ++index)
+    {
+        BOOST_CHECK_EQUAL(reader[index], index * 5000);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
@@ -0,0 +1,87 @@
+#include "util/cbor_renderer.hpp"
+#include "util/json_container.hpp"
+
+#include <boost/test/test_tools.hpp>
+#include <boost/test/unit_test.hpp>
+
+#include <cmath>
+#include <limits>
+#include <string>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(cbor_renderer)
+
+using namespace osrm;
+using namespace osrm::util;
+
+// renders the value as the only member "v" of an object and returns the bytes of the value
+std::string render(json::Value value)
+{
+    json::Object object;
+    object.values["v"] = std::move(value);
+    std::vector<char> out;
+    cbor::render(out, object);
+
+    // map with one member, key "v"
+    const std::string prefix("\xa1\x61v");
+    BOOST_REQUIRE(out.size() > prefix.size());
+    BOOST_CHECK_EQUAL(std::string(out.begin(), out.begin() + prefix.size()), prefix);
+    return std::string(out.begin() + prefix.size(), out.end());
+}
+
+BOOST_AUTO_TEST_CASE(integers)
+{
+    BOOST_CHECK_EQUAL(render(json::Number(0)), std::string("\x00", 1));
+    BOOST_CHECK_EQUAL(render(json::Number(23)), "\x17");
+    BOOST_CHECK_EQUAL(render(json::Number(24)), "\x18\x18");
+    BOOST_CHECK_EQUAL(render(json::Number(1000)), "\x19\x03\xe8");
+    BOOST_CHECK_EQUAL(render(json::Number(1000000)), std::string("\x1a\x00\x0f\x42\x40", 5));
+    BOOST_CHECK_EQUAL(render(json::Number(1e12)),
+                      std::string("\x1b\x00\x00\x00\xe8\xd4\xa5\x10\x00", 9));
+    BOOST_CHECK_EQUAL(render(json::Number(-1)), std::string("\x20", 1));
+    BOOST_CHECK_EQUAL(render(json::Number(-100)), "\x38\x63");
+}
+
+BOOST_AUTO_TEST_CASE(floats)
+{
+    // exactly representable in single precision
+    BOOST_CHECK_EQUAL(render(json::Number(1.5)), std::string("\xfa\x3f\xc0\x00\x00", 5));
+    BOOST_CHECK_EQUAL(render(json::Number(-4.25)), std::string("\xfa\xc0\x88\x00\x00", 5));
+    BOOST_CHECK_EQUAL(render(json::Number(std::numeric_limits<double>::infinity())),
+                      std::string("\xfa\x7f\x80\x00\x00", 5));
+    BOOST_CHECK_EQUAL(render(json::Number(1.1)),
+                      std::string("\xfb\x3f\xf1\x99\x99\x99\x99\x99\x9a", 9));
+    BOOST_CHECK_EQUAL(render(json::Number(1e300)),
+                      std::string("\xfb\x7e\x37\xe4\x3c\x88\x00\x75\x9c", 9));
+}
+
+BOOST_AUTO_TEST_CASE(strings_and_literals)
+{
+    BOOST_CHECK_EQUAL(render(json::String("Ok")), "\x62Ok");
+    BOOST_CHECK_EQUAL(render(json::String("")), "\x60");
+    const std::string long_string(300, 'a');
+    BOOST_CHECK_EQUAL(render(json::String(long_string)), "\x79\x01\x2c" + long_string);
+
+    BOOST_CHECK_EQUAL(render(json::True()), "\xf5");
+    BOOST_CHECK_EQUAL(render(json::False()), "\xf4");
+    BOOST_CHECK_EQUAL(render(json::Null()), "\xf6");
+}
+
+BOOST_AUTO_TEST_CASE(containers)
+{
+    json::Array array;
+    array.values.push_back(json::Number(1));
+    array.values.push_back(json::String("a"));
+    json::Array nested;
+    nested.values.push_back(json::Null());
+    array.values.push_back(std::move(nested));
+    BOOST_CHECK_EQUAL(render(std::move(array)), "\x83\x01\x61\x61\x81\xf6");
+
+    json::Object object;
+    object.values["code"] = "Ok";
+    BOOST_CHECK_EQUAL(render(std::move(object)), "\xa1\x64\x63ode\x62Ok");
+
+    BOOST_CHECK_EQUAL(render(json::Array()), "\x80");
+}
+
+BOOST_AUTO_TEST_SUITE_END()
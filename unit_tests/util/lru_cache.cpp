@@ -0,0 +1,81 @@
+#include "util/lru_cache.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <string>
+
+BOOST_AUTO_TEST_SUITE(lru_cache)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(get_and_insert)
+{
+    LRUCache<int, std::string> cache(2);
+    std::string value;
+    BOOST_CHECK(!cache.Get(1, value));
+
+    cache.Insert(1, "one");
+    cache.Insert(2, "two");
+    BOOST_CHECK_EQUAL(cache.Size(), 2);
+    BOOST_CHECK(cache.Get(1, value));
+    BOOST_CHECK_EQUAL(value, "one");
+
+    cache.Insert(2, "zwei");
+    BOOST_CHECK_EQUAL(cache.Size(), 2);
+    BOOST_CHECK(cache.Get(2, value));
+    BOOST_CHECK_EQUAL(value, "zwei");
+}
+
+BOOST_AUTO_TEST_CASE(evicts_least_recently_used)
+{
+    LRUCache<int, int> cache(3);
+    cache.Insert(1, 10);
+    cache.Insert(2, 20);
+    cache.Insert(3, 30);
+
+    // 1 becomes the most recently used entry, so 2 is evicted
+    int value;
+    BOOST_CHECK(cache.Get(1, value));
+    cache.Insert(4, 40);
+
+    BOOST_CHECK_EQUAL(cache.Size(), 3);
+    BOOST_CHECK(cache.Contains(1));
+    BOOST_CHECK(!cache.Contains(2));
+    BOOST_CHECK(cache.Contains(3));
+    BOOST_CHECK(cache.Contains(4));
+
+    cache.Clear();
+    BOOST_CHECK_EQUAL(cache.Size(), 0);
+    BOOST_CHECK(!cache.Contains(1));
+}
+
+BOOST_AUTO_TEST_CASE(capacity_bounds_the_cost)
+{
+    LRUCache<int, int> cache(10);
+    cache.Insert(1, 10, 4);
+    cache.Insert(2, 20, 4);
+    BOOST_CHECK_EQUAL(cache.Cost(), 8);
+
+    // evicts 1 to make room
+    cache.Insert(3, 30, 4);
+    BOOST_CHECK_EQUAL(cache.Size(), 2);
+    BOOST_CHECK_EQUAL(cache.Cost(), 8);
+    BOOST_CHECK(!cache.Contains(1));
+
+    // replacing an entry updates its cost
+    cache.Insert(2, 21, 6);
+    BOOST_CHECK_EQUAL(cache.Cost(), 10);
+    int value;
+    BOOST_CHECK(cache.Get(2, value));
+    BOOST_CHECK_EQUAL(value, 21);
+
+    // entries larger than the capacity are not cached and don't evict anything
+    cache.Insert(4, 40, 11);
+    BOOST_CHECK(!cache.Contains(4));
+    BOOST_CHECK(cache.Contains(2));
+    BOOST_CHECK(cache.Contains(3));
+    BOOST_CHECK_EQUAL(cache.Cost(), 10);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
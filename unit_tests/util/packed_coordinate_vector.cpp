@@ -0,0 +1,98 @@
+#include "util/packed_coordinate_vector.hpp"
+#include "util/coordinate.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <random>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(packed_coordinate_vector_test)
+
+using namespace osrm;
+using namespace osrm::util;
+
+namespace
+{
+void checkEqual(const std::vector<Coordinate> &coordinates,
+                const PackedCoordinateVector<> &packed)
+{
+    BOOST_REQUIRE_EQUAL(packed.size(), coordinates.size());
+    for (std::size_t index = 0; index < coordinates.size(); ++index)
+    {
+        BOOST_CHECK_EQUAL(packed[index], coordinates[index]);
+    }
+}
+}
+
+BOOST_AUTO_TEST_CASE(nearby_coordinates)
+{
+    // a random walk, consecutive nodes are close to each other like in an extract
+    std::mt19937 generator(42);
+    std::uniform_int_distribution<int> step(-2000, 2000);
+    std::vector<Coordinate> coordinates;
+    int lon = 13388860, lat = 52517037;
+    for (int index = 0; index < 1000; ++index)
+    {
+        lon += step(generator);
+        lat += step(generator);
+        coordinates.emplace_back(FixedLongitude{lon}, FixedLatitude{lat});
+    }
+
+    const PackedCoordinateVector<> packed(coordinates);
+    checkEqual(coordinates, packed);
+    BOOST_CHECK_LT(packed.GetSizeInBytes(), coordinates.size() * sizeof(Coordinate) / 2);
+}
+
+BOOST_AUTO_TEST_CASE(extreme_coordinates)
+{
+    // blocks spanning the whole world and blocks with identical coordinates
+    std::vector<Coordinate> coordinates;
+    for (int index = 0; index < 70; ++index)
+    {
+        coordinates.emplace_back(FloatLongitude{index % 2 == 0 ? -180. : 180.},
+                                 FloatLatitude{index % 3 == 0 ? -90. : 90.});
+    }
+    for (int index = 0; index < 70; ++index)
+    {
+        coordinates.emplace_back(FloatLongitude{-0.000001}, FloatLatitude{0.000001});
+    }
+    coordinates.emplace_back(FloatLongitude{7.1}, FloatLatitude{-43.2});
+
+    const PackedCoordinateVector<> packed(coordinates);
+    checkEqual(coordinates, packed);
+}
+
+BOOST_AUTO_TEST_CASE(empty_and_shared_memory)
+{
+    const PackedCoordinateVector<> empty(std::vector<Coordinate>{});
+    BOOST_CHECK(empty.empty());
+
+    const std::vector<Coordinate> coordinates = {
+        Coordinate{FloatLongitude{1.}, FloatLatitude{2.}},
+        Coordinate{FloatLongitude{1.5}, FloatLatitude{2.5}},
+        Coordinate{FloatLongitude{-1.}, FloatLatitude{-2.}}};
+
+    PackedCoordinateEncoder counter(coordinates.size());
+    for (const auto coordinate : coordinates)
+    {
+        counter.push_back(coordinate);
+    }
+    std::vector<std::uint64_t> memory(counter.Finish(), ~0ull);
+
+    PackedCoordinateEncoder encoder(coordinates.size(), memory.data());
+    for (const auto coordinate : coordinates)
+    {
+        encoder.push_back(coordinate);
+    }
+    BOOST_CHECK_EQUAL(encoder.Finish(), memory.size());
+
+    PackedCoordinateVector<true> packed;
+    packed.reset(memory.data(), memory.size());
+    BOOST_REQUIRE_EQUAL(packed.size(), coordinates.size());
+    for (std::size_t index = 0; index < coordinates.size(); ++index)
+    {
+        BOOST_CHECK_EQUAL(packed[index], coordinates[index]);
+    }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
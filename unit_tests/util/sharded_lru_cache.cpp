@@ -0,0 +1,95 @@
+#include "util/sharded_lru_cache.hpp"
+
+#include <boost/test/unit_test.hpp>
+
+#include <atomic>
+#include <string>
+#include <thread>
+#include <vector>
+
+BOOST_AUTO_TEST_SUITE(sharded_lru_cache)
+
+using namespace osrm;
+using namespace osrm::util;
+
+BOOST_AUTO_TEST_CASE(get_and_insert)
+{
+    ShardedLRUCache<int, std::string> cache(64);
+    std::string value;
+    BOOST_CHECK(!cache.Get(1, value));
+
+    cache.Insert(1, "one");
+    cache.Insert(2, "two");
+    BOOST_CHECK(cache.Get(1, value));
+    BOOST_CHECK_EQUAL(value, "one");
+
+    cache.Insert(2, "zwei");
+    BOOST_CHECK(cache.Get(2, value));
+    BOOST_CHECK_EQUAL(value, "zwei");
+
+    BOOST_CHECK_EQUAL(cache.GetNumberOfHits(), 2);
+    BOOST_CHECK_EQUAL(cache.GetNumberOfMisses(), 1);
+}
+
+BOOST_AUTO_TEST_CASE(capacity_is_split_over_the_shards)
+{
+    const int capacity = 4 * 16;
+    ShardedLRUCache<int, int, std::hash<int>, 16> cache(capacity);
+    for (int key = 0; key < 100 * capacity; ++key)
+    {
+        cache.Insert(key, key);
+    }
+
+    int cached = 0;
+    int value;
+    for (int key = 0; key < 100 * capacity; ++key)
+    {
+        if (cache.Get(key, value))
+        {
+            BOOST_CHECK_EQUAL(value, key);
+            ++cached;
+        }
+    }
+    // every shard is filled up to its capacity by the most recent keys
+    BOOST_CHECK_EQUAL(cached, capacity);
+}
+
+BOOST_AUTO_TEST_CASE(concurrent_lookups)
+{
+    ShardedLRUCache<int, int> cache(1024);
+    const int number_of_keys = 512;
+
+    // Boost.Test assertions are not thread-safe, count the wrong values instead
+    std::atomic<int> wrong_values{0};
+    std::vector<std::thread> threads;
+    for (int thread = 0; thread < 4; ++thread)
+    {
+        threads.emplace_back([&cache, &wrong_values] {
+            for (int round = 0; round < 10; ++round)
+            {
+                for (int key = 0; key < number_of_keys; ++key)
+                {
+                    int value;
+                    if (cache.Get(key, value))
+                    {
+                        wrong_values += value != 2 * key;
+                    }
+                    else
+                    {
+                        cache.Insert(key, 2 * key);
+                    }
+                }
+            }
+        });
+    }
+    for (auto &thread : threads)
+    {
+        thread.join();
+    }
+
+    BOOST_CHECK_EQUAL(wrong_values, 0);
+    BOOST_CHECK_EQUAL(cache.GetNumberOfHits() + cache.GetNumberOfMisses(),
+                      4 * 10 * number_of_keys);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
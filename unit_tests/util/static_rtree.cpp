@@ -10,6 +10,7 @@
 #include "mocks/mock_datafacade.hpp"
 
 #include <boost/functional/hash.hpp>
+#include <boost/optional.hpp>
 #include <boost/test/auto_unit_test.hpp>
 #include <boost/test/test_case_template.hpp>
 #include <boost/test/unit_test.hpp>
@@ -302,6 +303,86 @@ BOOST_FIXTURE_TEST_CASE(construct_multiple_levels_test, TestRandomGraphFixture_M
     construction_test("test_5", this);
 }
 
+BOOST_FIXTURE_TEST_CASE(batch_nearest_test, TestRandomGraphFixture_MultipleLevels)
+{
+    std::string leaves_path;
+    std::string nodes_path;
+    build_rtree<TestRandomGraphFixture_MultipleLevels>("test_batch", this, leaves_path, nodes_path);
+    TestStaticRTree rtree(nodes_path, leaves_path, coords);
+
+    // clusters of nearby queries share leaves
+    std::mt19937 g(RANDOM_SEED);
+    std::uniform_int_distribution<> lat_udist(WORLD_MIN_LAT, WORLD_MAX_LAT);
+    std::uniform_int_distribution<> lon_udist(WORLD_MIN_LON, WORLD_MAX_LON);
+    std::uniform_int_distribution<> offset_udist(-100000, 100000);
+    std::vector<Coordinate> queries;
+    for (unsigned cluster = 0; cluster < 20; ++cluster)
+    {
+        const auto lon = lon_udist(g);
+        const auto lat = lat_udist(g);
+        for (unsigned i = 0; i < 20; ++i)
+        {
+            queries.emplace_back(FixedLongitude{lon + offset_udist(g)},
+                                 FixedLatitude{lat + offset_udist(g)});
+        }
+    }
+
+    std::vector<std::vector<TestData>> results(queries.size());
+    rtree.Nearest(queries, [&](const std::size_t index, TestStaticRTree::NearestBatch &batch) {
+        results[index] = batch.Nearest(
+            queries[index],
+            [](const TestStaticRTree::CandidateSegment &) { return std::make_pair(true, true); },
+            [](const std::size_t num_results, const TestStaticRTree::CandidateSegment &) {
+                return num_results >= 3;
+            });
+    });
+
+    for (const auto index : irange<std::size_t>(0, queries.size()))
+    {
+        const auto expected = rtree.Nearest(queries[index], 3);
+        BOOST_REQUIRE_EQUAL(results[index].size(), expected.size());
+        for (const auto i : irange<std::size_t>(0, expected.size()))
+        {
+            BOOST_CHECK_EQUAL(results[index][i].u, expected[i].u);
+            BOOST_CHECK_EQUAL(results[index][i].v, expected[i].v);
+        }
+    }
+}
+
+BOOST_FIXTURE_TEST_CASE(leaf_statistics_test, TestRandomGraphFixture_MultipleLevels)
+{
+    std::string leaves_path;
+    std::string nodes_path;
+    build_rtree<TestRandomGraphFixture_MultipleLevels>(
+        "test_leaves", this, leaves_path, nodes_path);
+    TestStaticRTree rtree(nodes_path, leaves_path, coords);
+
+    // not counted unless enabled
+    rtree.Nearest(coords.front(), 1);
+    BOOST_CHECK_EQUAL(rtree.GetNumberOfLeafAccesses(), 0);
+    BOOST_CHECK_EQUAL(rtree.GetNumberOfLeafPageFaults(), 0);
+    rtree.EnableLeafStatistics();
+
+    rtree.WarmUpLeaves();
+    BOOST_CHECK_EQUAL(rtree.GetNumberOfResidentLeafPages(), rtree.GetNumberOfLeafPages());
+
+    rtree.Nearest(coords.front(), 1);
+    const auto single_accesses = rtree.GetNumberOfLeafAccesses();
+    BOOST_CHECK_GT(single_accesses, 0);
+
+    const auto nearest = [](const std::size_t, TestStaticRTree::NearestBatch &batch) {
+        batch.Nearest(Coordinate{},
+                      [](const TestStaticRTree::CandidateSegment &) {
+                          return std::make_pair(true, true);
+                      },
+                      [](const std::size_t num_results, const TestStaticRTree::CandidateSegment &) {
+                          return num_results >= 1;
+                      });
+    };
+    rtree.Nearest(std::vector<Coordinate>(2, coords.front()), nearest);
+    BOOST_CHECK_GT(rtree.GetNumberOfLeafAccesses(), single_accesses);
+}
+
 // Bug: If you querry a point that lies between two BBs that have a gap,
 // one BB will be pruned, even if it could contain a nearer match.
 BOOST_AUTO_TEST_CASE(regression_test)
@@ -440,6 +521,139 @@ BOOST_AUTO_TEST_CASE(bearing_tests)
     }
 }
 
+BOOST_AUTO_TEST_CASE(batch_snapping_tests)
+{
+    using Coord = std::pair<FloatLongitude, FloatLatitude>;
+    using Edge = std::pair<unsigned, unsigned>;
+    GraphFixture fixture(
+        {
+            Coord(FloatLongitude{0.0}, FloatLatitude{0.0}),
+            Coord(FloatLongitude{10.0}, FloatLatitude{10.0}),
+            Coord(FloatLongitude{10.0}, FloatLatitude{0.0}),
+        },
+        {Edge(0, 1), Edge(1, 0), Edge(1, 2), Edge(2, 1)});
+
+    std::string leaves_path;
+    std::string nodes_path;
+    build_rtree<GraphFixture, MiniStaticRTree>(
+        "test_batch_snapping", &fixture, leaves_path, nodes_path);
+    MiniStaticRTree rtree(nodes_path, leaves_path, fixture.coords);
+    MockDataFacade mockfacade;
+    engine::GeospatialQuery<MiniStaticRTree, MockDataFacade> query(
+        rtree, fixture.coords, mockfacade);
+
+    const std::vector<Coordinate> inputs = {Coordinate(FloatLongitude{5.1}, FloatLatitude{5.0}),
+                                            Coordinate(FloatLongitude{9.0}, FloatLatitude{5.0}),
+                                            Coordinate(FloatLongitude{5.2}, FloatLatitude{5.0}),
+                                            Coordinate(FloatLongitude{9.5}, FloatLatitude{2.0})};
+    using Radiuses = std::vector<boost::optional<double>>;
+    using Bearings = std::vector<boost::optional<engine::Bearing>>;
+    const auto check_batch = [&](const Radiuses &batch_radiuses, const Bearings &batch_bearings) {
+        const auto results = query.NearestPhantomNodesWithAlternativeFromBigComponent(
+            inputs, batch_radiuses, batch_bearings);
+        BOOST_REQUIRE_EQUAL(results.size(), inputs.size());
+        for (const auto index : irange<std::size_t>(0, inputs.size()))
+        {
+            const auto radius = batch_radiuses.empty() ? boost::none : batch_radiuses[index];
+            const auto bearing = batch_bearings.empty() ? boost::none : batch_bearings[index];
+            std::pair<engine::PhantomNode, engine::PhantomNode> expected;
+            if (radius && bearing)
+            {
+                expected = query.NearestPhantomNodeWithAlternativeFromBigComponent(
+                    inputs[index], *radius, bearing->bearing, bearing->range);
+            }
+            else if (radius)
+            {
+                expected =
+                    query.NearestPhantomNodeWithAlternativeFromBigComponent(inputs[index], *radius);
+            }
+            else if (bearing)
+            {
+                expected = query.NearestPhantomNodeWithAlternativeFromBigComponent(
+                    inputs[index], bearing->bearing, bearing->range);
+            }
+            else
+            {
+                expected = query.NearestPhantomNodeWithAlternativeFromBigComponent(inputs[index]);
+            }
+
+            BOOST_CHECK(results[index].first == expected.first);
+            BOOST_CHECK_EQUAL(results[index].first.forward_segment_id.id,
+                              expected.first.forward_segment_id.id);
+            BOOST_CHECK_EQUAL(results[index].first.forward_segment_id.enabled,
+                              expected.first.forward_segment_id.enabled);
+            BOOST_CHECK(results[index].second == expected.second);
+        }
+    };
+
+    const Radiuses radiuses = {boost::none, 0.01, 11000, 11000};
+    const Bearings bearings = {
+        boost::none, boost::none, engine::Bearing{45, 10}, engine::Bearing{180, 10}};
+    check_batch({}, {});
+    check_batch(radiuses, {});
+    check_batch({}, bearings);
+    check_batch(radiuses, bearings);
+}
+
+BOOST_AUTO_TEST_CASE(snapping_cache_tests)
+{
+    using Coord = std::pair<FloatLongitude, FloatLatitude>;
+    using Edge = std::pair<unsigned, unsigned>;
+    GraphFixture fixture(
+        {
+            Coord(FloatLongitude{0.0}, FloatLatitude{0.0}),
+            Coord(FloatLongitude{10.0}, FloatLatitude{10.0}),
+        },
+        {Edge(0, 1), Edge(1, 0)});
+
+    std::string leaves_path;
+    std::string nodes_path;
+    build_rtree<GraphFixture, MiniStaticRTree>("test_snapping", &fixture, leaves_path, nodes_path);
+    MiniStaticRTree rtree(nodes_path, leaves_path, fixture.coords);
+    MockDataFacade mockfacade;
+    engine::GeospatialQuery<MiniStaticRTree, MockDataFacade> query(
+        rtree, fixture.coords, mockfacade);
+    engine::GeospatialQuery<MiniStaticRTree, MockDataFacade> cached_query(
+        rtree, fixture.coords, mockfacade);
+    cached_query.SetSnappingCacheSize(64);
+    const auto &cache = *cached_query.GetSnappingCache();
+
+    Coordinate input(FloatLongitude{5.1}, FloatLatitude{5.0});
+
+    const auto check_equal = [](const std::vector<engine::PhantomNodeWithDistance> &lhs,
+                                const std::vector<engine::PhantomNodeWithDistance> &rhs) {
+        BOOST_REQUIRE_EQUAL(lhs.size(), rhs.size());
+        for (std::size_t index = 0; index < lhs.size(); ++index)
+        {
+            BOOST_CHECK(lhs[index].phantom_node.location == rhs[index].phantom_node.location);
+            BOOST_CHECK_EQUAL(lhs[index].phantom_node.forward_segment_id.id,
+                              rhs[index].phantom_node.forward_segment_id.id);
+            BOOST_CHECK_EQUAL(lhs[index].phantom_node.forward_weight,
+                              rhs[index].phantom_node.forward_weight);
+            BOOST_CHECK_EQUAL(lhs[index].distance, rhs[index].distance);
+        }
+    };
+
+    for (int repetition = 0; repetition < 2; ++repetition)
+    {
+        check_equal(cached_query.NearestPhantomNodes(input, 5),
+                    query.NearestPhantomNodes(input, 5));
+        check_equal(cached_query.NearestPhantomNodes(input, 5, 45, 10),
+                    query.NearestPhantomNodes(input, 5, 45, 10));
+        check_equal(cached_query.NearestPhantomNodesInRange(input, 11000, 270, 10),
+                    query.NearestPhantomNodesInRange(input, 11000, 270, 10));
+
+        const auto cached_pair =
+            cached_query.NearestPhantomNodeWithAlternativeFromBigComponent(input);
+        const auto pair = query.NearestPhantomNodeWithAlternativeFromBigComponent(input);
+        BOOST_CHECK(cached_pair.first == pair.first);
+        BOOST_CHECK(cached_pair.second == pair.second);
+    }
+
+    BOOST_CHECK_EQUAL(cache.GetNumberOfMisses(), 4);
+    BOOST_CHECK_EQUAL(cache.GetNumberOfHits(), 4);
+}
+
 BOOST_AUTO_TEST_CASE(bbox_search_tests)
 {
     using Coord = std::pair<FloatLongitude, FloatLatitude>;